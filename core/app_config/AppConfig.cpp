@@ -57,6 +57,7 @@ DEFINE_FLAG_INT32(pub_buffer_file_num, "how many buffer files in default", 25);
 DEFINE_FLAG_INT32(default_local_file_size, "default size of one buffer file", 20 * 1024 * 1024);
 DEFINE_FLAG_INT32(pub_local_file_size, "default size of one buffer file", 20 * 1024 * 1024);
 DEFINE_FLAG_INT32(process_thread_count, "", 1);
+DEFINE_FLAG_INT32(file_reader_thread_count, "file reading worker count, 1 means reading in LogInput thread", 1);
 DEFINE_FLAG_INT32(send_request_concurrency, "max count keep in mem when async send", 15);
 DEFINE_FLAG_STRING(default_buffer_file_path, "set current execution dir in default", "");
 DEFINE_FLAG_STRING(buffer_file_path, "set buffer dir", "");
@@ -518,6 +519,7 @@ AppConfig::AppConfig() {
     // mOpenStreamLog = false;
     mSendRequestConcurrency = INT32_FLAG(send_request_concurrency);
     mProcessThreadCount = INT32_FLAG(process_thread_count);
+    mFileReaderThreadCount = INT32_FLAG(file_reader_thread_count);
     // mMappingConfigPath = STRING_FLAG(default_mapping_config_path);
     mMachineCpuUsageThreshold = DOUBLE_FLAG(default_machine_cpu_usage_threshold);
     mCpuUsageUpLimit = DOUBLE_FLAG(cpu_usage_up_limit);
@@ -768,6 +770,7 @@ void AppConfig::LoadEnvResourceLimit() {
     LoadSingleValueEnvConfig("mem_usage_limit", mMemUsageUpLimit, (int64_t)384);
     LoadSingleValueEnvConfig("max_bytes_per_sec", mMaxBytePerSec, (int32_t)(1024 * 1024));
     LoadSingleValueEnvConfig("process_thread_count", mProcessThreadCount, (int32_t)1);
+    LoadSingleValueEnvConfig("file_reader_thread_count", mFileReaderThreadCount, (int32_t)1);
     LoadSingleValueEnvConfig("send_request_concurrency", mSendRequestConcurrency, (int32_t)10);
 }
 
@@ -870,6 +873,11 @@ void AppConfig::LoadResourceConf(const Json::Value& confJson) {
     else
         mProcessThreadCount = INT32_FLAG(process_thread_count);
 
+    if (confJson.isMember("file_reader_thread_count") && confJson["file_reader_thread_count"].isInt())
+        mFileReaderThreadCount = confJson["file_reader_thread_count"].asInt();
+    else
+        mFileReaderThreadCount = INT32_FLAG(file_reader_thread_count);
+
     LoadInt32Parameter(INT32_FLAG(logreader_max_rotate_queue_size),
                        confJson,
                        "logreader_max_rotate_queue_size",
@@ -118,6 +118,7 @@ private:
     int64_t mMemUsageUpLimit;
 #endif
     int32_t mProcessThreadCount;
+    int32_t mFileReaderThreadCount;
     bool mInputFlowControl;
     bool mResourceAutoScale;
     float mMachineCpuUsageThreshold;
@@ -439,6 +440,8 @@ public:
 
     int32_t GetProcessThreadCount() const { return mProcessThreadCount; }
 
+    int32_t GetFileReaderThreadCount() const { return mFileReaderThreadCount; }
+
     // const std::string& GetMappingConfigPath() const { return mMappingConfigPath; }
 
     // const std::string& GetUserConfigPath() const { return mUserConfigPath; }
@@ -518,6 +521,7 @@ public:
     friend class InputPrometheusUnittest;
     friend class InputContainerStdioUnittest;
     friend class BatcherUnittest;
+    friend class DiskBufferWriterUnittest;
 #endif
 };
 
@@ -40,6 +40,7 @@
 #include "file_server/event_handler/LogInput.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "logger/Logger.h"
+#include "metadata/K8sMetadata.h"
 #include "monitor/Monitor.h"
 #include "pipeline/PipelineManager.h"
 #include "pipeline/plugin/PluginRegistry.h"
@@ -369,6 +370,8 @@ void Application::Exit() {
 
     FlusherRunner::GetInstance()->Stop();
     HttpSink::GetInstance()->Stop();
+    // the async curl runner must be stopped before exit, otherwise its destructor waits for the thread forever
+    K8sMetadata::GetInstance().Stop();
 
     // TODO: make it common
     FlusherSLS::RecycleResourceIfNotUsed();
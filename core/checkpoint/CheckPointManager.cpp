@@ -48,6 +48,7 @@ bool CheckPointManager::CheckVersion() {
 }
 
 void CheckPointManager::AddCheckPoint(CheckPoint* checkPointPtr) {
+    std::lock_guard<std::mutex> lock(mFileCheckPointMux);
     DevInodeCheckPointHashMap::iterator it
         = mDevInodeCheckPointPtrMap.find(CheckPointKey(checkPointPtr->mDevInode, checkPointPtr->mConfigName));
     if (it != mDevInodeCheckPointPtrMap.end())
@@ -57,12 +58,14 @@ void CheckPointManager::AddCheckPoint(CheckPoint* checkPointPtr) {
 }
 
 void CheckPointManager::DeleteCheckPoint(DevInode devInode, const std::string& configName) {
+    std::lock_guard<std::mutex> lock(mFileCheckPointMux);
     DevInodeCheckPointHashMap::iterator it = mDevInodeCheckPointPtrMap.find(CheckPointKey(devInode, configName));
     if (it != mDevInodeCheckPointPtrMap.end())
         mDevInodeCheckPointPtrMap.erase(it);
 }
 
 bool CheckPointManager::GetCheckPoint(DevInode devInode, const std::string& configName, CheckPointPtr& checkPointPtr) {
+    std::lock_guard<std::mutex> lock(mFileCheckPointMux);
     DevInodeCheckPointHashMap::iterator it = mDevInodeCheckPointPtrMap.find(CheckPointKey(devInode, configName));
     if (it != mDevInodeCheckPointPtrMap.end()) {
         checkPointPtr = it->second;
@@ -20,6 +20,7 @@
 #include <boost/optional.hpp>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -112,6 +113,8 @@ public:
     typedef std::map<CheckPointKey, CheckPointPtr> DevInodeCheckPointHashMap;
 
 private:
+    // file checkpoints are added, fetched and deleted by reader workers concurrently
+    std::mutex mFileCheckPointMux;
     DevInodeCheckPointHashMap mDevInodeCheckPointPtrMap;
     std::unordered_map<std::string, DirCheckPointPtr> mDirNameMap;
     int32_t mLastCheckTime;
@@ -0,0 +1,250 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/CharFinder.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define CHAR_FINDER_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// AVX2 is only dispatched on gcc and clang, where functions can be compiled for a target other than the default one
+#if defined(CHAR_FINDER_X86) && defined(__GNUC__)
+#define CHAR_FINDER_AVX2
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace logtail {
+
+namespace char_finder {
+
+namespace {
+
+#ifdef CHAR_FINDER_X86
+inline uint32_t CountTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return idx;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline uint32_t HighestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanReverse(&idx, mask);
+    return idx;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+#endif
+
+size_t FindLastCharScalar(const char* data, size_t size, char ch) {
+    for (size_t i = size; i > 0; --i) {
+        if (data[i - 1] == ch) {
+            return i - 1;
+        }
+    }
+    return size;
+}
+
+void FindAllCharsScalar(const char* data, size_t size, char ch, std::vector<size_t>& positions) {
+    const char* begin = data;
+    const char* end = data + size;
+    while (begin < end) {
+        const char* pos = static_cast<const char*>(memchr(begin, ch, end - begin));
+        if (pos == nullptr) {
+            break;
+        }
+        positions.push_back(pos - data);
+        begin = pos + 1;
+    }
+}
+
+#ifdef CHAR_FINDER_X86
+size_t FindLastCharSSE2(const char* data, size_t size, char ch) {
+    const __m128i target = _mm_set1_epi8(ch);
+    size_t i = size;
+    while (i >= 16) {
+        i -= 16;
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target)));
+        if (mask) {
+            return i + HighestBit(mask);
+        }
+    }
+    size_t res = FindLastCharScalar(data, i, ch);
+    return res == i ? size : res;
+}
+
+void FindAllCharsSSE2(const char* data, size_t size, char ch, std::vector<size_t>& positions) {
+    const __m128i target = _mm_set1_epi8(ch);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target)));
+        while (mask) {
+            positions.push_back(i + CountTrailingZeros(mask));
+            mask &= mask - 1;
+        }
+    }
+    for (; i < size; ++i) {
+        if (data[i] == ch) {
+            positions.push_back(i);
+        }
+    }
+}
+#endif
+
+#ifdef CHAR_FINDER_AVX2
+TARGET_AVX2 size_t FindLastCharAVX2(const char* data, size_t size, char ch) {
+    const __m256i target = _mm256_set1_epi8(ch);
+    size_t i = size;
+    while (i >= 32) {
+        i -= 32;
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, target)));
+        if (mask) {
+            return i + HighestBit(mask);
+        }
+    }
+    size_t res = FindLastCharSSE2(data, i, ch);
+    return res == i ? size : res;
+}
+
+TARGET_AVX2 void FindAllCharsAVX2(const char* data, size_t size, char ch, std::vector<size_t>& positions) {
+    const __m256i target = _mm256_set1_epi8(ch);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, target)));
+        while (mask) {
+            positions.push_back(i + CountTrailingZeros(mask));
+            mask &= mask - 1;
+        }
+    }
+    for (; i < size; ++i) {
+        if (data[i] == ch) {
+            positions.push_back(i);
+        }
+    }
+}
+#endif
+
+Impl DetectImpl() {
+#ifdef CHAR_FINDER_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Impl::AVX2;
+    }
+#endif
+#ifdef CHAR_FINDER_X86
+    // sse2 is part of x86-64
+    return Impl::SSE2;
+#else
+    return Impl::SCALAR;
+#endif
+}
+
+} // namespace
+
+Impl GetImpl() {
+    static const Impl sImpl = DetectImpl();
+    return sImpl;
+}
+
+const char* GetImplName(Impl impl) {
+    switch (impl) {
+        case Impl::AVX2:
+            return "avx2";
+        case Impl::SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
+
+bool IsImplSupported(Impl impl) {
+    switch (impl) {
+        case Impl::AVX2:
+            return GetImpl() == Impl::AVX2;
+        case Impl::SSE2:
+            return GetImpl() != Impl::SCALAR;
+        default:
+            return true;
+    }
+}
+
+size_t FindLastChar(Impl impl, const char* data, size_t size, char ch) {
+    switch (impl) {
+#ifdef CHAR_FINDER_AVX2
+        case Impl::AVX2:
+            return FindLastCharAVX2(data, size, ch);
+#endif
+#ifdef CHAR_FINDER_X86
+        case Impl::SSE2:
+            return FindLastCharSSE2(data, size, ch);
+#endif
+        default:
+            return FindLastCharScalar(data, size, ch);
+    }
+}
+
+void FindAllChars(Impl impl, const char* data, size_t size, char ch, std::vector<size_t>& positions) {
+    switch (impl) {
+#ifdef CHAR_FINDER_AVX2
+        case Impl::AVX2:
+            FindAllCharsAVX2(data, size, ch, positions);
+            return;
+#endif
+#ifdef CHAR_FINDER_X86
+        case Impl::SSE2:
+            FindAllCharsSSE2(data, size, ch, positions);
+            return;
+#endif
+        default:
+            FindAllCharsScalar(data, size, ch, positions);
+            return;
+    }
+}
+
+} // namespace char_finder
+
+size_t FindFirstChar(const char* data, size_t size, char ch) {
+    if (size == 0) {
+        return 0;
+    }
+    // memchr of libc is vectorized and dispatched at runtime already
+    const char* pos = static_cast<const char*>(memchr(data, ch, size));
+    return pos == nullptr ? size : pos - data;
+}
+
+size_t FindLastChar(const char* data, size_t size, char ch) {
+    return char_finder::FindLastChar(char_finder::GetImpl(), data, size, ch);
+}
+
+void FindAllChars(const char* data, size_t size, char ch, std::vector<size_t>& positions) {
+    char_finder::FindAllChars(char_finder::GetImpl(), data, size, ch, positions);
+}
+
+} // namespace logtail
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Vectorized single character search used for line splitting. The implementation (AVX2, SSE2 or scalar) is chosen
+// at runtime according to the cpu.
+namespace logtail {
+
+// position of the first ch in [data, data + size), or size if not found
+size_t FindFirstChar(const char* data, size_t size, char ch);
+// position of the last ch in [data, data + size), or size if not found
+size_t FindLastChar(const char* data, size_t size, char ch);
+// positions of all ch in [data, data + size) are appended to positions in one pass
+void FindAllChars(const char* data, size_t size, char ch, std::vector<size_t>& positions);
+
+namespace char_finder {
+
+enum class Impl { SCALAR, SSE2, AVX2 };
+
+Impl GetImpl();
+const char* GetImplName(Impl impl);
+bool IsImplSupported(Impl impl);
+
+// used by tests and benchmarks to compare implementations, impl must be supported
+size_t FindLastChar(Impl impl, const char* data, size_t size, char ch);
+void FindAllChars(Impl impl, const char* data, size_t size, char ch, std::vector<size_t>& positions);
+
+} // namespace char_finder
+
+} // namespace logtail
@@ -0,0 +1,540 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/FastJsonParser.h"
+
+#include <cstdint>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FAST_JSON_PARSER_SSE2
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#include "common/StringTools.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+// deeper values are left to rapidjson, which is not expected for logs
+const size_t kMaxDepth = 64;
+// integers with at most 18 digits always fit in int64, and are printed as they are by ToString
+const size_t kMaxPlainIntegerDigits = 18;
+
+const StringView kTrue("true");
+const StringView kFalse("false");
+
+inline bool IsWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// position of the first '"', '\\' or control character in [p, end), which ends the unescaped part of a string
+const char* FindStringSpecialChar(const char* p, const char* end) {
+#ifdef FAST_JSON_PARSER_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i controlMax = _mm_set1_epi8(0x1F);
+    for (; end - p >= 16; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i isQuote = _mm_cmpeq_epi8(chunk, quote);
+        __m128i isBackslash = _mm_cmpeq_epi8(chunk, backslash);
+        // unsigned chunk <= 0x1F
+        __m128i isControl = _mm_cmpeq_epi8(_mm_max_epu8(chunk, controlMax), controlMax);
+        uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(isQuote, isBackslash), isControl)));
+        if (mask) {
+#if defined(_MSC_VER)
+            unsigned long idx;
+            _BitScanForward(&idx, mask);
+            return p + idx;
+#else
+            return p + __builtin_ctz(mask);
+#endif
+        }
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == '"' || *p == '\\' || static_cast<unsigned char>(*p) < 0x20) {
+            return p;
+        }
+    }
+    return end;
+}
+
+bool ParseHex4(const char* p, const char* end, uint32_t& codepoint) {
+    if (end - p < 4) {
+        return false;
+    }
+    codepoint = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        char c = p[i];
+        codepoint <<= 4;
+        if (c >= '0' && c <= '9') {
+            codepoint |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            codepoint |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            codepoint |= c - 'A' + 10;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+char* EncodeUtf8(uint32_t codepoint, char* out) {
+    if (codepoint < 0x80) {
+        *out++ = static_cast<char>(codepoint);
+    } else if (codepoint < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (codepoint >> 6));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (codepoint >> 12));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (codepoint >> 18));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+    return out;
+}
+
+class Scanner {
+public:
+    Scanner(StringView json, SourceBuffer& sourceBuffer)
+        : mCur(json.data()), mEnd(json.data() + json.size()), mSourceBuffer(sourceBuffer) {}
+
+    bool ParseObject(vector<FastJsonParser::Member>& members) {
+        SkipWhitespace();
+        if (mCur == mEnd || *mCur != '{') {
+            return false;
+        }
+        ++mCur;
+        SkipWhitespace();
+        if (mCur < mEnd && *mCur == '}') {
+            ++mCur;
+            return ParseEnd();
+        }
+        while (true) {
+            StringView key, value;
+            if (mCur == mEnd || *mCur != '"' || !ParseString(key)) {
+                return false;
+            }
+            SkipWhitespace();
+            if (mCur == mEnd || *mCur != ':') {
+                return false;
+            }
+            ++mCur;
+            SkipWhitespace();
+            if (!ParseValue(value)) {
+                return false;
+            }
+            members.emplace_back(key, value);
+            SkipWhitespace();
+            if (mCur == mEnd) {
+                return false;
+            }
+            if (*mCur == '}') {
+                ++mCur;
+                return ParseEnd();
+            }
+            if (*mCur != ',') {
+                return false;
+            }
+            ++mCur;
+            SkipWhitespace();
+        }
+    }
+
+private:
+    // returns whether any whitespace is skipped
+    bool SkipWhitespace() {
+        const char* begin = mCur;
+        while (mCur < mEnd && IsWhitespace(*mCur)) {
+            ++mCur;
+        }
+        return mCur != begin;
+    }
+
+    // rapidjson parses the buffer as a null-terminated string, so anything after '\0' is ignored
+    bool ParseEnd() {
+        SkipWhitespace();
+        return mCur == mEnd || *mCur == '\0';
+    }
+
+    // mCur points to the opening quote, and is moved to the position after the closing quote. @hasEscape tells whether
+    // the string needs decoding, and @isCompact whether it is written the same by rapidjson::Writer after decoding.
+    bool SkipString(bool& hasEscape, bool& isCompact) {
+        const char* p = mCur + 1;
+        while (true) {
+            p = FindStringSpecialChar(p, mEnd);
+            if (p == mEnd) {
+                return false;
+            }
+            if (*p == '"') {
+                break;
+            }
+            if (*p != '\\') {
+                // unescaped control character
+                return false;
+            }
+            hasEscape = true;
+            if (++p == mEnd) {
+                return false;
+            }
+            switch (*p) {
+                case '"':
+                case '\\':
+                case 'b':
+                case 'f':
+                case 'n':
+                case 'r':
+                case 't':
+                    ++p;
+                    break;
+                case '/':
+                    isCompact = false;
+                    ++p;
+                    break;
+                case 'u': {
+                    isCompact = false;
+                    uint32_t codepoint = 0;
+                    if (!ParseHex4(p + 1, mEnd, codepoint)) {
+                        return false;
+                    }
+                    p += 5;
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                        uint32_t low = 0;
+                        if (mEnd - p < 2 || p[0] != '\\' || p[1] != 'u' || !ParseHex4(p + 2, mEnd, low) || low < 0xDC00
+                            || low > 0xDFFF) {
+                            return false;
+                        }
+                        p += 6;
+                    } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+                        // lone low surrogate is left to rapidjson
+                        return false;
+                    }
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        mCur = p + 1;
+        return true;
+    }
+
+    bool ParseString(StringView& res) {
+        const char* begin = mCur + 1;
+        bool hasEscape = false, isCompact = true;
+        if (!SkipString(hasEscape, isCompact)) {
+            return false;
+        }
+        const char* end = mCur - 1;
+        if (!hasEscape) {
+            res = StringView(begin, end - begin);
+            return true;
+        }
+        // decoded string is never longer than the escaped one
+        StringBuffer buffer = mSourceBuffer.AllocateStringBuffer(end - begin);
+        char* out = buffer.data;
+        for (const char* p = begin; p < end;) {
+            if (*p != '\\') {
+                *out++ = *p++;
+                continue;
+            }
+            ++p;
+            switch (*p++) {
+                case 'b':
+                    *out++ = '\b';
+                    break;
+                case 'f':
+                    *out++ = '\f';
+                    break;
+                case 'n':
+                    *out++ = '\n';
+                    break;
+                case 'r':
+                    *out++ = '\r';
+                    break;
+                case 't':
+                    *out++ = '\t';
+                    break;
+                case 'u': {
+                    uint32_t codepoint = 0;
+                    ParseHex4(p, end, codepoint);
+                    p += 4;
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                        uint32_t low = 0;
+                        ParseHex4(p + 2, end, low);
+                        p += 6;
+                        codepoint = (((codepoint - 0xD800) << 10) | (low - 0xDC00)) + 0x10000;
+                    }
+                    out = EncodeUtf8(codepoint, out);
+                    break;
+                }
+                default:
+                    // '"', '\\' and '/'
+                    *out++ = p[-1];
+                    break;
+            }
+        }
+        res = StringView(buffer.data, out - buffer.data);
+        return true;
+    }
+
+    // mCur points to the first character of the number. @isPlainInteger tells whether it is printed as it is by
+    // RapidjsonValueToString.
+    bool SkipNumber(bool& isPlainInteger) {
+        const char* begin = mCur;
+        if (*mCur == '-') {
+            ++mCur;
+        }
+        const char* digitsBegin = mCur;
+        if (mCur == mEnd || !IsDigit(*mCur)) {
+            return false;
+        }
+        if (*mCur == '0') {
+            ++mCur;
+        } else {
+            while (mCur < mEnd && IsDigit(*mCur)) {
+                ++mCur;
+            }
+        }
+        // -0 is converted to 0
+        isPlainInteger = static_cast<size_t>(mCur - digitsBegin) <= kMaxPlainIntegerDigits
+            && !(*digitsBegin == '0' && digitsBegin != begin);
+        if (mCur < mEnd && *mCur == '.') {
+            isPlainInteger = false;
+            ++mCur;
+            if (mCur == mEnd || !IsDigit(*mCur)) {
+                return false;
+            }
+            while (mCur < mEnd && IsDigit(*mCur)) {
+                ++mCur;
+            }
+        }
+        if (mCur < mEnd && (*mCur == 'e' || *mCur == 'E')) {
+            isPlainInteger = false;
+            ++mCur;
+            if (mCur < mEnd && (*mCur == '+' || *mCur == '-')) {
+                ++mCur;
+            }
+            if (mCur == mEnd || !IsDigit(*mCur)) {
+                return false;
+            }
+            while (mCur < mEnd && IsDigit(*mCur)) {
+                ++mCur;
+            }
+        }
+        return true;
+    }
+
+    bool SkipLiteral(const StringView& literal) {
+        if (static_cast<size_t>(mEnd - mCur) < literal.size() || StringView(mCur, literal.size()) != literal) {
+            return false;
+        }
+        mCur += literal.size();
+        return true;
+    }
+
+    // mCur points to the first character of a nested value. @isCompact is set to false if the raw text differs from the
+    // one written by rapidjson::Writer.
+    bool SkipValue(size_t depth, bool& isCompact) {
+        if (mCur == mEnd || depth > kMaxDepth) {
+            return false;
+        }
+        switch (*mCur) {
+            case '{':
+            case '[': {
+                bool isObject = *mCur == '{';
+                char close = isObject ? '}' : ']';
+                ++mCur;
+                if (SkipWhitespace()) {
+                    isCompact = false;
+                }
+                if (mCur < mEnd && *mCur == close) {
+                    ++mCur;
+                    return true;
+                }
+                while (true) {
+                    if (isObject) {
+                        bool hasEscape = false;
+                        if (mCur == mEnd || *mCur != '"' || !SkipString(hasEscape, isCompact)) {
+                            return false;
+                        }
+                        if (SkipWhitespace()) {
+                            isCompact = false;
+                        }
+                        if (mCur == mEnd || *mCur != ':') {
+                            return false;
+                        }
+                        ++mCur;
+                        if (SkipWhitespace()) {
+                            isCompact = false;
+                        }
+                    }
+                    if (!SkipValue(depth + 1, isCompact)) {
+                        return false;
+                    }
+                    if (SkipWhitespace()) {
+                        isCompact = false;
+                    }
+                    if (mCur == mEnd) {
+                        return false;
+                    }
+                    if (*mCur == close) {
+                        ++mCur;
+                        return true;
+                    }
+                    if (*mCur != ',') {
+                        return false;
+                    }
+                    ++mCur;
+                    if (SkipWhitespace()) {
+                        isCompact = false;
+                    }
+                }
+            }
+            case '"': {
+                bool hasEscape = false;
+                return SkipString(hasEscape, isCompact);
+            }
+            case 't':
+                return SkipLiteral(kTrue);
+            case 'f':
+                return SkipLiteral(kFalse);
+            case 'n':
+                return SkipLiteral("null");
+            default: {
+                bool isPlainInteger = false;
+                if (!SkipNumber(isPlainInteger)) {
+                    return false;
+                }
+                if (!isPlainInteger) {
+                    isCompact = false;
+                }
+                return true;
+            }
+        }
+    }
+
+    // the raw text of a value is converted by rapidjson when it cannot be referenced as it is
+    bool ConvertByRapidjson(const char* begin, StringView& res) {
+        rapidjson::Document doc;
+        doc.Parse(begin, mCur - begin);
+        if (doc.HasParseError()) {
+            return false;
+        }
+        StringBuffer buffer = mSourceBuffer.CopyString(RapidjsonValueToString(doc));
+        res = StringView(buffer.data, buffer.size);
+        return true;
+    }
+
+    bool ParseValue(StringView& res) {
+        if (mCur == mEnd) {
+            return false;
+        }
+        const char* begin = mCur;
+        switch (*mCur) {
+            case '"':
+                return ParseString(res);
+            case 't':
+                res = kTrue;
+                return SkipLiteral(kTrue);
+            case 'f':
+                res = kFalse;
+                return SkipLiteral(kFalse);
+            case 'n':
+                res = StringView();
+                return SkipLiteral("null");
+            case '{':
+            case '[': {
+                bool isCompact = true;
+                if (!SkipValue(1, isCompact)) {
+                    return false;
+                }
+                if (isCompact) {
+                    res = StringView(begin, mCur - begin);
+                    return true;
+                }
+                return ConvertByRapidjson(begin, res);
+            }
+            default: {
+                bool isPlainInteger = false;
+                if (!SkipNumber(isPlainInteger)) {
+                    return false;
+                }
+                if (isPlainInteger) {
+                    res = StringView(begin, mCur - begin);
+                    return true;
+                }
+                return ConvertByRapidjson(begin, res);
+            }
+        }
+    }
+
+    const char* mCur;
+    const char* mEnd;
+    SourceBuffer& mSourceBuffer;
+};
+
+} // namespace
+
+bool FastJsonParser::ParseObject(StringView json, SourceBuffer& sourceBuffer, vector<Member>& members) {
+    Scanner scanner(json, sourceBuffer);
+    return scanner.ParseObject(members);
+}
+
+string RapidjsonValueToString(const rapidjson::Value& value) {
+    if (value.IsString())
+        return string(value.GetString(), value.GetStringLength());
+    else if (value.IsBool())
+        return ToString(value.GetBool());
+    else if (value.IsInt())
+        return ToString(value.GetInt());
+    else if (value.IsUint())
+        return ToString(value.GetUint());
+    else if (value.IsInt64())
+        return ToString(value.GetInt64());
+    else if (value.IsUint64())
+        return ToString(value.GetUint64());
+    else if (value.IsDouble())
+        return ToString(value.GetDouble());
+    else if (value.IsNull())
+        return "";
+    else // if (value.IsObject() || value.IsArray())
+    {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        value.Accept(writer);
+        return string(buffer.GetString(), buffer.GetLength());
+    }
+}
+
+} // namespace logtail
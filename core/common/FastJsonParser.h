@@ -0,0 +1,47 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "common/memory/SourceBuffer.h"
+#include "models/StringView.h"
+
+namespace logtail {
+
+// FastJsonParser parses the members of a json object in one pass without building a dom. Strings without escapes are
+// referenced in place, and escaped ones are decoded into the source buffer with a single write. Nested objects and
+// arrays are referenced as raw substrings when they are already compact, i.e. the same as written by rapidjson::Writer.
+// The results are exactly the same as converting members of rapidjson::Document by RapidjsonValueToString. Input that
+// cannot be handled this way, including invalid json and json other than an object, is rejected, and should be parsed
+// by rapidjson::Document for the result or the error.
+class FastJsonParser {
+public:
+    using Member = std::pair<StringView, StringView>;
+
+    // members are appended to @members in order, which are valid only if true is returned. Views point to @json or to
+    // buffers allocated from @sourceBuffer.
+    static bool ParseObject(StringView json, SourceBuffer& sourceBuffer, std::vector<Member>& members);
+};
+
+std::string RapidjsonValueToString(const rapidjson::Value& value);
+
+} // namespace logtail
@@ -0,0 +1,226 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "IoUringReader.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define LOGTAIL_IO_URING_SUPPORTED
+#endif
+#endif
+
+#include "logger/Logger.h"
+
+namespace logtail {
+
+IoUringReader::~IoUringReader() {
+    Destroy();
+}
+
+#ifdef LOGTAIL_IO_URING_SUPPORTED
+
+bool IoUringReader::Init(uint32_t depth, size_t bufferSize) {
+    if (IsInited() || depth == 0 || bufferSize == 0) {
+        return false;
+    }
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+    if (fd < 0) {
+        LOG_WARNING(sLogger, ("failed to setup io_uring", strerror(errno))("depth", depth));
+        return false;
+    }
+    mRingFd = fd;
+    mDepth = std::min(depth, params.sq_entries);
+    mBufferSize = bufferSize;
+
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        mSqRingSize = mCqRingSize = std::max(mSqRingSize, mCqRingSize);
+    }
+    mSqRing = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (mSqRing == MAP_FAILED) {
+        mSqRing = nullptr;
+        LOG_WARNING(sLogger, ("failed to map io_uring sq ring", strerror(errno)));
+        Destroy();
+        return false;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        mCqRing = mSqRing;
+    } else {
+        mCqRing
+            = mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (mCqRing == MAP_FAILED) {
+            mCqRing = nullptr;
+            LOG_WARNING(sLogger, ("failed to map io_uring cq ring", strerror(errno)));
+            Destroy();
+            return false;
+        }
+    }
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    mSqes = mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (mSqes == MAP_FAILED) {
+        mSqes = nullptr;
+        LOG_WARNING(sLogger, ("failed to map io_uring sqes", strerror(errno)));
+        Destroy();
+        return false;
+    }
+
+    char* sq = static_cast<char*>(mSqRing);
+    mSqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    mSqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    mSqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(mCqRing);
+    mCqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    mCqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    mCqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    mCqes = cq + params.cq_off.cqes;
+
+    if (posix_memalign(reinterpret_cast<void**>(&mBuffers), 4096, mDepth * mBufferSize) != 0) {
+        mBuffers = nullptr;
+        LOG_WARNING(sLogger, ("failed to allocate io_uring buffers, size", mDepth * mBufferSize));
+        Destroy();
+        return false;
+    }
+    std::vector<iovec> iovs(mDepth);
+    for (uint32_t i = 0; i < mDepth; ++i) {
+        iovs[i].iov_base = mBuffers + i * mBufferSize;
+        iovs[i].iov_len = mBufferSize;
+    }
+    // registering buffers may fail due to RLIMIT_MEMLOCK, plain reads into the same buffers are used then
+    mFixedBuffers = syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, iovs.data(), mDepth) == 0;
+    if (!mFixedBuffers) {
+        LOG_INFO(sLogger, ("failed to register io_uring buffers", strerror(errno))("action", "use plain read"));
+    }
+    LOG_INFO(sLogger,
+             ("io_uring reader inited, depth", mDepth)("buffer size", mBufferSize)("fixed buffers", mFixedBuffers));
+    return true;
+}
+
+bool IoUringReader::Read(std::vector<Request>& requests) {
+    if (!IsInited()) {
+        return false;
+    }
+    unsigned toSubmit = static_cast<unsigned>(std::min<size_t>(requests.size(), mDepth));
+    if (toSubmit == 0) {
+        return true;
+    }
+
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(mSqes);
+    unsigned tail = *mSqTail;
+    for (unsigned i = 0; i < toSubmit; ++i) {
+        auto& req = requests[i];
+        char* buf = mBuffers + i * mBufferSize;
+        req.mData = buf;
+        req.mResult = 0;
+        unsigned idx = tail & *mSqMask;
+        io_uring_sqe* sqe = &sqes[idx];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = mFixedBuffers ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        sqe->fd = req.mFd;
+        sqe->addr = reinterpret_cast<uint64_t>(buf);
+        sqe->len = static_cast<uint32_t>(std::min(req.mSize, mBufferSize));
+        sqe->off = static_cast<uint64_t>(req.mOffset);
+        sqe->buf_index = static_cast<uint16_t>(i);
+        sqe->user_data = i;
+        mSqArray[idx] = idx;
+        ++tail;
+    }
+    __atomic_store_n(mSqTail, tail, __ATOMIC_RELEASE);
+
+    // waits for all completions with as few syscalls as possible, normally only one
+    unsigned pending = toSubmit, completed = 0;
+    io_uring_cqe* cqes = static_cast<io_uring_cqe*>(mCqes);
+    while (true) {
+        unsigned head = *mCqHead;
+        unsigned cqTail = __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE);
+        for (; head != cqTail; ++head, ++completed) {
+            io_uring_cqe* cqe = &cqes[head & *mCqMask];
+            if (cqe->user_data < requests.size()) {
+                requests[cqe->user_data].mResult = cqe->res;
+            }
+        }
+        __atomic_store_n(mCqHead, head, __ATOMIC_RELEASE);
+        if (completed >= toSubmit) {
+            break;
+        }
+        int ret = static_cast<int>(
+            syscall(__NR_io_uring_enter, mRingFd, pending, toSubmit - completed, IORING_ENTER_GETEVENTS, nullptr, 0));
+        ++mSyscallCnt;
+        if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                continue;
+            }
+            LOG_ERROR(sLogger, ("io_uring enter failed", strerror(errno))("action", "fallback to pread"));
+            Destroy();
+            return false;
+        }
+        pending -= std::min(pending, static_cast<unsigned>(ret));
+    }
+    return true;
+}
+
+void IoUringReader::Destroy() {
+    if (mSqes) {
+        munmap(mSqes, mSqesSize);
+        mSqes = nullptr;
+    }
+    if (mCqRing && mCqRing != mSqRing) {
+        munmap(mCqRing, mCqRingSize);
+    }
+    mCqRing = nullptr;
+    if (mSqRing) {
+        munmap(mSqRing, mSqRingSize);
+        mSqRing = nullptr;
+    }
+    if (mRingFd >= 0) {
+        close(mRingFd);
+        mRingFd = -1;
+    }
+    if (mBuffers) {
+        free(mBuffers);
+        mBuffers = nullptr;
+    }
+    mFixedBuffers = false;
+    mDepth = 0;
+}
+
+#else
+
+bool IoUringReader::Init(uint32_t depth, size_t bufferSize) {
+    LOG_INFO(sLogger, ("io_uring is not supported on this platform", "use pread"));
+    return false;
+}
+
+bool IoUringReader::Read(std::vector<Request>& requests) {
+    return false;
+}
+
+void IoUringReader::Destroy() {
+}
+
+#endif
+
+} // namespace logtail
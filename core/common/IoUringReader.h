@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace logtail {
+
+// IoUringReader submits a batch of positional reads with a single io_uring_enter syscall and completes them into
+// pre-registered buffers, one buffer per request slot. It talks to the kernel with raw syscalls, so no liburing is
+// needed. Init fails on platforms or kernels without io_uring (or when it is forbidden, e.g. by seccomp), in which
+// case the caller should stay with pread.
+// Not thread safe, each thread should own its reader.
+class IoUringReader {
+public:
+    struct Request {
+        int mFd = -1;
+        int64_t mOffset = 0;
+        size_t mSize = 0;
+        // bytes read, or -errno on failure
+        int32_t mResult = 0;
+        // points to the registered buffer of the slot, valid until next Read
+        const char* mData = nullptr;
+    };
+
+    IoUringReader() = default;
+    ~IoUringReader();
+    IoUringReader(const IoUringReader&) = delete;
+    IoUringReader& operator=(const IoUringReader&) = delete;
+
+    bool Init(uint32_t depth, size_t bufferSize);
+    bool IsInited() const { return mRingFd >= 0; }
+    uint32_t GetDepth() const { return mDepth; }
+    size_t GetBufferSize() const { return mBufferSize; }
+    uint64_t GetSyscallCount() const { return mSyscallCnt; }
+
+    // at most GetDepth() requests are read in one call, size of each request is truncated to GetBufferSize().
+    // return false if the ring is broken, and results of the requests should be ignored.
+    bool Read(std::vector<Request>& requests);
+
+private:
+    void Destroy();
+
+    int mRingFd = -1;
+    uint32_t mDepth = 0;
+    size_t mBufferSize = 0;
+    bool mFixedBuffers = false;
+    char* mBuffers = nullptr;
+    uint64_t mSyscallCnt = 0;
+
+    void* mSqRing = nullptr;
+    size_t mSqRingSize = 0;
+    void* mCqRing = nullptr;
+    size_t mCqRingSize = 0;
+    void* mSqes = nullptr;
+    size_t mSqesSize = 0;
+
+    unsigned* mSqTail = nullptr;
+    unsigned* mSqMask = nullptr;
+    unsigned* mSqArray = nullptr;
+    unsigned* mCqHead = nullptr;
+    unsigned* mCqTail = nullptr;
+    unsigned* mCqMask = nullptr;
+    void* mCqes = nullptr;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class IoUringReaderUnittest;
+#endif
+};
+
+} // namespace logtail
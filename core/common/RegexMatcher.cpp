@@ -0,0 +1,274 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/RegexMatcher.h"
+
+#include <cctype>
+#include <cstring>
+
+#include "common/StringTools.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+// \s of boost also matches \v, which is not included in \s of RE2
+const char* const kSpaceChars = "\\t\\n\\v\\f\\r ";
+
+// escaped word characters and \<, \>, \`, \' are classes, assertions or special characters in boost
+inline bool IsSpecialEscape(char c) {
+    return isalnum(static_cast<unsigned char>(c)) != 0 || strchr("_<>`'", c) != nullptr;
+}
+
+// whether the pattern has an alternation outside any group, so that no prefix is required
+bool HasTopLevelAlternation(const string& pattern) {
+    size_t depth = 0;
+    bool inClass = false;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '\\') {
+            ++i;
+        } else if (inClass) {
+            if (c == ']') {
+                inClass = false;
+            }
+        } else if (c == '[') {
+            inClass = true;
+            // ] right after [ or [^ is literal
+            if (i + 1 < pattern.size() && pattern[i + 1] == '^') {
+                ++i;
+            }
+            if (i + 1 < pattern.size() && pattern[i + 1] == ']') {
+                ++i;
+            }
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            if (depth > 0) {
+                --depth;
+            }
+        } else if (c == '|' && depth == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+RegexMatcher::RegexMatcher(const string& pattern) : mBoostRegex(pattern) {
+    bool isLiteral = false;
+    ExtractLiteralPrefix(pattern, mLiteralPrefix, isLiteral);
+    if (isLiteral) {
+        mEngine = Engine::LITERAL;
+        return;
+    }
+    string re2Pattern;
+    if (TranslateToRE2(pattern, re2Pattern)) {
+        // boost regexes are byte based and . matches newline by default
+        re2::RE2::Options options;
+        options.set_encoding(re2::RE2::Options::EncodingLatin1);
+        options.set_dot_nl(true);
+        options.set_log_errors(false);
+        mRE2 = make_shared<re2::RE2>(re2Pattern, options);
+        if (mRE2->ok()) {
+            mEngine = Engine::RE2;
+            return;
+        }
+        mRE2.reset();
+    }
+    mEngine = Engine::BOOST;
+}
+
+bool RegexMatcher::Search(StringView text, string& exception) const {
+    if (!HasLiteralPrefix(text)) {
+        return false;
+    }
+    switch (mEngine) {
+        case Engine::LITERAL:
+            return true;
+        case Engine::RE2:
+            return mRE2->Match(
+                re2::StringPiece(text.data(), text.size()), 0, text.size(), re2::RE2::ANCHOR_START, nullptr, 0);
+        default:
+            return BoostRegexSearch(text.data(), text.size(), mBoostRegex, exception);
+    }
+}
+
+bool RegexMatcher::Match(StringView text, string& exception) const {
+    switch (mEngine) {
+        case Engine::LITERAL:
+            return text == StringView(mLiteralPrefix);
+        case Engine::RE2:
+            return HasLiteralPrefix(text)
+                && mRE2->Match(
+                    re2::StringPiece(text.data(), text.size()), 0, text.size(), re2::RE2::ANCHOR_BOTH, nullptr, 0);
+        default:
+            return HasLiteralPrefix(text) && BoostRegexMatch(text.data(), text.size(), mBoostRegex, exception);
+    }
+}
+
+// the prefix is made of the leading characters which must be matched literally. Characters followed by a quantifier
+// and any characters of patterns with top level alternations are excluded.
+void RegexMatcher::ExtractLiteralPrefix(const string& pattern, string& prefix, bool& isLiteral) {
+    prefix.clear();
+    isLiteral = false;
+    if (HasTopLevelAlternation(pattern)) {
+        return;
+    }
+    size_t i = 0;
+    // the leading ^ always matches, since the text is searched from the beginning
+    if (!pattern.empty() && pattern[0] == '^') {
+        i = 1;
+    }
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        char literal = c;
+        size_t next = i + 1;
+        if (c == '\\') {
+            if (i + 1 == pattern.size() || IsSpecialEscape(pattern[i + 1])) {
+                break;
+            }
+            literal = pattern[i + 1];
+            next = i + 2;
+        } else if (strchr(".[]()*+?{}|^$", c) != nullptr) {
+            break;
+        }
+        if (next < pattern.size() && strchr("*+?{", pattern[next]) != nullptr) {
+            break;
+        }
+        prefix += literal;
+        i = next;
+    }
+    isLiteral = i == pattern.size();
+}
+
+// only syntax with the same meaning in boost and RE2 is accepted
+bool RegexMatcher::TranslateToRE2(const string& pattern, string& res) {
+    res.clear();
+    size_t i = 0;
+    if (!pattern.empty() && pattern[0] == '^') {
+        res += '^';
+        i = 1;
+    }
+    bool inClass = false;
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        if (c == '\\') {
+            if (i + 1 == pattern.size()) {
+                return false;
+            }
+            char e = pattern[i + 1];
+            if (e == 's') {
+                res += inClass ? string(kSpaceChars) : string("[") + kSpaceChars + "]";
+            } else if (e == 'S' && !inClass) {
+                res += string("[^") + kSpaceChars + "]";
+            } else if (strchr("dDwWtnrf", e) != nullptr || (e == 'b' && !inClass) || (e == 'B' && !inClass)
+                       || !IsSpecialEscape(e)) {
+                res += c;
+                res += e;
+            } else {
+                return false;
+            }
+            i += 2;
+            continue;
+        }
+        if (inClass) {
+            if (c == ']') {
+                inClass = false;
+            } else if (c == '[') {
+                if (i + 1 < pattern.size() && pattern[i + 1] == ':') {
+                    // posix class, e.g. [:alpha:]
+                    size_t end = pattern.find(":]", i + 2);
+                    if (end == string::npos) {
+                        return false;
+                    }
+                    res.append(pattern, i, end + 2 - i);
+                    i = end + 2;
+                    continue;
+                }
+                if (i + 1 < pattern.size() && (pattern[i + 1] == '.' || pattern[i + 1] == '=')) {
+                    // collating elements and equivalence classes
+                    return false;
+                }
+                res += "\\[";
+                ++i;
+                continue;
+            }
+            res += c;
+            ++i;
+            continue;
+        }
+        switch (c) {
+            case '[':
+                inClass = true;
+                res += c;
+                ++i;
+                if (i < pattern.size() && pattern[i] == '^') {
+                    res += '^';
+                    ++i;
+                }
+                if (i < pattern.size() && pattern[i] == ']') {
+                    return false;
+                }
+                continue;
+            case '(':
+                if (i + 1 < pattern.size() && pattern[i + 1] == '?') {
+                    // only non-capturing groups, no lookarounds, inline modifiers or named groups
+                    if (i + 2 < pattern.size() && pattern[i + 2] == ':') {
+                        res += "(?:";
+                        i += 3;
+                        continue;
+                    }
+                    return false;
+                }
+                break;
+            case '{': {
+                // only {n}, {n,} and {n,m}
+                size_t j = i + 1;
+                while (j < pattern.size() && isdigit(static_cast<unsigned char>(pattern[j]))) {
+                    ++j;
+                }
+                if (j == i + 1) {
+                    return false;
+                }
+                if (j < pattern.size() && pattern[j] == ',') {
+                    ++j;
+                    while (j < pattern.size() && isdigit(static_cast<unsigned char>(pattern[j]))) {
+                        ++j;
+                    }
+                }
+                if (j == pattern.size() || pattern[j] != '}') {
+                    return false;
+                }
+                res.append(pattern, i, j + 1 - i);
+                i = j + 1;
+                continue;
+            }
+            case '^':
+            case '$':
+                // ^ and $ of boost also match at line breaks
+                return false;
+            default:
+                break;
+        }
+        res += c;
+        ++i;
+    }
+    return !inClass;
+}
+
+} // namespace logtail
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <boost/regex.hpp>
+#include <re2/re2.h>
+
+#include "models/StringView.h"
+
+namespace logtail {
+
+// RegexMatcher is a compiled boost regex which is run by a cheaper engine when the results are known to be the same:
+// - patterns without special characters are compared literally;
+// - patterns whose syntax has the same meaning in RE2, which excludes backreferences, lookarounds, inline modifiers,
+//   anchors other than the leading ^ and so on, are run by the RE2 DFA, which is linear to the length of the text;
+// - other patterns are run by boost.
+// Besides, the literal prefix of the pattern is compared first, so that most unmatched lines are rejected without
+// running any engine.
+class RegexMatcher {
+public:
+    enum class Engine { LITERAL, RE2, BOOST };
+
+    // throws boost::regex_error if the pattern is invalid, the same as boost::regex
+    explicit RegexMatcher(const std::string& pattern);
+
+    // whether the regex matches a prefix of @text, the same as BoostRegexSearch
+    bool Search(StringView text, std::string& exception) const;
+    // whether the regex matches the whole @text, the same as BoostRegexMatch
+    bool Match(StringView text, std::string& exception) const;
+
+    const boost::regex& GetBoostRegex() const { return mBoostRegex; }
+    Engine GetEngine() const { return mEngine; }
+
+private:
+    static bool TranslateToRE2(const std::string& pattern, std::string& res);
+    static void ExtractLiteralPrefix(const std::string& pattern, std::string& prefix, bool& isLiteral);
+
+    bool HasLiteralPrefix(StringView text) const { return text.starts_with(StringView(mLiteralPrefix)); }
+
+    boost::regex mBoostRegex;
+    std::shared_ptr<re2::RE2> mRE2;
+    std::string mLiteralPrefix;
+    Engine mEngine = Engine::BOOST;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RegexMatcherUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,352 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/TimestampParser.h"
+
+#include <cctype>
+#include <climits>
+
+namespace logtail {
+
+namespace {
+
+inline bool IsDigit(unsigned char c) {
+    return c >= '0' && c <= '9';
+}
+
+// the same as conv_num in Strptime.cpp, i.e. digits are read as long as the result does not exceed @ulim
+inline const unsigned char* ParseNumber(const unsigned char* buf, int& dest, unsigned int llim, unsigned int ulim) {
+    unsigned char ch = *buf;
+    if (!IsDigit(ch)) {
+        return nullptr;
+    }
+    unsigned int result = 0;
+    unsigned int rulim = ulim;
+    do {
+        result = result * 10 + (ch - '0');
+        rulim /= 10;
+        ch = *++buf;
+    } while ((result * 10 <= ulim) && rulim && IsDigit(ch));
+    if (result < llim || result > ulim) {
+        return nullptr;
+    }
+    dest = result;
+    return buf;
+}
+
+// mktime is linear to minutes and seconds within a local hour, since utc offsets are changed at whole hours. So mktime
+// is only called for the first time string of each hour in each thread.
+time_t MakeLocalTime(int year, int month, int day, int hour, int minute, int second) {
+    struct HourCache {
+        int year = INT_MIN;
+        int month = 0;
+        int day = 0;
+        int hour = 0;
+        time_t base = 0;
+    };
+    static thread_local HourCache sCache;
+    if (sCache.year != year || sCache.month != month || sCache.day != day || sCache.hour != hour) {
+        struct tm tm = {0};
+        tm.tm_year = year;
+        tm.tm_mon = month;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        time_t base = mktime(&tm);
+        if (base == -1) {
+            tm = {0};
+            tm.tm_year = year;
+            tm.tm_mon = month;
+            tm.tm_mday = day;
+            tm.tm_hour = hour;
+            tm.tm_min = minute;
+            tm.tm_sec = second;
+            return mktime(&tm);
+        }
+        sCache.year = year;
+        sCache.month = month;
+        sCache.day = day;
+        sCache.hour = hour;
+        sCache.base = base;
+    }
+    return sCache.base + minute * 60 + second;
+}
+
+} // namespace
+
+const TimestampCache::Entry* TimestampCache::Find(StringView timeStr) const {
+    // the latest entries are checked first
+    for (size_t i = 1; i <= mSize; ++i) {
+        const Entry& entry = mEntries[(mNext + kCapacity - i) % kCapacity];
+        if (timeStr.starts_with(entry.key)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void TimestampCache::Add(StringView key, time_t second) {
+    if (key.empty()) {
+        return;
+    }
+    mEntries[mNext].key = key;
+    mEntries[mNext].second = second;
+    mNext = (mNext + 1) % kCapacity;
+    if (mSize < kCapacity) {
+        ++mSize;
+    }
+}
+
+TimestampParser::TimestampParser(const std::string& format, int32_t specifiedYear)
+    : mFormat(format), mSpecifiedYear(specifiedYear) {
+    if (mFormat == "%s") {
+        mKind = Kind::UNIX_SECONDS;
+    } else if (Compile()) {
+        mKind = Kind::COMPILED;
+    } else {
+        mSteps.clear();
+        mKind = Kind::STRPTIME;
+    }
+    // the second prefix can only be cached when there is no %f or %f is at the end
+    size_t pos = mFormat.find("%f");
+    mEndWithNanosecond = pos != std::string::npos && pos + 2 == mFormat.size();
+    mCacheable = mKind != Kind::UNIX_SECONDS && (pos == std::string::npos || mEndWithNanosecond);
+}
+
+const char* TimestampParser::Parse(const char* buf, LogtailTime& ts, int& nanosecondLength) const {
+    switch (mKind) {
+        case Kind::UNIX_SECONDS:
+            return ParseUnixSeconds(buf, ts, nanosecondLength);
+        case Kind::COMPILED:
+            return ParseCompiled(buf, ts, nanosecondLength);
+        default:
+            return Strptime(buf, mFormat.c_str(), &ts, nanosecondLength, mSpecifiedYear);
+    }
+}
+
+bool TimestampParser::Parse(StringView timeStr, LogtailTime& ts, TimestampCache& cache) const {
+    if (mCacheable) {
+        const TimestampCache::Entry* entry = cache.Find(timeStr);
+        if (entry != nullptr) {
+            if (!mEndWithNanosecond) {
+                if (entry->key.size() == timeStr.size()) {
+                    ts.tv_sec = entry->second;
+                    ts.tv_nsec = 0;
+                    return true;
+                }
+            } else if (entry->key.size() < timeStr.size()) {
+                int nanosecondLength = -1;
+                if (ParseNanosecond(timeStr.data() + entry->key.size(), ts.tv_nsec, nanosecondLength) != nullptr) {
+                    ts.tv_sec = entry->second;
+                    return true;
+                }
+            }
+        }
+    }
+    int nanosecondLength = -1;
+    const char* end = Parse(timeStr.data(), ts, nanosecondLength);
+    if (end == nullptr) {
+        return false;
+    }
+    if (mCacheable) {
+        if (!mEndWithNanosecond) {
+            cache.Add(timeStr, ts.tv_sec);
+        } else if (nanosecondLength > 0) {
+            cache.Add(StringView(timeStr.data(), end - nanosecondLength - timeStr.data()), ts.tv_sec);
+        }
+    }
+    return true;
+}
+
+// the same as conv_nanosecond in Strptime.cpp
+const char* TimestampParser::ParseNanosecond(const char* buf, long& nanosecond, int& nanosecondLength) {
+    nanosecond = 0;
+    const unsigned char* bp = reinterpret_cast<const unsigned char*>(buf);
+    if (!IsDigit(*bp)) {
+        return nullptr;
+    }
+    unsigned int result = 0;
+    int digitNum = 0;
+    do {
+        result = result * 10 + (*bp - '0');
+        ++digitNum;
+        ++bp;
+    } while (IsDigit(*bp));
+    for (int i = digitNum; i < 9; ++i) {
+        result *= 10;
+    }
+    nanosecond = result;
+    nanosecondLength = digitNum;
+    return reinterpret_cast<const char*>(bp);
+}
+
+bool TimestampParser::Compile() {
+    bool hasYear = false;
+    bool hasNanosecond = false;
+    for (size_t i = 0; i < mFormat.size(); ++i) {
+        unsigned char c = mFormat[i];
+        if (isspace(c)) {
+            mSteps.push_back({StepType::SPACE, 0});
+            continue;
+        }
+        if (c != '%') {
+            mSteps.push_back({StepType::LITERAL, static_cast<char>(c)});
+            continue;
+        }
+        if (++i == mFormat.size()) {
+            return false;
+        }
+        switch (mFormat[i]) {
+            case 'Y':
+                mSteps.push_back({StepType::YEAR, 0});
+                hasYear = true;
+                break;
+            case 'm':
+                mSteps.push_back({StepType::MONTH, 0});
+                break;
+            case 'd':
+            case 'e':
+                mSteps.push_back({StepType::DAY, 0});
+                break;
+            case 'H':
+                mSteps.push_back({StepType::HOUR, 0});
+                break;
+            case 'M':
+                mSteps.push_back({StepType::MINUTE, 0});
+                break;
+            case 'S':
+                mSteps.push_back({StepType::SECOND, 0});
+                break;
+            case 'f':
+                mSteps.push_back({StepType::NANOSECOND, 0});
+                hasNanosecond = true;
+                break;
+            case 'n':
+            case 't':
+                mSteps.push_back({StepType::SPACE, 0});
+                break;
+            case '%':
+                mSteps.push_back({StepType::LITERAL, '%'});
+                break;
+            // Strptime parses %F and %T recursively, which resets the nanoseconds parsed before
+            case 'F':
+                if (hasNanosecond) {
+                    return false;
+                }
+                mSteps.insert(mSteps.end(),
+                              {{StepType::YEAR, 0},
+                               {StepType::LITERAL, '-'},
+                               {StepType::MONTH, 0},
+                               {StepType::LITERAL, '-'},
+                               {StepType::DAY, 0}});
+                hasYear = true;
+                break;
+            case 'T':
+                if (hasNanosecond) {
+                    return false;
+                }
+                mSteps.insert(mSteps.end(),
+                              {{StepType::HOUR, 0},
+                               {StepType::LITERAL, ':'},
+                               {StepType::MINUTE, 0},
+                               {StepType::LITERAL, ':'},
+                               {StepType::SECOND, 0}});
+                break;
+            default:
+                return false;
+        }
+    }
+    // the year is deduced from the current date by Strptime if not specified
+    return hasYear || mSpecifiedYear > 0;
+}
+
+const char* TimestampParser::ParseUnixSeconds(const char* buf, LogtailTime& ts, int& nanosecondLength) const {
+    // leading zeros, signs, spaces and values which may overflow are left to Strptime
+    size_t digitCnt = 0;
+    while (IsDigit(buf[digitCnt])) {
+        ++digitCnt;
+    }
+    if (digitCnt == 0 || buf[0] == '0' || digitCnt > 18) {
+        return Strptime(buf, mFormat.c_str(), &ts, nanosecondLength, mSpecifiedYear);
+    }
+    // at most 10 digits are seconds, and the rest are nanoseconds
+    size_t secondLength = digitCnt < 10 ? digitCnt : 10;
+    time_t second = 0;
+    for (size_t i = 0; i < secondLength; ++i) {
+        second = second * 10 + (buf[i] - '0');
+    }
+    ts.tv_sec = second;
+    ts.tv_nsec = 0;
+    nanosecondLength = 0;
+    if (digitCnt > secondLength) {
+        ParseNanosecond(buf + secondLength, ts.tv_nsec, nanosecondLength);
+    }
+    return buf + digitCnt;
+}
+
+const char* TimestampParser::ParseCompiled(const char* buf, LogtailTime& ts, int& nanosecondLength) const {
+    const unsigned char* bp = reinterpret_cast<const unsigned char*>(buf);
+    int year = mSpecifiedYear - 1900;
+    int month = 0;
+    int day = 0;
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    int value = 0;
+    ts.tv_nsec = 0;
+    for (const auto& step : mSteps) {
+        switch (step.type) {
+            case StepType::LITERAL:
+                if (*bp++ != static_cast<unsigned char>(step.literal)) {
+                    return nullptr;
+                }
+                break;
+            case StepType::SPACE:
+                while (isspace(*bp)) {
+                    ++bp;
+                }
+                break;
+            case StepType::YEAR:
+                bp = ParseNumber(bp, value, 0, 9999);
+                year = value - 1900;
+                break;
+            case StepType::MONTH:
+                bp = ParseNumber(bp, value, 1, 12);
+                month = value - 1;
+                break;
+            case StepType::DAY:
+                bp = ParseNumber(bp, day, 1, 31);
+                break;
+            case StepType::HOUR:
+                bp = ParseNumber(bp, hour, 0, 23);
+                break;
+            case StepType::MINUTE:
+                bp = ParseNumber(bp, minute, 0, 59);
+                break;
+            case StepType::SECOND:
+                bp = ParseNumber(bp, second, 0, 61);
+                break;
+            case StepType::NANOSECOND:
+                bp = reinterpret_cast<const unsigned char*>(
+                    ParseNanosecond(reinterpret_cast<const char*>(bp), ts.tv_nsec, nanosecondLength));
+                break;
+        }
+        if (bp == nullptr) {
+            return nullptr;
+        }
+    }
+    ts.tv_sec = MakeLocalTime(year, month, day, hour, minute, second);
+    return reinterpret_cast<const char*>(bp);
+}
+
+} // namespace logtail
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "models/StringView.h"
+
+namespace logtail {
+
+// TimestampCache remembers the seconds of recently parsed time strings. Each entry is keyed by the second prefix of a
+// time string, i.e. the part before the nanoseconds, so that interleaved time strings from merged streams are parsed
+// only once per second. Keys are not copied, so the cache must not outlive the time strings, e.g. it is used within
+// one event group.
+class TimestampCache {
+public:
+    struct Entry {
+        StringView key;
+        time_t second = 0;
+    };
+
+    static const size_t kCapacity = 8;
+
+    // the entry whose key is a prefix of @timeStr, or nullptr if not found
+    const Entry* Find(StringView timeStr) const;
+    // the oldest entry is replaced if the cache is full
+    void Add(StringView key, time_t second);
+    size_t Size() const { return mSize; }
+
+private:
+    Entry mEntries[kCapacity];
+    size_t mSize = 0;
+    size_t mNext = 0;
+};
+
+// TimestampParser is a time format compiled for Strptime. Formats made of %Y, %m, %d, %e, %H, %M, %S, %f, %F, %T,
+// literals and spaces are parsed by hand-written steps, and %s by a dedicated parser, which avoid interpreting the
+// format for each time string. Besides, mktime, which dominates parsing, is only called once per local hour. Other
+// formats, and formats without a year unless a positive year is specified, are left to Strptime.
+class TimestampParser {
+public:
+    enum class Kind { UNIX_SECONDS, COMPILED, STRPTIME };
+
+    explicit TimestampParser(const std::string& format, int32_t specifiedYear = -1);
+
+    // the same as Strptime(buf, format, &ts, nanosecondLength, specifiedYear)
+    const char* Parse(const char* buf, LogtailTime& ts, int& nanosecondLength) const;
+    // the same as above, except that results of the time strings with the same second prefix are taken from @cache,
+    // which only works when there is no %f in the format or %f is at the end.
+    bool Parse(StringView timeStr, LogtailTime& ts, TimestampCache& cache) const;
+
+    Kind GetKind() const { return mKind; }
+    const std::string& GetFormat() const { return mFormat; }
+
+    // the same as Strptime(buf, "%f", &ts, nanosecondLength)
+    static const char* ParseNanosecond(const char* buf, long& nanosecond, int& nanosecondLength);
+
+private:
+    enum class StepType { LITERAL, SPACE, YEAR, MONTH, DAY, HOUR, MINUTE, SECOND, NANOSECOND };
+
+    struct Step {
+        StepType type;
+        char literal;
+    };
+
+    bool Compile();
+    const char* ParseUnixSeconds(const char* buf, LogtailTime& ts, int& nanosecondLength) const;
+    const char* ParseCompiled(const char* buf, LogtailTime& ts, int& nanosecondLength) const;
+
+    std::string mFormat;
+    int32_t mSpecifiedYear = -1;
+    Kind mKind = Kind::STRPTIME;
+    std::vector<Step> mSteps;
+    bool mCacheable = false;
+    bool mEndWithNanosecond = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class TimestampParserUnittest;
+#endif
+};
+
+} // namespace logtail
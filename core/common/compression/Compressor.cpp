@@ -15,6 +15,9 @@
 #include "common/compression/Compressor.h"
 
 #include <chrono>
+#if defined(__linux__)
+#include <time.h>
+#endif
 
 #include "monitor/metric_constants/MetricConstants.h"
 
@@ -22,6 +25,21 @@ using namespace std;
 
 namespace logtail {
 
+namespace {
+
+// compression runs on the calling thread, so its cpu time is the thread cpu time spent in Compress
+chrono::nanoseconds GetThreadCpuTime() {
+#if defined(__linux__)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return chrono::seconds(ts.tv_sec) + chrono::nanoseconds(ts.tv_nsec);
+    }
+#endif
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch());
+}
+
+} // namespace
+
 void Compressor::SetMetricRecordRef(MetricLabels&& labels, DynamicMetricLabels&& dynamicLabels) {
     WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
         mMetricsRecordRef, MetricCategory::METRIC_CATEGORY_COMPONENT, std::move(labels), std::move(dynamicLabels));
@@ -32,6 +50,9 @@ void Compressor::SetMetricRecordRef(MetricLabels&& labels, DynamicMetricLabels&&
     mTotalProcessMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS);
     mDiscardedItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL);
     mDiscardedItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_SIZE_BYTES);
+    mTotalCpuTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_COMPRESSOR_TOTAL_CPU_TIME_MS);
+    mCompressionRatio = mMetricsRecordRef.CreateDoubleGauge(METRIC_COMPONENT_COMPRESSOR_COMPRESSION_RATIO);
+    mCpuTimePerMBMs = mMetricsRecordRef.CreateDoubleGauge(METRIC_COMPONENT_COMPRESSOR_CPU_TIME_PER_MB_MS);
 }
 
 bool Compressor::DoCompress(const string& input, string& output, string& errorMsg) {
@@ -41,13 +62,23 @@ bool Compressor::DoCompress(const string& input, string& output, string& errorMs
     }
 
     auto before = chrono::system_clock::now();
+    auto cpuBefore = GetThreadCpuTime();
     auto res = Compress(input, output, errorMsg);
 
     if (mMetricsRecordRef != nullptr) {
         mTotalProcessMs->Add(chrono::system_clock::now() - before);
+        mTotalCpuTimeMs->Add(GetThreadCpuTime() - cpuBefore);
         if (res) {
             mOutItemsTotal->Add(1);
             mOutItemSizeBytes->Add(output.size());
+            uint64_t inSize = mInItemSizeBytes->GetValue() - mDiscardedItemSizeBytes->GetValue();
+            uint64_t outSize = mOutItemSizeBytes->GetValue();
+            if (outSize > 0) {
+                mCompressionRatio->Set(static_cast<double>(inSize) / outSize);
+            }
+            if (inSize > 0) {
+                mCpuTimePerMBMs->Set(static_cast<double>(mTotalCpuTimeMs->GetValue()) * 1024 * 1024 / inSize);
+            }
         } else {
             mDiscardedItemsTotal->Add(1);
             mDiscardedItemSizeBytes->Add(input.size());
@@ -47,6 +47,10 @@ protected:
     CounterPtr mDiscardedItemsTotal;
     CounterPtr mDiscardedItemSizeBytes;
     TimeCounterPtr mTotalProcessMs;
+    TimeCounterPtr mTotalCpuTimeMs;
+    // accumulated input size / output size of succeeded items
+    DoubleGaugePtr mCompressionRatio;
+    DoubleGaugePtr mCpuTimePerMBMs;
 
 private:
     virtual bool Compress(const std::string& input, std::string& output, std::string& errorMsg) = 0;
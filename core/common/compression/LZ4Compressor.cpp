@@ -16,12 +16,25 @@
 
 #include <lz4/lz4.h>
 
+#include <memory>
+
 #include "common/StringTools.h"
 
 using namespace std;
 
 namespace logtail {
 
+namespace {
+
+// the state is initialized by LZ4_compress_fast_extState on each call, so one buffer per thread is enough for all
+// compressors, and the allocation on the stack in LZ4_compress_default is avoided
+char* GetThreadState() {
+    thread_local unique_ptr<char[]> sState(new char[LZ4_sizeofState()]);
+    return sState.get();
+}
+
+} // namespace
+
 bool LZ4Compressor::Compress(const string& input, string& output, string& errorMsg) {
     int encodingSize = LZ4_compressBound(input.size());
     if (encodingSize <= 0) {
@@ -30,8 +43,8 @@ bool LZ4Compressor::Compress(const string& input, string& output, string& errorM
     }
     output.resize(static_cast<size_t>(encodingSize));
     try {
-        encodingSize = static_cast<size_t>(
-            LZ4_compress_default(input.c_str(), const_cast<char*>(output.c_str()), input.size(), encodingSize));
+        encodingSize = static_cast<size_t>(LZ4_compress_fast_extState(
+            GetThreadState(), input.c_str(), const_cast<char*>(output.c_str()), input.size(), encodingSize, 1));
         if (encodingSize <= 0) {
             errorMsg = "error code: " + ToString(encodingSize);
             return false;
@@ -16,16 +16,38 @@
 
 #include <zstd/zstd.h>
 
+#include <memory>
+
 using namespace std;
 
 namespace logtail {
 
+namespace {
+
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const { ZSTD_freeCCtx(ctx); }
+};
+
+// compressors are shared by all threads sending data of the pipeline, so each thread keeps its own context, which
+// is reused by all compressors to avoid allocating the internal tables for every batch
+ZSTD_CCtx* GetThreadCCtx() {
+    thread_local unique_ptr<ZSTD_CCtx, CCtxDeleter> sCCtx(ZSTD_createCCtx());
+    return sCCtx.get();
+}
+
+} // namespace
+
 bool ZstdCompressor::Compress(const string& input, string& output, string& errorMsg) {
+    ZSTD_CCtx* ctx = GetThreadCCtx();
+    if (ctx == nullptr) {
+        errorMsg = "failed to create zstd context";
+        return false;
+    }
     size_t encodingSize = ZSTD_compressBound(input.size());
     output.resize(encodingSize);
     try {
-        encodingSize = ZSTD_compress(
-            const_cast<char*>(output.c_str()), encodingSize, input.c_str(), input.size(), mCompressionLevel);
+        encodingSize = ZSTD_compressCCtx(
+            ctx, const_cast<char*>(output.c_str()), encodingSize, input.c_str(), input.size(), mCompressionLevel);
         if (ZSTD_isError(encodingSize)) {
             errorMsg = ZSTD_getErrorName(encodingSize);
             return false;
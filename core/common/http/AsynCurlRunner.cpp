@@ -26,6 +26,12 @@ using namespace std;
 namespace logtail {
 
 bool AsynCurlRunner::Init() {
+    lock_guard<mutex> lock(mInitMux);
+    if (mThreadRes.valid() && mThreadRes.wait_for(chrono::seconds(0)) != future_status::ready) {
+        ++mUserCnt;
+        mIsFlush = false;
+        return true;
+    }
     mClient = curl_multi_init();
     mIsFlush = false;
     if (mClient == nullptr) {
@@ -33,11 +39,23 @@ bool AsynCurlRunner::Init() {
         return false;
     }
     mThreadRes = async(launch::async, &AsynCurlRunner::Run, this);
+    ++mUserCnt;
     return true;
 }
 
 void AsynCurlRunner::Stop() {
+    lock_guard<mutex> lock(mInitMux);
+    if (mUserCnt == 0) {
+        return;
+    }
+    if (--mUserCnt > 0) {
+        LOG_INFO(sLogger, ("async curl runner", "still used by other modules")("user count", mUserCnt));
+        return;
+    }
     mIsFlush = true;
+    if (!mThreadRes.valid()) {
+        return;
+    }
     future_status s = mThreadRes.wait_for(chrono::seconds(1));
     if (s == future_status::ready) {
         LOG_INFO(sLogger, ("async curl runner", "stopped successfully"));
@@ -83,7 +101,7 @@ bool AsynCurlRunner::AddRequestToClient(unique_ptr<AsynHttpRequest>&& request) {
                                    request->mUrl,
                                    request->mQueryString,
                                    request->mHeader,
-                                   request->mBody,
+                                   request->GetBody(),
                                    request->mResponse,
                                    headers,
                                    request->mTimeout,
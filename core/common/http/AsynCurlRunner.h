@@ -39,6 +39,8 @@ public:
         return &instance;
     }
 
+    // the runner is shared by several modules, each of which calls Init once on start and Stop once on exit, and the
+    // runner is only stopped when the last user stops it
     bool Init();
     void Stop();
     bool AddRequest(std::unique_ptr<AsynHttpRequest>&& request);
@@ -55,6 +57,8 @@ private:
     CURLM* mClient = nullptr;
     SafeQueue<std::unique_ptr<AsynHttpRequest>> mQueue;
 
+    std::mutex mInitMux;
+    size_t mUserCnt = 0;
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
 
@@ -71,10 +71,11 @@ CURL* CreateCurlHandler(const std::string& method,
                         bool replaceHostWithIp,
                         const std::string& intf,
                         bool followRedirects,
-                        std::optional<CurlTLS> tls) {
+                        std::optional<CurlTLS> tls,
+                        CURL* reusedCurl) {
     static DnsCache* dnsCache = DnsCache::GetInstance();
 
-    CURL* curl = curl_easy_init();
+    CURL* curl = reusedCurl != nullptr ? reusedCurl : curl_easy_init();
     if (curl == nullptr) {
         return nullptr;
     }
@@ -153,7 +154,7 @@ bool SendHttpRequest(std::unique_ptr<HttpRequest>&& request, HttpResponse& respo
                                    request->mUrl,
                                    request->mQueryString,
                                    request->mHeader,
-                                   request->mBody,
+                                   request->GetBody(),
                                    response,
                                    headers,
                                    request->mTimeout,
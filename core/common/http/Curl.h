@@ -28,6 +28,8 @@
 
 namespace logtail {
 
+// if reusedCurl is given, it is configured and returned instead of a new handler, and it should have been reset by
+// curl_easy_reset
 CURL* CreateCurlHandler(const std::string& method,
                         bool httpsFlag,
                         const std::string& host,
@@ -42,7 +44,8 @@ CURL* CreateCurlHandler(const std::string& method,
                         bool replaceHostWithIp = true,
                         const std::string& intf = "",
                         bool followRedirects = false,
-                        std::optional<CurlTLS> tls = std::nullopt);
+                        std::optional<CurlTLS> tls = std::nullopt,
+                        CURL* reusedCurl = nullptr);
 
 bool SendHttpRequest(std::unique_ptr<HttpRequest>&& request, HttpResponse& response);
 
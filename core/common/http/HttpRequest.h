@@ -47,6 +47,9 @@ struct HttpRequest {
 
     std::map<std::string, std::string> mHeader;
     std::string mBody;
+    // if not null, the body is borrowed from the owner of the request instead of being copied into mBody, and the
+    // owner must outlive the request
+    const std::string* mBodyRef = nullptr;
     std::string mHost;
     int32_t mPort;
     uint32_t mTimeout = static_cast<uint32_t>(INT32_FLAG(default_http_request_timeout_secs));
@@ -82,6 +85,8 @@ struct HttpRequest {
           mFollowRedirects(followRedirects),
           mTls(std::move(tls)) {}
     virtual ~HttpRequest() = default;
+
+    const std::string& GetBody() const { return mBodyRef != nullptr ? *mBodyRef : mBody; }
 };
 
 struct AsynHttpRequest : public HttpRequest {
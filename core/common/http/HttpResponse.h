@@ -69,7 +69,8 @@ class HttpResponse {
                                    bool replaceHostWithIp,
                                    const std::string& intf,
                                    bool followRedirects,
-                                   std::optional<CurlTLS> tls);
+                                   std::optional<CurlTLS> tls,
+                                   void* reusedCurl);
 
 public:
     HttpResponse()
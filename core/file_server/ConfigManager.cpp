@@ -241,12 +241,27 @@ void ConfigManager::RemoveHandler(const string& dir, bool delete_flag) {
 
 // this functions should only be called when register base dir
 bool ConfigManager::RegisterHandlers() {
+    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
+    return RegisterHandlers(nameConfigMap);
+}
+
+bool ConfigManager::RegisterHandlers(const unordered_set<string>& configNames) {
+    unordered_map<string, FileDiscoveryConfig> nameConfigMap;
+    for (const auto& name : configNames) {
+        auto config = FileServer::GetInstance()->GetFileDiscoveryConfig(name);
+        if (config.first != nullptr) {
+            nameConfigMap[name] = config;
+        }
+    }
+    return RegisterHandlers(nameConfigMap);
+}
+
+bool ConfigManager::RegisterHandlers(const unordered_map<string, FileDiscoveryConfig>& nameConfigMap) {
     if (mSharedHandler == NULL) {
         mSharedHandler = new NormalEventHandler();
     }
     vector<FileDiscoveryConfig> sortedConfigs;
     vector<FileDiscoveryConfig> wildcardConfigs;
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
     for (auto itr = nameConfigMap.begin(); itr != nameConfigMap.end(); ++itr) {
         if (itr->second.first->GetWildcardPaths().empty())
             sortedConfigs.push_back(itr->second);
@@ -609,16 +624,17 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             }
         }
     }
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    FileServer::GetInstance()->GetFileDiscoveryIndex().FindCandidates(path, candidates);
+    auto itr = candidates.begin();
     FileDiscoveryConfig prevMatch(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
+    for (; itr != candidates.end(); ++itr) {
+        const FileDiscoveryOptions* config = itr->first;
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -630,21 +646,21 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             if (!name.empty() && !config->mAllowingIncludedByMultiConfigs) {
                 nameRepeat++;
                 logNameList.append("logstore:");
-                logNameList.append(itr->second.second->GetLogstoreName());
+                logNameList.append(itr->second->GetLogstoreName());
                 logNameList.append(",config:");
-                logNameList.append(itr->second.second->GetConfigName());
+                logNameList.append(itr->second->GetConfigName());
                 logNameList.append(" ");
-                multiConfigs.push_back(itr->second);
+                multiConfigs.push_back(*itr);
             }
 
             // note: best config is the one which length is longest and create time is nearest
             curLen = config->GetBasePath().size();
             if (prevLen < curLen) {
-                prevMatch = itr->second;
+                prevMatch = *itr;
                 prevLen = curLen;
             } else if (prevLen == curLen && prevMatch.first) {
-                if (prevMatch.second->GetCreateTime() > itr->second.second->GetCreateTime()) {
-                    prevMatch = itr->second;
+                if (prevMatch.second->GetCreateTime() > itr->second->GetCreateTime()) {
+                    prevMatch = *itr;
                     prevLen = curLen;
                 }
             }
@@ -698,10 +714,11 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
         }
     }
     bool alarmFlag = false;
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
+    vector<FileDiscoveryConfig> candidates;
+    FileServer::GetInstance()->GetFileDiscoveryIndex().FindCandidates(path, candidates);
+    auto itr = candidates.begin();
+    for (; itr != candidates.end(); ++itr) {
+        const FileDiscoveryOptions* config = itr->first;
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -709,7 +726,7 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
 
         bool match = config->IsMatch(path, name);
         if (match) {
-            allConfig.push_back(itr->second);
+            allConfig.push_back(*itr);
         }
     }
 
@@ -746,16 +763,17 @@ int32_t ConfigManager::FindMatchWithForceFlag(std::vector<FileDiscoveryConfig>&
             }
         }
     }
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    FileServer::GetInstance()->GetFileDiscoveryIndex().FindCandidates(path, candidates);
+    auto itr = candidates.begin();
     FileDiscoveryConfig prevMatch = make_pair(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        FileDiscoveryConfig config = itr->second;
+    for (; itr != candidates.end(); ++itr) {
+        FileDiscoveryConfig config = *itr;
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -867,10 +885,11 @@ void ConfigManager::DeleteHandlers() {
 // 1. No wildcard path: the base path of Config is the prefix of @path and within depth.
 // 2. Wildcard path: @path matches and within depth.
 void ConfigManager::GetRelatedConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs) {
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    for (auto iter = nameConfigMap.begin(); iter != nameConfigMap.end(); ++iter) {
-        if (iter->second.first->IsMatch(path, "")) {
-            configs.push_back(iter->second);
+    vector<FileDiscoveryConfig> candidates;
+    FileServer::GetInstance()->GetFileDiscoveryIndex().FindCandidates(path, candidates);
+    for (const auto& candidate : candidates) {
+        if (candidate.first->IsMatch(path, "")) {
+            configs.push_back(candidate);
         }
     }
 }
@@ -1004,17 +1023,11 @@ void ConfigManager::GetContainerStoppedEvents(std::vector<Event*>& eventVec) {
             LOG_ERROR(sLogger, ("invalid container info update param", errorMsg)("action", "ignore current cmd"));
             continue;
         }
-        std::vector<ContainerInfo>::iterator iter = config.first->GetContainerInfo()->begin();
-        std::vector<ContainerInfo>::iterator iend = config.first->GetContainerInfo()->end();
-        for (; iter != iend; ++iter) {
-            if (iter->mID == containerInfo.mID) {
-                break;
-            }
-        }
-        if (iter == iend) {
+        const ContainerInfo* info = config.first->GetContainerInfoByID(containerInfo.mID);
+        if (info == NULL) {
             continue;
         }
-        Event* pStoppedEvent = new Event(iter->mRealBaseDir, "", EVENT_ISDIR | EVENT_CONTAINER_STOPPED, -1, 0);
+        Event* pStoppedEvent = new Event(info->mRealBaseDir, "", EVENT_ISDIR | EVENT_CONTAINER_STOPPED, -1, 0);
         LOG_DEBUG(
             sLogger,
             ("GetContainerStoppedEvent Type", pStoppedEvent->GetType())("Source", pStoppedEvent->GetSource())(
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -259,6 +260,8 @@ public:
     void RegisterWildcardPath(const FileDiscoveryConfig& config, const std::string& path, int32_t depth);
     bool RegisterHandlers(const std::string& basePath, const FileDiscoveryConfig& config);
     bool RegisterHandlers();
+    // only register handlers of the given configs, for incremental config update
+    bool RegisterHandlers(const std::unordered_set<std::string>& configNames);
     bool RegisterHandlersRecursively(const std::string& dir, const FileDiscoveryConfig& config, bool checkTimeout);
     // 废弃，蚂蚁
     // /**
@@ -515,6 +518,7 @@ private:
                                      int preservedDirDepth,
                                      int maxDepth);
     bool RegisterDescendants(const std::string& path, const FileDiscoveryConfig& config, int withinDepth);
+    bool RegisterHandlers(const std::unordered_map<std::string, FileDiscoveryConfig>& nameConfigMap);
     // bool CheckLogType(const std::string& logTypeStr, LogType& logType);
     // 废弃
     // std::vector<std::string> GetStringVector(const Json::Value& value);
@@ -28,6 +28,7 @@
 #include <limits.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "app_config/AppConfig.h"
@@ -589,7 +590,7 @@ EventDispatcher::ValidateCheckpointResult EventDispatcher::validateCheckpoint(
     return ValidateCheckpointResult::kDevInodeNotFound;
 }
 
-void EventDispatcher::AddExistedCheckPointFileEvents() {
+void EventDispatcher::AddExistedCheckPointFileEvents(const unordered_set<string>* configNames) {
     // All checkpoint will be add into event queue or be deleted
     // This operation will delete not existed file's check point
     map<DevInode, SplitedFilePath> cachePathDevInodeMap;
@@ -598,6 +599,9 @@ void EventDispatcher::AddExistedCheckPointFileEvents() {
     vector<CheckPointManager::CheckPointKey> deleteKeyVec;
     vector<Event*> eventVec;
     for (auto iter = checkPointMap.begin(); iter != checkPointMap.end(); ++iter) {
+        if (configNames != nullptr && configNames->find(iter->second->mConfigName) == configNames->end()) {
+            continue;
+        }
         auto const result = validateCheckpoint(iter->second, cachePathDevInodeMap, eventVec);
         if (!(result == ValidateCheckpointResult::kNormal || result == ValidateCheckpointResult::kRotate)) {
             deleteKeyVec.push_back(iter->first);
@@ -614,6 +618,12 @@ void EventDispatcher::AddExistedCheckPointFileEvents() {
     // Load exactly once checkpoints and create events from them.
     // Because they are not in v1 checkpoint manager, no need to delete them.
     auto exactlyOnceConfigs = FileServer::GetInstance()->GetExactlyOnceConfigs();
+    if (configNames != nullptr) {
+        exactlyOnceConfigs.erase(remove_if(exactlyOnceConfigs.begin(),
+                                           exactlyOnceConfigs.end(),
+                                           [&](const string& name) { return configNames->count(name) == 0; }),
+                                 exactlyOnceConfigs.end());
+    }
     if (!exactlyOnceConfigs.empty()) {
         static auto* sCptMV2 = CheckpointManagerV2::GetInstance();
         auto exactlyOnceCpts = sCptMV2->ScanCheckpoints(exactlyOnceConfigs);
@@ -994,6 +1004,59 @@ void EventDispatcher::DumpCheckPoint() {
     LOG_INFO(sLogger, ("checkpoint dump", "succeeded"));
 }
 
+void EventDispatcher::DumpAndRemoveReaders(const unordered_set<string>& configNames) {
+    for (auto it = mWdDirInfoMap.begin(); it != mWdDirInfoMap.end(); ++it) {
+        it->second->mHandler->DumpAndRemoveReaders(configNames);
+    }
+    LOG_INFO(sLogger, ("save log reader status of updated configs", "succeeded")("config count", configNames.size()));
+}
+
+// dirs registered before are not registered again, so existed files in them should be read by the configs explicitly
+void EventDispatcher::AddExistedFileEventsOfConfigs(const unordered_set<string>& configNames) {
+    vector<FileDiscoveryConfig> configs;
+    for (const auto& name : configNames) {
+        auto config = FileServer::GetInstance()->GetFileDiscoveryConfig(name);
+        if (config.first != nullptr) {
+            configs.push_back(config);
+        }
+    }
+    if (configs.empty()) {
+        return;
+    }
+    for (auto it = mPathWdMap.begin(); it != mPathWdMap.end(); ++it) {
+        for (const auto& config : configs) {
+            if (config.first->IsMatch(it->first, "")) {
+                AddExistedFileEvents(it->first, it->second);
+                break;
+            }
+        }
+    }
+}
+
+// dirs of removed configs are released, as DumpAllHandlersMeta does for all dirs
+void EventDispatcher::UnregisterUnrelatedDirs() {
+    vector<string> paths;
+    for (auto it = mPathWdMap.begin(); it != mPathWdMap.end(); ++it) {
+        vector<FileDiscoveryConfig> configs;
+        ConfigManager::GetInstance()->GetRelatedConfigs(it->first, configs);
+        if (configs.empty()) {
+            paths.push_back(it->first);
+        }
+    }
+    for (const auto& path : paths) {
+        auto it = mPathWdMap.find(path);
+        if (it == mPathWdMap.end()) {
+            continue;
+        }
+        ConfigManager::GetInstance()->AddHandlerToDelete(mWdDirInfoMap[it->second]->mHandler);
+        UnregisterEventHandler(path);
+        ConfigManager::GetInstance()->RemoveHandler(path, false);
+    }
+    if (!paths.empty()) {
+        LOG_INFO(sLogger, ("unregister dirs not related to any config", "succeeded")("dir count", paths.size()));
+    }
+}
+
 bool EventDispatcher::IsAllFileRead() {
     for (auto it = mWdDirInfoMap.begin(); it != mWdDirInfoMap.end(); ++it) {
         if (!((it->second)->mHandler)->IsAllFileRead()) {
@@ -213,7 +213,13 @@ public:
     void ReadInotifyEvents(std::vector<Event*>& eventVec);
 
     void ProcessHandlerTimeOut();
-    void AddExistedCheckPointFileEvents();
+    // only checkpoints of @configNames are verified if given
+    void AddExistedCheckPointFileEvents(const std::unordered_set<std::string>* configNames = nullptr);
+
+    // for incremental config update, should be called with file server held on
+    void DumpAndRemoveReaders(const std::unordered_set<std::string>& configNames);
+    void AddExistedFileEventsOfConfigs(const std::unordered_set<std::string>& configNames);
+    void UnregisterUnrelatedDirs();
 
     void DumpInotifyWatcherDirs();
 
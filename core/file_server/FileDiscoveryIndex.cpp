@@ -0,0 +1,182 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/FileDiscoveryIndex.h"
+
+#if defined(__linux__)
+#include <fnmatch.h>
+#endif
+
+#include "common/FileSystemUtil.h"
+#include "common/StringTools.h"
+
+using namespace std;
+
+namespace logtail {
+
+void FileDiscoveryIndex::Add(const string& name, const FileDiscoveryConfig& config) {
+    Remove(name);
+    if (config.first->IsContainerDiscoveryEnabled()) {
+        mUnindexedConfigs[name] = config;
+        return;
+    }
+    // if the base path contains wildcard but is not parsed as wildcard path, it is matched literally
+    const string& basePath = config.first->GetBasePath();
+    bool isWildcard = !config.first->GetWildcardPaths().empty();
+    vector<PathComponent> components;
+    SplitPath(basePath, isWildcard, components);
+    Node* node = &mRoot;
+    for (const auto& component : components) {
+        auto& child = *FindChild(node, component);
+        node = child.get();
+    }
+    node->mConfigs[name] = config;
+    mNamePathMap[name] = make_pair(basePath, isWildcard);
+}
+
+void FileDiscoveryIndex::Remove(const string& name) {
+    if (mUnindexedConfigs.erase(name) > 0) {
+        return;
+    }
+    auto iter = mNamePathMap.find(name);
+    if (iter == mNamePathMap.end()) {
+        return;
+    }
+    vector<PathComponent> components;
+    SplitPath(iter->second.first, iter->second.second, components);
+    mNamePathMap.erase(iter);
+
+    vector<Node*> nodes{&mRoot};
+    for (const auto& component : components) {
+        nodes.push_back(FindChild(nodes.back(), component)->get());
+    }
+    nodes.back()->mConfigs.erase(name);
+    // remove the nodes no longer used
+    for (size_t i = components.size(); i > 0 && nodes[i]->Empty(); --i) {
+        Node* parent = nodes[i - 1];
+        if (components[i - 1].second) {
+            for (auto it = parent->mPatternChildren.begin(); it != parent->mPatternChildren.end(); ++it) {
+                if (it->second.get() == nodes[i]) {
+                    parent->mPatternChildren.erase(it);
+                    break;
+                }
+            }
+        } else {
+            parent->mChildren.erase(components[i - 1].first);
+        }
+    }
+}
+
+void FileDiscoveryIndex::Clear() {
+    mRoot.mChildren.clear();
+    mRoot.mPatternChildren.clear();
+    mRoot.mConfigs.clear();
+    mNamePathMap.clear();
+    mUnindexedConfigs.clear();
+}
+
+void FileDiscoveryIndex::FindCandidates(const string& path, vector<FileDiscoveryConfig>& res) const {
+    for (const auto& item : mUnindexedConfigs) {
+        res.push_back(item.second);
+    }
+    // empty components, which can be matched by wildcard with FNM_PATHNAME, are not kept in the trie. such paths are
+    // not expected, so just return all configs.
+    if (path.find(PATH_SEPARATOR + PATH_SEPARATOR, 1) != string::npos) {
+        CollectConfigs(&mRoot, res);
+        return;
+    }
+    vector<PathComponent> components;
+    SplitPath(path, false, components);
+    vector<string> names;
+    names.reserve(components.size());
+    for (auto& component : components) {
+        names.push_back(std::move(component.first));
+    }
+    FindCandidates(&mRoot, names, 0, res);
+}
+
+void FileDiscoveryIndex::SplitPath(const string& path, bool isWildcard, vector<PathComponent>& components) {
+    size_t pos = 0;
+    while (pos < path.size()) {
+        size_t end = path.find(PATH_SEPARATOR[0], pos);
+        if (end == string::npos) {
+            end = path.size();
+        }
+        if (end > pos) {
+            components.emplace_back(path.substr(pos, end - pos), false);
+            if (isWildcard && components.back().first.find_first_of("*?[") != string::npos) {
+                components.back().second = true;
+            }
+        }
+        pos = end + 1;
+    }
+}
+
+// a new child is created if not found
+unique_ptr<FileDiscoveryIndex::Node>* FileDiscoveryIndex::FindChild(Node* node, const PathComponent& component) {
+    unique_ptr<Node>* child = nullptr;
+    if (component.second) {
+        for (auto& item : node->mPatternChildren) {
+            if (item.first == component.first) {
+                child = &item.second;
+                break;
+            }
+        }
+        if (child == nullptr) {
+            node->mPatternChildren.emplace_back(component.first, nullptr);
+            child = &node->mPatternChildren.back().second;
+        }
+    } else {
+        child = &node->mChildren[component.first];
+    }
+    if (!*child) {
+        *child = make_unique<Node>();
+    }
+    return child;
+}
+
+void FileDiscoveryIndex::FindCandidates(const Node* node,
+                                        const vector<string>& components,
+                                        size_t idx,
+                                        vector<FileDiscoveryConfig>& res) {
+    for (const auto& item : node->mConfigs) {
+        res.push_back(item.second);
+    }
+    if (idx == components.size()) {
+        return;
+    }
+    auto iter = node->mChildren.find(components[idx]);
+    if (iter != node->mChildren.end()) {
+        FindCandidates(iter->second.get(), components, idx + 1, res);
+    }
+    for (const auto& item : node->mPatternChildren) {
+        if (fnmatch(item.first.c_str(), components[idx].c_str(), 0) == 0) {
+            FindCandidates(item.second.get(), components, idx + 1, res);
+        }
+    }
+}
+
+void FileDiscoveryIndex::CollectConfigs(const Node* node, vector<FileDiscoveryConfig>& res) {
+    for (const auto& item : node->mConfigs) {
+        res.push_back(item.second);
+    }
+    for (const auto& item : node->mChildren) {
+        CollectConfigs(item.second.get(), res);
+    }
+    for (const auto& item : node->mPatternChildren) {
+        CollectConfigs(item.second.get(), res);
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "file_server/FileDiscoveryOptions.h"
+
+namespace logtail {
+
+// FileDiscoveryIndex organizes file discovery configs by the components of their base paths in a trie, so that the
+// configs possibly matching a path can be found in time proportional to the depth of the path rather than the number
+// of configs. Components of wildcard base paths are kept as patterns and matched against one path component each,
+// which is the same as matching the whole path with FNM_PATHNAME. The candidates still need to be checked by
+// FileDiscoveryOptions::IsMatch for file pattern, blacklist and depth. Configs with container discovery enabled, whose
+// real base dirs change with containers, are always candidates.
+// not thread-safe, should be protected explicitly by the owner
+class FileDiscoveryIndex {
+public:
+    void Add(const std::string& name, const FileDiscoveryConfig& config);
+    void Remove(const std::string& name);
+    void Clear();
+    // configs are appended to @res
+    void FindCandidates(const std::string& path, std::vector<FileDiscoveryConfig>& res) const;
+    size_t Size() const { return mNamePathMap.size() + mUnindexedConfigs.size(); }
+
+private:
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>> mChildren;
+        std::vector<std::pair<std::string, std::unique_ptr<Node>>> mPatternChildren;
+        std::unordered_map<std::string, FileDiscoveryConfig> mConfigs;
+
+        bool Empty() const { return mChildren.empty() && mPatternChildren.empty() && mConfigs.empty(); }
+    };
+
+    // component and whether it is a pattern
+    using PathComponent = std::pair<std::string, bool>;
+
+    static void SplitPath(const std::string& path, bool isWildcard, std::vector<PathComponent>& components);
+    static std::unique_ptr<Node>* FindChild(Node* node, const PathComponent& component);
+    static void FindCandidates(const Node* node,
+                               const std::vector<std::string>& components,
+                               size_t idx,
+                               std::vector<FileDiscoveryConfig>& res);
+    static void CollectConfigs(const Node* node, std::vector<FileDiscoveryConfig>& res);
+
+    Node mRoot;
+    // config name -> base path and whether it is wildcard
+    std::unordered_map<std::string, std::pair<std::string, bool>> mNamePathMap;
+    std::unordered_map<std::string, FileDiscoveryConfig> mUnindexedConfigs;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FileDiscoveryIndexUnittest;
+#endif
+};
+
+} // namespace logtail
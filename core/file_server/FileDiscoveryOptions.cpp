@@ -39,6 +39,29 @@ inline bool _IsSubPath(const string& basePath, const string& subPath) {
     return false;
 }
 
+// @func is called with the idx of each container whose real base dir is @path or its ancestor, from the longest real
+// base dir to the shortest, until it returns true. the result is the same as checking _IsSubPath for every container.
+template <typename Func>
+bool _FindContainerByBaseDir(const unordered_multimap<string, size_t>& index, const string& path, Func func) {
+    if (index.empty()) {
+        return false;
+    }
+    string prefix = path;
+    while (true) {
+        auto range = index.equal_range(prefix);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (func(iter->second)) {
+                return true;
+            }
+        }
+        size_t pos = prefix.rfind(PATH_SEPARATOR[0]);
+        if (pos == string::npos) {
+            return false;
+        }
+        prefix.resize(pos);
+    }
+}
+
 inline bool _IsPathMatched(const string& basePath, const string& path, int maxDepth) {
     size_t pathSize = path.size();
     size_t basePathSize = basePath.size();
@@ -511,8 +534,8 @@ bool FileDiscoveryOptions::IsMatch(const string& path, const string& name) const
         }
 
         // Normal base path.
-        for (size_t i = 0; i < mContainerInfos->size(); ++i) {
-            const string& containerBasePath = (*mContainerInfos)[i].mRealBaseDir;
+        return _FindContainerByBaseDir(mContainerBaseDirIndex, path, [&](size_t idx) {
+            const string& containerBasePath = (*mContainerInfos)[idx].mRealBaseDir;
             if (_IsPathMatched(containerBasePath, path, mMaxDirSearchDepth)) {
                 if (!mHasBlacklist) {
                     return true;
@@ -523,8 +546,8 @@ bool FileDiscoveryOptions::IsMatch(const string& path, const string& name) const
                 if (!IsObjectInBlacklist(pathInContainer, name))
                     return true;
             }
-        }
-        return false;
+            return false;
+        });
     }
 
     // File not in docker: wildcard or non-wildcard.
@@ -641,16 +664,32 @@ bool FileDiscoveryOptions::WithinMaxDepth(const string& path) const {
     return true;
 }
 
+void FileDiscoveryOptions::SetContainerInfo(const shared_ptr<vector<ContainerInfo>>& info) {
+    mContainerInfos = info;
+    RebuildContainerInfoIndex();
+}
+
 ContainerInfo* FileDiscoveryOptions::GetContainerPathByLogPath(const string& logPath) const {
     if (!mContainerInfos) {
         return NULL;
     }
-    for (size_t i = 0; i < mContainerInfos->size(); ++i) {
-        if (_IsSubPath((*mContainerInfos)[i].mRealBaseDir, logPath)) {
-            return &(*mContainerInfos)[i];
-        }
+    ContainerInfo* res = NULL;
+    _FindContainerByBaseDir(mContainerBaseDirIndex, logPath, [&](size_t idx) {
+        res = &(*mContainerInfos)[idx];
+        return true;
+    });
+    return res;
+}
+
+ContainerInfo* FileDiscoveryOptions::GetContainerInfoByID(const string& id) const {
+    if (!mContainerInfos) {
+        return NULL;
     }
-    return NULL;
+    auto iter = mContainerIDIndex.find(id);
+    if (iter == mContainerIDIndex.end()) {
+        return NULL;
+    }
+    return &(*mContainerInfos)[iter->second];
 }
 
 bool FileDiscoveryOptions::IsSameContainerInfo(const Json::Value& paramsJSON, const PipelineContext* ctx) {
@@ -668,12 +707,8 @@ bool FileDiscoveryOptions::IsSameContainerInfo(const Json::Value& paramsJSON, co
             return true;
         }
         // try update
-        for (size_t i = 0; i < mContainerInfos->size(); ++i) {
-            if ((*mContainerInfos)[i] == containerInfo) {
-                return true;
-            }
-        }
-        return false;
+        const ContainerInfo* info = GetContainerInfoByID(containerInfo.mID);
+        return info != NULL && *info == containerInfo;
     }
 
     // check all
@@ -689,17 +724,17 @@ bool FileDiscoveryOptions::IsSameContainerInfo(const Json::Value& paramsJSON, co
         return false;
     }
 
-    for (size_t i = 0; i < mContainerInfos->size(); ++i) {
-        unordered_map<string, ContainerInfo>::iterator iter = allPathMap.find((*mContainerInfos)[i].mID);
+    for (auto& item : allPathMap) {
+        const ContainerInfo* info = GetContainerInfoByID(item.first);
         // need delete
-        if (iter == allPathMap.end()) {
+        if (info == NULL) {
             return false;
         }
-        if (!mDeduceAndSetContainerBaseDirFunc(iter->second, ctx, this)) {
+        if (!mDeduceAndSetContainerBaseDirFunc(item.second, ctx, this)) {
             return true;
         }
         // need update
-        if ((*mContainerInfos)[i] != iter->second) {
+        if (*info != item.second) {
             return false;
         }
     }
@@ -721,16 +756,7 @@ bool FileDiscoveryOptions::UpdateContainerInfo(const Json::Value& paramsJSON, co
         if (!mDeduceAndSetContainerBaseDirFunc(containerInfo, ctx, this)) {
             return false;
         }
-        // try update
-        for (size_t i = 0; i < mContainerInfos->size(); ++i) {
-            if ((*mContainerInfos)[i].mID == containerInfo.mID) {
-                // update
-                (*mContainerInfos)[i] = containerInfo;
-                return true;
-            }
-        }
-        // add
-        mContainerInfos->push_back(containerInfo);
+        AddOrUpdateContainerInfo(containerInfo);
         return true;
     }
 
@@ -742,13 +768,23 @@ bool FileDiscoveryOptions::UpdateContainerInfo(const Json::Value& paramsJSON, co
                    "skip this path")("params", paramsJSON.toStyledString())("errorMsg", errorMsg));
         return false;
     }
-    // if update all, clear and reset
-    mContainerInfos->clear();
-    for (unordered_map<string, ContainerInfo>::iterator iter = allPathMap.begin(); iter != allPathMap.end(); ++iter) {
-        if (!mDeduceAndSetContainerBaseDirFunc(iter->second, ctx, this)) {
+    for (auto& item : allPathMap) {
+        if (!mDeduceAndSetContainerBaseDirFunc(item.second, ctx, this)) {
             return false;
         }
-        mContainerInfos->push_back(iter->second);
+    }
+    // if update all, only apply the difference
+    vector<string> removedIDs;
+    for (const auto& info : *mContainerInfos) {
+        if (allPathMap.find(info.mID) == allPathMap.end()) {
+            removedIDs.push_back(info.mID);
+        }
+    }
+    for (const auto& id : removedIDs) {
+        RemoveContainerInfo(id);
+    }
+    for (auto& item : allPathMap) {
+        AddOrUpdateContainerInfo(item.second);
     }
     return true;
 }
@@ -763,13 +799,71 @@ bool FileDiscoveryOptions::DeleteContainerInfo(const Json::Value& paramsJSON) {
         LOG_ERROR(sLogger, ("invalid container info update param", errorMsg)("action", "ignore current cmd"));
         return false;
     }
-    for (vector<ContainerInfo>::iterator iter = mContainerInfos->begin(); iter != mContainerInfos->end(); ++iter) {
-        if (iter->mID == containerInfo.mID) {
-            mContainerInfos->erase(iter);
-            break;
+    RemoveContainerInfo(containerInfo.mID);
+    return true;
+}
+
+void FileDiscoveryOptions::RebuildContainerInfoIndex() {
+    mContainerIDIndex.clear();
+    mContainerBaseDirIndex.clear();
+    if (!mContainerInfos) {
+        return;
+    }
+    for (size_t i = 0; i < mContainerInfos->size(); ++i) {
+        mContainerIDIndex[(*mContainerInfos)[i].mID] = i;
+        mContainerBaseDirIndex.emplace((*mContainerInfos)[i].mRealBaseDir, i);
+    }
+}
+
+// @containerInfo may be moved
+void FileDiscoveryOptions::AddOrUpdateContainerInfo(ContainerInfo& containerInfo) {
+    auto iter = mContainerIDIndex.find(containerInfo.mID);
+    if (iter == mContainerIDIndex.end()) {
+        size_t idx = mContainerInfos->size();
+        mContainerIDIndex[containerInfo.mID] = idx;
+        mContainerBaseDirIndex.emplace(containerInfo.mRealBaseDir, idx);
+        mContainerInfos->push_back(std::move(containerInfo));
+        return;
+    }
+    ContainerInfo& info = (*mContainerInfos)[iter->second];
+    if (info == containerInfo) {
+        return;
+    }
+    if (info.mRealBaseDir != containerInfo.mRealBaseDir) {
+        RemoveContainerBaseDirIndex(info.mRealBaseDir, iter->second);
+        mContainerBaseDirIndex.emplace(containerInfo.mRealBaseDir, iter->second);
+    }
+    info = std::move(containerInfo);
+}
+
+// the last container is moved to the position of the removed one, so the order of mContainerInfos is not kept
+void FileDiscoveryOptions::RemoveContainerInfo(const string& id) {
+    auto iter = mContainerIDIndex.find(id);
+    if (iter == mContainerIDIndex.end()) {
+        return;
+    }
+    size_t idx = iter->second;
+    size_t lastIdx = mContainerInfos->size() - 1;
+    mContainerIDIndex.erase(iter);
+    RemoveContainerBaseDirIndex((*mContainerInfos)[idx].mRealBaseDir, idx);
+    if (idx != lastIdx) {
+        ContainerInfo& last = (*mContainerInfos)[lastIdx];
+        mContainerIDIndex[last.mID] = idx;
+        RemoveContainerBaseDirIndex(last.mRealBaseDir, lastIdx);
+        mContainerBaseDirIndex.emplace(last.mRealBaseDir, idx);
+        (*mContainerInfos)[idx] = std::move(last);
+    }
+    mContainerInfos->pop_back();
+}
+
+void FileDiscoveryOptions::RemoveContainerBaseDirIndex(const string& realBaseDir, size_t idx) {
+    auto range = mContainerBaseDirIndex.equal_range(realBaseDir);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        if (iter->second == idx) {
+            mContainerBaseDirIndex.erase(iter);
+            return;
         }
     }
-    return true;
 }
 
 } // namespace logtail
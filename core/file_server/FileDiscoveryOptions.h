@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -44,7 +45,7 @@ public:
     bool IsContainerDiscoveryEnabled() const { return mEnableContainerDiscovery; }
     void SetEnableContainerDiscoveryFlag(bool flag) { mEnableContainerDiscovery = true; }
     const std::shared_ptr<std::vector<ContainerInfo>>& GetContainerInfo() const { return mContainerInfos; }
-    void SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info) { mContainerInfos = info; }
+    void SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info);
     void SetDeduceAndSetContainerBaseDirFunc(bool (*f)(ContainerInfo&,
                                                        const PipelineContext*,
                                                        const FileDiscoveryOptions*)) {
@@ -59,6 +60,7 @@ public:
     bool UpdateContainerInfo(const Json::Value& paramsJSON, const PipelineContext*);
     bool DeleteContainerInfo(const Json::Value& paramsJSON);
     ContainerInfo* GetContainerPathByLogPath(const std::string& logPath) const;
+    ContainerInfo* GetContainerInfoByID(const std::string& id) const;
     // 过渡使用
     bool IsTailingAllMatchedFiles() const { return mTailingAllMatchedFiles; }
     void SetTailingAllMatchedFiles(bool flag) { mTailingAllMatchedFiles = flag; }
@@ -78,6 +80,10 @@ private:
     bool IsObjectInBlacklist(const std::string& path, const std::string& name) const;
     bool IsFileNameInBlacklist(const std::string& fileName) const;
     bool IsWildcardPathMatch(const std::string& path, const std::string& name = "") const;
+    void RebuildContainerInfoIndex();
+    void AddOrUpdateContainerInfo(ContainerInfo& containerInfo);
+    void RemoveContainerInfo(const std::string& id);
+    void RemoveContainerBaseDirIndex(const std::string& realBaseDir, size_t idx);
 
     std::string mBasePath;
     std::string mFilePattern;
@@ -109,6 +115,10 @@ private:
 
     bool mEnableContainerDiscovery = false;
     std::shared_ptr<std::vector<ContainerInfo>> mContainerInfos; // must not be null if container discovery is enabled
+    // indexes of mContainerInfos, which should only be modified through the member functions to keep them consistent
+    std::unordered_map<std::string, size_t> mContainerIDIndex;
+    // real base dir -> idx, real base dirs of a path are found by looking up each of its prefixes
+    std::unordered_multimap<std::string, size_t> mContainerBaseDirIndex;
     bool (*mDeduceAndSetContainerBaseDirFunc)(ContainerInfo& containerInfo,
                                               const PipelineContext*,
                                               const FileDiscoveryOptions*)
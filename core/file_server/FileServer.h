@@ -18,9 +18,11 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "common/Lock.h"
+#include "file_server/FileDiscoveryIndex.h"
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/MultilineOptions.h"
 #include "file_server/reader/FileReaderOptions.h"
@@ -43,12 +45,17 @@ public:
 
     void Start();
     void Pause(bool isConfigUpdate = true);
+    // incremental config update: only handlers and readers of the updated configs are dumped and rebuilt, while
+    // readers of other configs are kept. Threads are held on during the swap only.
+    void PauseConfigs(const std::unordered_set<std::string>& names);
+    void ResumeConfigs(const std::unordered_set<std::string>& names);
 
     // for plugin
     FileDiscoveryConfig GetFileDiscoveryConfig(const std::string& name) const;
     const std::unordered_map<std::string, FileDiscoveryConfig>& GetAllFileDiscoveryConfigs() const {
         return mPipelineNameFileDiscoveryConfigsMap;
     }
+    const FileDiscoveryIndex& GetFileDiscoveryIndex() const { return mFileDiscoveryIndex; }
     void AddFileDiscoveryConfig(const std::string& name, FileDiscoveryOptions* opts, const PipelineContext* ctx);
     void RemoveFileDiscoveryConfig(const std::string& name);
 
@@ -99,6 +106,7 @@ private:
     mutable ReadWriteLock mReadWriteLock;
 
     std::unordered_map<std::string, FileDiscoveryConfig> mPipelineNameFileDiscoveryConfigsMap;
+    FileDiscoveryIndex mFileDiscoveryIndex;
     std::unordered_map<std::string, FileReaderConfig> mPipelineNameFileReaderConfigsMap;
     std::unordered_map<std::string, MultilineConfig> mPipelineNameMultilineConfigsMap;
     std::unordered_map<std::string, std::shared_ptr<std::vector<ContainerInfo>>> mAllContainerInfoMap;
@@ -64,7 +64,8 @@ private:
     BlockedEventManager() = default;
     ~BlockedEventManager();
 
-    // only used by LogInput thread
+    // race condition from reader worker threads and LogInput thread
+    std::mutex mEventMapMux;
     std::unordered_map<int64_t, BlockedEvent> mEventMap;
 
     // race condition from Processor Runner threads and LogInput thread
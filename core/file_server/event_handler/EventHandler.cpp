@@ -28,6 +28,7 @@
 #include "file_server/FileServer.h"
 #include "file_server/event/BlockEventManager.h"
 #include "file_server/event_handler/LogInput.h"
+#include "file_server/event_handler/ReaderWorkerPool.h"
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
 #include "pipeline/queue/ProcessQueueManager.h"
@@ -201,6 +202,19 @@ bool CreateModifyHandler::IsAllFileRead() {
     return true;
 }
 
+void CreateModifyHandler::DumpAndRemoveReaders(const unordered_set<string>& configNames) {
+    for (const auto& configName : configNames) {
+        auto iter = mModifyHandlerPtrMap.find(configName);
+        if (iter == mModifyHandlerPtrMap.end()) {
+            continue;
+        }
+        iter->second->DumpReaderMeta(true, true);
+        iter->second->DumpReaderMeta(false, true);
+        delete iter->second;
+        mModifyHandlerPtrMap.erase(iter);
+    }
+}
+
 ModifyHandler* CreateModifyHandler::GetOrCreateModifyHandler(const std::string& configName,
                                                              const FileDiscoveryConfig& pConfig) {
     ModifyHandlerMap::iterator iter = mModifyHandlerPtrMap.find(configName);
@@ -244,10 +258,13 @@ void CreateModifyHandler::Handle(const Event& event) {
         mCreateHandlerPtr->Handle(event);
     } else if (event.IsContainerStopped() && isDir) {
         for (auto& pair : mModifyHandlerPtrMap) {
+            if (!event.GetConfigName().empty() && event.GetConfigName() != pair.first) {
+                continue;
+            }
             LOG_DEBUG(sLogger,
                       ("Handle container stopped event, config", pair.first)("Source", event.GetSource())(
                           "Object", event.GetObject())("Dev", event.GetDev())("Inode", event.GetInode()));
-            pair.second->Handle(event);
+            ReaderWorkerPool::GetInstance()->Dispatch(pair.second, event);
         }
     } else if (event.IsCreate() || event.IsModify() || event.IsMoveFrom() || event.IsMoveTo() || event.IsDeleted()) {
         if (!event.GetConfigName().empty()) {
@@ -256,7 +273,8 @@ void CreateModifyHandler::Handle(const Event& event) {
                 LOG_DEBUG(sLogger,
                           ("Process event with existed config", event.GetConfigName())("Source", event.GetSource())(
                               "Object", event.GetObject())("Dev", event.GetDev())("Inode", event.GetInode()));
-                GetOrCreateModifyHandler(pConfig.second->GetConfigName(), pConfig)->Handle(event);
+                ReaderWorkerPool::GetInstance()->Dispatch(
+                    GetOrCreateModifyHandler(pConfig.second->GetConfigName(), pConfig), event);
             } else {
                 // if event is delete
                 LOG_WARNING(sLogger, ("can not find config, config may be deleted", event.GetConfigName()));
@@ -272,7 +290,8 @@ void CreateModifyHandler::Handle(const Event& event) {
             for (auto configIter = pConfigVec.begin(); configIter != pConfigVec.end(); ++configIter) {
                 LOG_DEBUG(sLogger,
                           ("Process event with multi config", pConfigVec.size())(event.GetSource(), event.GetObject()));
-                GetOrCreateModifyHandler(configIter->second->GetConfigName(), *configIter)->Handle(event);
+                ReaderWorkerPool::GetInstance()->Dispatch(
+                    GetOrCreateModifyHandler(configIter->second->GetConfigName(), *configIter), event);
             }
         }
     }
@@ -287,8 +306,10 @@ void CreateModifyHandler::HandleTimeOut() {
 }
 
 // implementation for ModifyHandler
+std::atomic_uint32_t ModifyHandler::sHandlerCnt{0};
+
 ModifyHandler::ModifyHandler(const std::string& configName, const FileDiscoveryConfig& pConfig)
-    : mConfigName(configName) {
+    : mConfigName(configName), mWorkerIdx(sHandlerCnt++) {
     // default is 2 * INT64_FLAG(read_file_time_slice)
     mReadFileTimeSlice = 1 << (ProcessQueueManager::sMaxPriority - pConfig.second->GetGlobalConfig().mPriority)
             * INT64_FLAG(read_file_time_slice);
@@ -478,6 +499,7 @@ LogFileReaderPtr ModifyHandler::CreateLogFileReaderPtr(const string& path,
 
 
 void ModifyHandler::Handle(const Event& event) {
+    unique_lock<mutex> lock(mHandlerMux);
     const string& path = event.GetSource();
     const string& name = event.GetObject();
 
@@ -774,7 +796,20 @@ void ModifyHandler::Handle(const Event& event) {
             }
             auto logBuffer = make_unique<LogBuffer>();
             hasMoreData = reader->ReadLog(*logBuffer, &event);
-            int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get());
+            int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get(), &lock);
+            // the lock is released while waiting for the process queue, so the reader may have been removed by
+            // HandleTimeOut in the meantime, in which case readerArrayPtr must not be touched any more
+            if (pushRetry > 0) {
+                auto devInodeIter = mDevInodeReaderMap.find(reader->GetDevInode());
+                if (devInodeIter == mDevInodeReaderMap.end() || devInodeIter->second != reader) {
+                    LOG_INFO(sLogger,
+                             ("reader removed while pushing log to process queue, project", reader->GetProject())(
+                                 "logstore", reader->GetLogstore())("config", mConfigName)(
+                                 "log reader queue name", reader->GetHostLogPath())(
+                                 "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode));
+                    return;
+                }
+            }
             if (!hasMoreData) {
                 if (reader->IsFileDeleted()) {
                     LOG_INFO(sLogger,
@@ -886,6 +921,7 @@ void ModifyHandler::Handle(const Event& event) {
 }
 
 void ModifyHandler::HandleTimeOut() {
+    lock_guard<mutex> lock(mHandlerMux);
     MakeSpaceForNewReader();
     DeleteTimeoutReader();
     DeleteRollbackReader();
@@ -961,6 +997,7 @@ void ModifyHandler::HandleTimeOut() {
 }
 
 bool ModifyHandler::DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) {
+    lock_guard<mutex> lock(mHandlerMux);
     if (!isRotatorReader) {
         for (DevInodeLogFileReaderMap::iterator it = mDevInodeReaderMap.begin(); it != mDevInodeReaderMap.end(); ++it) {
             int32_t idxInReaderArray = LogFileReader::CHECKPOINT_IDX_OF_NOT_IN_READER_ARRAY;
@@ -981,6 +1018,7 @@ bool ModifyHandler::DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) {
 }
 
 bool ModifyHandler::IsAllFileRead() {
+    lock_guard<mutex> lock(mHandlerMux);
     for (auto it = mNameReaderMap.begin(); it != mNameReaderMap.end(); ++it) {
         if (it->second.size() > 1 || (!it->second.empty() && !it->second[0]->IsReadToEnd())) {
             return false;
@@ -993,6 +1031,33 @@ bool ModifyHandler::IsAllFileRead() {
     return true;
 }
 
+LogFileReaderPtr ModifyHandler::GetReadRange(const Event& event, int& fd, int64_t& offset, size_t& size) {
+    lock_guard<mutex> lock(mHandlerMux);
+    if (!event.IsModify() || event.IsReaderFlushTimeout()) {
+        return LogFileReaderPtr();
+    }
+    auto iter = mDevInodeReaderMap.find(DevInode(event.GetDev(), event.GetInode()));
+    if (iter == mDevInodeReaderMap.end()) {
+        return LogFileReaderPtr();
+    }
+    LogFileReaderPtrArray* readerArray = iter->second->GetReaderArray();
+    if (readerArray == nullptr || readerArray->empty()) {
+        return LogFileReaderPtr();
+    }
+    // the same reader as the one read in Handle
+    LogFileReaderPtr reader = (*readerArray)[0];
+    if (!reader->GetNextReadRange(fd, offset, size)) {
+        return LogFileReaderPtr();
+    }
+    return reader;
+}
+
+void ModifyHandler::SetPrefetchedData(
+    const LogFileReaderPtr& reader, int64_t offset, const char* data, size_t size, bool reachEnd) {
+    lock_guard<mutex> lock(mHandlerMux);
+    reader->SetPrefetchedData(offset, data, size, reachEnd);
+}
+
 void ModifyHandler::DeleteTimeoutReader() {
     if ((int32_t)mDevInodeReaderMap.size() > INT32_FLAG(logreader_count_maxlimit))
         DeleteTimeoutReader(86400);
@@ -1070,7 +1135,9 @@ void ModifyHandler::ForceReadLogAndPush(LogFileReaderPtr reader) {
     PushLogToProcessor(reader, logBuffer.get());
 }
 
-int32_t ModifyHandler::PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* logBuffer) {
+int32_t ModifyHandler::PushLogToProcessor(LogFileReaderPtr reader,
+                                          LogBuffer* logBuffer,
+                                          unique_lock<mutex>* handlerLock) {
     int32_t pushRetry = 0;
     if (!logBuffer->rawBuffer.empty()) {
         reader->ReportMetrics(logBuffer->readLength);
@@ -1078,10 +1145,18 @@ int32_t ModifyHandler::PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* lo
 
         while (!ProcessorRunner::GetInstance()->PushQueue(reader->GetQueueKey(), 0, std::move(group))) // 10ms
         {
+            // do not block HandleTimeOut and DumpReaderMeta while the process queue is full
+            if (pushRetry == 0 && handlerLock != nullptr) {
+                handlerLock->unlock();
+            }
             ++pushRetry;
-            if (pushRetry % 10 == 0)
+            // events can only be read by LogInput thread
+            if (pushRetry % 10 == 0 && !ReaderWorkerPool::GetInstance()->IsEnabled())
                 LogInput::GetInstance()->TryReadEvents(false);
         }
+        if (pushRetry > 0 && handlerLock != nullptr) {
+            handlerLock->lock();
+        }
     }
     return pushRetry;
 }
@@ -17,9 +17,12 @@
 #pragma once
 #include <time.h>
 
+#include <atomic>
 #include <deque>
 #include <map>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "file_server/reader/LogFileReader.h"
 
@@ -40,6 +43,8 @@ public:
     virtual void HandleTimeOut() = 0;
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) = 0;
     virtual bool IsAllFileRead() { return true; }
+    // dump readers of the configs to checkpoint and release them, readers of other configs are untouched
+    virtual void DumpAndRemoveReaders(const std::unordered_set<std::string>& configNames) {}
     virtual ~EventHandler() {}
 };
 
@@ -63,6 +68,12 @@ private:
     uint64_t mReadFileTimeSlice;
     std::string mConfigName;
     int32_t mLastOverflowErrorTime;
+    // index of the reader worker that handles all events of this handler
+    uint32_t mWorkerIdx;
+    // Handle is called by reader worker while timeout and dump are called by LogInput thread
+    mutable std::mutex mHandlerMux;
+
+    static std::atomic_uint32_t sHandlerCnt;
 
     void DeleteTimeoutReader();
     void DeleteTimeoutReader(int32_t timeoutInterval);
@@ -98,7 +109,10 @@ private:
                                             uint32_t exactlyonceConcurrency = 0,
                                             bool forceBeginingFlag = false);
 
-    int32_t PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* logBuffer);
+    // if @handlerLock is given, it is released while the process queue is full and held again before returning
+    int32_t PushLogToProcessor(LogFileReaderPtr reader,
+                               LogBuffer* logBuffer,
+                               std::unique_lock<std::mutex>* handlerLock = nullptr);
 
     void ForceReadLogAndPush(LogFileReaderPtr reader);
 
@@ -114,6 +128,12 @@ public:
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
     bool IsAllFileRead() override;
 
+    const std::string& GetConfigName() const { return mConfigName; }
+    uint32_t GetWorkerIdx() const { return mWorkerIdx; }
+    // batched reading: returns the range to be read on the modify event, or nullptr if the reader is not ready
+    LogFileReaderPtr GetReadRange(const Event& event, int& fd, int64_t& offset, size_t& size);
+    void SetPrefetchedData(const LogFileReaderPtr& reader, int64_t offset, const char* data, size_t size, bool reachEnd);
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConfigUpdatorUnittest;
     friend class EventDispatcherTest;
@@ -168,6 +188,7 @@ public:
     virtual void HandleTimeOut();
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
     bool IsAllFileRead() override;
+    void DumpAndRemoveReaders(const std::unordered_set<std::string>& configNames) override;
 
     ModifyHandler* GetOrCreateModifyHandler(const std::string& configName, const FileDiscoveryConfig& pConfig);
 
@@ -30,6 +30,7 @@
 #include "file_server/event/BlockEventManager.h"
 #include "file_server/event_handler/EventHandler.h"
 #include "file_server/event_handler/HistoryFileImporter.h"
+#include "file_server/event_handler/ReaderWorkerPool.h"
 #include "file_server/polling/PollingCache.h"
 #include "file_server/polling/PollingDirFile.h"
 #include "file_server/polling/PollingEventQueue.h"
@@ -96,12 +97,14 @@ void LogInput::Start() {
     mEnableFileIncludedByMultiConfigs = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
         METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG);
 
+    ReaderWorkerPool::GetInstance()->Start(AppConfig::GetInstance()->GetFileReaderThreadCount());
     mThreadRes = async(launch::async, &LogInput::ProcessLoop, this);
 }
 
 void LogInput::Resume() {
     LOG_INFO(sLogger, ("event handle daemon resume", "starts"));
     mInteruptFlag = false;
+    ReaderWorkerPool::GetInstance()->Resume();
     mAccessMainThreadRWL.unlock();
     LOG_INFO(sLogger, ("event handle daemon resume", "succeeded"));
 }
@@ -114,11 +117,13 @@ void LogInput::HoldOn() {
             return;
         }
         mThreadRes.wait(); // should we set a timeout here? what it network outrage for an hour?
+        ReaderWorkerPool::GetInstance()->Stop();
         LOG_INFO(sLogger, ("input event handle daemon", "stopped successfully"));
     } else {
         LOG_INFO(sLogger, ("input event handle daemon pause", "starts"));
         mInteruptFlag = true;
         mAccessMainThreadRWL.lock();
+        ReaderWorkerPool::GetInstance()->HoldOn();
         LOG_INFO(sLogger, ("input event handle daemon pause", "succeeded"));
     }
 }
@@ -321,7 +326,8 @@ void LogInput::ProcessEvent(EventDispatcher* dispatcher, Event* ev) {
             if (object.size() > 0)
                 path += PATH_SEPARATOR + object;
             dispatcher->UnregisterAllDir(path);
-        } else if (ev->IsDir() && ev->IsContainerStopped()) {
+        } else if (ev->IsDir() && ev->IsContainerStopped() && ev->GetConfigName().empty()) {
+            // events with config name are returned by reader workers for the sub dir already, handle them directly
             string path = source;
             if (object.size() > 0)
                 path += PATH_SEPARATOR + object;
@@ -458,7 +464,9 @@ void LogInput::ProcessLoop() {
         }
 
         if (Application::GetInstance()->IsExiting()
-            && (!BOOL_FLAG(enable_full_drain_mode) || EventDispatcher::GetInstance()->IsAllFileRead())) {
+            && (!BOOL_FLAG(enable_full_drain_mode)
+                || (!ReaderWorkerPool::GetInstance()->HasPendingEvents()
+                    && EventDispatcher::GetInstance()->IsAllFileRead()))) {
             break;
         }
     }
@@ -467,6 +475,7 @@ void LogInput::ProcessLoop() {
 }
 
 void LogInput::PushEventQueue(std::vector<Event*>& eventVec) {
+    lock_guard<mutex> lock(mEventQueueMux);
     for (std::vector<Event*>::iterator iter = eventVec.begin(); iter != eventVec.end(); ++iter) {
         string key;
         key.append((*iter)->GetSource())
@@ -493,6 +502,7 @@ void LogInput::PushEventQueue(std::vector<Event*>& eventVec) {
 }
 
 void LogInput::PushEventQueue(Event* ev) {
+    lock_guard<mutex> lock(mEventQueueMux);
     string key;
     key.append(ev->GetSource())
         .append(">")
@@ -516,6 +526,7 @@ void LogInput::PushEventQueue(Event* ev) {
 }
 
 Event* LogInput::PopEventQueue() {
+    lock_guard<mutex> lock(mEventQueueMux);
     if (mInotifyEventQueue.size() > 0) {
         Event* ev = mInotifyEventQueue.front();
         mInotifyEventQueue.pop();
@@ -536,6 +547,7 @@ void LogInput::CleanEnviroments() {
             break;
         delete ev;
     }
+    lock_guard<mutex> lock(mEventQueueMux);
     mModifyEventSet.clear();
 }
 #endif
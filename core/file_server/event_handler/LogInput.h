@@ -18,6 +18,7 @@
 #define __LOG_ILOGTAIL_LOG_INPUT_H__
 
 #include <condition_variable>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <unordered_set>
@@ -70,6 +71,8 @@ private:
     Event* PopEventQueue();
     void UpdateCriticalMetric(int32_t curTime);
 
+    // events can be pushed back by reader workers
+    mutable std::mutex mEventQueueMux;
     std::queue<Event*> mInotifyEventQueue;
     std::unordered_set<int64_t> mModifyEventSet;
     ReadWriteLock mAccessMainThreadRWL;
@@ -0,0 +1,220 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/event_handler/ReaderWorkerPool.h"
+
+#include <string>
+#include <unordered_set>
+
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/LogInput.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(file_reader_worker_exit_timeout_secs, "", 60);
+DEFINE_FLAG_BOOL(enable_file_reader_io_uring,
+                 "read files in batch with io_uring in reader workers, pread is used if io_uring is unavailable",
+                 false);
+DEFINE_FLAG_INT32(file_reader_io_uring_depth, "max reads submitted in one batch by each reader worker", 32);
+DEFINE_FLAG_INT32(file_reader_io_uring_buffer_size, "bytes read ahead for each file in one batch", 64 * 1024);
+
+using namespace std;
+
+namespace logtail {
+
+void ReaderWorkerPool::Start(uint32_t threadCount) {
+    if (mEnabled || threadCount <= 1) {
+        return;
+    }
+    mIsStopped = false;
+    for (uint32_t idx = 0; idx < threadCount; ++idx) {
+        mShards.emplace_back(make_unique<Shard>());
+    }
+    for (uint32_t idx = 0; idx < threadCount; ++idx) {
+        mShards[idx]->mThreadRes = async(launch::async, &ReaderWorkerPool::Run, this, idx);
+    }
+    mEnabled = true;
+    LOG_INFO(sLogger, ("file reader worker pool", "started")("thread count", threadCount));
+}
+
+void ReaderWorkerPool::Stop() {
+    if (!mEnabled) {
+        return;
+    }
+    mIsStopped = true;
+    for (size_t idx = 0; idx < mShards.size(); ++idx) {
+        auto& shard = *mShards[idx];
+        shard.mCV.notify_all();
+        if (!shard.mThreadRes.valid()) {
+            continue;
+        }
+        future_status s = shard.mThreadRes.wait_for(chrono::seconds(INT32_FLAG(file_reader_worker_exit_timeout_secs)));
+        if (s == future_status::ready) {
+            LOG_INFO(sLogger, ("file reader worker", "stopped successfully")("idx", idx));
+        } else {
+            // threads still refer to their shards and handlers, so they must be joined before shards are released
+            LOG_WARNING(sLogger, ("file reader worker", "not stopped in time, keep waiting")("idx", idx));
+            shard.mThreadRes.wait();
+            LOG_INFO(sLogger, ("file reader worker", "stopped")("idx", idx));
+        }
+    }
+    mEnabled = false;
+    mShards.clear();
+    mPendingEventCnt = 0;
+}
+
+void ReaderWorkerPool::HoldOn() {
+    if (!mEnabled) {
+        return;
+    }
+    LOG_INFO(sLogger, ("file reader worker pool pause", "starts"));
+    mWorkerRWL.lock();
+    size_t cnt = 0;
+    unordered_set<string> returnedEvents;
+    for (auto& shard : mShards) {
+        lock_guard<mutex> lock(shard->mMux);
+        for (auto& item : shard->mQueue) {
+            // config name is kept so that the event is routed to the same config only after resuming, otherwise dir
+            // events would be dispatched to all handlers again
+            auto& ev = item.second;
+            ev->SetConfigName(item.first->GetConfigName());
+            string key = ToString(ev->GetType()) + ">" + ev->GetSource() + ">" + ev->GetObject() + ">"
+                + ToString(ev->GetDev()) + ">" + ToString(ev->GetInode()) + ">" + ev->GetConfigName();
+            if (!returnedEvents.insert(key).second) {
+                continue;
+            }
+            LogInput::GetInstance()->PushEventQueue(ev.release());
+            ++cnt;
+        }
+        mPendingEventCnt -= shard->mQueue.size();
+        shard->mQueue.clear();
+    }
+    LOG_INFO(sLogger, ("file reader worker pool pause", "succeeded")("events returned to event queue", cnt));
+}
+
+void ReaderWorkerPool::Resume() {
+    if (!mEnabled) {
+        return;
+    }
+    LOG_INFO(sLogger, ("file reader worker pool resume", "starts"));
+    mWorkerRWL.unlock();
+    LOG_INFO(sLogger, ("file reader worker pool resume", "succeeded"));
+}
+
+void ReaderWorkerPool::Dispatch(ModifyHandler* handler, const Event& event) {
+    if (!mEnabled) {
+        handler->Handle(event);
+        return;
+    }
+    auto& shard = *mShards[handler->GetWorkerIdx() % mShards.size()];
+    {
+        lock_guard<mutex> lock(shard.mMux);
+        shard.mQueue.emplace_back(handler, make_unique<Event>(event));
+        ++mPendingEventCnt;
+    }
+    shard.mCV.notify_one();
+}
+
+void ReaderWorkerPool::Run(size_t idx) {
+    LOG_INFO(sLogger, ("file reader worker", "started")("idx", idx));
+    auto& shard = *mShards[idx];
+    // each worker owns its ring since io_uring is not shared among threads
+    IoUringReader ioUring;
+    size_t batchSize = 1;
+    if (BOOL_FLAG(enable_file_reader_io_uring)
+        && ioUring.Init(INT32_FLAG(file_reader_io_uring_depth), INT32_FLAG(file_reader_io_uring_buffer_size))) {
+        batchSize = ioUring.GetDepth();
+    }
+    vector<pair<ModifyHandler*, unique_ptr<Event>>> batch;
+    while (true) {
+        {
+            unique_lock<mutex> lock(shard.mMux);
+            shard.mCV.wait_for(
+                lock, chrono::milliseconds(100), [&]() { return !shard.mQueue.empty() || mIsStopped.load(); });
+            if (shard.mQueue.empty()) {
+                if (mIsStopped) {
+                    break;
+                }
+                continue;
+            }
+        }
+
+        ReadLock rLock(mWorkerRWL);
+        {
+            lock_guard<mutex> lock(shard.mMux);
+            // events may have been returned to LogInput during hold on
+            while (!shard.mQueue.empty() && batch.size() < batchSize) {
+                batch.emplace_back(shard.mQueue.front().first, std::move(shard.mQueue.front().second));
+                shard.mQueue.pop_front();
+            }
+        }
+        if (batch.empty()) {
+            continue;
+        }
+        vector<LogFileReaderPtr> prefetchedReaders;
+        if (ioUring.IsInited() && batch.size() > 1) {
+            Prefetch(ioUring, batch, prefetchedReaders);
+        }
+        for (auto& item : batch) {
+            item.first->Handle(*item.second);
+            --mPendingEventCnt;
+        }
+        // prefetched data not consumed by Handle should not outlive the batch
+        for (size_t i = 0; i < prefetchedReaders.size(); ++i) {
+            if (prefetchedReaders[i]) {
+                batch[i].first->SetPrefetchedData(prefetchedReaders[i], -1, nullptr, 0, false);
+            }
+        }
+        batch.clear();
+    }
+    LOG_INFO(sLogger, ("file reader worker", "stopped")("idx", idx));
+}
+
+void ReaderWorkerPool::Prefetch(IoUringReader& ioUring,
+                                const vector<pair<ModifyHandler*, unique_ptr<Event>>>& batch,
+                                vector<LogFileReaderPtr>& readers) {
+    readers.resize(batch.size());
+    vector<IoUringReader::Request> requests;
+    vector<size_t> requestIdx;
+    unordered_set<LogFileReader*> visited;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        IoUringReader::Request req;
+        LogFileReaderPtr reader = batch[i].first->GetReadRange(*batch[i].second, req.mFd, req.mOffset, req.mSize);
+        if (!reader || !visited.insert(reader.get()).second) {
+            continue;
+        }
+        req.mSize = min(req.mSize, ioUring.GetBufferSize());
+        readers[i] = reader;
+        requests.emplace_back(req);
+        requestIdx.emplace_back(i);
+    }
+    if (requests.size() <= 1 || !ioUring.Read(requests)) {
+        // nothing to batch, or io_uring is broken and pread is used from now on
+        readers.clear();
+        return;
+    }
+    for (size_t i = 0; i < requests.size(); ++i) {
+        size_t pos = requestIdx[i];
+        if (requests[i].mResult < 0) {
+            readers[pos].reset();
+            continue;
+        }
+        size_t size = static_cast<size_t>(requests[i].mResult);
+        batch[pos].first->SetPrefetchedData(
+            readers[pos], requests[i].mOffset, requests[i].mData, size, size < requests[i].mSize);
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "common/IoUringReader.h"
+#include "common/Lock.h"
+#include "file_server/event/Event.h"
+#include "file_server/reader/LogFileReader.h"
+
+namespace logtail {
+
+class ModifyHandler;
+
+// ReaderWorkerPool offloads file reading from the LogInput thread. Each ModifyHandler is bound to exactly one
+// worker (shard), so all readers owned by the handler are still read by a single thread and the events of one
+// handler are handled in order. LogInput only routes events to the shards.
+// When file_reader_thread_count <= 1, the pool is disabled and events are handled inline as before.
+// With enable_file_reader_io_uring, each worker takes events in batch and reads ahead the files to be read with one
+// io_uring submission, the data is then consumed by LogFileReader::ReadFile in place of pread.
+class ReaderWorkerPool {
+public:
+    ReaderWorkerPool(const ReaderWorkerPool&) = delete;
+    ReaderWorkerPool& operator=(const ReaderWorkerPool&) = delete;
+
+    static ReaderWorkerPool* GetInstance() {
+        static ReaderWorkerPool instance;
+        return &instance;
+    }
+
+    void Start(uint32_t threadCount);
+    void Stop();
+    // called with LogInput held on, pending events are moved back to LogInput event queue since handlers may be
+    // destroyed before resuming.
+    void HoldOn();
+    void Resume();
+
+    void Dispatch(ModifyHandler* handler, const Event& event);
+    bool IsEnabled() const { return mEnabled; }
+    bool HasPendingEvents() const { return mPendingEventCnt.load() > 0; }
+    size_t GetThreadCount() const { return mShards.size(); }
+
+private:
+    struct Shard {
+        mutable std::mutex mMux;
+        std::condition_variable mCV;
+        std::deque<std::pair<ModifyHandler*, std::unique_ptr<Event>>> mQueue;
+        std::future<void> mThreadRes;
+    };
+
+    ReaderWorkerPool() = default;
+    ~ReaderWorkerPool() = default;
+
+    void Run(size_t idx);
+    void Prefetch(IoUringReader& ioUring,
+                  const std::vector<std::pair<ModifyHandler*, std::unique_ptr<Event>>>& batch,
+                  std::vector<LogFileReaderPtr>& readers);
+
+    std::vector<std::unique_ptr<Shard>> mShards;
+    std::atomic_bool mEnabled{false};
+    std::atomic_bool mIsStopped{false};
+    // events dispatched but not yet handled, including the ones being handled
+    std::atomic_size_t mPendingEventCnt{0};
+    // workers read under read lock, HoldOn takes write lock to wait for all in-flight events to finish
+    ReadWriteLock mWorkerRWL;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ReaderWorkerPoolUnittest;
+#endif
+};
+
+} // namespace logtail
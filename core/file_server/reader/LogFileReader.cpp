@@ -31,6 +31,7 @@
 #include "app_config/AppConfig.h"
 #include "checkpoint/CheckPointManager.h"
 #include "checkpoint/CheckpointManagerV2.h"
+#include "common/CharFinder.h"
 #include "common/ErrorUtil.h"
 #include "common/FileSystemUtil.h"
 #include "common/Flags.h"
@@ -736,8 +737,7 @@ void LogFileReader::FixLastFilePos(LogFileOperator& op, int64_t endOffset) {
         for (size_t endPs = 0; endPs < readSizeReal - 1; ++endPs) {
             if (readBuf[endPs] == '\n') {
                 LineInfo line = GetLastLine(StringView(readBuf, readSizeReal - 1), endPs, true);
-                if (BoostRegexSearch(
-                        line.data.data(), line.data.size(), *mMultilineConfig.first->GetStartPatternReg(), exception)) {
+                if (mMultilineConfig.first->GetStartPatternReg()->Search(line.data, exception)) {
                     mLastFilePos += line.lineBegin;
                     mCache.clear();
                     free(readBuf);
@@ -1913,7 +1913,22 @@ LogFileReader::ReadFile(LogFileOperator& op, void* buf, size_t size, int64_t& of
     //             GetRegion());
     //     }
     // } else {
-    nbytes = op.Pread(buf, 1, size, offset);
+    if (mPrefetchedData && offset == mPrefetchedOffset && &op == &mLogFileOp) {
+        // data has been read by batched reading, only the rest (if any) is read by pread
+        size_t prefetched = std::min(size, mPrefetchedSize);
+        bool toEnd = mPrefetchedToEnd;
+        memcpy(buf, mPrefetchedData, prefetched);
+        ClearPrefetchedData();
+        nbytes = static_cast<int>(prefetched);
+        if (prefetched < size && !toEnd) {
+            int rest = op.Pread((char*)buf + prefetched, 1, size - prefetched, offset + prefetched);
+            if (rest > 0) {
+                nbytes += rest;
+            }
+        }
+    } else {
+        nbytes = op.Pread(buf, 1, size, offset);
+    }
     if (nbytes < 0) {
         LOG_ERROR(sLogger,
                   ("Pread fail to read log file", mHostLogPath)("mLastFilePos", mLastFilePos)("size", size)("offset",
@@ -1926,6 +1941,23 @@ LogFileReader::ReadFile(LogFileOperator& op, void* buf, size_t size, int64_t& of
     return nbytes;
 }
 
+bool LogFileReader::GetNextReadRange(int& fd, int64_t& offset, size_t& size) const {
+    if (!mLogFileOp.IsOpen() || mEOOption) {
+        return false;
+    }
+    fd = mLogFileOp.GetFd();
+    offset = GetLastReadPos();
+    size = BUFFER_SIZE > mCache.size() ? BUFFER_SIZE - mCache.size() : 0;
+    return size > 0;
+}
+
+void LogFileReader::SetPrefetchedData(int64_t offset, const char* data, size_t size, bool reachEnd) {
+    mPrefetchedOffset = offset;
+    mPrefetchedData = data;
+    mPrefetchedSize = size;
+    mPrefetchedToEnd = reachEnd;
+}
+
 LogFileReader::FileCompareResult LogFileReader::CompareToFile(const string& filePath) {
     LogFileOperator logFileOp;
     logFileOp.Open(filePath.c_str());
@@ -2015,20 +2047,14 @@ LogFileReader::RemoveLastIncompleteLog(char* buffer, int32_t size, int32_t& roll
             LineInfo content = GetLastLine(StringView(buffer, size), endPs, false);
             if (mMultilineConfig.first->GetEndPatternReg()) {
                 // start + end, continue + end, end
-                if (BoostRegexSearch(content.data.data(),
-                                     content.data.size(),
-                                     *mMultilineConfig.first->GetEndPatternReg(),
-                                     exception)) {
+                if (mMultilineConfig.first->GetEndPatternReg()->Search(content.data, exception)) {
                     // Ensure the end line is complete
                     if (buffer[content.lineEnd] == '\n') {
                         return content.lineEnd + 1;
                     }
                 }
             } else if (mMultilineConfig.first->GetStartPatternReg()
-                       && BoostRegexSearch(content.data.data(),
-                                           content.data.size(),
-                                           *mMultilineConfig.first->GetStartPatternReg(),
-                                           exception)) {
+                       && mMultilineConfig.first->GetStartPatternReg()->Search(content.data, exception)) {
                 // start + continue, start
                 rollbackLineFeedCount += content.rollbackLineFeedCount;
                 // Keep all the buffer if rollback all
@@ -2197,17 +2223,10 @@ LineInfo RawTextParser::GetLastLine(StringView buffer,
         return {.data = StringView(), .lineBegin = 0, .lineEnd = 0, .rollbackLineFeedCount = 0, .fullLine = false};
     }
 
-    for (int32_t begin = end; begin > 0; --begin) {
-        if (begin == 0 || buffer[begin - 1] == '\n') {
-            return {.data = StringView(buffer.data() + begin, end - begin),
-                    .lineBegin = begin,
-                    .lineEnd = end,
-                    .rollbackLineFeedCount = 1,
-                    .fullLine = true};
-        }
-    }
-    return {.data = StringView(buffer.data(), end),
-            .lineBegin = 0,
+    size_t pos = FindLastChar(buffer.data(), end, '\n');
+    int32_t begin = pos == static_cast<size_t>(end) ? 0 : static_cast<int32_t>(pos) + 1;
+    return {.data = StringView(buffer.data() + begin, end - begin),
+            .lineBegin = begin,
             .lineEnd = end,
             .rollbackLineFeedCount = 1,
             .fullLine = true};
@@ -2472,6 +2491,7 @@ void LogFileReader::SetEventGroupMetaAndTag(PipelineEventGroup& group) {
 PipelineEventGroup LogFileReader::GenerateEventGroup(LogFileReaderPtr reader, LogBuffer* logBuffer) {
     PipelineEventGroup group{std::shared_ptr<SourceBuffer>(std::move(logBuffer->sourcebuffer))};
     reader->SetEventGroupMetaAndTag(group);
+    group.SetMetadataTime(EventGroupMetaKey::READ_TIMESTAMP_MICROSEC, std::chrono::system_clock::now());
 
     LogEvent* event = group.AddLogEvent();
     time_t logtime = time(nullptr);
@@ -337,6 +337,13 @@ public:
 
     bool HasDataInCache() const { return mCache.size(); }
 
+    // batched reading: the range to be read next, returns false if the file is not opened.
+    bool GetNextReadRange(int& fd, int64_t& offset, size_t& size) const;
+    // data read ahead by batched reading, used by ReadFile instead of pread if the offset matches. reachEnd means
+    // the file had no more data when read ahead. data must be kept valid until ClearPrefetchedData is called.
+    void SetPrefetchedData(int64_t offset, const char* data, size_t size, bool reachEnd);
+    void ClearPrefetchedData() { SetPrefetchedData(-1, nullptr, 0, false); }
+
     LogFileReaderPtrArray* GetReaderArray();
 
     void SetReaderArray(LogFileReaderPtrArray* readerArray);
@@ -508,6 +515,10 @@ protected:
     // bool mMarkOffsetFlag = false;
     // std::string mTimeFormat; // for backward reading
     LogFileOperator mLogFileOp; // encapsulate fuse & non-fuse mode
+    int64_t mPrefetchedOffset = -1;
+    const char* mPrefetchedData = nullptr;
+    size_t mPrefetchedSize = 0;
+    bool mPrefetchedToEnd = false;
     // std::string mFuseTrimedFilename;
     LogFileReaderPtrArray* mReaderArray = nullptr;
     // uint64_t mLogstoreKey;
@@ -16,17 +16,70 @@
 #include <chrono>
 #include <ctime>
 #include <thread>
+#include <utility>
 
 #include "common/MachineInfoUtil.h"
+#include "common/http/AsynCurlRunner.h"
 #include "common/http/Curl.h"
 #include "common/http/HttpRequest.h"
 #include "common/http/HttpResponse.h"
 #include "logger/Logger.h"
 
+DEFINE_FLAG_INT32(k8s_meta_negative_cache_ttl_sec,
+                  "keys not found in k8s meta service or failed to fetch are not requested again within the ttl",
+                  60);
+
 using namespace std;
 
 namespace logtail {
 
+static const uint32_t kOperatorRequestTimeoutSecs = 30;
+static const uint32_t kOperatorRequestMaxTryCnt = 3;
+
+static string GetOperatorPath(containerInfoType infoType) {
+    return infoType == containerInfoType::IpInfo ? "/metadata/ip" : "/metadata/containerid";
+}
+
+static string BuildOperatorRequestBody(const vector<string>& keys) {
+    Json::Value jsonObj;
+    for (const auto& str : keys) {
+        jsonObj["keys"].append(str);
+    }
+    Json::StreamWriterBuilder writer;
+    return Json::writeString(writer, jsonObj);
+}
+
+class K8sMetadataHttpRequest : public AsynHttpRequest {
+public:
+    K8sMetadataHttpRequest(const string& host,
+                           int32_t port,
+                           const string& body,
+                           vector<string>&& keys,
+                           containerInfoType infoType)
+        : AsynHttpRequest("GET",
+                          false,
+                          host,
+                          port,
+                          GetOperatorPath(infoType),
+                          "",
+                          map<string, string>(),
+                          body,
+                          HttpResponse(),
+                          kOperatorRequestTimeoutSecs,
+                          kOperatorRequestMaxTryCnt),
+          mKeys(std::move(keys)),
+          mInfoType(infoType) {}
+
+    bool IsContextValid() const override { return true; }
+    void OnSendDone(HttpResponse& response) override {
+        K8sMetadata::GetInstance().OnAsyncRequestDone(mKeys, mInfoType, response);
+    }
+
+private:
+    vector<string> mKeys;
+    containerInfoType mInfoType;
+};
+
 size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     ((std::string*)userp)->append((char*)contents, size * nmemb);
     return size * nmemb;
@@ -93,57 +146,143 @@ bool K8sMetadata::FromContainerJson(const Json::Value& json, std::shared_ptr<Con
     return true;
 }
 
+bool K8sMetadata::HandleOperatorResponse(HttpResponse& res, containerInfoType infoType) {
+    if (res.GetStatusCode() != 200) {
+        LOG_DEBUG(sLogger, ("fetch k8s meta from one operator fail, code is ", res.GetStatusCode()));
+        return false;
+    }
+    Json::CharReaderBuilder readerBuilder;
+    std::unique_ptr<Json::CharReader> reader(readerBuilder.newCharReader());
+    Json::Value root;
+    std::string errors;
+
+    auto& responseBody = *res.GetBody<std::string>();
+    if (!reader->parse(responseBody.c_str(), responseBody.c_str() + responseBody.size(), &root, &errors)) {
+        LOG_DEBUG(sLogger, ("JSON parse error:", errors));
+        return false;
+    }
+    if (infoType == containerInfoType::ContainerIdInfo) {
+        SetContainerCache(root);
+    } else {
+        SetIpCache(root);
+    }
+    return true;
+}
+
 bool K8sMetadata::SendRequestToOperator(const std::string& urlHost,
                                         const std::string& output,
                                         containerInfoType infoType) {
     std::unique_ptr<HttpRequest> request;
     HttpResponse res;
-    std::string path = "/metadata/containerid";
-    if (infoType == containerInfoType::IpInfo) {
-        path = "/metadata/ip";
-    }
-    request = std::make_unique<HttpRequest>(
-        "GET", false, mServiceHost, mServicePort, path, "", map<std::string, std::string>(), output, 30, 3);
+    request = std::make_unique<HttpRequest>("GET",
+                                            false,
+                                            mServiceHost,
+                                            mServicePort,
+                                            GetOperatorPath(infoType),
+                                            "",
+                                            map<std::string, std::string>(),
+                                            output,
+                                            kOperatorRequestTimeoutSecs,
+                                            kOperatorRequestMaxTryCnt);
     bool success = SendHttpRequest(std::move(request), res);
     if (success) {
-        if (res.GetStatusCode() != 200) {
-            LOG_DEBUG(sLogger, ("fetch k8s meta from one operator fail, code is ", res.GetStatusCode()));
-            return false;
+        return HandleOperatorResponse(res, infoType);
+    } else {
+        LOG_DEBUG(sLogger, ("fetch k8s meta from one operator fail", urlHost));
+        return false;
+    }
+}
+
+bool K8sMetadata::IsCached(const std::string& key, containerInfoType infoType) {
+    return infoType == containerInfoType::ContainerIdInfo ? containerCache.contains(key) : ipCache.contains(key);
+}
+
+void K8sMetadata::AsyncSendRequestToOperator(const std::vector<std::string>& keys, containerInfoType infoType) {
+    std::vector<std::string> keysToFetch;
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mFetchStateMux);
+        auto& pendingKeys = mPendingKeys[static_cast<size_t>(infoType)];
+        auto& negativeCache = mNegativeCache[static_cast<size_t>(infoType)];
+        for (const auto& key : keys) {
+            if (key.empty() || pendingKeys.find(key) != pendingKeys.end()) {
+                continue;
+            }
+            auto iter = negativeCache.find(key);
+            if (iter != negativeCache.end()) {
+                if (iter->second > now) {
+                    continue;
+                }
+                negativeCache.erase(iter);
+            }
+            pendingKeys.insert(key);
+            keysToFetch.push_back(key);
         }
-        Json::CharReaderBuilder readerBuilder;
-        Json::CharReader* reader = readerBuilder.newCharReader();
-        Json::Value root;
-        std::string errors;
-
-        auto& responseBody = *res.GetBody<std::string>();
-        if (reader->parse(responseBody.c_str(), responseBody.c_str() + responseBody.size(), &root, &errors)) {
-            if (infoType == containerInfoType::ContainerIdInfo) {
-                SetContainerCache(root);
+        if (!keysToFetch.empty() && !mIsCurlRunnerStarted) {
+            mIsCurlRunnerStarted = AsynCurlRunner::GetInstance()->Init();
+        }
+    }
+    if (keysToFetch.empty()) {
+        return;
+    }
+    std::string body = BuildOperatorRequestBody(keysToFetch);
+    AsynCurlRunner::GetInstance()->AddRequest(
+        std::make_unique<K8sMetadataHttpRequest>(mServiceHost, mServicePort, body, std::move(keysToFetch), infoType));
+}
+
+void K8sMetadata::Stop() {
+    bool isCurlRunnerStarted = false;
+    {
+        // not held while stopping, since pending requests call OnAsyncRequestDone on the runner thread
+        std::lock_guard<std::mutex> lock(mFetchStateMux);
+        std::swap(isCurlRunnerStarted, mIsCurlRunnerStarted);
+    }
+    if (isCurlRunnerStarted) {
+        AsynCurlRunner::GetInstance()->Stop();
+    }
+}
+
+void K8sMetadata::OnAsyncRequestDone(const std::vector<std::string>& keys,
+                                     containerInfoType infoType,
+                                     HttpResponse& response) {
+    bool success = response.GetNetworkStatus().mCode == NetworkCode::Ok && HandleOperatorResponse(response, infoType);
+    if (!success) {
+        LOG_DEBUG(sLogger, ("fetch k8s meta from operator fail", mServiceHost)("keys count", keys.size()));
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto expireTime = now + std::chrono::seconds(INT32_FLAG(k8s_meta_negative_cache_ttl_sec));
+    std::lock_guard<std::mutex> lock(mFetchStateMux);
+    auto& pendingKeys = mPendingKeys[static_cast<size_t>(infoType)];
+    auto& negativeCache = mNegativeCache[static_cast<size_t>(infoType)];
+    for (const auto& key : keys) {
+        pendingKeys.erase(key);
+        if (!success || !IsCached(key, infoType)) {
+            negativeCache[key] = expireTime;
+        }
+    }
+    if (negativeCache.size() > mCacheSize) {
+        for (auto iter = negativeCache.begin(); iter != negativeCache.end();) {
+            if (iter->second <= now) {
+                iter = negativeCache.erase(iter);
             } else {
-                SetIpCache(root);
+                ++iter;
             }
-        } else {
-            LOG_DEBUG(sLogger, ("JSON parse error:", errors));
-            delete reader;
-            return false;
         }
-
-        delete reader;
-        return true;
-    } else {
-        LOG_DEBUG(sLogger, ("fetch k8s meta from one operator fail", urlHost));
-        return false;
     }
 }
 
+void K8sMetadata::AsyncGetByContainerIdsFromServer(const std::vector<std::string>& containerIds) {
+    AsyncSendRequestToOperator(containerIds, containerInfoType::ContainerIdInfo);
+}
+
+void K8sMetadata::AsyncGetByIpsFromServer(const std::vector<std::string>& ips) {
+    AsyncSendRequestToOperator(ips, containerInfoType::IpInfo);
+}
+
 bool K8sMetadata::GetByContainerIdsFromServer(std::vector<std::string> containerIds) {
-    Json::Value jsonObj;
-    for (auto& str : containerIds) {
-        jsonObj["keys"].append(str);
-    }
-    Json::StreamWriterBuilder writer;
-    std::string output = Json::writeString(writer, jsonObj);
-    return SendRequestToOperator(mServiceHost, output, containerInfoType::ContainerIdInfo);
+    return SendRequestToOperator(
+        mServiceHost, BuildOperatorRequestBody(containerIds), containerInfoType::ContainerIdInfo);
 }
 
 void K8sMetadata::GetByLocalHostFromServer() {
@@ -189,14 +328,7 @@ void K8sMetadata::SetIpCache(const Json::Value& root) {
 }
 
 bool K8sMetadata::GetByIpsFromServer(std::vector<std::string> ips) {
-    Json::Value jsonObj;
-    for (auto& str : ips) {
-        jsonObj["keys"].append(str);
-    }
-    Json::StreamWriterBuilder writer;
-    std::string output = Json::writeString(writer, jsonObj);
-    std::string urlHost = mServiceHost;
-    return SendRequestToOperator(urlHost, output, containerInfoType::IpInfo);
+    return SendRequestToOperator(mServiceHost, BuildOperatorRequestBody(ips), containerInfoType::IpInfo);
 }
 
 std::shared_ptr<k8sContainerInfo> K8sMetadata::GetInfoByContainerIdFromCache(const std::string& containerId) {
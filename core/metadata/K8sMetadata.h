@@ -11,13 +11,19 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific l
 #pragma once
+#include <chrono>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <curl/curl.h>
 #include "common/LRUCache.h"
 #include "app_config/AppConfig.h"
 #include <json/json.h>
 #include "common/Flags.h"
+#include "common/http/HttpResponse.h"
 
 DECLARE_FLAG_STRING(loong_collector_operator_service);
 DECLARE_FLAG_INT32(loong_collector_k8s_meta_service_port);
@@ -55,12 +61,24 @@ namespace logtail {
 
     class K8sMetadata {
         private:
-            lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>> containerCache;
-            lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>> ipCache;
+            // the caches are updated by the async curl runner thread, so they must be thread-safe
+            lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>, std::mutex> containerCache;
+            lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>, std::mutex> ipCache;
             std::string mServiceHost;
             int32_t mServicePort;
+            size_t mCacheSize;
+
+            // keys being fetched asynchronously and keys not found recently (with expire time), which are not
+            // requested again, so that lookups for the same keys are coalesced and an unavailable operator is not
+            // flooded with requests
+            std::mutex mFetchStateMux;
+            std::unordered_set<std::string> mPendingKeys[2];
+            std::unordered_map<std::string, std::chrono::steady_clock::time_point> mNegativeCache[2];
+            // whether the async curl runner has been started by the first async request, guarded by mFetchStateMux
+            bool mIsCurlRunnerStarted = false;
+
             K8sMetadata(size_t cacheSize)
-              : containerCache(cacheSize, 0), ipCache(cacheSize, 0){
+              : containerCache(cacheSize, 0), ipCache(cacheSize, 0), mCacheSize(cacheSize){
                 mServiceHost = STRING_FLAG(loong_collector_operator_service);
                 mServicePort = INT32_FLAG(loong_collector_k8s_meta_service_port);
               }
@@ -71,6 +89,9 @@ namespace logtail {
             void SetContainerCache(const Json::Value& root);
             bool FromInfoJson(const Json::Value& json, k8sContainerInfo& info);
             bool FromContainerJson(const Json::Value& json, std::shared_ptr<ContainerData> data);
+            bool HandleOperatorResponse(HttpResponse& res, containerInfoType infoType);
+            void AsyncSendRequestToOperator(const std::vector<std::string>& keys, containerInfoType infoType);
+            bool IsCached(const std::string& key, containerInfoType infoType);
 
         public:
             static K8sMetadata& GetInstance() {
@@ -87,6 +108,16 @@ namespace logtail {
             // get info by ip from cache
             std::shared_ptr<k8sContainerInfo> GetInfoByIpFromCache(const std::string& ip);
             bool SendRequestToOperator(const std::string& urlHost, const std::string& output, containerInfoType infoType);
+            // non-blocking versions of GetBy*FromServer, the caches are updated when the response arrives. keys being
+            // fetched or not found recently are skipped.
+            void AsyncGetByContainerIdsFromServer(const std::vector<std::string>& containerIds);
+            void AsyncGetByIpsFromServer(const std::vector<std::string>& ips);
+            // stops the async curl runner if it is started by async requests
+            void Stop();
+            // called by the async curl runner thread when the request for @keys is done
+            void OnAsyncRequestDone(const std::vector<std::string>& keys,
+                                    containerInfoType infoType,
+                                    HttpResponse& response);
     
     #ifdef APSARA_UNIT_TEST_MAIN
         friend class k8sMetadataUnittest;
@@ -37,23 +37,18 @@ void LabelingK8sMetadata::AddLabelToLogGroup(PipelineEventGroup& logGroup) {
     EventsContainer& events = logGroup.MutableEvents();
     std::vector<std::string> containerVec;
     std::vector<std::string> remoteIpVec;
-    std::vector<size_t>  cotainerNotTag;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (!ProcessEvent(events[rIdx], containerVec, remoteIpVec)) {
-            cotainerNotTag.push_back(rIdx);
-        }
+        ProcessEvent(events[rIdx], containerVec, remoteIpVec);
     }
+    // fetching metadata must not block the processor thread. events not labeled are sent as is, and events of the same
+    // containers or ips in later batches will be labeled once the metadata is fetched.
     auto& k8sMetadata = K8sMetadata::GetInstance();
-    if (containerVec.empty() || (!k8sMetadata.GetByContainerIdsFromServer(containerVec))) {
-        return;
-    }
-    if (remoteIpVec.empty() || (!k8sMetadata.GetByIpsFromServer(remoteIpVec))) {
-        return;
+    if (!containerVec.empty()) {
+        k8sMetadata.AsyncGetByContainerIdsFromServer(containerVec);
     }
-    for (size_t i = 0; i < cotainerNotTag.size(); ++i) {
-        ProcessEvent(events[i], containerVec, remoteIpVec);
+    if (!remoteIpVec.empty()) {
+        k8sMetadata.AsyncGetByIpsFromServer(remoteIpVec);
     }
-    return;
 }
 
 bool LabelingK8sMetadata::ProcessEvent(PipelineEventPtr& e, std::vector<std::string>& containerVec, std::vector<std::string>& remoteIpVec) {
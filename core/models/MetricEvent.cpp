@@ -102,6 +102,12 @@ Json::Value MetricEvent::ToJson(bool enableEventMeta) const {
             } else if constexpr (is_same_v<T, UntypedMultiDoubleValues>) {
                 root["value"]["type"] = "untyped_multi_double_values";
                 root["value"]["detail"] = get<UntypedMultiDoubleValues>(mValue).ToJson();
+            } else if constexpr (is_same_v<T, HistogramValue>) {
+                root["value"]["type"] = "histogram";
+                root["value"]["detail"] = get<HistogramValue>(mValue).ToJson();
+            } else if constexpr (is_same_v<T, SummaryValue>) {
+                root["value"]["type"] = "summary";
+                root["value"]["detail"] = get<SummaryValue>(mValue).ToJson();
             } else if constexpr (is_same_v<T, monostate>) {
                 root["value"]["type"] = "unknown";
             }
@@ -132,6 +138,14 @@ bool MetricEvent::FromJson(const Json::Value& root) {
         UntypedMultiDoubleValues v(this);
         v.FromJson(value["detail"]);
         SetValue(v);
+    } else if (value["type"].asString() == "histogram") {
+        HistogramValue v;
+        v.FromJson(value["detail"]);
+        SetValue(v);
+    } else if (value["type"].asString() == "summary") {
+        SummaryValue v;
+        v.FromJson(value["detail"]);
+        SetValue(v);
     }
     if (root.isMember("tags")) {
         Json::Value tags = root["tags"];
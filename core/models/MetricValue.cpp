@@ -16,6 +16,10 @@
 
 #include "models/MetricValue.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
 using namespace std;
 
 namespace logtail {
@@ -89,6 +93,19 @@ size_t DataSize(const MetricValue& value) {
         value);
 }
 
+string FormatPromFloat(double value) {
+    if (isnan(value)) {
+        return "NaN";
+    }
+    if (isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    // shortest representation that round trips, same as strconv.FormatFloat(value, 'g', -1, 64) in most cases
+    char buf[32];
+    auto res = to_chars(buf, buf + sizeof(buf), value);
+    return string(buf, res.ptr - buf);
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 Json::Value UntypedSingleValue::ToJson() const {
     return Json::Value(mValue);
@@ -114,6 +131,48 @@ void UntypedMultiDoubleValues::FromJson(const Json::Value& value) {
         }
     }
 }
+
+Json::Value HistogramValue::ToJson() const {
+    Json::Value res;
+    res["sum"] = mSum;
+    res["count"] = mCount;
+    res["buckets"] = Json::Value(Json::objectValue);
+    for (const auto& bucket : mBuckets) {
+        res["buckets"][FormatPromFloat(bucket.first)] = bucket.second;
+    }
+    return res;
+}
+
+void HistogramValue::FromJson(const Json::Value& value) {
+    mSum = value["sum"].asDouble();
+    mCount = value["count"].asDouble();
+    mBuckets.clear();
+    for (const auto& key : value["buckets"].getMemberNames()) {
+        mBuckets.emplace_back(stod(key), value["buckets"][key].asDouble());
+    }
+    sort(mBuckets.begin(), mBuckets.end());
+}
+
+Json::Value SummaryValue::ToJson() const {
+    Json::Value res;
+    res["sum"] = mSum;
+    res["count"] = mCount;
+    res["quantiles"] = Json::Value(Json::objectValue);
+    for (const auto& quantile : mQuantiles) {
+        res["quantiles"][FormatPromFloat(quantile.first)] = quantile.second;
+    }
+    return res;
+}
+
+void SummaryValue::FromJson(const Json::Value& value) {
+    mSum = value["sum"].asDouble();
+    mCount = value["count"].asDouble();
+    mQuantiles.clear();
+    for (const auto& key : value["quantiles"].getMemberNames()) {
+        mQuantiles.emplace_back(stod(key), value["quantiles"][key].asDouble());
+    }
+    sort(mQuantiles.begin(), mQuantiles.end());
+}
 #endif
 
 } // namespace logtail
@@ -17,7 +17,10 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #ifdef APSARA_UNIT_TEST_MAIN
 #include <json/json.h>
@@ -71,8 +74,44 @@ struct UntypedMultiDoubleValues {
 #endif
 };
 
-using MetricValue = std::variant<std::monostate, UntypedSingleValue, UntypedMultiDoubleValues>;
+// classic prometheus histogram of one series, which is exposed as one sample per bucket plus _sum and _count
+struct HistogramValue {
+    // upper bound and cumulative count of each bucket, sorted by upper bound
+    std::vector<std::pair<double, double>> mBuckets;
+    double mSum = 0.0;
+    double mCount = 0.0;
+
+    size_t SampleCnt() const { return mBuckets.size() + 2; }
+    size_t DataSize() const { return sizeof(HistogramValue) + mBuckets.size() * sizeof(std::pair<double, double>); }
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    Json::Value ToJson() const;
+    void FromJson(const Json::Value& value);
+#endif
+};
+
+// prometheus summary of one series, which is exposed as one sample per quantile plus _sum and _count
+struct SummaryValue {
+    // quantile and its value, sorted by quantile
+    std::vector<std::pair<double, double>> mQuantiles;
+    double mSum = 0.0;
+    double mCount = 0.0;
+
+    size_t SampleCnt() const { return mQuantiles.size() + 2; }
+    size_t DataSize() const { return sizeof(SummaryValue) + mQuantiles.size() * sizeof(std::pair<double, double>); }
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    Json::Value ToJson() const;
+    void FromJson(const Json::Value& value);
+#endif
+};
+
+using MetricValue
+    = std::variant<std::monostate, UntypedSingleValue, UntypedMultiDoubleValues, HistogramValue, SummaryValue>;
 
 size_t DataSize(const MetricValue& value);
 
+// formats bucket bounds and quantiles as prometheus does, e.g. 0.005, 1e+06 and +Inf
+std::string FormatPromFloat(double value);
+
 } // namespace logtail
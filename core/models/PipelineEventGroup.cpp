@@ -16,6 +16,8 @@
 
 #include "models/PipelineEventGroup.h"
 
+#include <charconv>
+
 #ifdef APSARA_UNIT_TEST_MAIN
 #include <sstream>
 #endif
@@ -255,6 +257,22 @@ void PipelineEventGroup::SetMetadataNoCopy(EventGroupMetaKey key, StringView val
     mMetadata[key] = val;
 }
 
+void PipelineEventGroup::SetMetadataTime(EventGroupMetaKey key, chrono::system_clock::time_point val) {
+    SetMetadata(key, to_string(chrono::duration_cast<chrono::microseconds>(val.time_since_epoch()).count()));
+}
+
+chrono::system_clock::time_point PipelineEventGroup::GetMetadataTime(EventGroupMetaKey key) const {
+    auto it = mMetadata.find(key);
+    if (it == mMetadata.end()) {
+        return chrono::system_clock::time_point();
+    }
+    int64_t val = 0;
+    if (from_chars(it->second.data(), it->second.data() + it->second.size(), val).ec != errc()) {
+        return chrono::system_clock::time_point();
+    }
+    return chrono::system_clock::time_point(chrono::microseconds(val));
+}
+
 StringView PipelineEventGroup::GetMetadata(EventGroupMetaKey key) const {
     auto it = mMetadata.find(key);
     if (it != mMetadata.end()) {
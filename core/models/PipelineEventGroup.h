@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -59,7 +60,11 @@ enum class EventGroupMetaKey {
     PROMETHEUS_SCRAPE_TIMESTAMP_MILLISEC,
     PROMETHEUS_UP_STATE,
 
-    SOURCE_ID
+    SOURCE_ID,
+
+    // for latency statistics, in microseconds since epoch
+    READ_TIMESTAMP_MICROSEC,
+    PROCESS_TIMESTAMP_MICROSEC
 };
 
 using GroupMetadata = std::map<EventGroupMetaKey, StringView>;
@@ -104,6 +109,9 @@ public:
     void SetMetadataNoCopy(EventGroupMetaKey key, StringView val);
     void DelMetadata(EventGroupMetaKey key);
     void SetAllMetadata(const GroupMetadata& other) { mMetadata = other; }
+    void SetMetadataTime(EventGroupMetaKey key, std::chrono::system_clock::time_point val);
+    // return epoch if not set
+    std::chrono::system_clock::time_point GetMetadataTime(EventGroupMetaKey key) const;
 
     void SetTag(StringView key, StringView val);
     void SetTag(const std::string& key, const std::string& val);
@@ -62,6 +62,15 @@ const string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL = "buffered_groups_t
 const string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL = "buffered_events_total";
 const string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES = "buffered_size_bytes";
 const string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS = "total_add_time_ms";
+const string METRIC_COMPONENT_BATCHER_BATCH_LATENCY_MS = "batch_latency_ms";
+const string METRIC_COMPONENT_BATCHER_PROCESS_TO_FLUSH_LATENCY_MS = "process_to_flush_latency_ms";
+
+/**********************************************************
+ *   compressor
+ **********************************************************/
+const string METRIC_COMPONENT_COMPRESSOR_TOTAL_CPU_TIME_MS = "total_cpu_time_ms";
+const string METRIC_COMPONENT_COMPRESSOR_COMPRESSION_RATIO = "compression_ratio";
+const string METRIC_COMPONENT_COMPRESSOR_CPU_TIME_PER_MB_MS = "cpu_time_per_mb_ms";
 
 /**********************************************************
  *   queue
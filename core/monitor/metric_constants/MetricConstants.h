@@ -57,6 +57,8 @@ extern const std::string METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL;
 extern const std::string METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES;
 extern const std::string METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS;
+extern const std::string METRIC_PIPELINE_PROCESSORS_PROCESS_LATENCY_MS;
+extern const std::string METRIC_PIPELINE_READ_TO_PROCESS_LATENCY_MS;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES;
@@ -108,6 +110,8 @@ extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TOTAL;
 extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TIME_MS;
 extern const std::string METRIC_PLUGIN_PROM_SCRAPE_TIME_MS;
 extern const std::string METRIC_PLUGIN_PROM_SCRAPE_DELAY_TOTAL;
+extern const std::string METRIC_PLUGIN_PROM_RELABEL_CACHE_HIT_TOTAL;
+extern const std::string METRIC_PLUGIN_PROM_RELABEL_CACHE_MISS_TOTAL;
 
 /**********************************************************
  *   input_ebpf
@@ -159,6 +163,8 @@ extern const std::string METRIC_PLUGIN_OUT_SUCCESSFUL_EVENTS_TOTAL;
  *   all flusher （所有发送插件通用指标）
  **********************************************************/
 extern const std::string METRIC_PLUGIN_FLUSHER_TOTAL_PACKAGE_TIME_MS;
+extern const std::string METRIC_PLUGIN_FLUSHER_FLUSH_TO_SEND_DONE_LATENCY_MS;
+extern const std::string METRIC_PLUGIN_FLUSHER_READ_TO_SEND_DONE_LATENCY_MS;
 extern const std::string METRIC_PLUGIN_FLUSHER_OUT_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PLUGIN_FLUSHER_SEND_DONE_TOTAL;
 extern const std::string METRIC_PLUGIN_FLUSHER_SUCCESS_TOTAL;
@@ -240,6 +246,15 @@ extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS;
+extern const std::string METRIC_COMPONENT_BATCHER_BATCH_LATENCY_MS;
+extern const std::string METRIC_COMPONENT_BATCHER_PROCESS_TO_FLUSH_LATENCY_MS;
+
+/**********************************************************
+ *   compressor
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_COMPRESSOR_TOTAL_CPU_TIME_MS;
+extern const std::string METRIC_COMPONENT_COMPRESSOR_COMPRESSION_RATIO;
+extern const std::string METRIC_COMPONENT_COMPRESSOR_CPU_TIME_PER_MB_MS;
 
 /**********************************************************
  *   queue
@@ -296,6 +311,15 @@ extern const std::string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_
 extern const std::string METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS;
 extern const std::string METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_SEND_CONCURRENCY;
+extern const std::string METRIC_RUNNER_SINK_HANDLER_POOL_HIT_RATE;
+extern const std::string METRIC_RUNNER_SINK_POOLED_HANDLERS_TOTAL;
+extern const std::string METRIC_RUNNER_SINK_NEW_CONNECTIONS_TOTAL;
+extern const std::string METRIC_RUNNER_SINK_RESPONSE_LATENCY_MS;
+
+/**********************************************************
+ *   processor runner
+ **********************************************************/
+extern const std::string METRIC_RUNNER_PROCESSOR_QUEUE_WAIT_LATENCY_MS;
 
 /**********************************************************
  *   flusher runner
@@ -60,6 +60,8 @@ const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TOTAL = "prom_subscribe_total";
 const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TIME_MS = "prom_subscribe_time_ms";
 const std::string METRIC_PLUGIN_PROM_SCRAPE_TIME_MS = "prom_scrape_time_ms";
 const std::string METRIC_PLUGIN_PROM_SCRAPE_DELAY_TOTAL = "prom_scrape_delay_total";
+const std::string METRIC_PLUGIN_PROM_RELABEL_CACHE_HIT_TOTAL = "prom_relabel_cache_hit_total";
+const std::string METRIC_PLUGIN_PROM_RELABEL_CACHE_MISS_TOTAL = "prom_relabel_cache_miss_total";
 
 /**********************************************************
  *   input_ebpf
@@ -137,6 +139,8 @@ const string METRIC_PLUGIN_PARSE_STDOUT_TOTAL = "parse_stdout_total";
  *   all flusher （所有发送插件通用指标）
  **********************************************************/
 const string METRIC_PLUGIN_FLUSHER_TOTAL_PACKAGE_TIME_MS = "total_package_time_ms";
+const string METRIC_PLUGIN_FLUSHER_FLUSH_TO_SEND_DONE_LATENCY_MS = "flush_to_send_done_latency_ms";
+const string METRIC_PLUGIN_FLUSHER_READ_TO_SEND_DONE_LATENCY_MS = "read_to_send_done_latency_ms";
 const string METRIC_PLUGIN_FLUSHER_OUT_EVENT_GROUPS_TOTAL = "send_total";
 const string METRIC_PLUGIN_FLUSHER_SEND_DONE_TOTAL = "send_done_total";
 const string METRIC_PLUGIN_FLUSHER_SUCCESS_TOTAL = "success_total";
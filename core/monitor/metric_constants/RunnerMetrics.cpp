@@ -52,6 +52,15 @@ const string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS = "succes
 const string METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS = "failed_response_time_ms";
 const string METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL = "sending_items_total";
 const string METRIC_RUNNER_SINK_SEND_CONCURRENCY = "send_concurrency";
+const string METRIC_RUNNER_SINK_HANDLER_POOL_HIT_RATE = "handler_pool_hit_rate";
+const string METRIC_RUNNER_SINK_POOLED_HANDLERS_TOTAL = "pooled_handlers_total";
+const string METRIC_RUNNER_SINK_NEW_CONNECTIONS_TOTAL = "new_connections_total";
+const string METRIC_RUNNER_SINK_RESPONSE_LATENCY_MS = "response_latency_ms";
+
+/**********************************************************
+ *   processor runner
+ **********************************************************/
+const string METRIC_RUNNER_PROCESSOR_QUEUE_WAIT_LATENCY_MS = "queue_wait_latency_ms";
 
 /**********************************************************
  *   flusher runner
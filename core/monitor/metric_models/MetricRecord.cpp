@@ -54,6 +54,12 @@ DoubleGaugePtr MetricsRecord::CreateDoubleGauge(const std::string& name) {
     return gaugePtr;
 }
 
+HistogramPtr MetricsRecord::CreateHistogram(const std::string& name) {
+    HistogramPtr histogramPtr = std::make_shared<Histogram>(name);
+    mHistograms.emplace_back(histogramPtr);
+    return histogramPtr;
+}
+
 void MetricsRecord::MarkDeleted() {
     mDeleted = true;
 }
@@ -90,6 +96,10 @@ const std::vector<DoubleGaugePtr>& MetricsRecord::GetDoubleGauges() const {
     return mDoubleGauges;
 }
 
+const std::vector<HistogramPtr>& MetricsRecord::GetHistograms() const {
+    return mHistograms;
+}
+
 MetricsRecord* MetricsRecord::Collect() {
     MetricsRecord* metrics = new MetricsRecord(mCategory, mLabels, mDynamicLabels);
     for (auto& item : mCounters) {
@@ -108,6 +118,10 @@ MetricsRecord* MetricsRecord::Collect() {
         DoubleGaugePtr newPtr(item->Collect());
         metrics->mDoubleGauges.emplace_back(newPtr);
     }
+    for (auto& item : mHistograms) {
+        HistogramPtr newPtr(item->Collect());
+        metrics->mHistograms.emplace_back(newPtr);
+    }
     return metrics;
 }
 
@@ -157,6 +171,10 @@ DoubleGaugePtr MetricsRecordRef::CreateDoubleGauge(const std::string& name) {
     return mMetrics->CreateDoubleGauge(name);
 }
 
+HistogramPtr MetricsRecordRef::CreateHistogram(const std::string& name) {
+    return mMetrics->CreateHistogram(name);
+}
+
 const MetricsRecord* MetricsRecordRef::operator->() const {
     return mMetrics;
 }
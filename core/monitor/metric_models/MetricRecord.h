@@ -39,6 +39,7 @@ private:
     std::vector<TimeCounterPtr> mTimeCounters;
     std::vector<IntGaugePtr> mIntGauges;
     std::vector<DoubleGaugePtr> mDoubleGauges;
+    std::vector<HistogramPtr> mHistograms;
 
     std::atomic_bool mDeleted;
     MetricsRecord* mNext = nullptr;
@@ -55,10 +56,12 @@ public:
     const std::vector<TimeCounterPtr>& GetTimeCounters() const;
     const std::vector<IntGaugePtr>& GetIntGauges() const;
     const std::vector<DoubleGaugePtr>& GetDoubleGauges() const;
+    const std::vector<HistogramPtr>& GetHistograms() const;
     CounterPtr CreateCounter(const std::string& name);
     TimeCounterPtr CreateTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    HistogramPtr CreateHistogram(const std::string& name);
     MetricsRecord* Collect();
     void SetNext(MetricsRecord* next);
     MetricsRecord* GetNext() const;
@@ -87,6 +90,7 @@ public:
     TimeCounterPtr CreateTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    HistogramPtr CreateHistogram(const std::string& name);
     const MetricsRecord* operator->() const;
     // this is not thread-safe, and should be only used before WriteMetrics::CommitMetricsRecordRef
     void AddLabels(MetricLabels&& labels);
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -24,6 +25,10 @@
 #include <string>
 #include <vector>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include "protobuf/sls/sls_logs.pb.h"
 
 namespace logtail {
@@ -33,28 +38,100 @@ enum class MetricType {
     METRIC_TYPE_TIME_COUNTER,
     METRIC_TYPE_INT_GAUGE,
     METRIC_TYPE_DOUBLE_GAUGE,
+    METRIC_TYPE_HISTOGRAM,
 };
 
+// counters may be updated by all processor and flusher threads. a counter starts with a single value, which is only
+// updated by the first thread adding to it. once another thread adds to it, the counter is considered hot and its
+// value is split into shards allocated then, each of which occupies a whole cache line and is mostly updated by one
+// thread only. the value and the shards are summed up when the counter is read, which only happens on metric
+// snapshot. so cold counters cost no more than a few words, and only hot ones pay for the cache lines.
 class Counter {
-protected:
-    std::string mName;
-    std::atomic_uint64_t mVal;
-
 public:
+    static constexpr size_t kShardCnt = 8;
+
     Counter(const std::string& name, uint64_t val = 0) : mName(name), mVal(val) {}
-    uint64_t GetValue() const { return mVal.load(); }
+    ~Counter() { delete[] mShards.load(std::memory_order_relaxed); }
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    uint64_t GetValue() const {
+        uint64_t sum = mVal.load(std::memory_order_relaxed);
+        const Shard* shards = mShards.load(std::memory_order_acquire);
+        if (shards != nullptr) {
+            for (size_t i = 0; i < kShardCnt; ++i) {
+                sum += shards[i].mVal.load(std::memory_order_relaxed);
+            }
+        }
+        return sum;
+    }
     const std::string& GetName() const { return mName; }
-    void Add(uint64_t val) { mVal.fetch_add(val); }
-    Counter* Collect() { return new Counter(mName, mVal.exchange(0)); }
+    void Add(uint64_t val) {
+        size_t threadId = GetThreadId();
+        Shard* shards = mShards.load(std::memory_order_acquire);
+        if (shards == nullptr) {
+            size_t owner = mOwnerThreadId.load(std::memory_order_relaxed);
+            if (owner == threadId
+                || (owner == 0 && mOwnerThreadId.compare_exchange_strong(owner, threadId, std::memory_order_relaxed))) {
+                mVal.fetch_add(val, std::memory_order_relaxed);
+                return;
+            }
+            shards = AllocateShards();
+        }
+        shards[threadId % kShardCnt].mVal.fetch_add(val, std::memory_order_relaxed);
+    }
+    // the snapshot is never updated concurrently, so it is not sharded
+    Counter* Collect() { return new Counter(mName, Exchange()); }
+    bool IsSharded() const { return mShards.load(std::memory_order_acquire) != nullptr; }
+
+protected:
+    struct alignas(64) Shard {
+        std::atomic_uint64_t mVal{0};
+    };
+
+    // threads are numbered from 1 on first use, and assigned to shards in a round-robin manner
+    static size_t GetThreadId() {
+        static std::atomic_size_t sNextId{1};
+        thread_local size_t sId = sNextId.fetch_add(1, std::memory_order_relaxed);
+        return sId;
+    }
+
+    Shard* AllocateShards() {
+        Shard* shards = new Shard[kShardCnt];
+        Shard* expected = nullptr;
+        if (!mShards.compare_exchange_strong(expected, shards, std::memory_order_acq_rel)) {
+            // allocated by another thread
+            delete[] shards;
+            return expected;
+        }
+        return shards;
+    }
+
+    uint64_t Exchange() {
+        uint64_t sum = mVal.exchange(0, std::memory_order_relaxed);
+        Shard* shards = mShards.load(std::memory_order_acquire);
+        if (shards != nullptr) {
+            for (size_t i = 0; i < kShardCnt; ++i) {
+                sum += shards[i].mVal.exchange(0, std::memory_order_relaxed);
+            }
+        }
+        return sum;
+    }
+
+    std::string mName;
+    std::atomic_uint64_t mVal;
+    // 0 if no thread has added to the counter yet
+    std::atomic_size_t mOwnerThreadId{0};
+    std::atomic<Shard*> mShards{nullptr};
 };
 
 // input: nanosecond, output: milisecond
 class TimeCounter : public Counter {
 public:
     TimeCounter(const std::string& name, uint64_t val = 0) : Counter(name, val) {}
-    uint64_t GetValue() const { return mVal.load()/1000000; }
-    void Add(std::chrono::nanoseconds val) { mVal.fetch_add(val.count()); }
-    TimeCounter* Collect() { return new TimeCounter(mName, mVal.exchange(0)); }
+    uint64_t GetValue() const { return Counter::GetValue() / 1000000; }
+    void Add(std::chrono::nanoseconds val) { Counter::Add(val.count()); }
+    TimeCounter* Collect() { return new TimeCounter(mName, Exchange()); }
 };
 
 template <typename T>
@@ -83,10 +160,93 @@ public:
     void Sub(uint64_t val) { mVal.fetch_sub(val); }
 };
 
+// latencies are recorded in microseconds into fixed log-linear buckets: values less than 4 have their own buckets, and
+// each power of 2 above is split into 4 linear buckets, so that quantiles are accurate to within 25%. values no less
+// than 2^32us (about 71 minutes) all fall into the last bucket.
+// input: nanosecond, output: milisecond
+class Histogram {
+public:
+    static constexpr size_t kSubBucketBits = 2;
+    static constexpr size_t kSubBucketCnt = 1 << kSubBucketBits;
+    static constexpr size_t kMaxBits = 32;
+    static constexpr size_t kBucketCnt = (kMaxBits - kSubBucketBits + 1) * kSubBucketCnt;
+
+    Histogram(const std::string& name) : mName(name) {}
+
+    const std::string& GetName() const { return mName; }
+    void Add(std::chrono::nanoseconds val) {
+        uint64_t us = val.count() > 0 ? static_cast<uint64_t>(val.count()) / 1000 : 0;
+        mBuckets[GetBucketIdx(us)].fetch_add(1, std::memory_order_relaxed);
+    }
+    Histogram* Collect() {
+        auto res = new Histogram(mName);
+        for (size_t i = 0; i < kBucketCnt; ++i) {
+            res->mBuckets[i].store(mBuckets[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        return res;
+    }
+    uint64_t GetBucketCnt(size_t idx) const { return mBuckets[idx].load(std::memory_order_relaxed); }
+
+    static size_t GetBucketIdx(uint64_t us) {
+        if (us < kSubBucketCnt) {
+            return us;
+        }
+#if defined(_MSC_VER)
+        unsigned long highestBit;
+        _BitScanReverse64(&highestBit, us);
+#else
+        size_t highestBit = 63 - __builtin_clzll(us);
+#endif
+        if (highestBit >= kMaxBits) {
+            return kBucketCnt - 1;
+        }
+        size_t sub = (us >> (highestBit - kSubBucketBits)) & (kSubBucketCnt - 1);
+        return (highestBit - kSubBucketBits + 1) * kSubBucketCnt + sub;
+    }
+    // [lower, upper) in microseconds
+    static std::pair<uint64_t, uint64_t> GetBucketBounds(size_t idx) {
+        if (idx < kSubBucketCnt) {
+            return {idx, idx + 1};
+        }
+        size_t shift = idx / kSubBucketCnt - 1;
+        uint64_t sub = kSubBucketCnt + idx % kSubBucketCnt;
+        return {sub << shift, (sub + 1) << shift};
+    }
+    // q in [0, 1], result in milliseconds, estimated by linear interpolation within the bucket
+    static double GetQuantileMs(const std::vector<uint64_t>& buckets, double q) {
+        uint64_t total = 0;
+        for (auto cnt : buckets) {
+            total += cnt;
+        }
+        if (total == 0) {
+            return 0.0;
+        }
+        double rank = q * total;
+        uint64_t cum = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            if (buckets[i] == 0) {
+                continue;
+            }
+            if (cum + buckets[i] >= rank) {
+                auto bounds = GetBucketBounds(i);
+                double ratio = (rank - cum) / buckets[i];
+                return (bounds.first + (bounds.second - bounds.first) * ratio) / 1000.0;
+            }
+            cum += buckets[i];
+        }
+        return GetBucketBounds(buckets.size() - 1).second / 1000.0;
+    }
+
+private:
+    std::string mName;
+    std::array<std::atomic_uint64_t, kBucketCnt> mBuckets{};
+};
+
 using CounterPtr = std::shared_ptr<Counter>;
 using TimeCounterPtr = std::shared_ptr<TimeCounter>;
 using IntGaugePtr = std::shared_ptr<IntGauge>;
 using DoubleGaugePtr = std::shared_ptr<Gauge<double>>;
+using HistogramPtr = std::shared_ptr<Histogram>;
 
 using MetricLabels = std::vector<std::pair<std::string, std::string>>;
 using MetricLabelsPtr = std::shared_ptr<MetricLabels>;
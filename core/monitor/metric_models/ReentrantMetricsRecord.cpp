@@ -38,6 +38,9 @@ void ReentrantMetricsRecord::Init(const std::string& category,
             case MetricType::METRIC_TYPE_DOUBLE_GAUGE:
                 mDoubleGauges[metric.first] = mMetricsRecordRef.CreateDoubleGauge(metric.first);
                 break;
+            case MetricType::METRIC_TYPE_HISTOGRAM:
+                mHistograms[metric.first] = mMetricsRecordRef.CreateHistogram(metric.first);
+                break;
             default:
                 break;
         }
@@ -84,6 +87,14 @@ DoubleGaugePtr ReentrantMetricsRecord::GetDoubleGauge(const std::string& name) {
     return nullptr;
 }
 
+HistogramPtr ReentrantMetricsRecord::GetHistogram(const std::string& name) {
+    auto it = mHistograms.find(name);
+    if (it != mHistograms.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
 ReentrantMetricsRecordRef PluginMetricManager::GetOrCreateReentrantMetricsRecordRef(MetricLabels labels, DynamicMetricLabels dynamicLabels) {
     std::lock_guard<std::mutex> lock(mutex);
 
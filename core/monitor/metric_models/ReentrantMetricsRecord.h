@@ -28,6 +28,7 @@ private:
     std::unordered_map<std::string, TimeCounterPtr> mTimeCounters;
     std::unordered_map<std::string, IntGaugePtr> mIntGauges;
     std::unordered_map<std::string, DoubleGaugePtr> mDoubleGauges;
+    std::unordered_map<std::string, HistogramPtr> mHistograms;
 
 public:
     void Init(const std::string& category,
@@ -40,6 +41,7 @@ public:
     TimeCounterPtr GetTimeCounter(const std::string& name);
     IntGaugePtr GetIntGauge(const std::string& name);
     DoubleGaugePtr GetDoubleGauge(const std::string& name);
+    HistogramPtr GetHistogram(const std::string& name);
 };
 using ReentrantMetricsRecordRef = std::shared_ptr<ReentrantMetricsRecord>;
 
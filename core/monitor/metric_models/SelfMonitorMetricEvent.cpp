@@ -60,6 +60,14 @@ SelfMonitorMetricEvent::SelfMonitorMetricEvent(MetricsRecord* metricRecord) {
     for (auto& item : metricRecord->GetDoubleGauges()) {
         mGauges[item->GetName()] = item->GetValue();
     }
+    // histograms
+    for (auto& item : metricRecord->GetHistograms()) {
+        auto& buckets = mHistograms[item->GetName()];
+        buckets.resize(Histogram::kBucketCnt);
+        for (size_t i = 0; i < Histogram::kBucketCnt; ++i) {
+            buckets[i] = item->GetBucketCnt(i);
+        }
+    }
     CreateKey();
 }
 
@@ -149,6 +157,13 @@ void SelfMonitorMetricEvent::Merge(SelfMonitorMetricEvent& event) {
     for (auto gauge = event.mGauges.begin(); gauge != event.mGauges.end(); gauge++) {
         mGauges[gauge->first] = gauge->second;
     }
+    for (auto& histogram : event.mHistograms) {
+        auto& buckets = mHistograms[histogram.first];
+        buckets.resize(histogram.second.size());
+        for (size_t i = 0; i < histogram.second.size(); ++i) {
+            buckets[i] += histogram.second[i];
+        }
+    }
     mUpdatedFlag = true;
 }
 
@@ -179,6 +194,20 @@ void SelfMonitorMetricEvent::ReadAsMetricEvent(MetricEvent* metricEventPtr) {
     for (auto gauge = mGauges.begin(); gauge != mGauges.end(); gauge++) {
         metricEventPtr->MutableValue<UntypedMultiDoubleValues>()->SetValue(gauge->first, gauge->second);
     }
+    // only the count and some quantiles of histograms are sent
+    for (auto& histogram : mHistograms) {
+        auto& buckets = histogram.second;
+        uint64_t cnt = 0;
+        for (auto bucketCnt : buckets) {
+            cnt += bucketCnt;
+        }
+        auto values = metricEventPtr->MutableValue<UntypedMultiDoubleValues>();
+        values->SetValue(histogram.first + "_count", cnt);
+        values->SetValue(histogram.first + "_p50", Histogram::GetQuantileMs(buckets, 0.5));
+        values->SetValue(histogram.first + "_p90", Histogram::GetQuantileMs(buckets, 0.9));
+        values->SetValue(histogram.first + "_p99", Histogram::GetQuantileMs(buckets, 0.99));
+        buckets.assign(buckets.size(), 0);
+    }
     // set flags
     mLastSendInterval = 0;
     mUpdatedFlag = false;
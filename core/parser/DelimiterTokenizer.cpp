@@ -0,0 +1,259 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "parser/DelimiterTokenizer.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define DELIMITER_TOKENIZER_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// AVX2 is only dispatched on gcc and clang, where functions can be compiled for a target other than the default one
+#if defined(DELIMITER_TOKENIZER_X86) && defined(__GNUC__)
+#define DELIMITER_TOKENIZER_AVX2
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace logtail {
+
+namespace delimiter_tokenizer {
+
+namespace {
+
+const size_t kBlockSize = 64;
+
+inline uint32_t CountTrailingZeros(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, mask);
+    return idx;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// bit i of the result is the xor of bits [0, i] of mask, i.e. whether byte i is enclosed by quotes. The opening quote
+// is regarded as enclosed and the closing one is not.
+inline uint64_t PrefixXor(uint64_t mask) {
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+inline void AppendPositions(size_t base, uint64_t mask, std::vector<size_t>& positions) {
+    while (mask) {
+        positions.push_back(base + CountTrailingZeros(mask));
+        mask &= mask - 1;
+    }
+}
+
+void LoadMasksScalar(const char* data, char separator, char quote, uint64_t& separatorMask, uint64_t& quoteMask) {
+    separatorMask = 0;
+    quoteMask = 0;
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        separatorMask |= static_cast<uint64_t>(data[i] == separator) << i;
+        quoteMask |= static_cast<uint64_t>(data[i] == quote) << i;
+    }
+}
+
+#ifdef DELIMITER_TOKENIZER_X86
+inline uint64_t CompareSSE2(const char* data, __m128i target) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target)));
+}
+
+void LoadMasksSSE2(const char* data, char separator, char quote, uint64_t& separatorMask, uint64_t& quoteMask) {
+    const __m128i sep = _mm_set1_epi8(separator);
+    const __m128i quo = _mm_set1_epi8(quote);
+    separatorMask = CompareSSE2(data, sep) | CompareSSE2(data + 16, sep) << 16 | CompareSSE2(data + 32, sep) << 32
+        | CompareSSE2(data + 48, sep) << 48;
+    quoteMask = CompareSSE2(data, quo) | CompareSSE2(data + 16, quo) << 16 | CompareSSE2(data + 32, quo) << 32
+        | CompareSSE2(data + 48, quo) << 48;
+}
+#endif
+
+#ifdef DELIMITER_TOKENIZER_AVX2
+TARGET_AVX2 void
+LoadMasksAVX2(const char* data, char separator, char quote, uint64_t& separatorMask, uint64_t& quoteMask) {
+    const __m256i sep = _mm256_set1_epi8(separator);
+    const __m256i quo = _mm256_set1_epi8(quote);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+    separatorMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, sep)))
+        | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, sep)))) << 32;
+    quoteMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, quo)))
+        | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, quo)))) << 32;
+}
+#endif
+
+using LoadMasksFunc = void (*)(const char*, char, char, uint64_t&, uint64_t&);
+
+LoadMasksFunc GetLoadMasksFunc(char_finder::Impl impl) {
+    switch (impl) {
+#ifdef DELIMITER_TOKENIZER_AVX2
+        case char_finder::Impl::AVX2:
+            return LoadMasksAVX2;
+#endif
+#ifdef DELIMITER_TOKENIZER_X86
+        case char_finder::Impl::SSE2:
+            return LoadMasksSSE2;
+#endif
+        default:
+            return LoadMasksScalar;
+    }
+}
+
+} // namespace
+
+bool FindSeparators(char_finder::Impl impl,
+                    const char* data,
+                    size_t size,
+                    char separator,
+                    char quote,
+                    bool useQuote,
+                    std::vector<size_t>& separators,
+                    std::vector<size_t>& quotes) {
+    LoadMasksFunc loadMasks = GetLoadMasksFunc(impl);
+    // all ones if the previous block ends within quotes
+    uint64_t inQuote = 0;
+    char tail[kBlockSize];
+    for (size_t i = 0; i < size; i += kBlockSize) {
+        uint64_t separatorMask = 0;
+        uint64_t quoteMask = 0;
+        if (i + kBlockSize <= size) {
+            loadMasks(data + i, separator, quote, separatorMask, quoteMask);
+        } else {
+            // the last partial block is copied, and bits out of range are cleared
+            memset(tail, 0, kBlockSize);
+            memcpy(tail, data + i, size - i);
+            loadMasks(tail, separator, quote, separatorMask, quoteMask);
+            uint64_t valid = (static_cast<uint64_t>(1) << (size - i)) - 1;
+            separatorMask &= valid;
+            quoteMask &= valid;
+        }
+        if (useQuote) {
+            if (quoteMask) {
+                uint64_t quoted = PrefixXor(quoteMask) ^ inQuote;
+                inQuote = static_cast<uint64_t>(static_cast<int64_t>(quoted) >> 63);
+                separatorMask &= ~quoted;
+                AppendPositions(i, quoteMask, quotes);
+            } else {
+                separatorMask &= ~inQuote;
+            }
+        }
+        AppendPositions(i, separatorMask, separators);
+    }
+    return inQuote == 0;
+}
+
+} // namespace delimiter_tokenizer
+
+DelimiterTokenizer::DelimiterTokenizer(char separator, char quote, bool useQuote)
+    : mSeparator(separator), mQuote(quote), mUseQuote(useQuote) {
+}
+
+bool DelimiterTokenizer::FindSeparators(const char* data,
+                                        size_t size,
+                                        std::vector<size_t>& separators,
+                                        std::vector<size_t>& quotes) const {
+    return delimiter_tokenizer::FindSeparators(
+        char_finder::GetImpl(), data, size, mSeparator, mQuote, mUseQuote, separators, quotes);
+}
+
+bool DelimiterTokenizer::ParseDelimiterLine(
+    StringView buffer, int begin, int end, std::vector<StringView>& columnValues, LogEvent& event) const {
+    static thread_local std::vector<size_t> sSeparators;
+    static thread_local std::vector<size_t> sQuotes;
+    sSeparators.clear();
+    sQuotes.clear();
+
+    const char* data = buffer.data() + begin;
+    size_t size = end - begin;
+    if (!FindSeparators(data, size, sSeparators, sQuotes)) {
+        columnValues.clear();
+        return false;
+    }
+    size_t quoteIdx = 0;
+    size_t columnBegin = 0;
+    for (size_t separator : sSeparators) {
+        if (quoteIdx == sQuotes.size() || sQuotes[quoteIdx] > separator) {
+            columnValues.emplace_back(data + columnBegin, separator - columnBegin);
+        } else if (!AddQuotedColumn(data, columnBegin, separator, sQuotes, quoteIdx, columnValues, event)) {
+            columnValues.clear();
+            return false;
+        }
+        columnBegin = separator + 1;
+    }
+    if (quoteIdx == sQuotes.size()) {
+        columnValues.emplace_back(data + columnBegin, size - columnBegin);
+    } else if (!AddQuotedColumn(data, columnBegin, size, sQuotes, quoteIdx, columnValues, event)) {
+        columnValues.clear();
+        return false;
+    }
+    return true;
+}
+
+bool DelimiterTokenizer::AddQuotedColumn(const char* data,
+                                         size_t begin,
+                                         size_t end,
+                                         const std::vector<size_t>& quotes,
+                                         size_t& quoteIdx,
+                                         std::vector<StringView>& columnValues,
+                                         LogEvent& event) const {
+    size_t first = quoteIdx;
+    while (quoteIdx < quotes.size() && quotes[quoteIdx] < end) {
+        ++quoteIdx;
+    }
+    // the column must be enclosed by quotes
+    size_t last = quoteIdx - 1;
+    if (last == first || quotes[first] != begin || quotes[last] != end - 1) {
+        return false;
+    }
+    // and inner quotes must be doubled
+    for (size_t i = first + 1; i < last; i += 2) {
+        if (i + 1 >= last || quotes[i + 1] != quotes[i] + 1) {
+            return false;
+        }
+    }
+    size_t escapedCnt = (last - first - 1) / 2;
+    if (escapedCnt == 0) {
+        columnValues.emplace_back(data + begin + 1, end - begin - 2);
+        return true;
+    }
+    size_t len = end - begin - 2 - escapedCnt;
+    StringBuffer sb = event.GetSourceBuffer()->AllocateStringBuffer(len);
+    char* res = sb.data;
+    size_t pos = begin + 1;
+    for (size_t i = first + 1; i < last; i += 2) {
+        // one of the doubled quotes is kept
+        memcpy(res, data + pos, quotes[i] + 1 - pos);
+        res += quotes[i] + 1 - pos;
+        pos = quotes[i] + 2;
+    }
+    memcpy(res, data + pos, end - 1 - pos);
+    columnValues.emplace_back(sb.data, len);
+    return true;
+}
+
+} // namespace logtail
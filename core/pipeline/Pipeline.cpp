@@ -327,6 +327,8 @@ bool Pipeline::Init(PipelineConfig&& config) {
     mProcessorsInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
     mProcessorsTotalProcessTimeMs
         = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
+    mProcessorsProcessLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_PIPELINE_PROCESSORS_PROCESS_LATENCY_MS);
+    mReadToProcessLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_PIPELINE_READ_TO_PROCESS_LATENCY_MS);
     mFlushersInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
     mFlushersInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
     mFlushersInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
@@ -369,13 +371,22 @@ void Pipeline::Process(vector<PipelineEventGroup>& logGroupList, size_t inputInd
     mProcessorsInGroupsTotal->Add(logGroupList.size());
 
     auto before = chrono::system_clock::now();
+    for (auto& logGroup : logGroupList) {
+        auto readTime = logGroup.GetMetadataTime(EventGroupMetaKey::READ_TIMESTAMP_MICROSEC);
+        if (readTime != chrono::system_clock::time_point()) {
+            mReadToProcessLatencyMs->Add(before - readTime);
+        }
+        logGroup.SetMetadataTime(EventGroupMetaKey::PROCESS_TIMESTAMP_MICROSEC, before);
+    }
     for (auto& p : mInputs[inputIndex]->GetInnerProcessors()) {
         p->Process(logGroupList);
     }
     for (auto& p : mProcessorLine) {
         p->Process(logGroupList);
     }
-    mProcessorsTotalProcessTimeMs->Add(chrono::system_clock::now() - before);
+    auto processTime = chrono::system_clock::now() - before;
+    mProcessorsTotalProcessTimeMs->Add(processTime);
+    mProcessorsProcessLatencyMs->Add(processTime);
 }
 
 bool Pipeline::Send(vector<PipelineEventGroup>&& groupList) {
@@ -111,6 +111,8 @@ private:
     CounterPtr mProcessorsInGroupsTotal;
     CounterPtr mProcessorsInSizeBytes;
     TimeCounterPtr mProcessorsTotalProcessTimeMs;
+    HistogramPtr mProcessorsProcessLatencyMs;
+    HistogramPtr mReadToProcessLatencyMs;
     CounterPtr mFlushersInGroupsTotal;
     CounterPtr mFlushersInEventsTotal;
     CounterPtr mFlushersInSizeBytes;
@@ -50,7 +50,16 @@ static shared_ptr<Pipeline> sEmptyPipeline;
 void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
     // 过渡使用
     static bool isFileServerStarted = false;
-    bool isFileServerInputChanged = CheckIfFileServerUpdated(diff);
+    unordered_set<string> fileServerConfigNames;
+    bool isFileServerInputChanged = CheckIfFileServerUpdated(diff, fileServerConfigNames);
+
+    // pipelines of modified configs are built before file server is paused, so that readers of other configs are not
+    // held on during building
+    vector<shared_ptr<Pipeline>> modifiedPipelines;
+    for (auto& config : diff.mModified) {
+        // auto reuse old pipeline's process queue and sender queue
+        modifiedPipelines.push_back(BuildPipeline(std::move(config)));
+    }
 
 #ifndef APSARA_UNIT_TEST_MAIN
 #if defined(__ENTERPRISE__) && defined(__linux__) && !defined(__ANDROID__)
@@ -60,7 +69,7 @@ void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
 #endif
 #endif
     if (isFileServerStarted && isFileServerInputChanged) {
-        FileServer::GetInstance()->Pause();
+        FileServer::GetInstance()->PauseConfigs(fileServerConfigNames);
     }
 
     for (const auto& name : diff.mRemoved) {
@@ -72,8 +81,9 @@ void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
         ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(name,
                                                                                      ConfigFeedbackStatus::DELETED);
     }
-    for (auto& config : diff.mModified) {
-        auto p = BuildPipeline(std::move(config)); // auto reuse old pipeline's process queue and sender queue
+    for (size_t i = 0; i < diff.mModified.size(); ++i) {
+        auto& config = diff.mModified[i];
+        auto& p = modifiedPipelines[i];
         if (!p) {
             LOG_WARNING(sLogger,
                         ("failed to build pipeline for existing config",
@@ -130,7 +140,7 @@ void logtail::PipelineManager::UpdatePipelines(PipelineConfigDiff& diff) {
 
     if (isFileServerInputChanged) {
         if (isFileServerStarted) {
-            FileServer::GetInstance()->Resume();
+            FileServer::GetInstance()->ResumeConfigs(fileServerConfigNames);
         } else {
             FileServer::GetInstance()->Start();
             isFileServerStarted = true;
@@ -229,26 +239,32 @@ void PipelineManager::DecreasePluginUsageCnt(const unordered_map<string, unorder
     }
 }
 
-bool PipelineManager::CheckIfFileServerUpdated(PipelineConfigDiff& diff) {
+bool PipelineManager::CheckIfFileServerUpdated(PipelineConfigDiff& diff, unordered_set<string>& configNames) {
     for (const auto& name : diff.mRemoved) {
         string inputType = mPipelineNameEntityMap[name]->GetConfig()["inputs"][0]["Type"].asString();
         if (inputType == "input_file" || inputType == "input_container_stdio") {
-            return true;
+            configNames.insert(name);
         }
     }
     for (const auto& config : diff.mModified) {
         string inputType = (*config.mInputs[0])["Type"].asString();
-        if (inputType == "input_file" || inputType == "input_container_stdio") {
-            return true;
+        // the old pipeline may be the one with file server input
+        auto iter = mPipelineNameEntityMap.find(config.mName);
+        string oldInputType = iter == mPipelineNameEntityMap.end()
+            ? ""
+            : iter->second->GetConfig()["inputs"][0]["Type"].asString();
+        if (inputType == "input_file" || inputType == "input_container_stdio" || oldInputType == "input_file"
+            || oldInputType == "input_container_stdio") {
+            configNames.insert(config.mName);
         }
     }
     for (const auto& config : diff.mAdded) {
         string inputType = (*config.mInputs[0])["Type"].asString();
         if (inputType == "input_file" || inputType == "input_container_stdio") {
-            return true;
+            configNames.insert(config.mName);
         }
     }
-    return false;
+    return !configNames.empty();
 }
 
 } // namespace logtail
@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "common/Lock.h"
 #include "config/ConfigDiff.h"
@@ -59,7 +60,8 @@ private:
         const std::unordered_map<std::string, std::unordered_map<std::string, uint32_t>>& statistics);
     void FlushAllBatch();
     // TODO: 长期过渡使用
-    bool CheckIfFileServerUpdated(PipelineConfigDiff& diff);
+    // names of the updated configs with file server inputs are added to @configNames
+    bool CheckIfFileServerUpdated(PipelineConfigDiff& diff, std::unordered_set<std::string>& configNames);
 
     std::unordered_map<std::string, std::shared_ptr<Pipeline>> mPipelineNameEntityMap;
     mutable SpinLock mPluginCntMapLock;
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -33,7 +34,13 @@ public:
     GroupBatchItem() { mStatus.Reset(); }
 
     void Add(BatchedEvents&& g, int64_t totalEnqueTimeMs) {
+        if (mGroups.empty()) {
+            mCreateSteadyTime = std::chrono::steady_clock::now();
+        }
         mEventsCnt += g.mEvents.size();
+        if (mProcessTime == std::chrono::system_clock::time_point()) {
+            mProcessTime = g.mProcessTime;
+        }
         // mTotalEnqueTimeMs += totalEnqueTimeMs;
         mGroups.emplace_back(std::move(g));
         mStatus.Update(mGroups.back());
@@ -61,6 +68,9 @@ public:
     size_t GroupSize() const { return mGroups.size(); }
     size_t EventSize() const { return mEventsCnt; }
     size_t DataSize() const { return mStatus.GetSize(); }
+    time_t GetCreateTime() const { return mStatus.GetCreateTime(); }
+    std::chrono::steady_clock::time_point GetCreateSteadyTime() const { return mCreateSteadyTime; }
+    std::chrono::system_clock::time_point GetProcessTime() const { return mProcessTime; }
     int64_t TotalEnqueTimeMs() const { return mTotalEnqueTimeMs; }
 
     bool IsEmpty() { return mGroups.empty(); }
@@ -71,12 +81,17 @@ private:
         mStatus.Reset();
         mEventsCnt = 0;
         mTotalEnqueTimeMs = 0;
+        mProcessTime = std::chrono::system_clock::time_point();
+        mCreateSteadyTime = std::chrono::steady_clock::time_point();
     }
 
     std::vector<BatchedEvents> mGroups;
 
     GroupBatchStatus mStatus;
     size_t mEventsCnt = 0;
+    std::chrono::system_clock::time_point mProcessTime;
+    // the status create time is in seconds, which is too coarse for latency
+    std::chrono::steady_clock::time_point mCreateSteadyTime;
     // if more than 10^6 events are contained in the batch, the value may overflow
     // however, this is almost impossible in practice
     int64_t mTotalEnqueTimeMs = 0;
@@ -92,6 +107,9 @@ template <typename T = EventBatchStatus>
 class EventBatchItem {
 public:
     void Add(PipelineEventPtr&& e) {
+        if (mBatch.mEvents.empty()) {
+            mCreateSteadyTime = std::chrono::steady_clock::now();
+        }
         mBatch.mEvents.emplace_back(std::move(e));
         mStatus.Update(mBatch.mEvents.back());
         // mTotalEnqueTimeMs += std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now())
@@ -148,6 +166,13 @@ public:
         AddSourceBuffer(sourceBuffer);
     }
 
+    // events added later are never earlier than the first ones, so the timestamps are only set on reset
+    void SetTimestamps(std::chrono::system_clock::time_point readTime,
+                       std::chrono::system_clock::time_point processTime) {
+        mBatch.mReadTime = readTime;
+        mBatch.mProcessTime = processTime;
+    }
+
     void AddSourceBuffer(const std::shared_ptr<SourceBuffer>& sourceBuffer) {
         if (mSourceBuffers.find(sourceBuffer.get()) == mSourceBuffers.end()) {
             mSourceBuffers.insert(sourceBuffer.get());
@@ -161,6 +186,9 @@ public:
 
     size_t DataSize() const { return sizeof(decltype(mBatch.mEvents)) + mStatus.GetSize() + mBatch.mTags.DataSize(); }
     size_t EventSize() const { return mBatch.mEvents.size(); }
+    time_t GetCreateTime() const { return mStatus.GetCreateTime(); }
+    std::chrono::steady_clock::time_point GetCreateSteadyTime() const { return mCreateSteadyTime; }
+    std::chrono::system_clock::time_point GetProcessTime() const { return mBatch.mProcessTime; }
     int64_t TotalEnqueTimeMs() const { return mTotalEnqueTimeMs; }
 
 private:
@@ -169,6 +197,7 @@ private:
         mSourceBuffers.clear();
         mStatus.Reset();
         mTotalEnqueTimeMs = 0;
+        mCreateSteadyTime = std::chrono::steady_clock::time_point();
     }
 
     void UpdateExactlyOnceLogPosition() {
@@ -185,6 +214,7 @@ private:
     // if more than 10^6 events are contained in the batch, the value may overflow
     // however, this is almost impossible in practice
     int64_t mTotalEnqueTimeMs = 0;
+    std::chrono::steady_clock::time_point mCreateSteadyTime;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class EventBatchItemUnittest;
@@ -97,6 +97,8 @@ void BatchedEvents::Clear() {
     mSizeBytes = 0;
     mExactlyOnceCheckpoint.reset();
     mPackIdPrefix = StringView();
+    mReadTime = std::chrono::system_clock::time_point();
+    mProcessTime = std::chrono::system_clock::time_point();
 }
 
 } // namespace logtail
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <unordered_set>
 #include <vector>
 
@@ -32,6 +33,9 @@ struct BatchedEvents {
     // for flusher_sls only
     RangeCheckpointPtr mExactlyOnceCheckpoint;
     StringView mPackIdPrefix;
+    // earliest read and process time of the events, for latency statistics. epoch if unknown.
+    std::chrono::system_clock::time_point mReadTime;
+    std::chrono::system_clock::time_point mProcessTime;
 
     BatchedEvents() = default;
     ~BatchedEvents();
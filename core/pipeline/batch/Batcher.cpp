@@ -0,0 +1,43 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pipeline/batch/Batcher.h"
+
+#include <atomic>
+
+#include "app_config/AppConfig.h"
+
+DEFINE_FLAG_INT32(batcher_shard_count,
+                  "number of shards of each batcher with group batch enabled, 0 means the same as process thread count",
+                  1);
+
+using namespace std;
+
+namespace logtail {
+
+size_t GetBatcherShardCount() {
+    int32_t cnt = INT32_FLAG(batcher_shard_count);
+    if (cnt == 0) {
+        cnt = AppConfig::GetInstance()->GetProcessThreadCount();
+    }
+    return cnt > 0 ? static_cast<size_t>(cnt) : 1;
+}
+
+size_t GetBatcherThreadIndex() {
+    static atomic_size_t sThreadCnt{0};
+    thread_local size_t sIndex = sThreadCnt.fetch_add(1);
+    return sIndex;
+}
+
+} // namespace logtail
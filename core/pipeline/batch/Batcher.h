@@ -20,8 +20,10 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "common/Flags.h"
@@ -35,11 +37,20 @@
 #include "pipeline/batch/FlushStrategy.h"
 #include "pipeline/batch/TimeoutFlushManager.h"
 
+DECLARE_FLAG_INT32(batcher_shard_count);
+
 namespace logtail {
 
+// number of shards a batcher with group batch enabled is split into
+size_t GetBatcherShardCount();
+// a small index fixed for the calling thread, used to pick the shard
+size_t GetBatcherThreadIndex();
+
 template <typename T = EventBatchStatus>
 class Batcher {
 public:
+    Batcher() { mShards.emplace_back(std::make_unique<Shard>()); }
+
     bool Init(const Json::Value& config,
               Flusher* flusher,
               const DefaultFlushStrategyOptions& strategy,
@@ -98,6 +109,14 @@ public:
         mEventFlushStrategy.SetMinSizeBytes(minSizeBytes);
         mEventFlushStrategy.SetMinCnt(minCnt);
 
+        // each processor thread adds groups to its own shard, and batches of the same key in different shards are
+        // merged by the group queue only. Without group batch, one flush must produce exactly one batch, so no sharding.
+        if (enableGroupBatch) {
+            for (size_t i = mShards.size(); i < GetBatcherShardCount(); ++i) {
+                mShards.emplace_back(std::make_unique<Shard>());
+            }
+        }
+
         mFlusher = flusher;
 
         std::vector<std::pair<std::string, std::string>> labels{
@@ -121,6 +140,9 @@ public:
         mBufferedEventsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL);
         mBufferedDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES);
         mTotalAddTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS);
+        mBatchLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_COMPONENT_BATCHER_BATCH_LATENCY_MS);
+        mProcessToFlushLatencyMs
+            = mMetricsRecordRef.CreateHistogram(METRIC_COMPONENT_BATCHER_PROCESS_TO_FLUSH_LATENCY_MS);
 
         return true;
     }
@@ -128,12 +150,19 @@ public:
     // when group level batch is disabled, there should be only 1 element in BatchedEventsList
     void Add(PipelineEventGroup&& g, std::vector<BatchedEventsList>& res) {
         auto before = std::chrono::system_clock::now();
-        std::lock_guard<std::mutex> lock(mMux);
+        size_t shardIdx = GetShardIndex();
+        Shard& shard = *mShards[shardIdx];
+        std::lock_guard<std::mutex> lock(shard.mMux);
         size_t key = g.GetTagsHash();
-        EventBatchItem<T>& item = mEventQueueMap[key];
+        auto ret = shard.mEventQueueMap.try_emplace(key);
+        EventBatchItem<T>& item = ret.first->second;
         mInEventsTotal->Add(g.GetEvents().size());
         mInGroupDataSizeBytes->Add(g.DataSize());
-        mEventBatchItemsTotal->Set(mEventQueueMap.size());
+        auto readTime = g.GetMetadataTime(EventGroupMetaKey::READ_TIMESTAMP_MICROSEC);
+        auto processTime = g.GetMetadataTime(EventGroupMetaKey::PROCESS_TIMESTAMP_MICROSEC);
+        if (ret.second) {
+            mEventBatchItemsTotal->Add(1);
+        }
 
         if (g.DataSize() > mEventFlushStrategy.GetMinSizeBytes()) {
             // for group size larger than min batch size, separate group only if size is larger than max batch size
@@ -145,6 +174,7 @@ public:
                 // should consider time condition here because sls require this
                 if (!item.IsEmpty() && mEventFlushStrategy.NeedFlushByTime(item.GetStatus(), e)) {
                     mOutEventsTotal->Add(item.EventSize());
+                    AddProcessToFlushLatency(item.GetProcessTime());
                     item.Flush(res);
                 }
                 if (item.IsEmpty()) {
@@ -152,14 +182,17 @@ public:
                                g.GetSourceBuffer(),
                                g.GetExactlyOnceCheckpoint(),
                                g.GetMetadata(EventGroupMetaKey::SOURCE_ID));
+                    item.SetTimestamps(readTime, processTime);
                 }
                 item.Add(std::move(e));
                 if (mEventFlushStrategy.SizeReachingUpperLimit(item.GetStatus())) {
                     mOutEventsTotal->Add(item.EventSize());
+                    AddProcessToFlushLatency(item.GetProcessTime());
                     item.Flush(res);
                 }
             }
             mOutEventsTotal->Add(item.EventSize());
+            AddProcessToFlushLatency(item.GetProcessTime());
             item.Flush(res);
         } else {
             size_t eventsSize = g.GetEvents().size();
@@ -170,22 +203,8 @@ public:
                         UpdateMetricsOnFlushingEventQueue(item);
                         item.Flush(res);
                     } else {
-                        if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-                            UpdateMetricsOnFlushingGroupQueue();
-                            mGroupQueue->Flush(res);
-                        }
-                        if (mGroupQueue->IsEmpty()) {
-                            TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
-                                                                             mFlusher->GetFlusherIndex(),
-                                                                             0,
-                                                                             mGroupFlushStrategy->GetTimeoutSecs(),
-                                                                             mFlusher);
-                        }
-                        item.Flush(mGroupQueue.value());
-                        if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-                            UpdateMetricsOnFlushingGroupQueue();
-                            mGroupQueue->Flush(res);
-                        }
+                        std::lock_guard<std::mutex> groupLock(mGroupMux);
+                        FlushToGroupQueue(item, res);
                     }
                 }
                 if (item.IsEmpty()) {
@@ -193,9 +212,12 @@ public:
                                g.GetSourceBuffer(),
                                g.GetExactlyOnceCheckpoint(),
                                g.GetMetadata(EventGroupMetaKey::SOURCE_ID));
+                    item.SetTimestamps(readTime, processTime);
+                    size_t timeoutKey = GetTimeoutKey(key, shardIdx);
+                    shard.mTimeoutKeys[timeoutKey] = key;
                     TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                                      mFlusher->GetFlusherIndex(),
-                                                                     key,
+                                                                     timeoutKey,
                                                                      mEventFlushStrategy.GetTimeoutSecs(),
                                                                      mFlusher);
                     mBufferedGroupsTotal->Add(1);
@@ -216,11 +238,11 @@ public:
         mTotalAddTimeMs->Add(std::chrono::system_clock::now() - before);
     }
 
-    // key != 0: event level queue
+    // key != 0: event level queue, which is the timeout key of the queue
     // key = 0: group level queue
     void FlushQueue(size_t key, BatchedEventsList& res) {
-        std::lock_guard<std::mutex> lock(mMux);
         if (key == 0) {
+            std::lock_guard<std::mutex> groupLock(mGroupMux);
             if (!mGroupQueue) {
                 return;
             }
@@ -228,19 +250,92 @@ public:
             return mGroupQueue->Flush(res);
         }
 
-        auto iter = mEventQueueMap.find(key);
-        if (iter == mEventQueueMap.end()) {
-            return;
+        // the shard is unknown from the timeout key, so each shard is checked for a queue registered with the key
+        for (auto& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard->mMux);
+            auto keyIter = shard->mTimeoutKeys.find(key);
+            if (keyIter == shard->mTimeoutKeys.end()) {
+                continue;
+            }
+            auto iter = shard->mEventQueueMap.find(keyIter->second);
+            shard->mTimeoutKeys.erase(keyIter);
+            if (iter == shard->mEventQueueMap.end()) {
+                continue;
+            }
+
+            if (!mGroupQueue) {
+                UpdateMetricsOnFlushingEventQueue(iter->second);
+                iter->second.Flush(res);
+            } else {
+                std::lock_guard<std::mutex> groupLock(mGroupMux);
+                FlushToGroupQueue(iter->second, res);
+            }
+            shard->mEventQueueMap.erase(iter);
+            mEventBatchItemsTotal->Sub(1);
         }
+    }
+
+    void FlushAll(std::vector<BatchedEventsList>& res) {
+        for (auto& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard->mMux);
+            for (auto& item : shard->mEventQueueMap) {
+                if (!mGroupQueue) {
+                    UpdateMetricsOnFlushingEventQueue(item.second);
+                    item.second.Flush(res);
+                } else {
+                    std::lock_guard<std::mutex> groupLock(mGroupMux);
+                    if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
+                        UpdateMetricsOnFlushingGroupQueue();
+                        mGroupQueue->Flush(res);
+                    }
+                    item.second.Flush(mGroupQueue.value());
+                    if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
+                        UpdateMetricsOnFlushingGroupQueue();
+                        mGroupQueue->Flush(res);
+                    }
+                }
+            }
+            mEventBatchItemsTotal->Sub(shard->mEventQueueMap.size());
+            shard->mEventQueueMap.clear();
+            shard->mTimeoutKeys.clear();
+        }
+        std::lock_guard<std::mutex> groupLock(mGroupMux);
+        if (mGroupQueue) {
+            UpdateMetricsOnFlushingGroupQueue();
+            mGroupQueue->Flush(res);
+        }
+    }
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    EventFlushStrategy<T>& GetEventFlushStrategy() { return mEventFlushStrategy; }
+    std::optional<GroupFlushStrategy>& GetGroupFlushStrategy() { return mGroupFlushStrategy; }
+#endif
+
+private:
+    struct Shard {
+        std::mutex mMux;
+        std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+        // timeout key -> queue key of the queues registered in TimeoutFlushManager, so that a timeout key colliding
+        // with that of another shard never flushes a queue not registered with it
+        std::unordered_map<size_t, size_t> mTimeoutKeys;
+    };
 
-        if (!mGroupQueue) {
-            UpdateMetricsOnFlushingEventQueue(iter->second);
-            iter->second.Flush(res);
-            mEventQueueMap.erase(iter);
-            mEventBatchItemsTotal->Set(mEventQueueMap.size());
-            return;
+    size_t GetShardIndex() const {
+        if (mShards.size() == 1) {
+            return 0;
         }
+        return GetBatcherThreadIndex() % mShards.size();
+    }
 
+    // each shard has its own timeout record, so that a busy shard does not postpone the timeout flush of the same key
+    // in other shards. The key is kept for shard 0.
+    static size_t GetTimeoutKey(size_t key, size_t shardIdx) {
+        return key ^ (shardIdx * static_cast<size_t>(0x9e3779b97f4a7c15ULL));
+    }
+
+    // should be called with mGroupMux held
+    template <typename R>
+    void FlushToGroupQueue(EventBatchItem<T>& item, R& res) {
         if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
@@ -252,49 +347,17 @@ public:
                                                              mGroupFlushStrategy->GetTimeoutSecs(),
                                                              mFlusher);
         }
-        iter->second.Flush(mGroupQueue.value());
-        mEventQueueMap.erase(iter);
-        mEventBatchItemsTotal->Set(mEventQueueMap.size());
+        item.Flush(mGroupQueue.value());
         if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
         }
     }
 
-    void FlushAll(std::vector<BatchedEventsList>& res) {
-        std::lock_guard<std::mutex> lock(mMux);
-        for (auto& item : mEventQueueMap) {
-            if (!mGroupQueue) {
-                UpdateMetricsOnFlushingEventQueue(item.second);
-                item.second.Flush(res);
-            } else {
-                if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-                    UpdateMetricsOnFlushingGroupQueue();
-                    mGroupQueue->Flush(res);
-                }
-                item.second.Flush(mGroupQueue.value());
-                if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-                    UpdateMetricsOnFlushingGroupQueue();
-                    mGroupQueue->Flush(res);
-                }
-            }
-        }
-        if (mGroupQueue) {
-            UpdateMetricsOnFlushingGroupQueue();
-            mGroupQueue->Flush(res);
-        }
-        mEventBatchItemsTotal->Set(0);
-        mEventQueueMap.clear();
-    }
-
-#ifdef APSARA_UNIT_TEST_MAIN
-    EventFlushStrategy<T>& GetEventFlushStrategy() { return mEventFlushStrategy; }
-    std::optional<GroupFlushStrategy>& GetGroupFlushStrategy() { return mGroupFlushStrategy; }
-#endif
-
-private:
     void UpdateMetricsOnFlushingEventQueue(const EventBatchItem<T>& item) {
         mOutEventsTotal->Add(item.EventSize());
+        AddBatchLatency(item.GetCreateSteadyTime());
+        AddProcessToFlushLatency(item.GetProcessTime());
         // mTotalDelayMs->Add(
         //     item.EventSize()
         //         * std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now())
@@ -308,6 +371,8 @@ private:
 
     void UpdateMetricsOnFlushingGroupQueue() {
         mOutEventsTotal->Add(mGroupQueue->EventSize());
+        AddBatchLatency(mGroupQueue->GetCreateSteadyTime());
+        AddProcessToFlushLatency(mGroupQueue->GetProcessTime());
         // mTotalDelayMs->Add(
         //     mGroupQueue->EventSize()
         //         * std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now())
@@ -319,10 +384,23 @@ private:
         mBufferedDataSizeByte->Sub(mGroupQueue->DataSize());
     }
 
-    std::mutex mMux;
-    std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+    void AddBatchLatency(std::chrono::steady_clock::time_point createTime) {
+        if (createTime != std::chrono::steady_clock::time_point()) {
+            mBatchLatencyMs->Add(std::chrono::steady_clock::now() - createTime);
+        }
+    }
+
+    void AddProcessToFlushLatency(std::chrono::system_clock::time_point processTime) {
+        if (processTime != std::chrono::system_clock::time_point()) {
+            mProcessToFlushLatencyMs->Add(std::chrono::system_clock::now() - processTime);
+        }
+    }
+
+    std::vector<std::unique_ptr<Shard>> mShards;
     EventFlushStrategy<T> mEventFlushStrategy;
 
+    // lock order: shard lock first, then mGroupMux
+    std::mutex mGroupMux;
     std::optional<GroupBatchItem> mGroupQueue;
     std::optional<GroupFlushStrategy> mGroupFlushStrategy;
 
@@ -338,6 +416,8 @@ private:
     IntGaugePtr mBufferedEventsTotal;
     IntGaugePtr mBufferedDataSizeByte;
     TimeCounterPtr mTotalAddTimeMs;
+    HistogramPtr mBatchLatencyMs;
+    HistogramPtr mProcessToFlushLatencyMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BatcherUnittest;
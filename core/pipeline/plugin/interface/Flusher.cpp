@@ -46,6 +46,13 @@ void Flusher::SetPipelineForItemsWhenStop() {
     }
 }
 
+void Flusher::InitLatencyMetrics() {
+    mFlushToSendDoneLatencyMs
+        = GetMetricsRecordRef().CreateHistogram(METRIC_PLUGIN_FLUSHER_FLUSH_TO_SEND_DONE_LATENCY_MS);
+    mReadToSendDoneLatencyMs
+        = GetMetricsRecordRef().CreateHistogram(METRIC_PLUGIN_FLUSHER_READ_TO_SEND_DONE_LATENCY_MS);
+}
+
 void Flusher::GenerateQueueKey(const std::string& target) {
     mQueueKey = QueueKeyManager::GetInstance()->GetKey((HasContext() ? mContext->GetConfigName() : "") + "-" + Name()
                                                        + "-" + target);
@@ -89,6 +96,13 @@ void Flusher::DealSenderQueueItemAfterSend(SenderQueueItem* item, bool keep) {
         item->mStatus = SendingStatus::IDLE;
         ++item->mTryCnt;
     } else {
+        if (mFlushToSendDoneLatencyMs) {
+            auto now = chrono::system_clock::now();
+            mFlushToSendDoneLatencyMs->Add(now - item->mFirstEnqueTime);
+            if (item->mReadTime != chrono::system_clock::time_point()) {
+                mReadToSendDoneLatencyMs->Add(now - item->mReadTime);
+            }
+        }
         // TODO: because current profile has a dummy flusher, we have to use item->mQueueKey here
         SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
     }
@@ -47,6 +47,8 @@ public:
     size_t GetFlusherIndex() { return mIndex; }
     void SetFlusherIndex(size_t idx) { mIndex = idx; }
     const std::string& GetPluginID() const { return mPluginID; }
+    // should be called after metrics record is set
+    void InitLatencyMetrics();
 
 protected:
     void GenerateQueueKey(const std::string& target);
@@ -57,6 +59,8 @@ protected:
     QueueKey mQueueKey;
     std::string mPluginID;
     size_t mIndex = 0;
+    HistogramPtr mFlushToSendDoneLatencyMs;
+    HistogramPtr mReadToSendDoneLatencyMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherInstanceUnittest;
@@ -80,6 +80,7 @@ bool ExactlyOnceQueueManager::CreateOrUpdateQueue(QueueKey key,
             // mProcessPriorityQueue[priority].emplace_back(
             //     checkpoints.size(), checkpoints.size() - 1, checkpoints.size(), key, priority, config);
             mProcessQueues[key] = prev(mProcessPriorityQueue[priority].end());
+            mProcessQueueCnt = mProcessQueues.size();
         }
         // for exactly once, the feedback is one to one
         mProcessQueues[key]->SetDownStreamQueues(std::move(senderQueue));
@@ -253,6 +254,7 @@ void ExactlyOnceQueueManager::ClearTimeoutQueues() {
             auto queueItr = mProcessQueues.find(iter->first);
             mProcessPriorityQueue[queueItr->second->GetPriority()].erase(queueItr->second);
             mProcessQueues.erase(queueItr);
+            mProcessQueueCnt = mProcessQueues.size();
         }
         {
             lock_guard<mutex> lock(mSenderQueueMux);
@@ -279,6 +281,7 @@ void ExactlyOnceQueueManager::Clear() {
         for (size_t i = 0; i <= ProcessQueueManager::sMaxPriority; ++i) {
             mProcessPriorityQueue[i].clear();
         }
+        mProcessQueueCnt = 0;
     }
     {
         lock_guard<mutex> lock(mSenderQueueMux);
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -84,6 +85,8 @@ private:
     mutable std::mutex mProcessQueueMux;
     std::unordered_map<QueueKey, std::list<BoundedProcessQueue>::iterator> mProcessQueues;
     std::list<BoundedProcessQueue> mProcessPriorityQueue[ProcessQueueManager::sMaxPriority + 1];
+    // read without lock, so that process threads can skip exactly once queues when there is none
+    std::atomic_size_t mProcessQueueCnt{0};
 
     mutable std::mutex mSenderQueueMux;
     std::unordered_map<QueueKey, ExactlyOnceSenderQueue> mSenderQueues;
@@ -29,7 +29,6 @@ using namespace std;
 namespace logtail {
 
 ProcessQueueManager::ProcessQueueManager() : mBoundedQueueParam(INT32_FLAG(bounded_process_queue_capacity)) {
-    ResetCurrentQueueIndex();
 }
 
 bool ProcessQueueManager::CreateOrUpdateBoundedQueue(QueueKey key, uint32_t priority, const PipelineContext& ctx) {
@@ -50,9 +49,6 @@ bool ProcessQueueManager::CreateOrUpdateBoundedQueue(QueueKey key, uint32_t prio
     } else {
         CreateBoundedQueue(key, priority, ctx);
     }
-    if (mCurrentQueueIndex.second == mPriorityQueue[mCurrentQueueIndex.first].end()) {
-        mCurrentQueueIndex.second = mPriorityQueue[mCurrentQueueIndex.first].begin();
-    }
     return true;
 }
 
@@ -78,9 +74,6 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
     } else {
         CreateCircularQueue(key, priority, capacity, ctx);
     }
-    if (mCurrentQueueIndex.second == mPriorityQueue[mCurrentQueueIndex.first].end()) {
-        mCurrentQueueIndex.second = mPriorityQueue[mCurrentQueueIndex.first].begin();
-    }
     return true;
 }
 
@@ -117,6 +110,7 @@ int ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&&
             if (!(*iter->second.first)->Push(std::move(item))) {
                 return 1;
             }
+            AddReadyQueue(iter->second.first);
         } else {
             int res = ExactlyOnceQueueManager::GetInstance()->PushProcessQueue(key, std::move(item));
             if (res != 0) {
@@ -130,48 +124,39 @@ int ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&&
 
 bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
     configName.clear();
+    auto exactlyOnceQueueManager = ExactlyOnceQueueManager::GetInstance();
     lock_guard<mutex> lock(mQueueMux);
     for (size_t i = 0; i <= sMaxPriority; ++i) {
-        ProcessQueueIterator iter;
-        if (mCurrentQueueIndex.first == i) {
-            for (iter = mCurrentQueueIndex.second; iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
-                    continue;
-                }
-                configName = (*iter)->GetConfigName();
-                break;
-            }
-            if (configName.empty()) {
-                for (iter = mPriorityQueue[i].begin(); iter != mCurrentQueueIndex.second; ++iter) {
-                    if (!(*iter)->Pop(item)) {
-                        continue;
-                    }
-                    configName = (*iter)->GetConfigName();
-                    break;
-                }
-            }
-        } else {
-            for (iter = mPriorityQueue[i].begin(); iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
-                    continue;
+        // only non-empty queues are visited. those in front which cannot be popped now, e.g., with downstream queues
+        // full, stay where they are, while the one popped is moved to the end for fairness.
+        for (auto iter = mReadyQueues[i].begin(); iter != mReadyQueues[i].end();) {
+            auto& que = **iter;
+            if (!que->Pop(item)) {
+                if (que->Empty()) {
+                    mReadyQueueIndex.erase(que->GetKey());
+                    iter = mReadyQueues[i].erase(iter);
+                } else {
+                    ++iter;
                 }
-                configName = (*iter)->GetConfigName();
-                break;
+                continue;
             }
-        }
-        if (!configName.empty()) {
-            mCurrentQueueIndex.first = i;
-            mCurrentQueueIndex.second = ++iter;
-            if (mCurrentQueueIndex.second == mPriorityQueue[i].end()) {
-                mCurrentQueueIndex.second = mPriorityQueue[i].begin();
+            configName = que->GetConfigName();
+            if (que->Empty()) {
+                mReadyQueueIndex.erase(que->GetKey());
+                mReadyQueues[i].erase(iter);
+            } else {
+                mReadyQueues[i].splice(mReadyQueues[i].end(), mReadyQueues[i], iter);
             }
             return true;
         }
         // find exactly once queues next
+        if (exactlyOnceQueueManager->mProcessQueueCnt == 0) {
+            continue;
+        }
         {
-            lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
-            for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].begin();
-                 iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].end();
+            lock_guard<mutex> lock(exactlyOnceQueueManager->mProcessQueueMux);
+            for (auto iter = exactlyOnceQueueManager->mProcessPriorityQueue[i].begin();
+                 iter != exactlyOnceQueueManager->mProcessPriorityQueue[i].end();
                  ++iter) {
                 // process queue for exactly once can only be assgined to one specific thread
                 if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
@@ -181,12 +166,10 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
                     continue;
                 }
                 configName = iter->GetConfigName();
-                ResetCurrentQueueIndex();
                 return true;
             }
         }
     }
-    ResetCurrentQueueIndex();
     {
         unique_lock<mutex> lock(mStateMux);
         mValidToPop = false;
@@ -300,33 +283,35 @@ void ProcessQueueManager::CreateCircularQueue(QueueKey key,
 
 void ProcessQueueManager::AdjustQueuePriority(const ProcessQueueIterator& iter, uint32_t priority) {
     uint32_t oldPriority = (*iter)->GetPriority();
-    auto nextQueIter = next(iter);
     mPriorityQueue[priority].splice(mPriorityQueue[priority].end(), mPriorityQueue[oldPriority], iter);
     (*iter)->SetPriority(priority);
-    if (mCurrentQueueIndex.first == oldPriority && mCurrentQueueIndex.second == iter) {
-        if (nextQueIter == mPriorityQueue[oldPriority].end()) {
-            mCurrentQueueIndex.second = mPriorityQueue[oldPriority].begin();
-        } else {
-            mCurrentQueueIndex.second = nextQueIter;
-        }
+    auto readyIter = mReadyQueueIndex.find((*iter)->GetKey());
+    if (readyIter != mReadyQueueIndex.end()) {
+        mReadyQueues[priority].splice(mReadyQueues[priority].end(), mReadyQueues[oldPriority], readyIter->second);
     }
 }
 
 void ProcessQueueManager::DeleteQueueEntity(const ProcessQueueIterator& iter) {
-    uint32_t priority = (*iter)->GetPriority();
-    auto nextQueIter = mPriorityQueue[priority].erase(iter);
-    if (mCurrentQueueIndex.first == priority && mCurrentQueueIndex.second == iter) {
-        if (nextQueIter == mPriorityQueue[priority].end()) {
-            mCurrentQueueIndex.second = mPriorityQueue[priority].begin();
-        } else {
-            mCurrentQueueIndex.second = nextQueIter;
-        }
+    RemoveReadyQueue((*iter)->GetKey());
+    mPriorityQueue[(*iter)->GetPriority()].erase(iter);
+}
+
+void ProcessQueueManager::AddReadyQueue(const ProcessQueueIterator& iter) {
+    QueueKey key = (*iter)->GetKey();
+    if (mReadyQueueIndex.find(key) != mReadyQueueIndex.end()) {
+        return;
     }
+    auto& readyQueues = mReadyQueues[(*iter)->GetPriority()];
+    mReadyQueueIndex[key] = readyQueues.insert(readyQueues.end(), iter);
 }
 
-void ProcessQueueManager::ResetCurrentQueueIndex() {
-    mCurrentQueueIndex.first = 0;
-    mCurrentQueueIndex.second = mPriorityQueue[0].begin();
+void ProcessQueueManager::RemoveReadyQueue(QueueKey key) {
+    auto iter = mReadyQueueIndex.find(key);
+    if (iter == mReadyQueueIndex.end()) {
+        return;
+    }
+    mReadyQueues[(**iter->second)->GetPriority()].erase(iter->second);
+    mReadyQueueIndex.erase(iter);
 }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -335,8 +320,9 @@ void ProcessQueueManager::Clear() {
     mQueues.clear();
     for (size_t i = 0; i <= sMaxPriority; ++i) {
         mPriorityQueue[i].clear();
+        mReadyQueues[i].clear();
     }
-    ResetCurrentQueueIndex();
+    mReadyQueueIndex.clear();
 }
 #endif
 
@@ -76,14 +76,17 @@ private:
     void CreateCircularQueue(QueueKey key, uint32_t priority, size_t capacity, const PipelineContext& ctx);
     void AdjustQueuePriority(const ProcessQueueIterator& iter, uint32_t priority);
     void DeleteQueueEntity(const ProcessQueueIterator& iter);
-    void ResetCurrentQueueIndex();
+    void AddReadyQueue(const ProcessQueueIterator& iter);
+    void RemoveReadyQueue(QueueKey key);
 
     BoundedQueueParam mBoundedQueueParam;
 
     mutable std::mutex mQueueMux;
     std::unordered_map<QueueKey, std::pair<ProcessQueueIterator, QueueType>> mQueues;
     std::list<std::unique_ptr<ProcessQueueInterface>> mPriorityQueue[sMaxPriority + 1];
-    std::pair<uint32_t, ProcessQueueIterator> mCurrentQueueIndex;
+    // non-empty queues of each priority in round-robin order, so that empty queues are never visited when popping
+    std::list<ProcessQueueIterator> mReadyQueues[sMaxPriority + 1];
+    std::unordered_map<QueueKey, std::list<ProcessQueueIterator>::iterator> mReadyQueueIndex;
 
     mutable std::mutex mStateMux;
     mutable std::condition_variable mCond;
@@ -93,6 +96,7 @@ private:
     void Clear();
     friend class ProcessQueueManagerUnittest;
     friend class PipelineUnittest;
+    friend class ProcessQueueManagerBenchmark;
 #endif
 };
 
@@ -32,6 +32,9 @@ struct SLSSenderQueueItem : public SenderQueueItem {
     std::string mLogstore;
     RangeCheckpointPtr mExactlyOnceCheckpoint;
 
+    // md5 of mData, which is calculated on the first send and reused by retries since mData never changes
+    std::string mContentMd5;
+
     std::string mCurrentEndpoint;
     bool mRealIpFlag = false;
     int32_t mLastLogWarningTime = 0; // temporaily used
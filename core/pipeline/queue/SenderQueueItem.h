@@ -44,6 +44,8 @@ struct SenderQueueItem {
     std::atomic<SendingStatus> mStatus;
     std::chrono::system_clock::time_point mFirstEnqueTime;
     std::chrono::system_clock::time_point mLastSendTime;
+    // earliest read time of the events, epoch if unknown
+    std::chrono::system_clock::time_point mReadTime;
     uint32_t mTryCnt = 1;
 
     SenderQueueItem(std::string&& data,
@@ -73,6 +75,7 @@ struct SenderQueueItem {
           mStatus(item.mStatus.load()),
           mFirstEnqueTime(item.mFirstEnqueTime),
           mLastSendTime(item.mLastSendTime),
+          mReadTime(item.mReadTime),
           mTryCnt(item.mTryCnt) {}
 
     virtual SenderQueueItem* Clone() { return new SenderQueueItem(*this); }
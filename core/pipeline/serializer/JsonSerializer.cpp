@@ -14,6 +14,10 @@
 
 #include "pipeline/serializer/JsonSerializer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
 #include "constants/SpanConstants.h"
 #include "protobuf/sls/LogGroupSerializer.h"
 
@@ -23,6 +27,373 @@ namespace logtail {
 
 const string JSON_KEY_TIME = "__time__";
 
+namespace {
+
+// the characters which must be escaped in a json string, non-ascii characters are escaped as jsoncpp does
+struct JsonEscapeTable {
+    bool mNeedEscape[256];
+
+    JsonEscapeTable() {
+        for (int i = 0; i < 256; ++i) {
+            mNeedEscape[i] = i < 0x20 || i == '"' || i == '\\' || i >= 0x80;
+        }
+    }
+};
+
+const JsonEscapeTable JSON_ESCAPE_TABLE;
+
+// \uxxxx
+void AppendUnicodeEscape(string& out, uint32_t codepoint) {
+    static const char* HEX_CHARS = "0123456789abcdef";
+    char buf[6] = {'\\',
+                   'u',
+                   HEX_CHARS[(codepoint >> 12) & 0xf],
+                   HEX_CHARS[(codepoint >> 8) & 0xf],
+                   HEX_CHARS[(codepoint >> 4) & 0xf],
+                   HEX_CHARS[codepoint & 0xf]};
+    out.append(buf, 6);
+}
+
+// decodes the utf-8 character starting at @p and moves @p to its last byte, invalid sequences are decoded to U+FFFD,
+// the same as jsoncpp
+uint32_t Utf8ToCodepoint(const char*& p, const char* end) {
+    const uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+    uint32_t firstByte = static_cast<unsigned char>(*p);
+    if (firstByte < 0x80) {
+        return firstByte;
+    }
+    if (firstByte < 0xE0) {
+        if (end - p < 2) {
+            return REPLACEMENT_CHARACTER;
+        }
+        uint32_t codepoint = ((firstByte & 0x1F) << 6) | (static_cast<uint32_t>(p[1]) & 0x3F);
+        p += 1;
+        return codepoint < 0x80 ? REPLACEMENT_CHARACTER : codepoint;
+    }
+    if (firstByte < 0xF0) {
+        if (end - p < 3) {
+            return REPLACEMENT_CHARACTER;
+        }
+        uint32_t codepoint = ((firstByte & 0x0F) << 12) | ((static_cast<uint32_t>(p[1]) & 0x3F) << 6)
+            | (static_cast<uint32_t>(p[2]) & 0x3F);
+        p += 2;
+        if (codepoint >= 0xD800 && codepoint <= 0xDFFF) {
+            return REPLACEMENT_CHARACTER;
+        }
+        return codepoint < 0x800 ? REPLACEMENT_CHARACTER : codepoint;
+    }
+    if (firstByte < 0xF8) {
+        if (end - p < 4) {
+            return REPLACEMENT_CHARACTER;
+        }
+        uint32_t codepoint = ((firstByte & 0x07) << 18) | ((static_cast<uint32_t>(p[1]) & 0x3F) << 12)
+            | ((static_cast<uint32_t>(p[2]) & 0x3F) << 6) | (static_cast<uint32_t>(p[3]) & 0x3F);
+        p += 3;
+        return codepoint < 0x10000 ? REPLACEMENT_CHARACTER : codepoint;
+    }
+    return REPLACEMENT_CHARACTER;
+}
+
+// same escaping as jsoncpp with default settings, so that the output does not change
+void AppendEscaped(string& out, StringView s) {
+    const char* end = s.data() + s.size();
+    const char* p = s.data();
+    while (p < end) {
+        // copy the plain part in one go
+        const char* plain = p;
+        while (p < end && !JSON_ESCAPE_TABLE.mNeedEscape[static_cast<unsigned char>(*p)]) {
+            ++p;
+        }
+        out.append(plain, p - plain);
+        if (p == end) {
+            break;
+        }
+        switch (*p) {
+            case '"':
+                out.append("\\\"", 2);
+                break;
+            case '\\':
+                out.append("\\\\", 2);
+                break;
+            case '\b':
+                out.append("\\b", 2);
+                break;
+            case '\f':
+                out.append("\\f", 2);
+                break;
+            case '\n':
+                out.append("\\n", 2);
+                break;
+            case '\r':
+                out.append("\\r", 2);
+                break;
+            case '\t':
+                out.append("\\t", 2);
+                break;
+            default: {
+                uint32_t codepoint = Utf8ToCodepoint(p, end);
+                if (codepoint < 0x10000) {
+                    AppendUnicodeEscape(out, codepoint);
+                } else {
+                    // surrogate pair
+                    codepoint -= 0x10000;
+                    AppendUnicodeEscape(out, 0xD800 + ((codepoint >> 10) & 0x3FF));
+                    AppendUnicodeEscape(out, 0xDC00 + (codepoint & 0x3FF));
+                }
+                break;
+            }
+        }
+        ++p;
+    }
+}
+
+void AppendString(string& out, StringView s) {
+    out.push_back('"');
+    AppendEscaped(out, s);
+    out.push_back('"');
+}
+
+// "key":
+void AppendKey(string& out, StringView key) {
+    AppendString(out, key);
+    out.push_back(':');
+}
+
+void AppendInt(string& out, int64_t val) {
+    char buf[24];
+    int len = snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(val));
+    out.append(buf, len);
+}
+
+// same format as jsoncpp, so that the output does not change
+void AppendDouble(string& out, double val) {
+    if (isnan(val)) {
+        out.append("null");
+        return;
+    }
+    if (isinf(val)) {
+        out.append(val < 0 ? "-1e+9999" : "1e+9999");
+        return;
+    }
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%.17g", val);
+    out.append(buf, len);
+    if (StringView(buf, len).find_first_of(".e") == StringView::npos) {
+        out.append(".0");
+    }
+}
+
+template <typename Iter>
+void AppendStringMap(string& out, Iter begin, Iter end, bool& first) {
+    for (auto it = begin; it != end; ++it) {
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+        AppendKey(out, it->first);
+        AppendString(out, it->second);
+    }
+}
+
+template <typename Iter>
+void AppendStringObject(string& out, Iter begin, Iter end) {
+    out.push_back('{');
+    bool first = true;
+    AppendStringMap(out, begin, end, first);
+    out.push_back('}');
+}
+
+// {"sum":1.0,"count":2.0,"buckets":{"0.5":1.0,"+Inf":2.0}}
+template <typename T>
+void AppendDistribution(string& out, const T& value, StringView pointsKey, const vector<pair<double, double>>& points) {
+    out.push_back('{');
+    AppendKey(out, "sum");
+    AppendDouble(out, value.mSum);
+    out.push_back(',');
+    AppendKey(out, "count");
+    AppendDouble(out, value.mCount);
+    out.push_back(',');
+    AppendKey(out, pointsKey);
+    out.push_back('{');
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (i > 0) {
+            out.push_back(',');
+        }
+        AppendKey(out, FormatPromFloat(points[i].first));
+        AppendDouble(out, points[i].second);
+    }
+    out.push_back('}');
+    out.push_back('}');
+}
+
+void AppendSpan(string& out, const SpanEvent& e) {
+    AppendKey(out, DEFAULT_TRACE_TAG_TRACE_ID);
+    AppendString(out, e.GetTraceId());
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_SPAN_ID);
+    AppendString(out, e.GetSpanId());
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_PARENT_ID);
+    AppendString(out, e.GetParentSpanId());
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_SPAN_NAME);
+    AppendString(out, e.GetName());
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_SPAN_KIND);
+    AppendString(out, GetKindString(e.GetKind()));
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_STATUS_CODE);
+    AppendString(out, GetStatusString(e.GetStatus()));
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_TRACE_STATE);
+    AppendString(out, e.GetTraceState());
+    out.push_back(',');
+    // tags and scope tags
+    AppendKey(out, DEFAULT_TRACE_TAG_ATTRIBUTES);
+    out.push_back('{');
+    bool first = true;
+    AppendStringMap(out, e.TagsBegin(), e.TagsEnd(), first);
+    AppendStringMap(out, e.ScopeTagsBegin(), e.ScopeTagsEnd(), first);
+    out.push_back('}');
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_LINKS);
+    out.push_back('[');
+    for (size_t i = 0; i < e.GetLinks().size(); ++i) {
+        const auto& link = e.GetLinks()[i];
+        if (i != 0) {
+            out.push_back(',');
+        }
+        out.push_back('{');
+        AppendKey(out, DEFAULT_TRACE_TAG_TRACE_ID);
+        AppendString(out, link.GetTraceId());
+        out.push_back(',');
+        AppendKey(out, DEFAULT_TRACE_TAG_SPAN_ID);
+        AppendString(out, link.GetSpanId());
+        out.push_back(',');
+        AppendKey(out, DEFAULT_TRACE_TAG_TRACE_STATE);
+        AppendString(out, link.GetTraceState());
+        out.push_back(',');
+        AppendKey(out, DEFAULT_TRACE_TAG_ATTRIBUTES);
+        AppendStringObject(out, link.TagsBegin(), link.TagsEnd());
+        out.push_back('}');
+    }
+    out.push_back(']');
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_EVENTS);
+    out.push_back('[');
+    for (size_t i = 0; i < e.GetEvents().size(); ++i) {
+        const auto& event = e.GetEvents()[i];
+        if (i != 0) {
+            out.push_back(',');
+        }
+        out.push_back('{');
+        AppendKey(out, DEFAULT_TRACE_TAG_SPAN_EVENT_NAME);
+        AppendString(out, event.GetName());
+        out.push_back(',');
+        AppendKey(out, DEFAULT_TRACE_TAG_TIMESTAMP);
+        AppendInt(out, static_cast<int64_t>(event.GetTimestampNs()));
+        out.push_back(',');
+        AppendKey(out, DEFAULT_TRACE_TAG_ATTRIBUTES);
+        AppendStringObject(out, event.TagsBegin(), event.TagsEnd());
+        out.push_back('}');
+    }
+    out.push_back(']');
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_START_TIME_NANO);
+    AppendInt(out, static_cast<int64_t>(e.GetStartTimeNs()));
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_END_TIME_NANO);
+    AppendInt(out, static_cast<int64_t>(e.GetEndTimeNs()));
+    out.push_back(',');
+    AppendKey(out, DEFAULT_TRACE_TAG_DURATION);
+    AppendInt(out, static_cast<int64_t>(e.GetEndTimeNs() - e.GetStartTimeNs()));
+}
+
+// a member of the top level object of an event
+struct JsonField {
+    enum class Type { STRING, INT, METRIC_LABELS, METRIC_VALUE };
+
+    JsonField(StringView key, StringView val) : mKey(key), mType(Type::STRING), mStr(val) {}
+    JsonField(StringView key, int64_t val) : mKey(key), mType(Type::INT), mInt(val) {}
+    JsonField(StringView key, Type type) : mKey(key), mType(type) {}
+
+    StringView mKey;
+    Type mType;
+    StringView mStr;
+    int64_t mInt = 0;
+};
+
+void AppendMetricValue(string& out, const MetricEvent& e) {
+    if (e.Is<UntypedSingleValue>()) {
+        AppendDouble(out, e.GetValue<UntypedSingleValue>()->mValue);
+    } else if (e.Is<UntypedMultiDoubleValues>()) {
+        const auto* values = e.GetValue<UntypedMultiDoubleValues>();
+        // null if there is no value, as before
+        if (values->ValusBegin() == values->ValusEnd()) {
+            out.append("null");
+            return;
+        }
+        out.push_back('{');
+        for (auto value = values->ValusBegin(); value != values->ValusEnd(); ++value) {
+            if (value != values->ValusBegin()) {
+                out.push_back(',');
+            }
+            AppendKey(out, value->first);
+            AppendDouble(out, value->second);
+        }
+        out.push_back('}');
+    } else if (e.Is<HistogramValue>()) {
+        const auto* value = e.GetValue<HistogramValue>();
+        AppendDistribution(out, *value, "buckets", value->mBuckets);
+    } else if (e.Is<SummaryValue>()) {
+        const auto* value = e.GetValue<SummaryValue>();
+        AppendDistribution(out, *value, "quantiles", value->mQuantiles);
+    }
+}
+
+// members are written in key order as jsoncpp does, and for members with the same key, the last one added wins, i.e.
+// the same output as setting them one by one to a Json::Value
+void AppendFields(string& out, vector<JsonField>& fields, const MetricEvent* metric = nullptr) {
+    stable_sort(fields.begin(), fields.end(), [](const JsonField& lhs, const JsonField& rhs) {
+        return lhs.mKey < rhs.mKey;
+    });
+    out.push_back('{');
+    bool first = true;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        const auto& field = fields[i];
+        if (i + 1 < fields.size() && fields[i + 1].mKey == field.mKey) {
+            continue;
+        }
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+        AppendKey(out, field.mKey);
+        switch (field.mType) {
+            case JsonField::Type::STRING:
+                AppendString(out, field.mStr);
+                break;
+            case JsonField::Type::INT:
+                AppendInt(out, field.mInt);
+                break;
+            case JsonField::Type::METRIC_LABELS:
+                // null if there is no label, as before
+                if (metric->TagsBegin() == metric->TagsEnd()) {
+                    out.append("null");
+                } else {
+                    AppendStringObject(out, metric->TagsBegin(), metric->TagsEnd());
+                }
+                break;
+            case JsonField::Type::METRIC_VALUE:
+                AppendMetricValue(out, *metric);
+                break;
+        }
+    }
+    out.push_back('}');
+}
+
+} // namespace
+
 bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, string& errorMsg) {
     if (group.mEvents.empty()) {
         errorMsg = "empty event group";
@@ -36,28 +407,32 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
         return false;
     }
 
-    Json::Value groupTags;
+    size_t tagsSize = 0;
     for (const auto& tag : group.mTags.mInner) {
-        groupTags[tag.first.to_string()] = tag.second.to_string();
+        tagsSize += tag.first.size() + tag.second.size() + 6;
     }
 
-    std::ostringstream oss;
+    // events are appended to res directly, so its capacity is reused by the caller
+    res.clear();
+    res.reserve(group.mSizeBytes + group.mEvents.size() * (tagsSize + 32));
+    // reused by all events
+    vector<JsonField> fields;
     switch (eventType) {
         case PipelineEvent::Type::LOG:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
                 const auto& e = group.mEvents[i].Cast<LogEvent>();
-                Json::Value eventJson;
-                // tags
-                eventJson.copy(groupTags);
-                // time
-                eventJson[JSON_KEY_TIME] = e.GetTimestamp();
+                fields.clear();
+                // tags, overridden by __time__ and contents
+                for (const auto& tag : group.mTags.mInner) {
+                    fields.emplace_back(tag.first, tag.second);
+                }
+                // time, overridden by contents
+                fields.emplace_back(JSON_KEY_TIME, static_cast<int64_t>(e.GetTimestamp()));
                 // contents
                 for (const auto& kv : e) {
-                    eventJson[kv.first.to_string()] = kv.second.to_string();
+                    fields.emplace_back(kv.first, kv.second);
                 }
-                Json::StreamWriterBuilder writer;
-                writer["indentation"] = "";
-                oss << Json::writeString(writer, eventJson);
+                AppendFields(res, fields);
             }
             break;
         case PipelineEvent::Type::METRIC:
@@ -66,38 +441,34 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
                 if (e.Is<std::monostate>()) {
                     continue;
                 }
-                Json::Value eventJson;
-                // tags
-                eventJson.copy(groupTags);
-                // time
-                eventJson[JSON_KEY_TIME] = e.GetTimestamp();
-                // __labels__
-                eventJson[METRIC_RESERVED_KEY_LABELS] = Json::Value();
-                for (auto tag = e.TagsBegin(); tag != e.TagsEnd(); tag++) {
-                    eventJson[METRIC_RESERVED_KEY_LABELS][tag->first.to_string()] = tag->second.to_string();
-                }
-                // __name__
-                eventJson[METRIC_RESERVED_KEY_NAME] = e.GetName().to_string();
-                // __value__
-                if (e.Is<UntypedSingleValue>()) {
-                    eventJson[METRIC_RESERVED_KEY_VALUE] = e.GetValue<UntypedSingleValue>()->mValue;
-                } else if (e.Is<UntypedMultiDoubleValues>()) {
-                    eventJson[METRIC_RESERVED_KEY_VALUE] = Json::Value();
-                    for (auto value = e.GetValue<UntypedMultiDoubleValues>()->ValusBegin();
-                         value != e.GetValue<UntypedMultiDoubleValues>()->ValusEnd();
-                         value++) {
-                        eventJson[METRIC_RESERVED_KEY_VALUE][value->first.to_string()] = value->second;
-                    }
+                fields.clear();
+                // tags, overridden by the reserved keys
+                for (const auto& tag : group.mTags.mInner) {
+                    fields.emplace_back(tag.first, tag.second);
                 }
-                Json::StreamWriterBuilder writer;
-                writer["indentation"] = "";
-                oss << Json::writeString(writer, eventJson);
+                fields.emplace_back(JSON_KEY_TIME, static_cast<int64_t>(e.GetTimestamp()));
+                fields.emplace_back(METRIC_RESERVED_KEY_LABELS, JsonField::Type::METRIC_LABELS);
+                fields.emplace_back(METRIC_RESERVED_KEY_NAME, e.GetName());
+                fields.emplace_back(METRIC_RESERVED_KEY_VALUE, JsonField::Type::METRIC_VALUE);
+                AppendFields(res, fields, &e);
             }
             break;
         case PipelineEvent::Type::SPAN:
-            LOG_ERROR(
-                sLogger,
-                ("invalid event type", "span type is not supported")("config", mFlusher->GetContext().GetConfigName()));
+            for (size_t i = 0; i < group.mEvents.size(); ++i) {
+                const auto& e = group.mEvents[i].Cast<SpanEvent>();
+                res.push_back('{');
+                for (const auto& tag : group.mTags.mInner) {
+                    AppendKey(res, tag.first);
+                    AppendString(res, tag.second);
+                    res.push_back(',');
+                }
+                // time
+                AppendKey(res, JSON_KEY_TIME);
+                AppendInt(res, e.GetTimestamp());
+                res.push_back(',');
+                AppendSpan(res, e);
+                res.push_back('}');
+            }
             break;
         case PipelineEvent::Type::RAW:
             LOG_ERROR(
@@ -107,8 +478,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
         default:
             break;
     }
-    res = oss.str();
     return true;
 }
 
-} // namespace logtail
\ No newline at end of file
+} // namespace logtail
@@ -22,6 +22,7 @@
 #include "common/compression/CompressType.h"
 #include "constants/SpanConstants.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
+#include "prometheus/Constants.h"
 #include "protobuf/sls/LogGroupSerializer.h"
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
@@ -30,6 +31,45 @@ using namespace std;
 
 namespace logtail {
 
+namespace {
+
+// histogram and summary values are serialized into one log per sample, as they are exposed in prometheus
+struct MetricLog {
+    size_t mEventIdx = 0;
+    string mValue;
+    // empty if the same as the event name, also overrides the __name__ label if not empty
+    string mName;
+    StringView mExtraLabelKey;
+    string mExtraLabelValue;
+    size_t mLabelSZ = 0;
+    size_t mLogSZ = 0;
+
+    MetricLog(size_t eventIdx, string&& value) : mEventIdx(eventIdx), mValue(std::move(value)) {}
+};
+
+template <typename T>
+void AddDistributionLogs(size_t eventIdx,
+                         const MetricEvent& e,
+                         const T& value,
+                         const vector<pair<double, double>>& points,
+                         StringView pointLabelKey,
+                         const string& pointNameSuffix,
+                         vector<MetricLog>& logs) {
+    string pointName = pointNameSuffix.empty() ? string() : e.GetName().to_string() + pointNameSuffix;
+    for (const auto& point : points) {
+        logs.emplace_back(eventIdx, to_string(point.second));
+        logs.back().mName = pointName;
+        logs.back().mExtraLabelKey = pointLabelKey;
+        logs.back().mExtraLabelValue = FormatPromFloat(point.first);
+    }
+    logs.emplace_back(eventIdx, to_string(value.mSum));
+    logs.back().mName = e.GetName().to_string() + prometheus::SUM_SUFFIX;
+    logs.emplace_back(eventIdx, to_string(value.mCount));
+    logs.back().mName = e.GetName().to_string() + prometheus::COUNT_SUFFIX;
+}
+
+} // namespace
+
 std::string SerializeSpanLinksToString(const SpanEvent& event) {
     if (event.GetLinks().empty()) {
         return "";
@@ -95,7 +135,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
 
     // caculate serialized logGroup size first, where some critical results can be cached
     vector<size_t> logSZ(group.mEvents.size());
-    vector<pair<string, size_t>> metricEventContentCache(group.mEvents.size());
+    vector<MetricLog> metricLogs;
     vector<array<string, 6>> spanEventContentCache(group.mEvents.size());
     size_t logGroupSZ = 0;
     switch (eventType) {
@@ -114,10 +154,18 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             break;
         }
         case PipelineEvent::Type::METRIC: {
+            metricLogs.reserve(group.mEvents.size());
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
                 const auto& e = group.mEvents[i].Cast<MetricEvent>();
                 if (e.Is<UntypedSingleValue>()) {
-                    metricEventContentCache[i].first = to_string(e.GetValue<UntypedSingleValue>()->mValue);
+                    metricLogs.emplace_back(i, to_string(e.GetValue<UntypedSingleValue>()->mValue));
+                } else if (e.Is<HistogramValue>()) {
+                    const auto* value = e.GetValue<HistogramValue>();
+                    AddDistributionLogs(
+                        i, e, *value, value->mBuckets, prometheus::BUCKET_LABEL, prometheus::BUCKET_SUFFIX, metricLogs);
+                } else if (e.Is<SummaryValue>()) {
+                    const auto* value = e.GetValue<SummaryValue>();
+                    AddDistributionLogs(i, e, *value, value->mQuantiles, prometheus::QUANTILE_LABEL, "", metricLogs);
                 } else {
                     // should not happen
                     LOG_ERROR(sLogger,
@@ -125,16 +173,19 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
                                "invalid metric event type")("config", mFlusher->GetContext().GetConfigName()));
                     continue;
                 }
-                metricEventContentCache[i].second = GetMetricLabelSize(e);
+            }
+            for (auto& log : metricLogs) {
+                const auto& e = group.mEvents[log.mEventIdx].Cast<MetricEvent>();
+                log.mLabelSZ = GetMetricLabelSize(e, log.mExtraLabelKey, log.mExtraLabelValue, log.mName);
 
                 size_t contentSZ = 0;
-                contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_NAME.size(), e.GetName().size());
-                contentSZ
-                    += GetLogContentSize(METRIC_RESERVED_KEY_VALUE.size(), metricEventContentCache[i].first.size());
+                contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_NAME.size(),
+                                               log.mName.empty() ? e.GetName().size() : log.mName.size());
+                contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_VALUE.size(), log.mValue.size());
                 contentSZ
                     += GetLogContentSize(METRIC_RESERVED_KEY_TIME_NANO.size(), e.GetTimestampNanosecond() ? 19U : 10U);
-                contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_LABELS.size(), metricEventContentCache[i].second);
-                logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
+                contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_LABELS.size(), log.mLabelSZ);
+                logGroupSZ += GetLogSize(contentSZ, false, log.mLogSZ);
             }
             break;
         }
@@ -234,17 +285,16 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             }
             break;
         case PipelineEvent::Type::METRIC:
-            for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<MetricEvent>();
-                if (e.Is<std::monostate>()) {
-                    continue;
-                }
-                serializer.StartToAddLog(logSZ[i]);
+            for (const auto& log : metricLogs) {
+                const auto& e = group.mEvents[log.mEventIdx].Cast<MetricEvent>();
+                serializer.StartToAddLog(log.mLogSZ);
                 serializer.AddLogTime(e.GetTimestamp());
-                serializer.AddLogContentMetricLabel(e, metricEventContentCache[i].second);
+                serializer.AddLogContentMetricLabel(
+                    e, log.mLabelSZ, log.mExtraLabelKey, log.mExtraLabelValue, log.mName);
                 serializer.AddLogContentMetricTimeNano(e);
-                serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, metricEventContentCache[i].first);
-                serializer.AddLogContent(METRIC_RESERVED_KEY_NAME, e.GetName());
+                serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, log.mValue);
+                serializer.AddLogContent(METRIC_RESERVED_KEY_NAME,
+                                         log.mName.empty() ? e.GetName() : StringView(log.mName));
             }
             break;
         case PipelineEvent::Type::SPAN:
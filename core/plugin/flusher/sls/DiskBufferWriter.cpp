@@ -14,6 +14,17 @@
 
 #include "plugin/flusher/sls/DiskBufferWriter.h"
 
+#if defined(__linux__)
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+#include <utility>
+
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
 #include "common/CompressTools.h"
@@ -22,6 +33,7 @@
 #include "common/FileSystemUtil.h"
 #include "common/RuntimeUtil.h"
 #include "common/StringTools.h"
+#include "common/http/Curl.h"
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
 #include "pipeline/limiter/RateLimiter.h"
@@ -29,6 +41,7 @@
 #include "pipeline/queue/SLSSenderQueueItem.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "plugin/flusher/sls/SLSClientManager.h"
+#include "plugin/flusher/sls/SLSResponse.h"
 #include "protobuf/sls/sls_logs.pb.h"
 #include "provider/Provider.h"
 #include "sdk/Exception.h"
@@ -41,6 +54,8 @@ DEFINE_FLAG_INT32(secondary_buffer_count_limit, "data ready for write buffer fil
 DEFINE_FLAG_INT32(send_retry_sleep_interval, "sleep microseconds when sync send fail, 50ms", 50000);
 DEFINE_FLAG_INT32(buffer_check_period, "check logtail local storage buffer period", 60);
 DEFINE_FLAG_INT32(unauthorized_wait_interval, "", 1);
+DEFINE_FLAG_BOOL(enable_buffer_file_sync, "sync buffer file to disk after each batch of data is written", true);
+DEFINE_FLAG_INT32(buffer_file_send_concurrency, "max count of buffered data sent concurrently when sending buffer file", 8);
 
 DECLARE_FLAG_INT32(discard_send_fail_interval);
 
@@ -50,6 +65,44 @@ namespace logtail {
 
 const int32_t DiskBufferWriter::BUFFER_META_BASE_SIZE = 65536;
 
+static bool WriteToFile(FILE* file, const vector<pair<const char*, size_t>>& pieces, bool sync) {
+#if defined(__linux__)
+    int fd = fileno(file);
+    vector<iovec> iovs;
+    iovs.reserve(pieces.size());
+    for (const auto& piece : pieces) {
+        iovs.push_back({const_cast<char*>(piece.first), piece.second});
+    }
+    size_t idx = 0;
+    while (idx < iovs.size()) {
+        ssize_t nbytes = writev(fd, &iovs[idx], static_cast<int>(min(iovs.size() - idx, static_cast<size_t>(IOV_MAX))));
+        if (nbytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        // skip the pieces written and continue from the partially written one
+        while (idx < iovs.size() && static_cast<size_t>(nbytes) >= iovs[idx].iov_len) {
+            nbytes -= iovs[idx].iov_len;
+            ++idx;
+        }
+        if (nbytes > 0) {
+            iovs[idx].iov_base = static_cast<char*>(iovs[idx].iov_base) + nbytes;
+            iovs[idx].iov_len -= nbytes;
+        }
+    }
+    return !sync || fdatasync(fd) == 0;
+#else
+    for (const auto& piece : pieces) {
+        if (fwrite(piece.first, 1, piece.second, file) != piece.second) {
+            return false;
+        }
+    }
+    return fflush(file) == 0;
+#endif
+}
+
 void DiskBufferWriter::Init() {
     mBufferDivideTime = time(NULL);
     mCheckPeriod = INT32_FLAG(buffer_check_period);
@@ -130,16 +183,18 @@ void DiskBufferWriter::BufferWriterThread() {
         // update bufferDiveideTime to flush data; buffer file before bufferDiveideTime will be ready for read
         if (time(NULL) - mBufferDivideTime > INT32_FLAG(buffer_file_alive_interval)) {
             CreateNewFile();
+            CloseBufferFile();
         }
 
         if (!res.empty()) {
+            SendToBufferFile(res);
             for (auto itr = res.begin(); itr != res.end(); ++itr) {
-                SendToBufferFile(*itr);
                 delete *itr;
             }
             res.clear();
         }
     }
+    CloseBufferFile();
 }
 
 void DiskBufferWriter::BufferSenderThread() {
@@ -162,6 +217,18 @@ void DiskBufferWriter::BufferSenderThread() {
             continue;
         }
         lock.unlock();
+        // forget files which have been removed
+        unordered_set<string> fileSet;
+        for (const auto& file : filesToSend) {
+            fileSet.insert(GetBufferFilePath() + file);
+        }
+        for (auto it = mBufferFileResumePos.begin(); it != mBufferFileResumePos.end();) {
+            if (fileSet.find(it->first) == fileSet.end()) {
+                it = mBufferFileResumePos.erase(it);
+            } else {
+                ++it;
+            }
+        }
         // mIsSendingBuffer = true;
         int32_t fileToSendCount = int32_t(filesToSend.size());
         int32_t bufferFileNumValue = AppConfig::GetInstance()->GetNumOfBufferFile();
@@ -281,6 +348,7 @@ bool DiskBufferWriter::LoadFileToSend(time_t timeLine, std::vector<std::string>&
 }
 
 bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
+                                          FILE* fin,
                                           const std::string& filename,
                                           std::string& encryption,
                                           EncryptionStateMeta& meta,
@@ -289,27 +357,10 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     bufferMeta.Clear();
     readResult = false;
     encryption.clear();
-    int retryTimes = 0;
 
-    FILE* fin = NULL;
-    while (true) {
-        retryTimes++;
-        fin = FileReadOnlyOpen(filename.c_str(), "rb");
-        if (fin)
-            break;
-        if (retryTimes >= 3) {
-            string errorStr = ErrnoToString(GetErrno());
-            AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
-                                                   string("open file error:") + filename + ",error:" + errorStr);
-            LOG_ERROR(sLogger, ("open file error", filename)("error", errorStr));
-            return false;
-        }
-        usleep(5000);
-    }
     fseek(fin, 0, SEEK_END);
     auto const currentSize = ftell(fin);
     if (currentSize == pos) {
-        fclose(fin);
         return false;
     }
     fseek(fin, pos, SEEK_SET);
@@ -324,7 +375,6 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
         LOG_ERROR(sLogger,
                   ("read encryption file meta error",
                    filename)("error", errorStr)("nbytes", nbytes)("pos", pos)("ftell", currentSize));
-        fclose(fin);
         return false;
     }
 
@@ -343,13 +393,11 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
         LOG_ERROR(sLogger,
                   ("meta of encryption file invalid", filename)("meta.mEncryptionSize", meta.mEncryptionSize)(
                       "meta.mEncodedInfoSize", meta.mEncodedInfoSize));
-        fclose(fin);
         return false;
     }
 
     pos += sizeof(meta) + encodedInfoSize + meta.mEncryptionSize;
     if ((time(NULL) - meta.mTimeStamp) > INT32_FLAG(log_expire_time) || meta.mHandled == 1) {
-        fclose(fin);
         if (meta.mHandled != 1) {
             LOG_WARNING(sLogger, ("timeout buffer file, meta.mTimeStamp", meta.mTimeStamp));
             AlarmManager::GetInstance()->SendAlarm(DISCARD_SECONDARY_ALARM,
@@ -361,7 +409,6 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     char* buffer = new char[encodedInfoSize + 1];
     nbytes = fread(buffer, sizeof(char), encodedInfoSize, fin);
     if (nbytes != static_cast<size_t>(encodedInfoSize)) {
-        fclose(fin);
         string errorStr = ErrnoToString(GetErrno());
         AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
                                                string("read projectname from file error:") + filename
@@ -377,7 +424,6 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     delete[] buffer;
     if (pbMeta) {
         if (!bufferMeta.ParseFromString(encodedInfo)) {
-            fclose(fin);
             AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
                                                    string("parse buffer meta from file error:") + filename);
             LOG_ERROR(sLogger, ("parse buffer meta from file error", filename)("buffer meta", encodedInfo));
@@ -399,7 +445,6 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     buffer = new char[meta.mEncryptionSize + 1];
     nbytes = fread(buffer, sizeof(char), meta.mEncryptionSize, fin);
     if (nbytes != static_cast<size_t>(meta.mEncryptionSize)) {
-        fclose(fin);
         string errorStr = ErrnoToString(GetErrno());
         AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
                                                string("read encryption from file error:") + filename
@@ -414,114 +459,170 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     encryption = string(buffer, meta.mEncryptionSize);
     readResult = true;
     delete[] buffer;
-    fclose(fin);
     return true;
 }
 
 void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t keyVersion) {
+    FILE* fin = NULL;
+    int retryTimes = 0;
+    while (true) {
+        retryTimes++;
+        fin = FileReadOnlyOpen(filename.c_str(), "rb");
+        if (fin)
+            break;
+        if (retryTimes >= 3) {
+            string errorStr = ErrnoToString(GetErrno());
+            AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
+                                                   string("open file error:") + filename + ",error:" + errorStr);
+            LOG_ERROR(sLogger, ("open file error", filename)("error", errorStr));
+            return;
+        }
+        usleep(5000);
+    }
+
     string encryption;
-    string logData;
     EncryptionStateMeta meta;
     bool readResult;
     bool writeBack = false;
     int32_t pos = INT32_FLAG(file_encryption_header_length);
+    // records before the resume position have all been handled in previous rounds
+    auto resumeIter = mBufferFileResumePos.find(filename);
+    if (resumeIter != mBufferFileResumePos.end()) {
+        pos = resumeIter->second;
+    } else {
+        pos = max(pos, ReadResumePos(fin));
+    }
+    const int32_t initialPos = pos;
+    int32_t resumePos = -1;
     sls_logs::LogtailBufferMeta bufferMeta;
     int32_t discardCount = 0;
-    while (ReadNextEncryption(pos, filename, encryption, meta, readResult, bufferMeta)) {
-        logData.clear();
-        bool sendResult = false;
-        if (!readResult || bufferMeta.project().empty()) {
-            if (meta.mHandled == 1)
+    const size_t concurrency = static_cast<size_t>(max(1, INT32_FLAG(buffer_file_send_concurrency)));
+    vector<BufferRecord> records;
+    records.reserve(concurrency);
+    bool hasMore = true;
+    while (hasMore) {
+        // collect a batch of records and send them concurrently
+        records.clear();
+        while (records.size() < concurrency) {
+            int32_t recordPos = pos;
+            if (!ReadNextEncryption(pos, fin, filename, encryption, meta, readResult, bufferMeta)) {
+                hasMore = false;
+                break;
+            }
+            string logData;
+            bool discard = false;
+            if (!readResult || bufferMeta.project().empty()) {
+                if (meta.mHandled == 1)
+                    continue;
+                discard = true;
+                discardCount++;
+            }
+            if (!discard) {
+                char* des = new char[meta.mLogDataSize];
+                if (!FileEncryption::GetInstance()->Decrypt(
+                        encryption.c_str(), meta.mEncryptionSize, des, meta.mLogDataSize, keyVersion)) {
+                    discard = true;
+                    discardCount++;
+                    LOG_ERROR(sLogger,
+                              ("decrypt error, project_name",
+                               bufferMeta.project())("key_version", keyVersion)("meta.mLogDataSize", meta.mLogDataSize));
+                    AlarmManager::GetInstance()->SendAlarm(ENCRYPT_DECRYPT_FAIL_ALARM,
+                                                           string("decrypt error, project_name:" + bufferMeta.project()
+                                                                  + ", key_version:" + ToString(keyVersion)
+                                                                  + ", meta.mLogDataSize:"
+                                                                  + ToString(meta.mLogDataSize)));
+                } else {
+                    if (bufferMeta.has_logstore())
+                        logData = string(des, meta.mLogDataSize);
+                    else {
+                        // compatible to old buffer file (logGroup string), convert to LZ4 compressed
+                        string logGroupStr = string(des, meta.mLogDataSize);
+                        sls_logs::LogGroup logGroup;
+                        if (!logGroup.ParseFromString(logGroupStr)) {
+                            discard = true;
+                            LOG_ERROR(sLogger,
+                                      ("parse error from string to loggroup, projectName is", bufferMeta.project()));
+                            discardCount++;
+                            AlarmManager::GetInstance()->SendAlarm(
+                                LOG_GROUP_PARSE_FAIL_ALARM,
+                                string("projectName is:" + bufferMeta.project() + ", fileName is:" + filename));
+                        } else if (!CompressLz4(logGroupStr, logData)) {
+                            discard = true;
+                            LOG_ERROR(sLogger, ("LZ4 compress loggroup fail, projectName is", bufferMeta.project()));
+                            discardCount++;
+                            AlarmManager::GetInstance()->SendAlarm(
+                                SEND_COMPRESS_FAIL_ALARM,
+                                string("projectName is:" + bufferMeta.project() + ", fileName is:" + filename));
+                        } else {
+                            bufferMeta.set_logstore(logGroup.category());
+                            bufferMeta.set_datatype(int(RawDataType::EVENT_GROUP));
+                            bufferMeta.set_rawsize(meta.mLogDataSize);
+                            bufferMeta.set_compresstype(sls_logs::SLS_CMP_LZ4);
+                            bufferMeta.set_telemetrytype(sls_logs::SLS_TELEMETRY_TYPE_LOGS);
+                        }
+                    }
+                }
+                delete[] des;
+            }
+            if (discard) {
+                meta.mHandled = 1;
+                WriteBackMeta(recordPos, (char*)&meta, sizeof(meta), filename);
                 continue;
-            sendResult = true;
-            discardCount++;
+            }
+            records.emplace_back();
+            auto& record = records.back();
+            record.mPos = recordPos;
+            record.mMeta = meta;
+            record.mBufferMeta.Swap(&bufferMeta);
+            record.mItem = make_unique<SenderQueueItem>(std::move(logData), record.mBufferMeta.rawsize(), nullptr, 0);
         }
-        if (!sendResult) {
-            char* des = new char[meta.mLogDataSize];
-            if (!FileEncryption::GetInstance()->Decrypt(
-                    encryption.c_str(), meta.mEncryptionSize, des, meta.mLogDataSize, keyVersion)) {
+
+        SendBufferRecords(records);
+        for (auto& record : records) {
+            bool sendResult = false;
+            if (record.mSendResult == SEND_OK)
+                sendResult = true;
+            else if (record.mSendResult == SEND_DISCARD_ERROR || record.mSendResult == SEND_PARAMETER_INVALID) {
+                AlarmManager::GetInstance()->SendAlarm(SEND_DATA_FAIL_ALARM,
+                                                       string("send buffer file fail, rawsize:")
+                                                           + ToString(record.mBufferMeta.rawsize())
+                                                           + "errorCode: " + record.mErrorCode,
+                                                       record.mBufferMeta.project(),
+                                                       record.mBufferMeta.logstore(),
+                                                       "");
                 sendResult = true;
                 discardCount++;
-                LOG_ERROR(sLogger,
-                          ("decrypt error, project_name",
-                           bufferMeta.project())("key_version", keyVersion)("meta.mLogDataSize", meta.mLogDataSize));
-                AlarmManager::GetInstance()->SendAlarm(ENCRYPT_DECRYPT_FAIL_ALARM,
-                                                       string("decrypt error, project_name:" + bufferMeta.project()
-                                                              + ", key_version:" + ToString(keyVersion)
-                                                              + ", meta.mLogDataSize:" + ToString(meta.mLogDataSize)));
+            }
+            LOG_DEBUG(sLogger,
+                      ("send LogGroup from local buffer file", filename)("rawsize", record.mBufferMeta.rawsize())(
+                          "sendResult", sendResult));
+            if (sendResult) {
+                record.mMeta.mHandled = 1;
+                WriteBackMeta(record.mPos, (char*)&record.mMeta, sizeof(record.mMeta), filename);
             } else {
-                if (bufferMeta.has_logstore())
-                    logData = string(des, meta.mLogDataSize);
-                else {
-                    // compatible to old buffer file (logGroup string), convert to LZ4 compressed
-                    string logGroupStr = string(des, meta.mLogDataSize);
-                    sls_logs::LogGroup logGroup;
-                    if (!logGroup.ParseFromString(logGroupStr)) {
-                        sendResult = true;
-                        LOG_ERROR(sLogger,
-                                  ("parse error from string to loggroup, projectName is", bufferMeta.project()));
-                        discardCount++;
-                        AlarmManager::GetInstance()->SendAlarm(
-                            LOG_GROUP_PARSE_FAIL_ALARM,
-                            string("projectName is:" + bufferMeta.project() + ", fileName is:" + filename));
-                    } else if (!CompressLz4(logGroupStr, logData)) {
-                        sendResult = true;
-                        LOG_ERROR(sLogger, ("LZ4 compress loggroup fail, projectName is", bufferMeta.project()));
-                        discardCount++;
-                        AlarmManager::GetInstance()->SendAlarm(
-                            SEND_COMPRESS_FAIL_ALARM,
-                            string("projectName is:" + bufferMeta.project() + ", fileName is:" + filename));
-                    } else {
-                        bufferMeta.set_logstore(logGroup.category());
-                        bufferMeta.set_datatype(int(RawDataType::EVENT_GROUP));
-                        bufferMeta.set_rawsize(meta.mLogDataSize);
-                        bufferMeta.set_compresstype(sls_logs::SLS_CMP_LZ4);
-                        bufferMeta.set_telemetrytype(sls_logs::SLS_TELEMETRY_TYPE_LOGS);
-                    }
-                }
-                if (!sendResult) {
-                    string errorCode;
-                    SendResult res = SendBufferFileData(bufferMeta, logData, errorCode);
-                    if (res == SEND_OK)
-                        sendResult = true;
-                    else if (res == SEND_DISCARD_ERROR || res == SEND_PARAMETER_INVALID) {
-                        AlarmManager::GetInstance()->SendAlarm(SEND_DATA_FAIL_ALARM,
-                                                               string("send buffer file fail, rawsize:")
-                                                                   + ToString(bufferMeta.rawsize())
-                                                                   + "errorCode: " + errorCode,
-                                                               bufferMeta.project(),
-                                                               bufferMeta.logstore(),
-                                                               "");
-                        sendResult = true;
-                        discardCount++;
-                    }
+                writeBack = true;
+                if (resumePos < 0) {
+                    resumePos = record.mPos;
                 }
             }
-            delete[] des;
-        }
-        if (sendResult)
-            meta.mHandled = 1;
-        LOG_DEBUG(sLogger,
-                  ("send LogGroup from local buffer file", filename)("rawsize", bufferMeta.rawsize())("sendResult",
-                                                                                                      sendResult));
-        WriteBackMeta(pos - meta.mEncryptionSize - sizeof(meta)
-                          - (meta.mEncodedInfoSize > BUFFER_META_BASE_SIZE
-                                 ? (meta.mEncodedInfoSize - BUFFER_META_BASE_SIZE)
-                                 : meta.mEncodedInfoSize),
-                      (char*)&meta,
-                      sizeof(meta),
-                      filename);
-        if (!sendResult)
-            writeBack = true;
+        }
         {
             lock_guard<mutex> lock(mBufferSenderThreadRunningMux);
             if (!mIsSendBufferThreadRunning) {
+                fclose(fin);
+                resumePos = resumePos < 0 ? pos : resumePos;
+                mBufferFileResumePos[filename] = resumePos;
+                if (resumePos != initialPos) {
+                    WriteBackResumePos(resumePos, filename);
+                }
                 return;
             }
         }
     }
+    fclose(fin);
     if (!writeBack) {
         remove(filename.c_str());
+        mBufferFileResumePos.erase(filename);
         if (discardCount > 0) {
             LOG_ERROR(sLogger, ("send buffer file, discard LogGroup count", discardCount)("delete file", filename));
             AlarmManager::GetInstance()->SendAlarm(DISCARD_SECONDARY_ALARM,
@@ -529,7 +630,285 @@ void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t
                                                        + ToString(discardCount) + " logGroups");
         } else
             LOG_INFO(sLogger, ("send buffer file success, delete buffer file", filename));
+    } else {
+        mBufferFileResumePos[filename] = resumePos;
+        if (resumePos != initialPos) {
+            WriteBackResumePos(resumePos, filename);
+        }
+    }
+}
+
+void DiskBufferWriter::SendBufferRecords(std::vector<BufferRecord>& records) {
+    if (records.empty()) {
+        return;
+    }
+    CURLM* multi = curl_multi_init();
+    if (multi == nullptr) {
+        LOG_ERROR(sLogger, ("failed to send buffer file data", "failed to init curl multi handle"));
+        return;
+    }
+    vector<BufferRecord*> pending;
+    for (auto& record : records) {
+        pending.push_back(&record);
+    }
+    time_t beginTime = time(NULL);
+    while (true) {
+        mSendBufferRecordsFunc(multi, pending);
+        vector<BufferRecord*> failed;
+        for (auto record : pending) {
+            if (record->mSent
+                && (record->mSendResult == SEND_NETWORK_ERROR || record->mSendResult == SEND_SERVER_ERROR
+                    || record->mSendResult == SEND_QUOTA_EXCEED || record->mSendResult == SEND_UNAUTHORIZED)) {
+                failed.push_back(record);
+            }
+        }
+        if (failed.empty()) {
+            break;
+        }
+        if (time(NULL) - beginTime >= INT32_FLAG(discard_send_fail_interval)) {
+            for (auto record : failed) {
+                record->mSendResult = SEND_DISCARD_ERROR;
+            }
+            break;
+        }
+        {
+            // back off before the next send rather than in the completion loop, so that responses of other records
+            // are not delayed
+            unique_lock<mutex> lock(mBufferSenderThreadRunningMux);
+            if (mStopCV.wait_for(lock, chrono::microseconds(GetSendRetryInterval(failed)), [this]() {
+                    return !mIsSendBufferThreadRunning;
+                })) {
+                break;
+            }
+        }
+        pending.swap(failed);
+    }
+    curl_multi_cleanup(multi);
+}
+
+int32_t DiskBufferWriter::GetSendRetryInterval(const std::vector<BufferRecord*>& failed) {
+    int32_t interval = INT32_FLAG(send_retry_sleep_interval);
+    for (auto record : failed) {
+        if (record->mSendResult == SEND_QUOTA_EXCEED) {
+            interval = max(interval, INT32_FLAG(quota_exceed_wait_interval));
+        } else if (record->mSendResult == SEND_UNAUTHORIZED) {
+            interval = max(interval, INT32_FLAG(unauthorized_wait_interval));
+        }
     }
+    return interval;
+}
+
+void DiskBufferWriter::SendBufferRecordsOnce(CURLM* multi, const std::vector<BufferRecord*>& records) {
+    struct Request {
+        BufferRecord* mRecord = nullptr;
+        unique_ptr<HttpSinkRequest> mRequest;
+        CURL* mCurl = nullptr;
+        curl_slist* mHeaders = nullptr;
+        string mRegion;
+        string mEndpoint;
+    };
+
+    vector<Request> requests(records.size());
+    int runningHandlers = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        auto& record = *records[i];
+        auto& request = requests[i];
+        const auto& bufferMeta = record.mBufferMeta;
+        request.mRecord = &record;
+        record.mSent = false;
+        record.mSendResult = SEND_NETWORK_ERROR;
+        record.mErrorCode.clear();
+        record.mErrorMsg.clear();
+
+        RateLimiter::FlowControl(bufferMeta.rawsize(), mSendLastTime, mSendLastByte, false);
+        request.mRegion = bufferMeta.endpoint();
+        if (request.mRegion.find("http://") == 0) // old buffer file which record the endpoint
+            request.mRegion = SLSClientManager::GetInstance()->GetRegionFromEndpoint(request.mRegion);
+        sdk::Client* sendClient = SLSClientManager::GetInstance()->GetClient(request.mRegion, bufferMeta.aliuid());
+        request.mEndpoint = sendClient->GetRawSlsHost();
+        if (request.mEndpoint.empty()) {
+            continue;
+        }
+
+        record.mSent = true;
+        const string& logData = record.mItem->mData;
+        if (bufferMeta.datatype() == int(RawDataType::EVENT_GROUP)) {
+            if (bufferMeta.has_telemetrytype() && bufferMeta.telemetrytype() == sls_logs::SLS_TELEMETRY_TYPE_METRICS) {
+                request.mRequest = sendClient->CreatePostMetricStoreLogsRequest(bufferMeta.project(),
+                                                                                bufferMeta.logstore(),
+                                                                                bufferMeta.compresstype(),
+                                                                                logData,
+                                                                                "",
+                                                                                bufferMeta.rawsize(),
+                                                                                record.mItem.get());
+            } else {
+                request.mRequest = sendClient->CreatePostLogStoreLogsRequest(bufferMeta.project(),
+                                                                             bufferMeta.logstore(),
+                                                                             bufferMeta.compresstype(),
+                                                                             logData,
+                                                                             "",
+                                                                             bufferMeta.rawsize(),
+                                                                             record.mItem.get(),
+                                                                             bufferMeta.shardhashkey());
+            }
+        } else {
+            request.mRequest = sendClient->CreatePostLogStoreLogPackageListRequest(bufferMeta.project(),
+                                                                                   bufferMeta.logstore(),
+                                                                                   bufferMeta.compresstype(),
+                                                                                   logData,
+                                                                                   "",
+                                                                                   record.mItem.get(),
+                                                                                   bufferMeta.shardhashkey());
+        }
+        if (!request.mRequest) {
+            record.mSendResult = SEND_UNAUTHORIZED;
+            record.mErrorCode = sdk::LOGE_UNAUTHORIZED;
+            OnBufferRecordSent(record, request.mRegion, request.mEndpoint);
+            continue;
+        }
+
+        auto& req = request.mRequest;
+        request.mCurl = CreateCurlHandler(req->mMethod,
+                                          req->mHTTPSFlag,
+                                          req->mHost,
+                                          req->mPort,
+                                          req->mUrl,
+                                          req->mQueryString,
+                                          req->mHeader,
+                                          req->GetBody(),
+                                          req->mResponse,
+                                          request.mHeaders,
+                                          req->mTimeout,
+                                          AppConfig::GetInstance()->IsHostIPReplacePolicyEnabled(),
+                                          AppConfig::GetInstance()->GetBindInterface());
+        if (request.mCurl == nullptr) {
+            record.mErrorCode = sdk::LOGE_REQUEST_ERROR;
+            record.mErrorMsg = "failed to init curl handler";
+            OnBufferRecordSent(record, request.mRegion, request.mEndpoint);
+            continue;
+        }
+        curl_easy_setopt(request.mCurl, CURLOPT_PRIVATE, &request);
+        if (curl_multi_add_handle(multi, request.mCurl) != CURLM_OK) {
+            curl_easy_cleanup(request.mCurl);
+            request.mCurl = nullptr;
+            record.mErrorCode = sdk::LOGE_REQUEST_ERROR;
+            record.mErrorMsg = "failed to add the easy curl handle to multi_handle";
+            OnBufferRecordSent(record, request.mRegion, request.mEndpoint);
+            continue;
+        }
+        ++runningHandlers;
+    }
+
+    while (runningHandlers > 0) {
+        CURLMcode mc = curl_multi_perform(multi, &runningHandlers);
+        if (mc != CURLM_OK) {
+            LOG_ERROR(sLogger, ("failed to call curl_multi_perform", "retry later")("errMsg", curl_multi_strerror(mc)));
+            break;
+        }
+        int msgsLeft = 0;
+        CURLMsg* msg = nullptr;
+        while ((msg = curl_multi_info_read(multi, &msgsLeft)) != nullptr) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            Request* request = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &request);
+            auto& record = *request->mRecord;
+            auto& response = request->mRequest->mResponse;
+            // the same error codes as those of sync sending in sdk client
+            switch (msg->data.result) {
+                case CURLE_OK: {
+                    long statusCode = 0;
+                    curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &statusCode);
+                    response.SetStatusCode(statusCode);
+                    if (!IsSLSResponse(response)) {
+                        record.mErrorCode = sdk::LOGE_REQUEST_ERROR;
+                        record.mErrorMsg = "Get invalid response";
+                        break;
+                    }
+                    SLSResponse slsResponse;
+                    slsResponse.Parse(response);
+                    if (slsResponse.mStatusCode != 200) {
+                        record.mErrorCode = slsResponse.mErrorCode;
+                        record.mErrorMsg = slsResponse.mErrorMsg;
+                    }
+                    break;
+                }
+                case CURLE_OPERATION_TIMEDOUT:
+                    record.mErrorCode = sdk::LOGE_CLIENT_OPERATION_TIMEOUT;
+                    record.mErrorMsg = "Request operation timeout.";
+                    break;
+                case CURLE_COULDNT_CONNECT:
+                    record.mErrorCode = sdk::LOGE_REQUEST_TIMEOUT;
+                    record.mErrorMsg = "Can not connect to server.";
+                    break;
+                default:
+                    record.mErrorCode = sdk::LOGE_REQUEST_ERROR;
+                    record.mErrorMsg = string("Request operation failed, curl error code : ")
+                        + curl_easy_strerror(msg->data.result);
+                    break;
+            }
+            record.mSendResult = record.mErrorCode.empty() ? SEND_OK : ConvertErrorCode(record.mErrorCode);
+            OnBufferRecordSent(record, request->mRegion, request->mEndpoint);
+            curl_multi_remove_handle(multi, request->mCurl);
+            curl_easy_cleanup(request->mCurl);
+            request->mCurl = nullptr;
+        }
+        if (runningHandlers > 0) {
+            curl_multi_wait(multi, nullptr, 0, 1000, nullptr);
+        }
+    }
+
+    for (auto& request : requests) {
+        if (request.mCurl != nullptr) {
+            curl_multi_remove_handle(multi, request.mCurl);
+            curl_easy_cleanup(request.mCurl);
+        }
+        if (request.mHeaders != nullptr) {
+            curl_slist_free_all(request.mHeaders);
+        }
+    }
+}
+
+void DiskBufferWriter::OnBufferRecordSent(BufferRecord& record, const string& region, const string& endpoint) {
+    if (record.mSendResult == SEND_OK) {
+        return;
+    }
+    const auto& bufferMeta = record.mBufferMeta;
+    bool hasAuthError = false;
+    switch (record.mSendResult) {
+        case SEND_NETWORK_ERROR:
+        case SEND_SERVER_ERROR:
+            SLSClientManager::GetInstance()->UpdateEndpointStatus(region, endpoint, false);
+            SLSClientManager::GetInstance()->ResetClientEndpoint(bufferMeta.aliuid(), region, time(NULL));
+            LOG_WARNING(sLogger,
+                        ("send data to SLS fail", "retry later")("error_code", record.mErrorCode)(
+                            "error_message", record.mErrorMsg)("endpoint", endpoint)("projectName",
+                                                                                     bufferMeta.project())(
+                            "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
+            break;
+        case SEND_QUOTA_EXCEED:
+            AlarmManager::GetInstance()->SendAlarm(SEND_QUOTA_EXCEED_ALARM,
+                                                   "error_code: " + record.mErrorCode
+                                                       + ", error_message: " + record.mErrorMsg,
+                                                   bufferMeta.project(),
+                                                   bufferMeta.logstore(),
+                                                   "");
+            // no region
+            if (!GetProfileSender()->IsProfileData("", bufferMeta.project(), bufferMeta.logstore()))
+                LOG_WARNING(sLogger,
+                            ("send data to SLS fail, error_code", record.mErrorCode)(
+                                "error_message", record.mErrorMsg)("endpoint", endpoint)(
+                                "projectName", bufferMeta.project())("logstore", bufferMeta.logstore())(
+                                "rawsize", bufferMeta.rawsize()));
+            break;
+        case SEND_UNAUTHORIZED:
+            hasAuthError = true;
+            break;
+        default:
+            break;
+    }
+    SLSClientManager::GetInstance()->UpdateAccessKeyStatus(bufferMeta.aliuid(), !hasAuthError);
 }
 
 // file is not really created when call CreateNewFile(), file created happened when SendToBufferFile() first called
@@ -603,6 +982,26 @@ bool DiskBufferWriter::WriteBackMeta(int32_t pos, const void* buf, int32_t lengt
 #endif
 }
 
+// the resume position is kept in the last bytes of the file header, which are zero padded and ignored when the header
+// is checked, so that files written by older versions are read from the first record
+int32_t DiskBufferWriter::ReadResumePos(FILE* fin) {
+    int32_t resumePos = 0;
+    fseek(fin, 0, SEEK_END);
+    auto const fileSize = ftell(fin);
+    fseek(fin, INT32_FLAG(file_encryption_header_length) - static_cast<int32_t>(sizeof(resumePos)), SEEK_SET);
+    if (fread(&resumePos, 1, sizeof(resumePos), fin) != sizeof(resumePos) || resumePos > fileSize) {
+        return 0;
+    }
+    return resumePos;
+}
+
+bool DiskBufferWriter::WriteBackResumePos(int32_t resumePos, const std::string& filename) {
+    return WriteBackMeta(INT32_FLAG(file_encryption_header_length) - static_cast<int32_t>(sizeof(resumePos)),
+                         &resumePos,
+                         sizeof(resumePos),
+                         filename);
+}
+
 string DiskBufferWriter::GetBufferFileHeader() {
     string reserve = STRING_FLAG(file_encryption_field_key_version) + STRING_FLAG(file_encryption_key_value_splitter)
         + ToString(FileEncryption::GetInstance()->GetDefaultKeyVersion());
@@ -612,228 +1011,118 @@ string DiskBufferWriter::GetBufferFileHeader() {
     return (STRING_FLAG(file_encryption_magic_number) + reserve + nullHeader);
 }
 
-bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
-    auto data = static_cast<SLSSenderQueueItem*>(dataPtr);
-    auto flusher = static_cast<const FlusherSLS*>(data->mFlusher);
+bool DiskBufferWriter::SendToBufferFile(const std::vector<SenderQueueItem*>& items) {
     string bufferFileName = GetBufferFileName();
     if (bufferFileName.empty()) {
         CreateNewFile();
         bufferFileName = GetBufferFileName();
     }
-    // if file not exist, create it new
-    FILE* fout = FileAppendOpen(bufferFileName.c_str(), "ab");
-    if (!fout) {
-        string errorStr = ErrnoToString(GetErrno());
-        AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
-                                               string("open file error:") + bufferFileName + ",error:" + errorStr);
-        LOG_ERROR(sLogger, ("open buffer file error", bufferFileName));
+    if (!OpenBufferFile(bufferFileName)) {
         return false;
     }
 
-    if (ftell(fout) == (streampos)0) {
-        string header = GetBufferFileHeader();
-        auto nbytes = fwrite(header.c_str(), 1, header.size(), fout);
-        if (header.size() != nbytes) {
-            string errorStr = ErrnoToString(GetErrno());
-            AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
-                                                   string("write file error:") + bufferFileName + ", error:" + errorStr
-                                                       + ", nbytes:" + ToString(nbytes));
-            LOG_ERROR(sLogger, ("error write encryption header", bufferFileName)("error", errorStr)("nbytes", nbytes));
-            fclose(fout);
-            return false;
-        }
+    // records of all items are written with one writev, and synced once
+    vector<EncryptionStateMeta> metas(items.size());
+    vector<string> encodedInfos(items.size());
+    vector<unique_ptr<char[]>> encryptions(items.size());
+    vector<pair<const char*, size_t>> pieces;
+    pieces.reserve(items.size() * 3 + 1);
+    string header;
+    if (mBufferFileSize == 0) {
+        header = GetBufferFileHeader();
+        pieces.emplace_back(header.data(), header.size());
     }
+    for (size_t i = 0; i < items.size(); ++i) {
+        auto data = static_cast<SLSSenderQueueItem*>(items[i]);
+        auto flusher = static_cast<const FlusherSLS*>(data->mFlusher);
 
-    char* des;
-    int32_t desLength;
-    if (!FileEncryption::GetInstance()->Encrypt(data->mData.c_str(), data->mData.size(), des, desLength)) {
-        fclose(fout);
-        LOG_ERROR(sLogger, ("encrypt error, project_name", flusher->mProject));
-        AlarmManager::GetInstance()->SendAlarm(ENCRYPT_DECRYPT_FAIL_ALARM,
-                                               string("encrypt error, project_name:" + flusher->mProject));
-        return false;
-    }
+        char* des;
+        int32_t desLength;
+        if (!FileEncryption::GetInstance()->Encrypt(data->mData.c_str(), data->mData.size(), des, desLength)) {
+            LOG_ERROR(sLogger, ("encrypt error, project_name", flusher->mProject));
+            AlarmManager::GetInstance()->SendAlarm(ENCRYPT_DECRYPT_FAIL_ALARM,
+                                                   string("encrypt error, project_name:" + flusher->mProject));
+            continue;
+        }
+        encryptions[i].reset(des);
 
-    sls_logs::LogtailBufferMeta bufferMeta;
-    bufferMeta.set_project(flusher->mProject);
-    bufferMeta.set_endpoint(flusher->mRegion);
-    bufferMeta.set_aliuid(flusher->mAliuid);
-    bufferMeta.set_logstore(data->mLogstore);
-    bufferMeta.set_datatype(int32_t(data->mType));
-    bufferMeta.set_rawsize(data->mRawSize);
-    bufferMeta.set_shardhashkey(data->mShardHashKey);
-    bufferMeta.set_compresstype(ConvertCompressType(flusher->GetCompressType()));
-    bufferMeta.set_telemetrytype(flusher->mTelemetryType);
-    string encodedInfo;
-    bufferMeta.SerializeToString(&encodedInfo);
+        sls_logs::LogtailBufferMeta bufferMeta;
+        bufferMeta.set_project(flusher->mProject);
+        bufferMeta.set_endpoint(flusher->mRegion);
+        bufferMeta.set_aliuid(flusher->mAliuid);
+        bufferMeta.set_logstore(data->mLogstore);
+        bufferMeta.set_datatype(int32_t(data->mType));
+        bufferMeta.set_rawsize(data->mRawSize);
+        bufferMeta.set_shardhashkey(data->mShardHashKey);
+        bufferMeta.set_compresstype(ConvertCompressType(flusher->GetCompressType()));
+        bufferMeta.set_telemetrytype(flusher->mTelemetryType);
+        bufferMeta.SerializeToString(&encodedInfos[i]);
 
-    EncryptionStateMeta meta;
-    int32_t encodedInfoSize = encodedInfo.size();
-    meta.mEncodedInfoSize = encodedInfoSize + BUFFER_META_BASE_SIZE;
-    meta.mLogDataSize = data->mData.size();
-    meta.mTimeStamp = time(NULL);
-    meta.mHandled = 0;
-    meta.mRetryTime = 0;
-    meta.mEncryptionSize = desLength;
-    char* buffer = new char[sizeof(meta) + encodedInfoSize + meta.mEncryptionSize];
-    memcpy(buffer, (char*)&meta, sizeof(meta));
-    memcpy(buffer + sizeof(meta), encodedInfo.c_str(), encodedInfoSize);
-    memcpy(buffer + sizeof(meta) + encodedInfoSize, des, desLength);
-    delete[] des;
-    const auto bytesToWrite = sizeof(meta) + encodedInfoSize + meta.mEncryptionSize;
-    auto nbytes = fwrite(buffer, 1, bytesToWrite, fout);
-    if (nbytes != bytesToWrite) {
+        EncryptionStateMeta& meta = metas[i];
+        meta.mEncodedInfoSize = encodedInfos[i].size() + BUFFER_META_BASE_SIZE;
+        meta.mLogDataSize = data->mData.size();
+        meta.mTimeStamp = time(NULL);
+        meta.mHandled = 0;
+        meta.mRetryTime = 0;
+        meta.mEncryptionSize = desLength;
+        pieces.emplace_back(reinterpret_cast<const char*>(&meta), sizeof(meta));
+        pieces.emplace_back(encodedInfos[i].data(), encodedInfos[i].size());
+        pieces.emplace_back(des, desLength);
+    }
+
+    size_t bytesToWrite = 0;
+    for (const auto& piece : pieces) {
+        bytesToWrite += piece.second;
+    }
+    if (!WriteToFile(mBufferFile, pieces, BOOL_FLAG(enable_buffer_file_sync))) {
         string errorStr = ErrnoToString(GetErrno());
         AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
                                                string("write file error:") + bufferFileName + ", error:" + errorStr
-                                                   + ", nbytes:" + ToString(nbytes));
-        LOG_ERROR(
-            sLogger,
-            ("write meta of buffer file", "fail")("filename", bufferFileName)("errorStr", errorStr)("nbytes", nbytes));
-        delete[] buffer;
-        fclose(fout);
+                                                   + ", bytes:" + ToString(bytesToWrite));
+        LOG_ERROR(sLogger,
+                  ("write buffer file", "fail")("filename", bufferFileName)("errorStr", errorStr)("bytes",
+                                                                                                  bytesToWrite));
+        // the file may end with a partial record, so following data is written to a new file
+        CreateNewFile();
+        CloseBufferFile();
         return false;
     }
-    delete[] buffer;
-    if (ftell(fout) > AppConfig::GetInstance()->GetLocalFileSize())
+    mBufferFileSize += bytesToWrite;
+    if (mBufferFileSize > AppConfig::GetInstance()->GetLocalFileSize()) {
         CreateNewFile();
-    fclose(fout);
-    LOG_DEBUG(sLogger, ("write buffer file", bufferFileName));
+        CloseBufferFile();
+    }
+    LOG_DEBUG(sLogger, ("write buffer file", bufferFileName)("items", items.size())("bytes", bytesToWrite));
     return true;
 }
 
-SendResult DiskBufferWriter::SendBufferFileData(const sls_logs::LogtailBufferMeta& bufferMeta,
-                                                const std::string& logData,
-                                                std::string& errorCode) {
-    RateLimiter::FlowControl(bufferMeta.rawsize(), mSendLastTime, mSendLastByte, false);
-    string region = bufferMeta.endpoint();
-    if (region.find("http://") == 0) // old buffer file which record the endpoint
-        region = SLSClientManager::GetInstance()->GetRegionFromEndpoint(region);
-
-    sdk::Client* sendClient = SLSClientManager::GetInstance()->GetClient(region, bufferMeta.aliuid());
-    SendResult sendRes;
-    const string& endpoint = sendClient->GetRawSlsHost();
-    if (endpoint.empty())
-        sendRes = SEND_NETWORK_ERROR;
-    else {
-        sendRes = SendToNetSync(sendClient, region, endpoint, bufferMeta, logData, errorCode);
-    }
-    return sendRes;
+bool DiskBufferWriter::OpenBufferFile(const std::string& filename) {
+    if (mBufferFile != nullptr && mOpenedBufferFileName == filename) {
+        return true;
+    }
+    CloseBufferFile();
+    // if file not exist, create it new
+    mBufferFile = FileAppendOpen(filename.c_str(), "ab");
+    if (!mBufferFile) {
+        string errorStr = ErrnoToString(GetErrno());
+        AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
+                                               string("open file error:") + filename + ",error:" + errorStr);
+        LOG_ERROR(sLogger, ("open buffer file error", filename));
+        return false;
+    }
+    fseek(mBufferFile, 0, SEEK_END);
+    mBufferFileSize = ftell(mBufferFile);
+    mOpenedBufferFileName = filename;
+    return true;
 }
 
-SendResult DiskBufferWriter::SendToNetSync(sdk::Client* sendClient,
-                                           const std::string& region,
-                                           const std::string& endpoint,
-                                           const sls_logs::LogtailBufferMeta& bufferMeta,
-                                           const std::string& logData,
-                                           std::string& errorCode) {
-    int32_t retryTimes = 0;
-    time_t beginTime = time(NULL);
-    while (true) {
-        ++retryTimes;
-        try {
-            if (bufferMeta.datatype() == int(RawDataType::EVENT_GROUP)) {
-                if (bufferMeta.has_telemetrytype()
-                    && bufferMeta.telemetrytype() == sls_logs::SLS_TELEMETRY_TYPE_METRICS) {
-                    sendClient->PostMetricStoreLogs(bufferMeta.project(),
-                                                    bufferMeta.logstore(),
-                                                    bufferMeta.compresstype(),
-                                                    logData,
-                                                    bufferMeta.rawsize());
-                } else if (bufferMeta.has_shardhashkey() && !bufferMeta.shardhashkey().empty())
-                    sendClient->PostLogStoreLogs(bufferMeta.project(),
-                                                 bufferMeta.logstore(),
-                                                 bufferMeta.compresstype(),
-                                                 logData,
-                                                 bufferMeta.rawsize(),
-                                                 bufferMeta.shardhashkey());
-                else
-                    sendClient->PostLogStoreLogs(bufferMeta.project(),
-                                                 bufferMeta.logstore(),
-                                                 bufferMeta.compresstype(),
-                                                 logData,
-                                                 bufferMeta.rawsize());
-            } else {
-                if (bufferMeta.has_shardhashkey() && !bufferMeta.shardhashkey().empty())
-                    sendClient->PostLogStoreLogPackageList(bufferMeta.project(),
-                                                           bufferMeta.logstore(),
-                                                           bufferMeta.compresstype(),
-                                                           logData,
-                                                           bufferMeta.shardhashkey());
-                else
-                    sendClient->PostLogStoreLogPackageList(
-                        bufferMeta.project(), bufferMeta.logstore(), bufferMeta.compresstype(), logData);
-            }
-            return SEND_OK;
-        } catch (sdk::LOGException& ex) {
-            errorCode = ex.GetErrorCode();
-            SendResult sendRes = ConvertErrorCode(errorCode);
-            bool hasAuthError = false;
-            switch (sendRes) {
-                case SEND_NETWORK_ERROR:
-                case SEND_SERVER_ERROR:
-                    SLSClientManager::GetInstance()->UpdateEndpointStatus(region, endpoint, false);
-                    SLSClientManager::GetInstance()->ResetClientEndpoint(bufferMeta.aliuid(), region, time(NULL));
-                    LOG_WARNING(sLogger,
-                                ("send data to SLS fail", "retry later")("error_code", errorCode)(
-                                    "error_message", ex.GetMessage())("endpoint", sendClient->GetRawSlsHost())(
-                                    "projectName", bufferMeta.project())("logstore", bufferMeta.logstore())(
-                                    "RetryTimes", retryTimes)("rawsize", bufferMeta.rawsize()));
-                    usleep(INT32_FLAG(send_retry_sleep_interval));
-                    break;
-                case SEND_QUOTA_EXCEED:
-                    AlarmManager::GetInstance()->SendAlarm(SEND_QUOTA_EXCEED_ALARM,
-                                                           "error_code: " + errorCode
-                                                               + ", error_message: " + ex.GetMessage(),
-                                                           bufferMeta.project(),
-                                                           bufferMeta.logstore(),
-                                                           "");
-                    // no region
-                    if (!GetProfileSender()->IsProfileData("", bufferMeta.project(), bufferMeta.logstore()))
-                        LOG_WARNING(sLogger,
-                                    ("send data to SLS fail, error_code", errorCode)("error_message", ex.GetMessage())(
-                                        "endpoint", sendClient->GetRawSlsHost())("projectName", bufferMeta.project())(
-                                        "logstore", bufferMeta.logstore())("RetryTimes", retryTimes)(
-                                        "rawsize", bufferMeta.rawsize()));
-                    usleep(INT32_FLAG(quota_exceed_wait_interval));
-                    break;
-                case SEND_UNAUTHORIZED:
-                    hasAuthError = true;
-                    usleep(INT32_FLAG(unauthorized_wait_interval));
-                    break;
-                default:
-                    break;
-            }
-            SLSClientManager::GetInstance()->UpdateAccessKeyStatus(bufferMeta.aliuid(), !hasAuthError);
-            if (time(nullptr) - beginTime >= INT32_FLAG(discard_send_fail_interval)) {
-                sendRes = SEND_DISCARD_ERROR;
-            }
-            if (sendRes != SEND_NETWORK_ERROR && sendRes != SEND_SERVER_ERROR && sendRes != SEND_QUOTA_EXCEED
-                && sendRes != SEND_UNAUTHORIZED) {
-                return sendRes;
-            }
-            {
-                lock_guard<mutex> lock(mBufferSenderThreadRunningMux);
-                if (!mIsSendBufferThreadRunning) {
-                    return sendRes;
-                }
-            }
-        } catch (...) {
-            if (retryTimes >= INT32_FLAG(send_retrytimes)) {
-                LOG_ERROR(sLogger,
-                          ("send data fail", "unknown excepiton")("endpoint", sendClient->GetRawSlsHost())(
-                              "projectName", bufferMeta.project())("logstore", bufferMeta.logstore())(
-                              "rawsize", bufferMeta.rawsize()));
-                return SEND_DISCARD_ERROR;
-            } else {
-                LOG_DEBUG(sLogger,
-                          ("send data fail", "unknown excepiton, retry later")("endpoint", sendClient->GetRawSlsHost())(
-                              "projectName", bufferMeta.project())("logstore", bufferMeta.logstore())(
-                              "rawsize", bufferMeta.rawsize()));
-                usleep(INT32_FLAG(send_retry_sleep_interval));
-            }
-        }
+void DiskBufferWriter::CloseBufferFile() {
+    if (mBufferFile != nullptr) {
+        fclose(mBufferFile);
+        mBufferFile = nullptr;
     }
+    mOpenedBufferFileName.clear();
+    mBufferFileSize = 0;
 }
 
-} // namespace logtail
\ No newline at end of file
+} // namespace logtail
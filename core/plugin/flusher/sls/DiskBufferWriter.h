@@ -16,11 +16,17 @@
 
 #pragma once
 
+#include <curl/multi.h>
+
 #include <condition_variable>
 #include <cstdint>
+#include <cstdio>
+#include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/SafeQueue.h"
@@ -58,26 +64,41 @@ private:
         int32_t mRetryTime;
     };
 
+    // a record read from buffer file for replay
+    struct BufferRecord {
+        int32_t mPos = 0;
+        EncryptionStateMeta mMeta;
+        sls_logs::LogtailBufferMeta mBufferMeta;
+        // owns the log data, so that the request references it rather than copying it
+        std::unique_ptr<SenderQueueItem> mItem;
+        // false if the record is not sent at all, e.g. no endpoint is available, and it is left for the next replay
+        bool mSent = false;
+        SendResult mSendResult = SEND_NETWORK_ERROR;
+        std::string mErrorCode;
+        std::string mErrorMsg;
+    };
+
     DiskBufferWriter() = default;
     ~DiskBufferWriter() = default;
 
     void BufferWriterThread();
     void BufferSenderThread();
 
-    SendResult SendToNetSync(sdk::Client* sendClient,
-                             const std::string& region,
-                             const std::string& endpoint,
-                             const sls_logs::LogtailBufferMeta& bufferMeta,
-                             const std::string& logData,
-                             std::string& errorCode);
-    SendResult SendBufferFileData(const sls_logs::LogtailBufferMeta& bufferMeta,
-                                  const std::string& logData,
-                                  std::string& errorCode);
-    bool SendToBufferFile(SenderQueueItem* dataPtr);
+    void SendBufferRecords(std::vector<BufferRecord>& records);
+    void SendBufferRecordsOnce(CURLM* multi, const std::vector<BufferRecord*>& records);
+    // the backoff before retrying the failed records, in microseconds
+    static int32_t GetSendRetryInterval(const std::vector<BufferRecord*>& failed);
+    void OnBufferRecordSent(BufferRecord& record, const std::string& region, const std::string& endpoint);
+    bool SendToBufferFile(const std::vector<SenderQueueItem*>& items);
+    bool OpenBufferFile(const std::string& filename);
+    void CloseBufferFile();
     bool LoadFileToSend(time_t timeLine, std::vector<std::string>& filesToSend);
     bool CreateNewFile();
     bool WriteBackMeta(const int32_t pos, const void* buf, int32_t length, const std::string& filename);
+    int32_t ReadResumePos(FILE* fin);
+    bool WriteBackResumePos(int32_t resumePos, const std::string& filename);
     bool ReadNextEncryption(int32_t& pos,
+                            FILE* fin,
                             const std::string& filename,
                             std::string& encryption,
                             EncryptionStateMeta& meta,
@@ -104,12 +125,28 @@ private:
     std::string mBufferFilePath;
     std::string mBufferFileName;
 
+    // only accessed by buffer writer thread, the current buffer file is kept open until it is switched
+    FILE* mBufferFile = nullptr;
+    std::string mOpenedBufferFileName;
+    int64_t mBufferFileSize = 0;
+
+    // only accessed by buffer sender thread, position of the first unhandled record of each partially sent file, so
+    // that handled records are not scanned again. It is also persisted in the file header to survive restarts.
+    std::unordered_map<std::string, int32_t> mBufferFileResumePos;
+    // sends a batch of records concurrently, which can be replaced in tests to simulate the results
+    std::function<void(CURLM*, const std::vector<BufferRecord*>&)> mSendBufferRecordsFunc
+        = [this](CURLM* multi, const std::vector<BufferRecord*>& records) { SendBufferRecordsOnce(multi, records); };
+
     volatile time_t mBufferDivideTime = 0;
     // volatile bool mIsSendingBuffer = false;
     int64_t mCheckPeriod = 0;
 
     int64_t mSendLastTime = 0;
     int32_t mSendLastByte = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class DiskBufferWriterUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -602,17 +602,26 @@ bool FlusherSLS::BuildRequest(SenderQueueItem* item, unique_ptr<HttpSinkRequest>
         }
         data->mRealIpFlag = sendClient->GetRawSlsHostFlag();
     }
+    if (data->mContentMd5.empty()) {
+        data->mContentMd5 = sdk::CalcMD5(data->mData);
+    }
 
     if (data->mType == RawDataType::EVENT_GROUP) {
         if (mTelemetryType == sls_logs::SLS_TELEMETRY_TYPE_METRICS) {
-            req = sendClient->CreatePostMetricStoreLogsRequest(
-                mProject, data->mLogstore, ConvertCompressType(GetCompressType()), data->mData, data->mRawSize, item);
+            req = sendClient->CreatePostMetricStoreLogsRequest(mProject,
+                                                               data->mLogstore,
+                                                               ConvertCompressType(GetCompressType()),
+                                                               data->mData,
+                                                               data->mContentMd5,
+                                                               data->mRawSize,
+                                                               item);
         } else {
             if (data->mShardHashKey.empty()) {
                 req = sendClient->CreatePostLogStoreLogsRequest(mProject,
                                                                 data->mLogstore,
                                                                 ConvertCompressType(GetCompressType()),
                                                                 data->mData,
+                                                                data->mContentMd5,
                                                                 data->mRawSize,
                                                                 item);
             } else {
@@ -622,6 +631,7 @@ bool FlusherSLS::BuildRequest(SenderQueueItem* item, unique_ptr<HttpSinkRequest>
                                                                 data->mLogstore,
                                                                 ConvertCompressType(GetCompressType()),
                                                                 data->mData,
+                                                                data->mContentMd5,
                                                                 data->mRawSize,
                                                                 item,
                                                                 data->mShardHashKey,
@@ -630,13 +640,18 @@ bool FlusherSLS::BuildRequest(SenderQueueItem* item, unique_ptr<HttpSinkRequest>
         }
     } else {
         if (data->mShardHashKey.empty())
-            req = sendClient->CreatePostLogStoreLogPackageListRequest(
-                mProject, data->mLogstore, ConvertCompressType(GetCompressType()), data->mData, item);
+            req = sendClient->CreatePostLogStoreLogPackageListRequest(mProject,
+                                                                      data->mLogstore,
+                                                                      ConvertCompressType(GetCompressType()),
+                                                                      data->mData,
+                                                                      data->mContentMd5,
+                                                                      item);
         else
             req = sendClient->CreatePostLogStoreLogPackageListRequest(mProject,
                                                                       data->mLogstore,
                                                                       ConvertCompressType(GetCompressType()),
                                                                       data->mData,
+                                                                      data->mContentMd5,
                                                                       item,
                                                                       data->mShardHashKey);
     }
@@ -959,6 +974,7 @@ void FlusherSLS::GenerateGoPlugin(const Json::Value& config, Json::Value& res) c
 
 bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
     string serializedData, compressedData;
+    auto readTime = group.GetMetadataTime(EventGroupMetaKey::READ_TIMESTAMP_MICROSEC);
     BatchedEvents g(std::move(group.MutableEvents()),
                     std::move(group.GetSizedTags()),
                     std::move(group.GetSourceBuffer()),
@@ -998,16 +1014,17 @@ bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
     }
     // must create a tmp, because eoo checkpoint is moved in second param
     auto fbKey = g.mExactlyOnceCheckpoint->fbKey;
-    return PushToQueue(fbKey,
-                       make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                       serializedData.size(),
-                                                       this,
-                                                       fbKey,
-                                                       mLogstore,
-                                                       RawDataType::EVENT_GROUP,
-                                                       g.mExactlyOnceCheckpoint->data.hash_key(),
-                                                       std::move(g.mExactlyOnceCheckpoint),
-                                                       false));
+    auto item = make_unique<SLSSenderQueueItem>(std::move(compressedData),
+                                                serializedData.size(),
+                                                this,
+                                                fbKey,
+                                                mLogstore,
+                                                RawDataType::EVENT_GROUP,
+                                                g.mExactlyOnceCheckpoint->data.hash_key(),
+                                                std::move(g.mExactlyOnceCheckpoint),
+                                                false);
+    item->mReadTime = readTime;
+    return PushToQueue(fbKey, std::move(item));
 }
 
 bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
@@ -1018,9 +1035,16 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
     string shardHashKey, serializedData, compressedData;
     size_t packageSize = 0;
     bool enablePackageList = groupList.size() > 1;
+    // earliest read time of the package list
+    chrono::system_clock::time_point listReadTime;
 
     bool allSucceeded = true;
     for (auto& group : groupList) {
+        auto readTime = group.mReadTime;
+        if (readTime != chrono::system_clock::time_point()
+            && (listReadTime == chrono::system_clock::time_point() || readTime < listReadTime)) {
+            listReadTime = readTime;
+        }
         if (!mShardHashKeys.empty()) {
             shardHashKey = GetShardHashKey(group);
         }
@@ -1065,37 +1089,37 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
             if (group.mExactlyOnceCheckpoint) {
                 // must create a tmp, because eoo checkpoint is moved in second param
                 auto fbKey = group.mExactlyOnceCheckpoint->fbKey;
-                allSucceeded
-                    = PushToQueue(fbKey,
-                                  make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                  serializedData.size(),
-                                                                  this,
-                                                                  fbKey,
-                                                                  mLogstore,
-                                                                  RawDataType::EVENT_GROUP,
-                                                                  group.mExactlyOnceCheckpoint->data.hash_key(),
-                                                                  std::move(group.mExactlyOnceCheckpoint),
-                                                                  false))
-                    && allSucceeded;
+                auto item = make_unique<SLSSenderQueueItem>(std::move(compressedData),
+                                                            serializedData.size(),
+                                                            this,
+                                                            fbKey,
+                                                            mLogstore,
+                                                            RawDataType::EVENT_GROUP,
+                                                            group.mExactlyOnceCheckpoint->data.hash_key(),
+                                                            std::move(group.mExactlyOnceCheckpoint),
+                                                            false);
+                item->mReadTime = readTime;
+                allSucceeded = PushToQueue(fbKey, std::move(item)) && allSucceeded;
             } else {
-                allSucceeded = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                                    serializedData.size(),
-                                                                                    this,
-                                                                                    mQueueKey,
-                                                                                    mLogstore,
-                                                                                    RawDataType::EVENT_GROUP,
-                                                                                    shardHashKey))
-                    && allSucceeded;
+                auto item = make_unique<SLSSenderQueueItem>(std::move(compressedData),
+                                                            serializedData.size(),
+                                                            this,
+                                                            mQueueKey,
+                                                            mLogstore,
+                                                            RawDataType::EVENT_GROUP,
+                                                            shardHashKey);
+                item->mReadTime = readTime;
+                allSucceeded = Flusher::PushToQueue(std::move(item)) && allSucceeded;
             }
         }
     }
     if (enablePackageList) {
         string errorMsg;
         mGroupListSerializer->DoSerialize(std::move(compressedLogGroups), serializedData, errorMsg);
-        allSucceeded
-            = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(
-                  std::move(serializedData), packageSize, this, mQueueKey, mLogstore, RawDataType::EVENT_GROUP_LIST))
-            && allSucceeded;
+        auto item = make_unique<SLSSenderQueueItem>(
+            std::move(serializedData), packageSize, this, mQueueKey, mLogstore, RawDataType::EVENT_GROUP_LIST);
+        item->mReadTime = listReadTime;
+        allSucceeded = Flusher::PushToQueue(std::move(item)) && allSucceeded;
     }
     return allSucceeded;
 }
@@ -53,7 +53,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                              mContext->GetRegion());
     } else if (!filterKeys.empty()) {
         bool hasError = false;
-        std::vector<boost::regex> regs;
+        std::vector<RegexMatcher> regs;
         for (const auto& reg : filterRegs) {
             if (!IsRegexValid(reg)) {
                 PARAM_WARNING_IGNORE(mContext->GetLogger(),
@@ -91,7 +91,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                  mContext->GetRegion());
         } else if (!mInclude.empty()) {
             std::vector<std::string> keys;
-            std::vector<boost::regex> regs;
+            std::vector<RegexMatcher> regs;
             bool hasError = false;
             for (auto& include : mInclude) {
                 if (!IsRegexValid(include.second)) {
@@ -107,7 +107,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                     break;
                 }
                 keys.emplace_back(include.first);
-                regs.emplace_back(boost::regex(include.second));
+                regs.emplace_back(include.second);
             }
             if (!hasError) {
                 mFilterRule = std::make_shared<LogFilterRule>();
@@ -285,14 +285,14 @@ bool ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent, const LogFil
 
 bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterRule& rule) {
     const std::vector<std::string>& keys = rule.FilterKeys;
-    const std::vector<boost::regex> regs = rule.FilterRegs;
+    const std::vector<RegexMatcher>& regs = rule.FilterRegs;
     std::string exception;
     for (uint32_t i = 0; i < keys.size(); ++i) {
         const auto& content = contents.FindContent(keys[i]);
         if (content == contents.end()) {
             return false;
         }
-        if (!BoostRegexMatch(content->second.data(), content->second.size(), regs[i], exception)) {
+        if (!regs[i].Match(content->second, exception)) {
             if (!exception.empty()) {
                 LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -490,7 +490,7 @@ bool RegexFilterValueNode::Match(const LogEvent& contents, const PipelineContext
     }
 
     std::string exception;
-    bool result = BoostRegexMatch(content->second.data(), content->second.size(), reg, exception);
+    bool result = reg.Match(content->second, exception);
     if (!result && !exception.empty() && AppConfig::GetInstance()->IsLogParseAlarmValid()) {
         LOG_ERROR(mContext.GetLogger(), ("regex_match in Filter fail", exception));
         if (mContext.GetAlarm().IsLowLevelAlarmValid()) {
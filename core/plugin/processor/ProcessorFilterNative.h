@@ -17,11 +17,10 @@
 #pragma once
 
 #include "app_config/AppConfig.h"
+#include "common/RegexMatcher.h"
 #include "models/LogEvent.h"
 #include "pipeline/plugin/interface/Processor.h"
 
-#include <boost/regex.hpp>
-
 namespace logtail {
 
 // BaseFilterNode
@@ -77,7 +76,7 @@ public:
 
 private:
     std::string key;
-    boost::regex reg;
+    RegexMatcher reg;
 };
 
 // UnaryFilterOperatorNode
@@ -121,7 +120,7 @@ private:
 
     struct LogFilterRule {
         std::vector<std::string> FilterKeys;
-        std::vector<boost::regex> FilterRegs;
+        std::vector<RegexMatcher> FilterRegs;
     };
 
     bool ProcessEvent(PipelineEventPtr& e);
@@ -16,6 +16,8 @@
 
 #include "plugin/processor/ProcessorParseApsaraNative.h"
 
+#include <cctype>
+
 #include "app_config/AppConfig.h"
 #include "common/LogtailCommonFlags.h"
 #include "common/ParamExtractor.h"
@@ -89,12 +91,11 @@ void ProcessorParseApsaraNative::Process(PipelineEventGroup& logGroup) {
     }
     const StringView& logPath = logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED);
     EventsContainer& events = logGroup.MutableEvents();
-    StringView timeStrCache;
-    LogtailTime cachedLogTime = {0, 0};
+    TimestampCache timestampCache;
 
     size_t wIdx = 0;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (ProcessEvent(logPath, events[rIdx], cachedLogTime, timeStrCache)) {
+        if (ProcessEvent(logPath, events[rIdx], timestampCache)) {
             if (wIdx != rIdx) {
                 events[wIdx] = std::move(events[rIdx]);
             }
@@ -109,14 +110,12 @@ void ProcessorParseApsaraNative::Process(PipelineEventGroup& logGroup) {
  * 处理单个日志事件。
  * @param logPath - 日志文件的路径。
  * @param e - 指向待处理日志事件的智能指针。
- * @param cachedLogTime - 上一条日志的时间戳（秒）。
- * @param timeStrCache - 缓存时间字符串，用于比较和更新。
+ * @param timestampCache - 缓存最近解析过的时间字符串，由同一日志组内的事件共享。
  * @return 如果事件被处理且保留，则返回true，如果事件被丢弃，则返回false。
  */
 bool ProcessorParseApsaraNative::ProcessEvent(const StringView& logPath,
                                               PipelineEventPtr& e,
-                                              LogtailTime& cachedLogTime,
-                                              StringView& timeStrCache) {
+                                              TimestampCache& timestampCache) {
     if (!IsSupportedEvent(e)) {
         mOutFailedEventsTotal->Add(1);
         return true;
@@ -133,7 +132,7 @@ bool ProcessorParseApsaraNative::ProcessEvent(const StringView& logPath,
         return true;
     }
     int64_t logTime_in_micro = 0;
-    time_t logTime = ApsaraEasyReadLogTimeParser(buffer, timeStrCache, cachedLogTime, logTime_in_micro);
+    time_t logTime = ApsaraEasyReadLogTimeParser(buffer, timestampCache, logTime_in_micro);
     if (logTime <= 0) // this case will handle empty apsara log line
     {
         StringView bufOut(buffer);
@@ -238,33 +237,34 @@ bool ProcessorParseApsaraNative::ProcessEvent(const StringView& logPath,
 }
 
 /*
- * 解析Apsara格式日志的时间。
+ * 解析Apsara格式日志的时间，时间字符串原地解析，不做拷贝。
  * @param buffer - 包含日志数据的字符串视图。
- * @param cachedTimeStr - 缓存的时间字符串。
- * @param cachedLogTime - 缓存的时间字符串的时间戳（秒），必须与cachedTimeStr同时修改。
+ * @param timestampCache - 缓存最近解析过的时间字符串的秒级部分及其时间戳（秒）。
  * @param microTime - 解析出的微秒时间戳。
  * @return 解析出的时间戳（秒），如果解析失败，则返回0。
  */
 time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffer,
-                                                               StringView& cachedTimeStr,
-                                                               LogtailTime& cachedLogTime,
+                                                               TimestampCache& timestampCache,
                                                                int64_t& microTime) {
+    static const TimestampParser sUnixSecondsParser("%s");
+    static const TimestampParser sDateTimeParser("%Y-%m-%d %H:%M:%S");
+
     if (buffer[0] != '[') {
         return 0;
     }
+    // the time string is the content between '[' and ']', and ']' stops parsing
+    size_t pos = buffer.find(']', 1);
+    if (pos == std::string::npos) {
+        LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
+        return 0;
+    }
+    const char* timeStr = buffer.data() + 1;
     LogtailTime logTime = {};
+    int nanosecondLength = 0;
     if (buffer[1] == '1') // for normal time, e.g 1378882630, starts with '1'
     {
-        int nanosecondLength = 0;
-        size_t pos = buffer.find(']', 1);
-        if (pos == std::string::npos) {
-            LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
-            return 0;
-        }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
-        auto strptimeResult = Strptime(strTime.c_str(), "%s", &logTime, nanosecondLength);
-        if (NULL == strptimeResult || strptimeResult[0] != ']') {
+        auto parseResult = sUnixSecondsParser.Parse(timeStr, logTime, nanosecondLength);
+        if (NULL == parseResult || parseResult[0] != ']') {
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer)("timeformat", "%s"));
             return 0;
         }
@@ -272,61 +272,31 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
         return logTime.tv_sec;
     }
     // test other date format case
-    {
-        size_t pos = buffer.find(']', 1);
-        if (pos == std::string::npos) {
-            LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
-            return 0;
-        }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
-        int nanosecondLength = 0;
-        if (IsPrefixString(strTime, cachedTimeStr) == true) {
-            if (strTime.size() > cachedTimeStr.size()) {
-                auto strptimeResult
-                    = Strptime(strTime.c_str() + cachedTimeStr.size() + 1, "%f", &logTime, nanosecondLength);
-                if (NULL == strptimeResult) {
-                    LOG_WARNING(sLogger,
-                                ("parse apsara log time microsecond",
-                                 "fail")("string", buffer)("timeformat", "%Y-%m-%d %H:%M:%S.%f"));
-                }
-            }
-            microTime = (int64_t)cachedLogTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
-            return cachedLogTime.tv_sec;
-        }
+    const char* secondEnd = NULL;
+    const TimestampCache::Entry* entry = timestampCache.Find(StringView(timeStr, pos - 1));
+    if (entry != NULL && !isdigit(static_cast<unsigned char>(timeStr[entry->key.size()]))) {
+        secondEnd = timeStr + entry->key.size();
+        logTime.tv_sec = entry->second;
+    } else {
         // parse second part
-        auto strptimeResult = Strptime(strTime.c_str(), "%Y-%m-%d %H:%M:%S", &logTime, nanosecondLength);
-        if (NULL == strptimeResult) {
+        secondEnd = sDateTimeParser.Parse(timeStr, logTime, nanosecondLength);
+        if (NULL == secondEnd) {
             LOG_WARNING(sLogger,
                         ("parse apsara log time", "fail")("string", buffer)("timeformat", "%Y-%m-%d %H:%M:%S"));
             return 0;
         }
-        // parse nanosecond part (optional)
-        if (*strptimeResult != '\0') {
-            strptimeResult = Strptime(strptimeResult + 1, "%f", &logTime, nanosecondLength);
-            if (NULL == strptimeResult) {
-                LOG_WARNING(sLogger,
-                            ("parse apsara log time microsecond", "fail")("string", buffer)("timeformat",
-                                                                                            "%Y-%m-%d %H:%M:%S.%f"));
-            }
-        }
         logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
-        microTime = (int64_t)logTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
-        // if the time is valid (strptime not return NULL), the date value size must be 19 ,like '2013-09-11 03:11:05'
-        cachedTimeStr = StringView(buffer.data() + 1, 19);
-        cachedLogTime = logTime;
-        return logTime.tv_sec;
+        timestampCache.Add(StringView(timeStr, secondEnd - timeStr), logTime.tv_sec);
     }
-}
-
-/*
- * 检查字符串是否包含指定的前缀。
- * @param all - 完整的字符串。
- * @param prefix - 要检查的前缀。
- * @return 如果字符串以指定前缀开头，则返回true；否则返回false。
- */
-bool ProcessorParseApsaraNative::IsPrefixString(const std::string& all, const StringView& prefix) {
-    return !prefix.empty() && std::equal(prefix.begin(), prefix.end(), all.begin());
+    // parse nanosecond part (optional), which follows a separator such as '.' or ','
+    if (*secondEnd != ']'
+        && NULL == TimestampParser::ParseNanosecond(secondEnd + 1, logTime.tv_nsec, nanosecondLength)) {
+        LOG_WARNING(sLogger,
+                    ("parse apsara log time microsecond", "fail")("string", buffer)("timeformat",
+                                                                                    "%Y-%m-%d %H:%M:%S.%f"));
+    }
+    microTime = (int64_t)logTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
+    return logTime.tv_sec;
 }
 
 /*
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "common/TimeUtil.h"
+#include "common/TimestampParser.h"
 #include "models/LogEvent.h"
 #include "pipeline/plugin/interface/Processor.h"
 #include "plugin/processor/CommonParserOptions.h"
@@ -41,12 +42,9 @@ protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
 
 private:
-    bool
-    ProcessEvent(const StringView& logPath, PipelineEventPtr& e, LogtailTime& lastLogTime, StringView& timeStrCache);
+    bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e, TimestampCache& timestampCache);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
-    time_t
-    ApsaraEasyReadLogTimeParser(StringView& buffer, StringView& timeStr, LogtailTime& lastLogTime, int64_t& microTime);
-    bool IsPrefixString(const std::string& all, const StringView& prefix);
+    time_t ApsaraEasyReadLogTimeParser(StringView& buffer, TimestampCache& timestampCache, int64_t& microTime);
     int32_t ParseApsaraBaseFields(const StringView& buffer, LogEvent& sourceEvent);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
@@ -106,7 +106,8 @@ bool ProcessorParseDelimiterNative::Init(const Json::Value& config) {
                              mContext->GetRegion());
     }
 
-    mDelimiterModeFsmParserPtr.reset(new DelimiterModeFsmParser(mQuote, mSeparatorChar));
+    mDelimiterTokenizerPtr.reset(
+        new DelimiterTokenizer(mSeparatorChar, mQuote, (mSeparator.size() == 1) && (mQuote != mSeparatorChar)));
 
     // Keys
     if (!GetMandatoryListParam(config, "Keys", mKeys, errorMsg)) {
@@ -251,7 +252,7 @@ bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath, Pipe
         if (useQuote) {
             columnValues.reserve(reserveSize);
             parseSuccess
-                = mDelimiterModeFsmParserPtr->ParseDelimiterLine(buffer, begIdx, endIdx, columnValues, sourceEvent);
+                = mDelimiterTokenizerPtr->ParseDelimiterLine(buffer, begIdx, endIdx, columnValues, sourceEvent);
             // handle auto extend
             if (!(mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND)
                 && columnValues.size() > mKeys.size()) {
@@ -369,26 +370,21 @@ bool ProcessorParseDelimiterNative::SplitString(
         colLens.push_back(size);
         return true;
     }
+    // positions of the first char of the separator are found by the tokenizer, and the rest chars are compared here
+    static thread_local std::vector<size_t> sCandidates;
+    static thread_local std::vector<size_t> sQuotes;
+    sCandidates.clear();
+    mDelimiterTokenizerPtr->FindSeparators(buffer + begIdx, size, sCandidates, sQuotes);
     size_t pos = begIdx;
-    size_t top = endIdx - d_size;
-    while (pos <= top) {
-        const char* pch = std::search(buffer + pos, buffer + endIdx, mSeparator.begin(), mSeparator.end());
-        size_t pos2;
-        // if not found, pos2 = endIdx
-        if (pch == buffer + endIdx) {
-            pos2 = endIdx;
-        } else {
-            pos2 = pch - buffer;
-        }
-        if (pos2 != pos) {
-            colBegIdxs.push_back(pos);
-            colLens.push_back(pos2 - pos);
-        } else {
-            colBegIdxs.push_back(pos);
-            colLens.push_back(0);
+    for (size_t candidate : sCandidates) {
+        size_t pos2 = begIdx + candidate;
+        // separators must not overlap
+        if (pos2 < pos || pos2 + d_size > (size_t)endIdx
+            || (d_size > 1 && memcmp(buffer + pos2 + 1, mSeparator.data() + 1, d_size - 1) != 0)) {
+            continue;
         }
-        if (pos2 == (size_t)endIdx)
-            return true;
+        colBegIdxs.push_back(pos);
+        colLens.push_back(pos2 - pos);
         pos = pos2 + d_size;
         if (colLens.size() >= mKeys.size() && !(mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND)) {
             colBegIdxs.push_back(pos2);
@@ -396,10 +392,8 @@ bool ProcessorParseDelimiterNative::SplitString(
             return true;
         }
     }
-    if (pos <= (size_t)endIdx) {
-        colBegIdxs.push_back(pos);
-        colLens.push_back(endIdx - pos);
-    }
+    colBegIdxs.push_back(pos);
+    colLens.push_back(endIdx - pos);
     return true;
 }
 
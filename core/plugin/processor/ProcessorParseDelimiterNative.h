@@ -19,7 +19,7 @@
 #include <memory>
 
 #include "models/LogEvent.h"
-#include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterTokenizer.h"
 #include "pipeline/plugin/interface/Processor.h"
 #include "plugin/processor/CommonParserOptions.h"
 
@@ -72,7 +72,7 @@ private:
 
     char mSeparatorChar;
     bool mSourceKeyOverwritten = false;
-    std::unique_ptr<DelimiterModeFsmParser> mDelimiterModeFsmParserPtr;
+    std::unique_ptr<DelimiterTokenizer> mDelimiterTokenizerPtr;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
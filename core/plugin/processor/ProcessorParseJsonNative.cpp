@@ -16,14 +16,15 @@
 
 #include "plugin/processor/ProcessorParseJsonNative.h"
 
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
-
+#include "common/FastJsonParser.h"
+#include "common/Flags.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
 #include "monitor/metric_constants/MetricConstants.h"
 #include "pipeline/plugin/instance/ProcessorInstance.h"
 
+DEFINE_FLAG_BOOL(enable_json_parse_fast_path, "parse json logs without building dom when possible", true);
+
 namespace logtail {
 
 const std::string ProcessorParseJsonNative::sName = "processor_parse_json_native";
@@ -117,6 +118,10 @@ bool ProcessorParseJsonNative::JsonLogLineParser(LogEvent& sourceEvent,
     if (buffer.empty())
         return false;
 
+    if (BOOL_FLAG(enable_json_parse_fast_path) && FastJsonLogLineParser(sourceEvent, buffer, sourceKeyOverwritten)) {
+        return true;
+    }
+
     bool parseSuccess = true;
     rapidjson::Document doc;
     doc.Parse(buffer.data(), buffer.size());
@@ -170,30 +175,22 @@ bool ProcessorParseJsonNative::JsonLogLineParser(LogEvent& sourceEvent,
     return true;
 }
 
-std::string ProcessorParseJsonNative::RapidjsonValueToString(const rapidjson::Value& value) {
-    if (value.IsString())
-        return std::string(value.GetString(), value.GetStringLength());
-    else if (value.IsBool())
-        return ToString(value.GetBool());
-    else if (value.IsInt())
-        return ToString(value.GetInt());
-    else if (value.IsUint())
-        return ToString(value.GetUint());
-    else if (value.IsInt64())
-        return ToString(value.GetInt64());
-    else if (value.IsUint64())
-        return ToString(value.GetUint64());
-    else if (value.IsDouble())
-        return ToString(value.GetDouble());
-    else if (value.IsNull())
-        return "";
-    else // if (value.IsObject() || value.IsArray())
-    {
-        rapidjson::StringBuffer buffer;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-        value.Accept(writer);
-        return std::string(buffer.GetString(), buffer.GetLength());
+bool ProcessorParseJsonNative::FastJsonLogLineParser(LogEvent& sourceEvent,
+                                                     const StringView& buffer,
+                                                     bool& sourceKeyOverwritten) {
+    // processors are shared by processor threads
+    static thread_local std::vector<FastJsonParser::Member> sMembers;
+    sMembers.clear();
+    if (!FastJsonParser::ParseObject(buffer, *sourceEvent.GetSourceBuffer(), sMembers)) {
+        return false;
     }
+    for (const auto& member : sMembers) {
+        if (member.first == mSourceKey) {
+            sourceKeyOverwritten = true;
+        }
+        AddLog(member.first, member.second, sourceEvent);
+    }
+    return true;
 }
 
 void ProcessorParseJsonNative::AddLog(const StringView& key,
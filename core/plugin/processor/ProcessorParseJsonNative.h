@@ -41,8 +41,9 @@ protected:
 private:
     bool JsonLogLineParser(LogEvent& sourceEvent, const StringView& logPath, PipelineEventPtr& e, bool& sourceKeyOverwritten);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
+    // returns false if the log is not supported, which is left to the dom parser
+    bool FastJsonLogLineParser(LogEvent& sourceEvent, const StringView& buffer, bool& sourceKeyOverwritten);
     bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e);
-    static std::string RapidjsonValueToString(const rapidjson::Value& value);
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
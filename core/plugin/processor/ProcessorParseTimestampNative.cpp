@@ -87,6 +87,8 @@ bool ProcessorParseTimestampNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    mTimestampParserPtr.reset(new TimestampParser(mSourceFormat, mSourceYear));
+
     mDiscardedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_DISCARDED_EVENTS_TOTAL);
     mOutFailedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_FAILED_EVENTS_TOTAL);
     mOutKeyNotFoundEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_KEY_NOT_FOUND_EVENTS_TOTAL);
@@ -101,13 +103,13 @@ void ProcessorParseTimestampNative::Process(PipelineEventGroup& logGroup) {
         return;
     }
     const StringView& logPath = logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED);
-    StringView timeStrCache;
+    TimestampCache timestampCache;
     EventsContainer& events = logGroup.MutableEvents();
     LogtailTime logTime = {0, 0};
 
     size_t wIdx = 0;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (ProcessEvent(logPath, events[rIdx], logTime, timeStrCache)) {
+        if (ProcessEvent(logPath, events[rIdx], logTime, timestampCache)) {
             if (wIdx != rIdx) {
                 events[wIdx] = std::move(events[rIdx]);
             }
@@ -125,7 +127,7 @@ bool ProcessorParseTimestampNative::IsSupportedEvent(const PipelineEventPtr& e)
 bool ProcessorParseTimestampNative::ProcessEvent(StringView logPath,
                                                  PipelineEventPtr& e,
                                                  LogtailTime& logTime,
-                                                 StringView& timeStrCache) {
+                                                 TimestampCache& cache) {
     if (!IsSupportedEvent(e)) {
         mOutFailedEventsTotal->Add(1);
         return true;
@@ -137,7 +139,7 @@ bool ProcessorParseTimestampNative::ProcessEvent(StringView logPath,
     }
     const StringView& timeStr = sourceEvent.GetContent(mSourceKey);
     uint64_t preciseTimestamp = 0;
-    bool parseSuccess = ParseLogTime(timeStr, logPath, logTime, preciseTimestamp, timeStrCache);
+    bool parseSuccess = ParseLogTime(timeStr, logPath, logTime, preciseTimestamp, cache);
     if (!parseSuccess) {
         mOutFailedEventsTotal->Add(1);
         return true;
@@ -179,32 +181,8 @@ bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, /
                                                  const StringView& logPath,
                                                  LogtailTime& logTime,
                                                  uint64_t& preciseTimestamp,
-                                                 StringView& timeStrCache // cache
-) {
-    // Second-level cache only work when:
-    // 1. No %f in the time format
-    // 2. The %f is at the end of the time format
-    const char* compareResult = strstr(mSourceFormat.c_str(), "%f");
-    bool haveNanosecond = compareResult != nullptr;
-    bool endWithNanosecond = compareResult == (mSourceFormat.c_str() + mSourceFormat.size() - 2);
-    int nanosecondLength = -1;
-    const char* strptimeResult = NULL;
-    if ((!haveNanosecond || endWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
-        bool isTimestampNanosecond = (mSourceFormat == "%s") && (curTimeStr.length() > timeStrCache.length());
-        if (endWithNanosecond || isTimestampNanosecond) {
-            strptimeResult = Strptime(curTimeStr.data() + timeStrCache.length(), "%f", &logTime, nanosecondLength);
-        } else {
-            strptimeResult = curTimeStr.data() + timeStrCache.length();
-            logTime.tv_nsec = 0;
-        }
-    } else {
-        strptimeResult = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
-        if (NULL != strptimeResult) {
-            timeStrCache = curTimeStr.substr(0, curTimeStr.length() - nanosecondLength);
-            logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
-        }
-    }
-    if (NULL == strptimeResult) {
+                                                 TimestampCache& cache) {
+    if (!mTimestampParserPtr->Parse(curTimeStr, logTime, cache)) {
         if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
             if (AlarmManager::GetInstance()->IsLowLevelAlarmValid()) {
                 LOG_WARNING(sLogger,
@@ -219,26 +197,7 @@ bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, /
         }
         return false;
     }
-
-    // if (mLegacyPreciseTimestampConfig.enabled) {
-    //     if (nanosecondLength < 0) {
-    //         preciseTimestamp = GetPreciseTimestamp(logTime.tv_sec, strptimeResult, mLegacyPreciseTimestampConfig);
-    //     } else {
-    //         preciseTimestamp = GetPreciseTimestampFromLogtailTime(logTime, mLegacyPreciseTimestampConfig);
-    //     }
-    // }
-    return true;
-}
-
-bool ProcessorParseTimestampNative::IsPrefixString(const StringView& all, const StringView& prefix) {
-    if (all.size() < prefix.size())
-        return false;
-    if (prefix.size() == 0)
-        return false;
-    for (size_t i = 0; i < prefix.size(); ++i) {
-        if (all[i] != prefix[i])
-            return false;
-    }
+    logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
     return true;
 }
 
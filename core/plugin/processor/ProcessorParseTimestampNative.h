@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "common/TimeUtil.h"
+#include "common/TimestampParser.h"
 #include "pipeline/plugin/interface/Processor.h"
 
 namespace logtail {
@@ -41,17 +44,16 @@ protected:
 
 private:
     /// @return false if data need to be discarded
-    bool ProcessEvent(StringView logPath, PipelineEventPtr& e, LogtailTime& logTime, StringView& timeStrCache);
+    bool ProcessEvent(StringView logPath, PipelineEventPtr& e, LogtailTime& logTime, TimestampCache& cache);
     /// @return false if parse time failed
     bool ParseLogTime(const StringView& curTimeStr, // str to parse
                       const StringView& logPath,
                       LogtailTime& logTime,
                       uint64_t& preciseTimestamp,
-                      StringView& timeStr // cache
-    );
-    bool IsPrefixString(const StringView& all, const StringView& prefix);
+                      TimestampCache& cache);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    std::unique_ptr<TimestampParser> mTimestampParserPtr;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
@@ -16,7 +16,6 @@
 
 #include "plugin/processor/inner/ProcessorMergeMultilineLogNative.h"
 
-#include <boost/regex.hpp>
 #include <string>
 
 #include "app_config/AppConfig.h"
@@ -215,20 +214,16 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
         StringView sourceVal = sourceEvent->GetContent(mSourceKey);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (mMultiline.GetStartPatternReg() != nullptr) {
-                regex = *mMultiline.GetStartPatternReg();
-            } else {
-                regex = *mMultiline.GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(sourceVal.data(), sourceVal.size(), regex, exception)) {
+            const RegexMatcher& firstPattern = mMultiline.GetStartPatternReg() != nullptr
+                ? *mMultiline.GetStartPatternReg()
+                : *mMultiline.GetContinuePatternReg();
+            if (firstPattern.Search(sourceVal, exception)) {
                 events.emplace_back(sourceEvent);
                 begin = cur;
                 isPartialLog = true;
             } else if (mMultiline.GetEndPatternReg() != nullptr && mMultiline.GetStartPatternReg() == nullptr
                        && mMultiline.GetContinuePatternReg() != nullptr
-                       && BoostRegexSearch(
-                           sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                       && mMultiline.GetEndPatternReg()->Search(sourceVal, exception)) {
                 // case: continue + end
                 // current line is matched against the end pattern rather than the continue pattern
                 begin = cur;
@@ -240,8 +235,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
         } else {
             // case: start + continue or continue + end
             if (mMultiline.GetContinuePatternReg() != nullptr
-                && BoostRegexSearch(
-                    sourceVal.data(), sourceVal.size(), *mMultiline.GetContinuePatternReg(), exception)) {
+                && mMultiline.GetContinuePatternReg()->Search(sourceVal, exception)) {
                 events.emplace_back(sourceEvent);
                 continue;
             }
@@ -251,8 +245,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                 if (mMultiline.GetContinuePatternReg() != nullptr) {
                     // current line is not matched against the continue pattern, so the end pattern will decide if
                     // the current log is a match or not
-                    if (BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (mMultiline.GetEndPatternReg()->Search(sourceVal, exception)) {
                         MergeEvents(events, true);
                         sourceEvents[newSize++] = std::move(sourceEvents[begin]);
                     } else {
@@ -262,8 +255,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (mMultiline.GetEndPatternReg()->Search(sourceVal, exception)) {
                         MergeEvents(events, true);
                         sourceEvents[newSize++] = std::move(sourceEvents[begin]);
                         if (mMultiline.GetStartPatternReg() != nullptr) {
@@ -279,8 +271,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
             } else {
                 if (mMultiline.GetContinuePatternReg() == nullptr) {
                     // case: start
-                    if (!BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (!mMultiline.GetStartPatternReg()->Search(sourceVal, exception)) {
                         events.emplace_back(sourceEvent);
                     } else {
                         MergeEvents(events, true);
@@ -293,8 +284,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                     // continue pattern is given, but current line is not matched against the continue pattern
                     MergeEvents(events, true);
                     sourceEvents[newSize++] = std::move(sourceEvents[begin]);
-                    if (!BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (!mMultiline.GetStartPatternReg()->Search(sourceVal, exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both start
                         // and continue pattern are given, and the current line is not matched against the start
                         // pattern
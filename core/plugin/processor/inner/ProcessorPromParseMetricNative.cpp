@@ -40,6 +40,9 @@ void ProcessorPromParseMetricNative::Process(PipelineEventGroup& eGroup) {
     }
     events.swap(newEvents);
     eGroup.SetMetadata(EventGroupMetaKey::PROMETHEUS_SAMPLES_SCRAPED, ToString(events.size()));
+    if (mScrapeConfigPtr->mConvertClassicHistograms) {
+        TextParser::MergeHistogramsAndSummaries(events);
+    }
 }
 
 bool ProcessorPromParseMetricNative::IsSupportedEvent(const PipelineEventPtr& e) const {
@@ -50,6 +53,11 @@ bool ProcessorPromParseMetricNative::ProcessEvent(PipelineEventPtr& e,
                                                   EventsContainer& newEvents,
                                                   PipelineEventGroup& eGroup,
                                                   TextParser& parser) {
+    if (e.Is<MetricEvent>()) {
+        // already parsed when the response is received
+        newEvents.emplace_back(std::move(e));
+        return true;
+    }
     if (!IsSupportedEvent(e)) {
         return false;
     }
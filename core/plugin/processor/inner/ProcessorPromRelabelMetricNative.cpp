@@ -17,6 +17,7 @@
 
 #include <json/json.h>
 
+#include <algorithm>
 #include <cstddef>
 
 #include "common/Flags.h"
@@ -29,6 +30,7 @@
 using namespace std;
 
 DECLARE_FLAG_STRING(_pod_name_);
+DEFINE_FLAG_INT32(prom_relabel_cache_max_series, "max series of relabel result cache per target", 100000);
 
 namespace logtail {
 
@@ -44,6 +46,9 @@ bool ProcessorPromRelabelMetricNative::Init(const Json::Value& config) {
 
     mLoongCollectorScraper = STRING_FLAG(_pod_name_);
 
+    mRelabelCacheHitTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_PROM_RELABEL_CACHE_HIT_TOTAL);
+    mRelabelCacheMissTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_PROM_RELABEL_CACHE_MISS_TOTAL);
+
     return true;
 }
 
@@ -53,10 +58,20 @@ void ProcessorPromRelabelMetricNative::Process(PipelineEventGroup& metricGroup)
     auto toDelete = GetToDeleteTargetLabels(targetTags);
 
     if (!mScrapeConfigPtr->mMetricRelabelConfigs.Empty() || !targetTags.empty()) {
+        shared_ptr<TargetRelabelCache> targetCache;
+        unique_lock<mutex> lock;
+        if (!mScrapeConfigPtr->mMetricRelabelConfigs.Empty()) {
+            targetCache = GetRelabelCache(targetTags);
+            lock = unique_lock<mutex>(targetCache->mMux);
+            targetCache->mCache.StartScrape(StringTo<uint64_t>(
+                metricGroup.GetMetadata(EventGroupMetaKey::PROMETHEUS_SCRAPE_TIMESTAMP_MILLISEC).to_string()));
+        }
+        RelabelResultCache* cache = targetCache ? &targetCache->mCache : nullptr;
+
         EventsContainer& events = metricGroup.MutableEvents();
         size_t wIdx = 0;
         for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-            if (ProcessEvent(events[rIdx], targetTags, toDelete)) {
+            if (ProcessEvent(events[rIdx], targetTags, toDelete, cache)) {
                 if (wIdx != rIdx) {
                     events[wIdx] = std::move(events[rIdx]);
                 }
@@ -64,6 +79,13 @@ void ProcessorPromRelabelMetricNative::Process(PipelineEventGroup& metricGroup)
             }
         }
         events.resize(wIdx);
+
+        if (cache) {
+            mRelabelCacheHitTotal->Add(cache->mHitCnt);
+            mRelabelCacheMissTotal->Add(cache->mMissCnt);
+            cache->mHitCnt = 0;
+            cache->mMissCnt = 0;
+        }
     }
 
     // delete mTags when key starts with __
@@ -85,12 +107,21 @@ bool ProcessorPromRelabelMetricNative::IsSupportedEvent(const PipelineEventPtr&
 
 bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e,
                                                     const GroupTags& targetTags,
-                                                    const vector<StringView>& toDelete) {
+                                                    const vector<StringView>& toDelete,
+                                                    RelabelResultCache* cache) {
     if (!IsSupportedEvent(e)) {
         return false;
     }
     auto& sourceEvent = e.Cast<MetricEvent>();
 
+    // target labels are the same for all series in the cache, so the series can be identified by its own labels
+    uint64_t hash = 0;
+    const RelabelResult* cachedResult = nullptr;
+    if (cache) {
+        hash = RelabelResultCache::Hash(sourceEvent);
+        cachedResult = cache->Get(hash);
+    }
+
     for (const auto& [k, v] : targetTags) {
         if (sourceEvent.HasTag(k)) {
             if (!mScrapeConfigPtr->mHonorLabels) {
@@ -107,8 +138,19 @@ bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e,
     }
 
     vector<string> toDeleteInRelabel;
-    if (!mScrapeConfigPtr->mMetricRelabelConfigs.Empty()
-        && !mScrapeConfigPtr->mMetricRelabelConfigs.Process(sourceEvent, toDeleteInRelabel)) {
+    if (cachedResult) {
+        if (!cachedResult->Apply(sourceEvent, toDeleteInRelabel)) {
+            return false;
+        }
+    } else if (cache) {
+        RelabelResult result;
+        bool keep = mScrapeConfigPtr->mMetricRelabelConfigs.Process(sourceEvent, toDeleteInRelabel, result);
+        cache->Add(hash, std::move(result));
+        if (!keep) {
+            return false;
+        }
+    } else if (!mScrapeConfigPtr->mMetricRelabelConfigs.Empty()
+               && !mScrapeConfigPtr->mMetricRelabelConfigs.Process(sourceEvent, toDeleteInRelabel)) {
         return false;
     }
     // set metricEvent name
@@ -127,6 +169,41 @@ bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e,
     return true;
 }
 
+shared_ptr<ProcessorPromRelabelMetricNative::TargetRelabelCache>
+ProcessorPromRelabelMetricNative::GetRelabelCache(const GroupTags& targetTags) {
+    uint64_t hash = prometheus::OFFSET64;
+    for (const auto& [k, v] : targetTags) {
+        for (auto c : k) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * prometheus::PRIME64;
+        }
+        hash = (hash ^ 0xff) * prometheus::PRIME64;
+        for (auto c : v) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * prometheus::PRIME64;
+        }
+        hash = (hash ^ 0xff) * prometheus::PRIME64;
+    }
+
+    time_t now = time(nullptr);
+    lock_guard<mutex> lock(mRelabelCacheMux);
+    // caches of targets not scraped since last sweep are removed
+    if (now - mLastRelabelCacheSweepTime >= max<int64_t>(mScrapeConfigPtr->mScrapeIntervalSeconds, 1) * 10) {
+        for (auto it = mRelabelCaches.begin(); it != mRelabelCaches.end();) {
+            if (it->second->mLastUsedTime < mLastRelabelCacheSweepTime) {
+                it = mRelabelCaches.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        mLastRelabelCacheSweepTime = now;
+    }
+    auto& cache = mRelabelCaches[hash];
+    if (!cache) {
+        cache = make_shared<TargetRelabelCache>(INT32_FLAG(prom_relabel_cache_max_series));
+    }
+    cache->mLastUsedTime = now;
+    return cache;
+}
+
 vector<StringView> ProcessorPromRelabelMetricNative::GetToDeleteTargetLabels(const GroupTags& targetTags) const {
     // delete tag which starts with __
     vector<StringView> toDelete;
@@ -152,7 +229,17 @@ void ProcessorPromRelabelMetricNative::AddAutoMetrics(PipelineEventGroup& metric
     auto timestamp = timestampMilliSec / 1000;
     auto nanoSec = timestampMilliSec % 1000 * 1000000;
 
-    uint64_t samplesPostMetricRelabel = metricGroup.GetEvents().size();
+    uint64_t samplesPostMetricRelabel = 0;
+    for (const auto& e : metricGroup.GetEvents()) {
+        // merged histograms and summaries are counted by their samples in the exposition
+        if (e.Is<MetricEvent>() && e.Cast<MetricEvent>().Is<HistogramValue>()) {
+            samplesPostMetricRelabel += e.Cast<MetricEvent>().GetValue<HistogramValue>()->SampleCnt();
+        } else if (e.Is<MetricEvent>() && e.Cast<MetricEvent>().Is<SummaryValue>()) {
+            samplesPostMetricRelabel += e.Cast<MetricEvent>().GetValue<SummaryValue>()->SampleCnt();
+        } else {
+            ++samplesPostMetricRelabel;
+        }
+    }
 
     auto scrapeDurationSeconds
         = StringTo<double>(metricGroup.GetMetadata(EventGroupMetaKey::PROMETHEUS_SCRAPE_DURATION).to_string());
@@ -16,11 +16,18 @@
 
 #pragma once
 
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEventPtr.h"
+#include "monitor/metric_models/MetricTypes.h"
 #include "pipeline/plugin/interface/Processor.h"
+#include "prometheus/labels/Relabel.h"
 #include "prometheus/schedulers/ScrapeConfig.h"
 
 namespace logtail {
@@ -36,7 +43,19 @@ protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
 
 private:
-    bool ProcessEvent(PipelineEventPtr& e, const GroupTags& targetTags, const std::vector<StringView>& toDelete);
+    struct TargetRelabelCache {
+        std::mutex mMux;
+        RelabelResultCache mCache;
+        time_t mLastUsedTime = 0;
+
+        explicit TargetRelabelCache(size_t maxSize) : mCache(maxSize) {}
+    };
+
+    bool ProcessEvent(PipelineEventPtr& e,
+                      const GroupTags& targetTags,
+                      const std::vector<StringView>& toDelete,
+                      RelabelResultCache* cache = nullptr);
+    std::shared_ptr<TargetRelabelCache> GetRelabelCache(const GroupTags& targetTags);
     std::vector<StringView> GetToDeleteTargetLabels(const GroupTags& targetTags) const;
 
     void AddAutoMetrics(PipelineEventGroup& metricGroup);
@@ -50,6 +69,14 @@ private:
     std::unique_ptr<ScrapeConfig> mScrapeConfigPtr;
     std::string mLoongCollectorScraper;
 
+    // relabel result caches of targets, keyed by the hash of target labels
+    std::mutex mRelabelCacheMux;
+    std::unordered_map<uint64_t, std::shared_ptr<TargetRelabelCache>> mRelabelCaches;
+    time_t mLastRelabelCacheSweepTime = 0;
+
+    CounterPtr mRelabelCacheHitTotal;
+    CounterPtr mRelabelCacheMissTotal;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorPromRelabelMetricNativeUnittest;
     friend class InputPrometheusUnittest;
@@ -16,6 +16,7 @@
 
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 
+#include "common/CharFinder.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
 
@@ -141,9 +142,12 @@ void ProcessorSplitLogStringNative::ProcessEvent(PipelineEventGroup& logGroup,
     StringView sourceVal = sourceEvent.GetContent(mSourceKey);
     StringBuffer sourceKey = logGroup.GetSourceBuffer()->CopyString(mSourceKey);
 
+    std::vector<size_t> splitPositions;
+    FindAllChars(sourceVal.data(), sourceVal.size(), mSplitChar, splitPositions);
     size_t begin = 0;
-    while (begin < sourceVal.size()) {
-        StringView content = GetNextLine(sourceVal, begin);
+    for (size_t idx = 0; begin < sourceVal.size(); ++idx) {
+        size_t end = idx < splitPositions.size() ? splitPositions[idx] : sourceVal.size();
+        StringView content(sourceVal.data() + begin, end - begin);
         if (mEnableRawContent) {
             std::unique_ptr<RawEvent> targetEvent = logGroup.CreateRawEvent(true);
             targetEvent->SetContentNoCopy(content);
@@ -170,17 +174,4 @@ void ProcessorSplitLogStringNative::ProcessEvent(PipelineEventGroup& logGroup,
     }
 }
 
-StringView ProcessorSplitLogStringNative::GetNextLine(StringView log, size_t begin) {
-    if (begin >= log.size()) {
-        return StringView();
-    }
-
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == mSplitChar) {
-            return StringView(log.data() + begin, end - begin);
-        }
-    }
-    return StringView(log.data() + begin, log.size() - begin);
-}
-
 } // namespace logtail
@@ -16,10 +16,10 @@
 
 #include "plugin/processor/inner/ProcessorSplitMultilineLogStringNative.h"
 
-#include <boost/regex.hpp>
 #include <string>
 
 #include "app_config/AppConfig.h"
+#include "common/CharFinder.h"
 #include "common/ParamExtractor.h"
 #include "constants/Constants.h"
 #include "logger/Logger.h"
@@ -172,18 +172,15 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         ++(*inputLines);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (mMultiline.GetStartPatternReg() != nullptr) {
-                regex = *mMultiline.GetStartPatternReg();
-            } else {
-                regex = *mMultiline.GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(content.data(), content.size(), regex, exception)) {
+            const RegexMatcher& firstPattern = mMultiline.GetStartPatternReg() != nullptr
+                ? *mMultiline.GetStartPatternReg()
+                : *mMultiline.GetContinuePatternReg();
+            if (firstPattern.Search(content, exception)) {
                 multiStartIndex = content.data();
                 isPartialLog = true;
             } else if (mMultiline.GetEndPatternReg() != nullptr && mMultiline.GetStartPatternReg() == nullptr
                        && mMultiline.GetContinuePatternReg() != nullptr
-                       && BoostRegexSearch(content.data(), content.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                       && mMultiline.GetEndPatternReg()->Search(content, exception)) {
                 // case: continue + end
                 CreateNewEvent(content, isLastLog, sourceKey, sourceEvent, logGroup, newEvents);
                 multiStartIndex = content.data() + content.size() + 1;
@@ -195,7 +192,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         } else {
             // case: start + continue or continue + end
             if (mMultiline.GetContinuePatternReg() != nullptr
-                && BoostRegexSearch(content.data(), content.size(), *mMultiline.GetContinuePatternReg(), exception)) {
+                && mMultiline.GetContinuePatternReg()->Search(content, exception)) {
                 begin += content.size() + 1;
                 continue;
             }
@@ -204,7 +201,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                 if (mMultiline.GetContinuePatternReg() != nullptr) {
                     // current line is not matched against the continue pattern, so the end pattern will decide
                     // if the current log is a match or not
-                    if (BoostRegexSearch(content.data(), content.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (mMultiline.GetEndPatternReg()->Search(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -226,7 +223,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(content.data(), content.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (mMultiline.GetEndPatternReg()->Search(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -247,7 +244,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             } else {
                 if (mMultiline.GetContinuePatternReg() == nullptr) {
                     // case: start
-                    if (BoostRegexSearch(content.data(), content.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (mMultiline.GetStartPatternReg()->Search(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() - 1 - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -267,8 +264,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                                    logGroup,
                                    newEvents);
                     mMatchedEventsTotal->Add(1);
-                    if (!BoostRegexSearch(
-                            content.data(), content.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (!mMultiline.GetStartPatternReg()->Search(content, exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both
                         // start and continue pattern are given, and the current line is not matched against the
                         // start pattern
@@ -381,12 +377,7 @@ StringView ProcessorSplitMultilineLogStringNative::GetNextLine(StringView log, s
         return StringView();
     }
 
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == '\n') {
-            return StringView(log.data() + begin, end - begin);
-        }
-    }
-    return StringView(log.data() + begin, log.size() - begin);
+    return StringView(log.data() + begin, FindFirstChar(log.data() + begin, log.size() - begin, '\n'));
 }
 
 } // namespace logtail
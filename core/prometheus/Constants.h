@@ -70,6 +70,7 @@ const char* const BASIC_PREFIX = "Basic ";
 const char* const HONOR_LABELS = "honor_labels";
 const char* const HONOR_TIMESTAMPS = "honor_timestamps";
 const char* const FOLLOW_REDIRECTS = "follow_redirects";
+const char* const CONVERT_CLASSIC_HISTOGRAMS = "convert_classic_histograms_to_nhcb";
 const char* const TLS_CONFIG = "tls_config";
 const char* const CA_FILE = "ca_file";
 const char* const CERT_FILE = "cert_file";
@@ -96,6 +97,11 @@ const char* const SCRAPE_TIMEOUT_LABEL_NAME = "__scrape_timeout__";
 const char* const SCHEME_LABEL_NAME = "__scheme__";
 const char* const METRICS_PATH_LABEL_NAME = "__metrics_path__";
 const char* const PARAM_LABEL_NAME = "__param_";
+const char* const BUCKET_LABEL = "le";
+const char* const QUANTILE_LABEL = "quantile";
+const char* const BUCKET_SUFFIX = "_bucket";
+const char* const SUM_SUFFIX = "_sum";
+const char* const COUNT_SUFFIX = "_count";
 const char* const LABELS = "labels";
 
 // auto metrics
@@ -266,4 +266,104 @@ bool RelabelConfigList::Empty() const {
     return mRelabelConfigs.empty();
 }
 
+bool RelabelConfigList::Process(MetricEvent& event, vector<string>& toDelete, RelabelResult& result) const {
+    vector<pair<string, string>> before;
+    before.reserve(event.TagsSize());
+    for (auto it = event.TagsBegin(); it != event.TagsEnd(); ++it) {
+        before.emplace_back(it->first.to_string(), it->second.to_string());
+    }
+    size_t toDeleteSize = toDelete.size();
+    result.mKeep = Process(event, toDelete);
+    if (!result.mKeep) {
+        return false;
+    }
+    result.mToDelete.assign(toDelete.begin() + toDeleteSize, toDelete.end());
+    // both are sorted by key
+    auto it = event.TagsBegin();
+    auto beforeIt = before.begin();
+    while (it != event.TagsEnd() || beforeIt != before.end()) {
+        if (it == event.TagsEnd() || (beforeIt != before.end() && StringView(beforeIt->first) < it->first)) {
+            result.mDelLabels.push_back(beforeIt->first);
+            ++beforeIt;
+        } else if (beforeIt == before.end() || it->first < StringView(beforeIt->first)) {
+            result.mSetLabels.emplace_back(it->first.to_string(), it->second.to_string());
+            ++it;
+        } else {
+            if (it->second != StringView(beforeIt->second)) {
+                result.mSetLabels.emplace_back(it->first.to_string(), it->second.to_string());
+            }
+            ++it;
+            ++beforeIt;
+        }
+    }
+    return true;
+}
+
+bool RelabelResult::Apply(MetricEvent& event, vector<string>& toDelete) const {
+    if (!mKeep) {
+        return false;
+    }
+    for (const auto& key : mDelLabels) {
+        event.DelTag(key);
+    }
+    for (const auto& [key, value] : mSetLabels) {
+        event.SetTag(key, value);
+    }
+    toDelete.insert(toDelete.end(), mToDelete.begin(), mToDelete.end());
+    return true;
+}
+
+uint64_t RelabelResultCache::Hash(const MetricEvent& event) {
+    uint64_t sum = prometheus::OFFSET64;
+    auto update = [&sum](StringView s) {
+        for (auto c : s) {
+            sum ^= static_cast<uint8_t>(c);
+            sum *= prometheus::PRIME64;
+        }
+        sum ^= 0xff;
+        sum *= prometheus::PRIME64;
+    };
+    update(event.GetName());
+    for (auto it = event.TagsBegin(); it != event.TagsEnd(); ++it) {
+        update(it->first);
+        update(it->second);
+    }
+    return sum;
+}
+
+void RelabelResultCache::StartScrape(uint64_t scrapeId) {
+    if (scrapeId == mScrapeId) {
+        return;
+    }
+    mScrapeId = scrapeId;
+    // series not seen in the last scrape have disappeared
+    for (auto it = mResults.begin(); it != mResults.end();) {
+        if (it->second.mGeneration != mGeneration) {
+            it = mResults.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++mGeneration;
+}
+
+const RelabelResult* RelabelResultCache::Get(uint64_t hash) {
+    auto it = mResults.find(hash);
+    if (it == mResults.end()) {
+        ++mMissCnt;
+        return nullptr;
+    }
+    ++mHitCnt;
+    it->second.mGeneration = mGeneration;
+    return &it->second;
+}
+
+void RelabelResultCache::Add(uint64_t hash, RelabelResult&& result) {
+    if (mResults.size() >= mMaxSize) {
+        return;
+    }
+    result.mGeneration = mGeneration;
+    mResults[hash] = std::move(result);
+}
+
 } // namespace logtail
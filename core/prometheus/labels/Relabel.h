@@ -18,7 +18,11 @@
 #include <json/json.h>
 
 #include <boost/regex.hpp>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "prometheus/labels/Labels.h"
 
@@ -69,10 +73,49 @@ private:
     void CollectLabelsToDelete(const std::string& labelName, std::vector<std::string>& toDelete) const;
 };
 
+// RelabelResult is the relabel decision of a series and the label mutations made by relabel, which can be applied to
+// the same series in the following scrapes without running relabel configs again.
+struct RelabelResult {
+    bool mKeep = true;
+    std::vector<std::pair<std::string, std::string>> mSetLabels;
+    std::vector<std::string> mDelLabels;
+    std::vector<std::string> mToDelete;
+    uint64_t mGeneration = 0;
+
+    bool Apply(MetricEvent&, std::vector<std::string>& toDelete) const;
+};
+
+// RelabelResultCache memoizes relabel results of the series of one target, keyed by the hash of series labels. Series
+// not seen in the last scrape are evicted when a new scrape begins, and no more series are cached after the size
+// reaches mMaxSize.
+// not thread-safe, should be protected explicitly by the owner
+class RelabelResultCache {
+public:
+    explicit RelabelResultCache(size_t maxSize) : mMaxSize(maxSize) {}
+
+    static uint64_t Hash(const MetricEvent&);
+
+    void StartScrape(uint64_t scrapeId);
+    const RelabelResult* Get(uint64_t hash);
+    void Add(uint64_t hash, RelabelResult&& result);
+    size_t Size() const { return mResults.size(); }
+
+    uint64_t mHitCnt = 0;
+    uint64_t mMissCnt = 0;
+
+private:
+    std::unordered_map<uint64_t, RelabelResult> mResults;
+    size_t mMaxSize = 0;
+    uint64_t mScrapeId = 0;
+    uint64_t mGeneration = 0;
+};
+
 class RelabelConfigList {
 public:
     bool Init(const Json::Value& relabelConfigs);
     bool Process(MetricEvent&, std::vector<std::string>& toDelete) const;
+    // same as above, with the label mutations recorded in @result
+    bool Process(MetricEvent&, std::vector<std::string>& toDelete, RelabelResult& result) const;
     bool Process(Labels&, std::vector<std::string>& toDelete) const;
 
     [[nodiscard]] bool Empty() const;
@@ -17,9 +17,14 @@
 #include "prometheus/labels/TextParser.h"
 
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <charconv>
 #include <cmath>
+#include <cstring>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "common/StringTools.h"
 #include "logger/Logger.h"
@@ -40,6 +45,120 @@ bool IsValidNumberChar(char c) {
     return sValidChars.count(c);
 };
 
+namespace {
+
+bool IsSameSeries(const MetricEvent& a, const MetricEvent& b, StringView ignoredKey) {
+    StringView nameKey(prometheus::NAME);
+    auto skip = [&](const MetricEvent& e, map<StringView, StringView>::const_iterator& it) {
+        while (it != e.TagsEnd() && (it->first == ignoredKey || it->first == nameKey)) {
+            ++it;
+        }
+    };
+    auto ia = a.TagsBegin();
+    auto ib = b.TagsBegin();
+    while (true) {
+        skip(a, ia);
+        skip(b, ib);
+        if (ia == a.TagsEnd() || ib == b.TagsEnd()) {
+            return ia == a.TagsEnd() && ib == b.TagsEnd();
+        }
+        if (ia->first != ib->first || ia->second != ib->second) {
+            return false;
+        }
+        ++ia;
+        ++ib;
+    }
+}
+
+bool IsNameOf(StringView name, StringView baseName, StringView suffix) {
+    return name.size() == baseName.size() + suffix.size() && name.starts_with(baseName) && name.ends_with(suffix);
+}
+
+bool ParseBound(StringView str, double& res) {
+    try {
+        res = stod(str.to_string());
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
+// returns the number of events consumed from @begin
+size_t MergeSeries(EventsContainer& events, size_t begin) {
+    auto& first = events[begin].Cast<MetricEvent>();
+    if (!first.Is<UntypedSingleValue>()) {
+        return 1;
+    }
+    StringView name = first.GetName();
+    StringView labelKey;
+    StringView baseName;
+    bool isHistogram = false;
+    if (name.ends_with(prometheus::BUCKET_SUFFIX) && first.HasTag(prometheus::BUCKET_LABEL)) {
+        isHistogram = true;
+        labelKey = prometheus::BUCKET_LABEL;
+        baseName = name.substr(0, name.size() - strlen(prometheus::BUCKET_SUFFIX));
+    } else if (first.HasTag(prometheus::QUANTILE_LABEL)) {
+        labelKey = prometheus::QUANTILE_LABEL;
+        baseName = name;
+    } else {
+        return 1;
+    }
+
+    vector<pair<double, double>> points;
+    size_t end = begin;
+    for (; end < events.size() && events[end].Is<MetricEvent>(); ++end) {
+        const auto& e = events[end].Cast<MetricEvent>();
+        if (e.GetName() != name || !e.Is<UntypedSingleValue>() || !e.HasTag(labelKey)
+            || !IsSameSeries(first, e, labelKey)) {
+            break;
+        }
+        double bound = 0.0;
+        if (!ParseBound(e.GetTag(labelKey), bound)) {
+            return 1;
+        }
+        points.emplace_back(bound, e.GetValue<UntypedSingleValue>()->mValue);
+    }
+    // _sum and _count follow the buckets or quantiles
+    if (end + 2 > events.size() || !events[end].Is<MetricEvent>() || !events[end + 1].Is<MetricEvent>()) {
+        return 1;
+    }
+    const auto& sumEvent = events[end].Cast<MetricEvent>();
+    const auto& countEvent = events[end + 1].Cast<MetricEvent>();
+    if (!IsNameOf(sumEvent.GetName(), baseName, prometheus::SUM_SUFFIX) || !sumEvent.Is<UntypedSingleValue>()
+        || !IsSameSeries(first, sumEvent, labelKey)
+        || !IsNameOf(countEvent.GetName(), baseName, prometheus::COUNT_SUFFIX)
+        || !countEvent.Is<UntypedSingleValue>() || !IsSameSeries(first, countEvent, labelKey)) {
+        return 1;
+    }
+    if (!is_sorted(points.begin(), points.end())) {
+        sort(points.begin(), points.end());
+    }
+    double sum = sumEvent.GetValue<UntypedSingleValue>()->mValue;
+    double count = countEvent.GetValue<UntypedSingleValue>()->mValue;
+
+    first.SetNameNoCopy(baseName);
+    first.DelTag(labelKey);
+    if (first.HasTag(prometheus::NAME)) {
+        first.SetTagNoCopy(prometheus::NAME, baseName);
+    }
+    if (isHistogram) {
+        first.SetValue<HistogramValue>();
+        auto* value = first.MutableValue<HistogramValue>();
+        value->mBuckets.swap(points);
+        value->mSum = sum;
+        value->mCount = count;
+    } else {
+        first.SetValue<SummaryValue>();
+        auto* value = first.MutableValue<SummaryValue>();
+        value->mQuantiles.swap(points);
+        value->mSum = sum;
+        value->mCount = count;
+    }
+    return end + 2 - begin;
+}
+
+} // namespace
+
 TextParser::TextParser(bool honorTimestamps) : mHonorTimestamps(honorTimestamps) {
 }
 
@@ -64,10 +183,26 @@ PipelineEventGroup TextParser::Parse(const string& content, uint64_t defaultTime
             eGroup.MutableEvents().emplace_back(std::move(metricEvent), false, nullptr);
         }
     }
+    if (mConvertClassicHistograms) {
+        MergeHistogramsAndSummaries(eGroup.MutableEvents());
+    }
 
     return eGroup;
 }
 
+void TextParser::MergeHistogramsAndSummaries(EventsContainer& events) {
+    size_t wIdx = 0;
+    for (size_t rIdx = 0; rIdx < events.size();) {
+        size_t cnt = events[rIdx].Is<MetricEvent>() ? MergeSeries(events, rIdx) : 1;
+        if (wIdx != rIdx) {
+            events[wIdx] = std::move(events[rIdx]);
+        }
+        ++wIdx;
+        rIdx += cnt;
+    }
+    events.resize(wIdx);
+}
+
 bool TextParser::ParseLine(StringView line, MetricEvent& metricEvent) {
     mLine = line;
     mPos = 0;
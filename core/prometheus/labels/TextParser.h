@@ -31,11 +31,17 @@ public:
     explicit TextParser(bool honorTimestamps);
 
     void SetDefaultTimestamp(uint64_t defaultTimestamp, uint32_t defaultNanoSec);
+    void SetConvertClassicHistograms(bool convert) { mConvertClassicHistograms = convert; }
 
     PipelineEventGroup Parse(const std::string& content, uint64_t defaultTimestamp, uint32_t defaultNanoSec);
 
     bool ParseLine(StringView line, MetricEvent& metricEvent);
 
+    // merges the buckets (quantiles), _sum and _count samples of one classic histogram (summary) series, which are
+    // adjacent in the exposition, into one event with HistogramValue (SummaryValue) named after the metric family.
+    // events not forming a complete series are left as is.
+    static void MergeHistogramsAndSummaries(EventsContainer& events);
+
 private:
     void HandleError(const std::string& errMsg);
 
@@ -63,6 +69,7 @@ private:
     std::string mDoubleStr;
 
     bool mHonorTimestamps{true};
+    bool mConvertClassicHistograms{false};
     time_t mDefaultTimestamp{0};
     uint32_t mDefaultNanoTimestamp{0};
 
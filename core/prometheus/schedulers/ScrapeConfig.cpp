@@ -21,6 +21,7 @@ ScrapeConfig::ScrapeConfig()
       mMetricsPath("/metrics"),
       mHonorLabels(false),
       mHonorTimestamps(true),
+      mConvertClassicHistograms(false),
       mScheme("http"),
       mFollowRedirects(true),
       mEnableTLS(false),
@@ -149,6 +150,11 @@ bool ScrapeConfig::InitStaticConfig(const Json::Value& scrapeConfig) {
         mHonorTimestamps = scrapeConfig[prometheus::HONOR_TIMESTAMPS].asBool();
     }
 
+    if (scrapeConfig.isMember(prometheus::CONVERT_CLASSIC_HISTOGRAMS)
+        && scrapeConfig[prometheus::CONVERT_CLASSIC_HISTOGRAMS].isBool()) {
+        mConvertClassicHistograms = scrapeConfig[prometheus::CONVERT_CLASSIC_HISTOGRAMS].asBool();
+    }
+
     if (scrapeConfig.isMember(prometheus::SCHEME) && scrapeConfig[prometheus::SCHEME].isString()) {
         mScheme = scrapeConfig[prometheus::SCHEME].asString();
     }
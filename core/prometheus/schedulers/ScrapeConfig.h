@@ -22,6 +22,8 @@ public:
     std::string mMetricsPath;
     bool mHonorLabels;
     bool mHonorTimestamps;
+    // merge the samples of classic histograms and summaries into one event per series
+    bool mConvertClassicHistograms;
     std::string mScheme;
 
     // auth header
@@ -21,6 +21,8 @@
 #include <string>
 #include <utility>
 
+#include "common/CharFinder.h"
+#include "common/Flags.h"
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
 #include "common/timer/HttpRequestTimerEvent.h"
@@ -35,6 +37,10 @@
 
 using namespace std;
 
+DEFINE_FLAG_BOOL(prom_stream_parse_metric,
+                 "parse prometheus metrics in http callback directly instead of in processor",
+                 false);
+
 namespace logtail {
 
 size_t PromMetricWriteCallback(char* buffer, size_t size, size_t nmemb, void* data) {
@@ -47,17 +53,16 @@ size_t PromMetricWriteCallback(char* buffer, size_t size, size_t nmemb, void* da
     auto* body = static_cast<PromMetricResponseBody*>(data);
 
     size_t begin = 0;
-    for (size_t end = begin; end < sizes; ++end) {
-        if (buffer[end] == '\n') {
-            if (begin == 0 && !body->mCache.empty()) {
-                body->mCache.append(buffer, end);
-                body->AddEvent(body->mCache.data(), body->mCache.size());
-                body->mCache.clear();
-            } else if (begin != end) {
-                body->AddEvent(buffer + begin, end - begin);
-            }
-            begin = end + 1;
+    for (size_t end = FindFirstChar(buffer, sizes, '\n'); end < sizes;
+         end = begin + FindFirstChar(buffer + begin, sizes - begin, '\n')) {
+        if (begin == 0 && !body->mCache.empty()) {
+            body->mCache.append(buffer, end);
+            body->AddEvent(body->mCache.data(), body->mCache.size());
+            body->mCache.clear();
+        } else if (begin != end) {
+            body->AddEvent(buffer + begin, end - begin);
         }
+        begin = end + 1;
     }
     if (begin < sizes) {
         body->mCache.append(buffer + begin, sizes - begin);
@@ -211,6 +216,14 @@ std::unique_ptr<TimerEvent> ScrapeScheduler::BuildScrapeTimerEvent(std::chrono::
     if (retry > 0) {
         retry -= 1;
     }
+    auto* body = new PromMetricResponseBody(mEventPool);
+    if (BOOL_FLAG(prom_stream_parse_metric)) {
+        // the scrape timestamp is determined before the request is sent
+        auto timestampMilliSec
+            = chrono::duration_cast<chrono::milliseconds>(mLatestScrapeTime.time_since_epoch()).count();
+        body->mParser = std::make_unique<TextParser>(mScrapeConfigPtr->mHonorTimestamps);
+        body->mParser->SetDefaultTimestamp(timestampMilliSec / 1000, timestampMilliSec % 1000 * 1000000);
+    }
     auto request = std::make_unique<PromHttpRequest>(
         sdk::HTTP_GET,
         mScrapeConfigPtr->mScheme == prometheus::HTTPS,
@@ -221,7 +234,7 @@ std::unique_ptr<TimerEvent> ScrapeScheduler::BuildScrapeTimerEvent(std::chrono::
         mScrapeConfigPtr->mRequestHeaders,
         "",
         HttpResponse(
-            new PromMetricResponseBody(mEventPool),
+            body,
             [](void* ptr) { delete static_cast<PromMetricResponseBody*>(ptr); },
             PromMetricWriteCallback),
         mScrapeConfigPtr->mScrapeTimeoutSeconds,
@@ -24,8 +24,10 @@
 #include "models/PipelineEventGroup.h"
 #include "monitor/metric_models/MetricTypes.h"
 #include "pipeline/queue/QueueKey.h"
+#include "prometheus/Constants.h"
 #include "prometheus/PromSelfMonitor.h"
 #include "prometheus/Utils.h"
+#include "prometheus/labels/TextParser.h"
 #include "prometheus/schedulers/ScrapeConfig.h"
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -41,13 +43,25 @@ struct PromMetricResponseBody {
     std::string mCache;
     size_t mRawSize = 0;
     EventPool* mEventPool = nullptr;
+    // if set, lines are parsed into metric events as soon as they are received, instead of being kept as raw events
+    // and parsed by processor
+    std::unique_ptr<TextParser> mParser;
 
     explicit PromMetricResponseBody(EventPool* eventPool)
         : mEventGroup(std::make_shared<SourceBuffer>()), mEventPool(eventPool) {};
     void AddEvent(char* line, size_t len) {
         if (IsValidMetric(StringView(line, len))) {
-            auto* e = mEventGroup.AddRawEvent(true, mEventPool);
             auto sb = mEventGroup.GetSourceBuffer()->CopyString(line, len);
+            if (mParser) {
+                auto* e = mEventGroup.AddMetricEvent(true, mEventPool);
+                if (mParser->ParseLine(StringView(sb.data, sb.size), *e)) {
+                    e->SetTag(StringView(prometheus::NAME), e->GetName());
+                } else {
+                    mEventGroup.MutableEvents().pop_back();
+                }
+                return;
+            }
+            auto* e = mEventGroup.AddRawEvent(true, mEventPool);
             e->SetContentNoCopy(sb);
         }
     }
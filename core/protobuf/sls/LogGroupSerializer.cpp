@@ -182,7 +182,11 @@ void LogGroupSerializer::AddString(StringView value) {
     mRes.append(value.data(), value.size());
 }
 
-void LogGroupSerializer::AddLogContentMetricLabel(const MetricEvent& e, size_t valueSZ) {
+void LogGroupSerializer::AddLogContentMetricLabel(const MetricEvent& e,
+                                                  size_t valueSZ,
+                                                  StringView extraKey,
+                                                  StringView extraValue,
+                                                  StringView name) {
     // Contents
     mRes.push_back(0x12);
     uint32_pack(GetStringSize(METRIC_RESERVED_KEY_LABELS.size()) + GetStringSize(valueSZ), mRes);
@@ -194,14 +198,29 @@ void LogGroupSerializer::AddLogContentMetricLabel(const MetricEvent& e, size_t v
     mRes.push_back(0x12);
     uint32_pack(valueSZ, mRes);
     bool hasPrev = false;
-    for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
+    auto appendLabel = [&](StringView key, StringView value) {
         if (hasPrev) {
             mRes.append(METRIC_LABELS_SEPARATOR);
         }
         hasPrev = true;
-        mRes.append(it->first.data(), it->first.size());
+        mRes.append(key.data(), key.size());
         mRes.append(METRIC_LABELS_KEY_VALUE_SEPARATOR);
-        mRes.append(it->second.data(), it->second.size());
+        mRes.append(value.data(), value.size());
+    };
+    bool extraAdded = extraKey.empty();
+    for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
+        if (!extraAdded && extraKey < it->first) {
+            appendLabel(extraKey, extraValue);
+            extraAdded = true;
+        }
+        if (!name.empty() && it->first == METRIC_RESERVED_KEY_NAME) {
+            appendLabel(it->first, name);
+        } else {
+            appendLabel(it->first, it->second);
+        }
+    }
+    if (!extraAdded) {
+        appendLabel(extraKey, extraValue);
     }
 }
 
@@ -258,13 +277,26 @@ size_t GetLogTagSize(size_t keySZ, size_t valueSZ) {
     return res;
 }
 
-size_t GetMetricLabelSize(const MetricEvent& e) {
+size_t GetMetricLabelSize(const MetricEvent& e, StringView extraKey, StringView extraValue, StringView name) {
     static size_t labelSepSZ = METRIC_LABELS_SEPARATOR.size();
     static size_t keyValSepSZ = METRIC_LABELS_KEY_VALUE_SEPARATOR.size();
 
-    size_t valueSZ = e.TagsSize() * keyValSepSZ + (e.TagsSize() - 1) * labelSepSZ;
+    size_t labelCnt = e.TagsSize();
+    size_t valueSZ = 0;
+    if (!extraKey.empty()) {
+        ++labelCnt;
+        valueSZ += extraKey.size() + extraValue.size();
+    }
+    if (labelCnt == 0) {
+        return 0;
+    }
+    valueSZ += labelCnt * keyValSepSZ + (labelCnt - 1) * labelSepSZ;
     for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
-        valueSZ += it->first.size() + it->second.size();
+        if (!name.empty() && it->first == METRIC_RESERVED_KEY_NAME) {
+            valueSZ += it->first.size() + name.size();
+        } else {
+            valueSZ += it->first.size() + it->second.size();
+        }
     }
     return valueSZ;
 }
@@ -46,7 +46,13 @@ public:
     void AddLogTag(StringView key, StringView value);
     std::string& GetResult() { return mRes; }
 
-    void AddLogContentMetricLabel(const MetricEvent& e, size_t valueSZ);
+    // @extraKey, if not empty, is added to the labels of the event in order
+    // @name, if not empty, replaces the value of the __name__ label of the event
+    void AddLogContentMetricLabel(const MetricEvent& e,
+                                  size_t valueSZ,
+                                  StringView extraKey = StringView(),
+                                  StringView extraValue = StringView(),
+                                  StringView name = StringView());
     void AddLogContentMetricTimeNano(const MetricEvent& e);
 
 private:
@@ -60,6 +66,9 @@ size_t GetLogSize(size_t contentSZ, bool hasNs, size_t& logSZ);
 size_t GetStringSize(size_t size);
 size_t GetLogTagSize(size_t keySZ, size_t valueSZ);
 
-size_t GetMetricLabelSize(const MetricEvent& e);
+size_t GetMetricLabelSize(const MetricEvent& e,
+                          StringView extraKey = StringView(),
+                          StringView extraValue = StringView(),
+                          StringView name = StringView());
 
 } // namespace logtail
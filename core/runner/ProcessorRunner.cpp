@@ -40,6 +40,7 @@ thread_local CounterPtr ProcessorRunner::sInGroupsCnt;
 thread_local CounterPtr ProcessorRunner::sInEventsCnt;
 thread_local CounterPtr ProcessorRunner::sInGroupDataSizeBytes;
 thread_local IntGaugePtr ProcessorRunner::sLastRunTime;
+thread_local HistogramPtr ProcessorRunner::sQueueWaitLatencyMs;
 
 ProcessorRunner::ProcessorRunner()
     : mThreadCount(AppConfig::GetInstance()->GetProcessThreadCount()), mThreadRes(mThreadCount) {
@@ -99,6 +100,7 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     sInEventsCnt = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_EVENTS_TOTAL);
     sInGroupDataSizeBytes = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_SIZE_BYTES);
     sLastRunTime = sMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
+    sQueueWaitLatencyMs = sMetricsRecordRef.CreateHistogram(METRIC_RUNNER_PROCESSOR_QUEUE_WAIT_LATENCY_MS);
 
     static int32_t lastFlushBatchTime = 0;
     while (true) {
@@ -122,6 +124,7 @@ void ProcessorRunner::Run(uint32_t threadNo) {
         sInEventsCnt->Add(item->mEventGroup.GetEvents().size());
         sInGroupsCnt->Add(1);
         sInGroupDataSizeBytes->Add(item->mEventGroup.DataSize());
+        sQueueWaitLatencyMs->Add(chrono::system_clock::now() - item->mEnqueTime);
 
         shared_ptr<Pipeline>& pipeline = item->mPipeline;
         bool hasOldPipeline = pipeline != nullptr;
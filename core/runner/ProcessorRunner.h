@@ -64,6 +64,7 @@ private:
     thread_local static CounterPtr sInEventsCnt;
     thread_local static CounterPtr sInGroupDataSizeBytes;
     thread_local static IntGaugePtr sLastRunTime;
+    thread_local static HistogramPtr sQueueWaitLatencyMs;
 };
 
 } // namespace logtail
@@ -26,6 +26,7 @@
 #include "runner/FlusherRunner.h"
 
 DEFINE_FLAG_INT32(http_sink_exit_timeout_secs, "", 5);
+DEFINE_FLAG_INT32(http_sink_max_idle_handlers_per_host, "max number of idle curl handlers kept for each host", 64);
 
 using namespace std;
 
@@ -37,6 +38,14 @@ bool HttpSink::Init() {
         LOG_ERROR(sLogger, ("failed to init http sink", "failed to init curl multi client"));
         return false;
     }
+    mShare = curl_share_init();
+    if (mShare != nullptr) {
+        // all handlers are used in the sink thread only, so no lock is needed
+        curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    } else {
+        LOG_WARNING(sLogger, ("failed to init curl share handle", "dns and tls session are not shared"));
+    }
 
     WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
         mMetricsRecordRef,
@@ -50,8 +59,12 @@ bool HttpSink::Init() {
         = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS);
     mFailedItemTotalResponseTimeMs
         = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS);
+    mResponseLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_RUNNER_SINK_RESPONSE_LATENCY_MS);
     mSendingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL);
     mSendConcurrency = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SEND_CONCURRENCY);
+    mHandlerPoolHitRate = mMetricsRecordRef.CreateDoubleGauge(METRIC_RUNNER_SINK_HANDLER_POOL_HIT_RATE);
+    mPooledHandlersTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_POOLED_HANDLERS_TOTAL);
+    mNewConnectionsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_SINK_NEW_CONNECTIONS_TOTAL);
 
     // TODO: should be dynamic
     mSendConcurrency->Set(AppConfig::GetInstance()->GetSendRequestConcurrency());
@@ -99,14 +112,20 @@ void HttpSink::Run() {
         }
         DoRun();
     }
+    ClearHandlerPool();
     auto mc = curl_multi_cleanup(mClient);
     if (mc != CURLM_OK) {
         LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
     }
+    if (mShare != nullptr) {
+        curl_share_cleanup(mShare);
+        mShare = nullptr;
+    }
 }
 
 bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
     curl_slist* headers = nullptr;
+    CURL* reusedCurl = AcquireHandler(request->mHost);
     CURL* curl = CreateCurlHandler(request->mMethod,
                                    request->mHTTPSFlag,
                                    request->mHost,
@@ -114,12 +133,15 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
                                    request->mUrl,
                                    request->mQueryString,
                                    request->mHeader,
-                                   request->mBody,
+                                   request->GetBody(),
                                    request->mResponse,
                                    headers,
                                    request->mTimeout,
                                    AppConfig::GetInstance()->IsHostIPReplacePolicyEnabled(),
-                                   AppConfig::GetInstance()->GetBindInterface());
+                                   AppConfig::GetInstance()->GetBindInterface(),
+                                   false,
+                                   std::nullopt,
+                                   reusedCurl);
     if (curl == nullptr) {
         request->mItem->mStatus = SendingStatus::IDLE;
         FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
@@ -133,6 +155,9 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
     }
 
     request->mPrivateData = headers;
+    if (mShare != nullptr) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, mShare);
+    }
     curl_easy_setopt(curl, CURLOPT_PRIVATE, request.get());
     request->mLastSendTime = chrono::system_clock::now();
 
@@ -238,7 +263,12 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
             CURL* handler = msg->easy_handle;
             HttpSinkRequest* request = nullptr;
             curl_easy_getinfo(handler, CURLINFO_PRIVATE, &request);
+            long newConnections = 0;
+            if (curl_easy_getinfo(handler, CURLINFO_NUM_CONNECTS, &newConnections) == CURLE_OK) {
+                mNewConnectionsTotal->Add(newConnections);
+            }
             auto pipelinePlaceHolder = request->mItem->mPipeline; // keep pipeline alive
+            const string host = request->mHost;
             auto responseTime = chrono::system_clock::now() - request->mLastSendTime;
             auto responseTimeMs = chrono::duration_cast<chrono::milliseconds>(responseTime).count();
             switch (msg->data.result) {
@@ -256,6 +286,7 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
                     mOutSuccessfulItemsTotal->Add(1);
                     mSuccessfulItemTotalResponseTimeMs->Add(responseTime);
+                    mResponseLatencyMs->Add(responseTime);
                     mSendingItemsTotal->Sub(1);
                     break;
                 }
@@ -291,11 +322,12 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     }
                     mOutFailedItemsTotal->Add(1);
                     mFailedItemTotalResponseTimeMs->Add(responseTime);
+                    mResponseLatencyMs->Add(responseTime);
                     mSendingItemsTotal->Sub(1);
                     break;
             }
             curl_multi_remove_handle(mClient, handler);
-            curl_easy_cleanup(handler);
+            ReleaseHandler(host, handler);
             if (!requestReused) {
                 if (request->mPrivateData) {
                     curl_slist_free_all((curl_slist*)request->mPrivateData);
@@ -307,4 +339,41 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
     }
 }
 
+CURL* HttpSink::AcquireHandler(const string& host) {
+    CURL* handler = nullptr;
+    auto it = mHandlerPool.find(host);
+    if (it != mHandlerPool.end() && !it->second.empty()) {
+        handler = it->second.back();
+        it->second.pop_back();
+        mPooledHandlersTotal->Sub(1);
+        ++mHandlerPoolHitCnt;
+    } else {
+        ++mHandlerPoolMissCnt;
+    }
+    mHandlerPoolHitRate->Set(static_cast<double>(mHandlerPoolHitCnt) / (mHandlerPoolHitCnt + mHandlerPoolMissCnt));
+    return handler;
+}
+
+void HttpSink::ReleaseHandler(const string& host, CURL* handler) {
+    auto& handlers = mHandlerPool[host];
+    if (handlers.size() >= static_cast<size_t>(INT32_FLAG(http_sink_max_idle_handlers_per_host))) {
+        curl_easy_cleanup(handler);
+        return;
+    }
+    // options are cleared, while dns cache and tls session ids are kept
+    curl_easy_reset(handler);
+    handlers.push_back(handler);
+    mPooledHandlersTotal->Add(1);
+}
+
+void HttpSink::ClearHandlerPool() {
+    for (auto& item : mHandlerPool) {
+        for (auto handler : item.second) {
+            curl_easy_cleanup(handler);
+        }
+    }
+    mHandlerPool.clear();
+    mPooledHandlersTotal->Set(0);
+}
+
 } // namespace logtail
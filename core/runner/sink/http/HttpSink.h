@@ -22,6 +22,9 @@
 #include <condition_variable>
 #include <future>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "runner/sink/Sink.h"
 #include "runner/sink/http/HttpSinkRequest.h"
@@ -50,8 +53,17 @@ private:
     bool AddRequestToClient(std::unique_ptr<HttpSinkRequest>&& request);
     void DoRun();
     void HandleCompletedRequests(int& runningHandlers);
+    CURL* AcquireHandler(const std::string& host);
+    void ReleaseHandler(const std::string& host, CURL* handler);
+    void ClearHandlerPool();
 
     CURLM* mClient = nullptr;
+    // dns and tls sessions are shared by all handlers, while connections are already shared within mClient
+    CURLSH* mShare = nullptr;
+    // idle handlers of each host, which are reset and reused by later requests to keep the resources allocated
+    std::unordered_map<std::string, std::vector<CURL*>> mHandlerPool;
+    uint64_t mHandlerPoolHitCnt = 0;
+    uint64_t mHandlerPoolMissCnt = 0;
 
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
@@ -62,12 +74,17 @@ private:
     CounterPtr mOutFailedItemsTotal;
     TimeCounterPtr mSuccessfulItemTotalResponseTimeMs;
     TimeCounterPtr mFailedItemTotalResponseTimeMs;
+    HistogramPtr mResponseLatencyMs;
     IntGaugePtr mSendingItemsTotal;
     IntGaugePtr mSendConcurrency;
+    DoubleGaugePtr mHandlerPoolHitRate;
+    IntGaugePtr mPooledHandlersTotal;
+    CounterPtr mNewConnectionsTotal;
     IntGaugePtr mLastRunTime;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherRunnerUnittest;
+    friend class HttpSinkUnittest;
 #endif
 };
 
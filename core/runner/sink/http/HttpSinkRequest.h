@@ -24,6 +24,8 @@ namespace logtail {
 struct HttpSinkRequest : public AsynHttpRequest {
     SenderQueueItem* mItem = nullptr;
 
+    // when body is the data of the item, it is borrowed rather than copied, since the item is not released until the
+    // request is done. This avoids duplicating large batches on each send and retry.
     HttpSinkRequest(const std::string& method,
                     bool httpsFlag,
                     const std::string& host,
@@ -33,10 +35,25 @@ struct HttpSinkRequest : public AsynHttpRequest {
                     const std::map<std::string, std::string>& header,
                     const std::string& body,
                     SenderQueueItem* item)
-        : AsynHttpRequest(method, httpsFlag, host, port, url, query, header, body), mItem(item) {}
+        : AsynHttpRequest(method, httpsFlag, host, port, url, query, header, BodyToCopy(body, item)),
+          mItem(item) {
+        if (IsItemData(body, item)) {
+            mBodyRef = &item->mData;
+        }
+    }
 
     bool IsContextValid() const override { return true; }
     void OnSendDone(HttpResponse& response) override {}
+
+private:
+    static bool IsItemData(const std::string& body, const SenderQueueItem* item) {
+        return item != nullptr && &body == &item->mData;
+    }
+
+    static const std::string& BodyToCopy(const std::string& body, const SenderQueueItem* item) {
+        static const std::string sEmpty;
+        return IsItemData(body, item) ? sEmpty : body;
+    }
 };
 
 } // namespace logtail
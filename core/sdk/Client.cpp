@@ -174,6 +174,7 @@ namespace sdk {
                                                                       const std::string& logstore,
                                                                       sls_logs::SlsCompressType compressType,
                                                                       const std::string& compressedLogGroup,
+                                                                      const std::string& contentMd5,
                                                                       uint32_t rawSize,
                                                                       SenderQueueItem* item,
                                                                       const std::string& hashKey,
@@ -184,10 +185,11 @@ namespace sdk {
         httpHeader[X_LOG_BODYRAWSIZE] = std::to_string(rawSize);
         httpHeader[X_LOG_COMPRESSTYPE] = Client::GetCompressTypeString(compressType);
         if (isTimeSeries) {
-            return CreateAsynPostMetricStoreLogsRequest(project, logstore, compressedLogGroup, httpHeader, item);
+            return CreateAsynPostMetricStoreLogsRequest(
+                project, logstore, compressedLogGroup, contentMd5, httpHeader, item);
         } else {
             return CreateAsynPostLogStoreLogsRequest(
-                project, logstore, compressedLogGroup, httpHeader, hashKey, hashKeySeqID, item);
+                project, logstore, compressedLogGroup, contentMd5, httpHeader, hashKey, hashKeySeqID, item);
         }
     }
 
@@ -196,6 +198,7 @@ namespace sdk {
                                                                                 const std::string& logstore,
                                                                                 sls_logs::SlsCompressType compressType,
                                                                                 const std::string& packageListData,
+                                                                                const std::string& contentMd5,
                                                                                 SenderQueueItem* item,
                                                                                 const std::string& hashKey) {
         map<string, string> httpHeader;
@@ -204,7 +207,7 @@ namespace sdk {
         httpHeader[X_LOG_BODYRAWSIZE] = std::to_string(packageListData.size());
         httpHeader[X_LOG_COMPRESSTYPE] = Client::GetCompressTypeString(compressType);
         return CreateAsynPostLogStoreLogsRequest(
-            project, logstore, packageListData, httpHeader, hashKey, kInvalidHashKeySeqID, item);
+            project, logstore, packageListData, contentMd5, httpHeader, hashKey, kInvalidHashKeySeqID, item);
     }
 
     void Client::SendRequest(const std::string& project,
@@ -265,6 +268,7 @@ namespace sdk {
     Client::CreateAsynPostMetricStoreLogsRequest(const std::string& project,
                                                  const std::string& logstore,
                                                  const std::string& body,
+                                                 const std::string& contentMd5,
                                                  std::map<std::string, std::string>& httpHeader,
                                                  SenderQueueItem* item) {
         SLSClientManager::AuthType type;
@@ -283,7 +287,7 @@ namespace sdk {
 
         string operation = METRICSTORES;
         operation.append("/").append(project).append("/").append(logstore).append("/api/v1/write");
-        httpHeader[CONTENT_MD5] = CalcMD5(body);
+        httpHeader[CONTENT_MD5] = contentMd5.empty() ? CalcMD5(body) : contentMd5;
         map<string, string> parameterList;
         string host = GetSlsHost();
         SetCommonHeader(httpHeader, (int32_t)(body.length()), "");
@@ -296,6 +300,7 @@ namespace sdk {
     Client::CreateAsynPostLogStoreLogsRequest(const std::string& project,
                                               const std::string& logstore,
                                               const std::string& body,
+                                              const std::string& contentMd5,
                                               std::map<std::string, std::string>& httpHeader,
                                               const std::string& hashKey,
                                               int64_t hashKeySeqID,
@@ -321,7 +326,7 @@ namespace sdk {
         else
             operation.append("/shards/route");
 
-        httpHeader[CONTENT_MD5] = CalcMD5(body);
+        httpHeader[CONTENT_MD5] = contentMd5.empty() ? CalcMD5(body) : contentMd5;
 
         map<string, string> parameterList;
         if (!hashKey.empty()) {
@@ -98,6 +98,7 @@ namespace sdk {
          * @param project The project name
          * @param logstore The logstore name
          * @param compressedLogGroup data of logGroup, LZ4 comressed
+         * @param contentMd5 md5 of compressedLogGroup, calculated if empty
          * @param rawSize before compress
          * @param compressType compression type
          * @return request_id.
@@ -106,6 +107,7 @@ namespace sdk {
                                                                        const std::string& logstore,
                                                                        sls_logs::SlsCompressType compressType,
                                                                        const std::string& compressedLogGroup,
+                                                                       const std::string& contentMd5,
                                                                        uint32_t rawSize,
                                                                        SenderQueueItem* item,
                                                                        const std::string& hashKey = "",
@@ -115,6 +117,7 @@ namespace sdk {
          * @param project The project name
          * @param logstore The logstore name
          * @param compressedLogGroup data of logGroup, LZ4 comressed
+         * @param contentMd5 md5 of compressedLogGroup, calculated if empty
          * @param rawSize before compress
          * @param compressType compression type
          * @return request_id.
@@ -123,10 +126,19 @@ namespace sdk {
                                                                           const std::string& logstore,
                                                                           sls_logs::SlsCompressType compressType,
                                                                           const std::string& compressedLogGroup,
+                                                                          const std::string& contentMd5,
                                                                           uint32_t rawSize,
                                                                           SenderQueueItem* item) {
-            return CreatePostLogStoreLogsRequest(
-                project, logstore, compressType, compressedLogGroup, rawSize, item, "", kInvalidHashKeySeqID, true);
+            return CreatePostLogStoreLogsRequest(project,
+                                                 logstore,
+                                                 compressType,
+                                                 compressedLogGroup,
+                                                 contentMd5,
+                                                 rawSize,
+                                                 item,
+                                                 "",
+                                                 kInvalidHashKeySeqID,
+                                                 true);
         }
 
 
@@ -134,12 +146,14 @@ namespace sdk {
          * @param project The project name
          * @param logstore The logstore name
          * @param packageListData data of logPackageList, consist of several LogGroup
+         * @param contentMd5 md5 of packageListData, calculated if empty
          * @return request_id.
          */
         std::unique_ptr<HttpSinkRequest> CreatePostLogStoreLogPackageListRequest(const std::string& project,
                                                                                  const std::string& logstore,
                                                                                  sls_logs::SlsCompressType compressType,
                                                                                  const std::string& packageListData,
+                                                                                 const std::string& contentMd5,
                                                                                  SenderQueueItem* item,
                                                                                  const std::string& hashKey = "");
 
@@ -168,6 +182,7 @@ namespace sdk {
         CreateAsynPostLogStoreLogsRequest(const std::string& project,
                                           const std::string& logstore,
                                           const std::string& body,
+                                          const std::string& contentMd5,
                                           std::map<std::string, std::string>& httpHeader,
                                           const std::string& hashKey,
                                           int64_t hashKeySeqID,
@@ -177,6 +192,7 @@ namespace sdk {
         CreateAsynPostMetricStoreLogsRequest(const std::string& project,
                                              const std::string& logstore,
                                              const std::string& body,
+                                             const std::string& contentMd5,
                                              std::map<std::string, std::string>& httpHeader,
                                              SenderQueueItem* item);
 
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "Common.h"
+
+#include <openssl/md5.h>
+
 #include "app_config/AppConfig.h"
 #include "common/TimeUtil.h"
 #include "common/StringTools.h"
@@ -186,8 +189,9 @@ namespace sdk {
     }
 
     std::string CalcMD5(const std::string& message) {
+        // the assembly implementation of openssl is faster than DoMd5, which matters for large request bodies
         uint8_t md5[MD5_BYTES];
-        DoMd5((const uint8_t*)message.data(), message.length(), md5);
+        MD5((const uint8_t*)message.data(), message.length(), md5);
         return HexToString(md5);
     }
 
@@ -361,7 +365,9 @@ namespace sdk {
         string signature;
         string osstream;
         if (!content.empty()) {
-            contentMd5 = CalcMD5(content);
+            // reuse the digest in the header to avoid hashing the body twice
+            auto md5Iter = httpHeader.find(CONTENT_MD5);
+            contentMd5 = md5Iter != httpHeader.end() ? md5Iter->second : CalcMD5(content);
         }
         string contentType;
         map<string, string>::iterator iter = httpHeader.find(CONTENT_TYPE);
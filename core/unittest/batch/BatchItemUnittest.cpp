@@ -118,6 +118,7 @@ void EventBatchItemUnittest::TestFlushGroupBatchItem() {
     PipelineEventPtr& e = sEventGroup->MutableEvents().back();
     mItem.Add(std::move(e));
     auto size = mItem.DataSize();
+    APSARA_TEST_TRUE(mItem.GetCreateSteadyTime() != chrono::steady_clock::time_point());
 
     GroupBatchItem res;
     mItem.Flush(res);
@@ -133,6 +134,7 @@ void EventBatchItemUnittest::TestFlushGroupBatchItem() {
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCnt());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
     APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_TRUE(mItem.GetCreateSteadyTime() == chrono::steady_clock::time_point());
     // APSARA_TEST_EQUAL(0, mItem.mTotalEnqueTimeMs);
 }
 
@@ -161,6 +163,7 @@ void EventBatchItemUnittest::TestFlushBatchedEvensList() {
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCnt());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
     APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_TRUE(mItem.GetCreateSteadyTime() == chrono::steady_clock::time_point());
     // APSARA_TEST_EQUAL(0, mItem.mTotalEnqueTimeMs);
 }
 
@@ -190,6 +193,7 @@ void EventBatchItemUnittest::TestFlushBatchedEvensLists() {
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCnt());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
     APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_TRUE(mItem.GetCreateSteadyTime() == chrono::steady_clock::time_point());
     // APSARA_TEST_EQUAL(0, mItem.mTotalEnqueTimeMs);
 }
 
@@ -281,6 +285,7 @@ void GroupBatchItemUnittest::TestFlushBatchedEvensList() {
     APSARA_TEST_TRUE(mItem.IsEmpty());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
     APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_TRUE(mItem.GetCreateSteadyTime() == chrono::steady_clock::time_point());
     APSARA_TEST_EQUAL(0, mItem.TotalEnqueTimeMs());
     APSARA_TEST_EQUAL(0U, mItem.EventSize());
     APSARA_TEST_EQUAL(0U, mItem.GroupSize());
@@ -298,6 +303,7 @@ void GroupBatchItemUnittest::TestFlushBatchedEvensLists() {
     APSARA_TEST_TRUE(mItem.IsEmpty());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
     APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_TRUE(mItem.GetCreateSteadyTime() == chrono::steady_clock::time_point());
     APSARA_TEST_EQUAL(0, mItem.TotalEnqueTimeMs());
     APSARA_TEST_EQUAL(0U, mItem.EventSize());
     APSARA_TEST_EQUAL(0U, mItem.GroupSize());
@@ -0,0 +1,133 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <json/json.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/StringTools.h"
+#include "pipeline/Pipeline.h"
+#include "pipeline/PipelineContext.h"
+#include "pipeline/batch/TimeoutFlushManager.h"
+#include "pipeline/queue/QueueKeyManager.h"
+#include "pipeline/queue/SenderQueueManager.h"
+#include "plugin/flusher/sls/FlusherSLS.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// groups are added from N threads into the batcher of one FlusherSLS, with and without sharding.
+class BatcherBenchmark : public ::testing::Test {
+public:
+    void TestContention();
+
+protected:
+    void SetUp() override {
+        mCtx.SetConfigName("test_config");
+        mCtx.SetPipeline(mPipeline);
+    }
+
+    void TearDown() override {
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear();
+        QueueKeyManager::GetInstance()->Clear();
+        SenderQueueManager::GetInstance()->Clear();
+    }
+
+private:
+    void Run(size_t threadCnt, size_t shardCnt);
+
+    const size_t mGroupCntPerThread = 20000;
+    const size_t mEventCntPerGroup = 10;
+    const size_t mKeyCntPerThread = 8;
+
+    Pipeline mPipeline;
+    PipelineContext mCtx;
+};
+
+void BatcherBenchmark::Run(size_t threadCnt, size_t shardCnt) {
+    Json::Value configJson, optionalGoPipeline;
+    configJson["Type"] = "flusher_sls";
+    configJson["Project"] = "test_project";
+    configJson["Logstore"] = "test_logstore";
+    configJson["Region"] = "test_region";
+    configJson["Endpoint"] = "test_region.log.aliyuncs.com";
+    INT32_FLAG(batcher_shard_count) = shardCnt;
+    FlusherSLS flusher;
+    flusher.SetContext(mCtx);
+    flusher.SetMetricsRecordRef(FlusherSLS::sName, "1");
+    if (!flusher.Init(configJson, optionalGoPipeline)) {
+        cout << "init flusher failed" << endl;
+        return;
+    }
+    INT32_FLAG(batcher_shard_count) = 1;
+
+    // groups are prepared in advance so that only Add is measured
+    vector<vector<PipelineEventGroup>> groups(threadCnt);
+    for (size_t i = 0; i < threadCnt; ++i) {
+        groups[i].reserve(mGroupCntPerThread);
+        for (size_t j = 0; j < mGroupCntPerThread; ++j) {
+            PipelineEventGroup g(make_shared<SourceBuffer>());
+            g.SetTag(string("__path__"), "/var/log/" + ToString(i) + "_" + ToString(j % mKeyCntPerThread) + ".log");
+            for (size_t k = 0; k < mEventCntPerGroup; ++k) {
+                auto e = g.AddLogEvent();
+                e->SetTimestamp(1234567890);
+                e->SetContent(string("content"), string(100, 'a'));
+            }
+            groups[i].emplace_back(std::move(g));
+        }
+    }
+
+    vector<thread> threads;
+    auto start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back([&, i]() {
+            vector<BatchedEventsList> res;
+            for (auto& g : groups[i]) {
+                flusher.mBatcher.Add(std::move(g), res);
+                res.clear();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    vector<BatchedEventsList> res;
+    flusher.mBatcher.FlushAll(res);
+
+    size_t groupCnt = threadCnt * mGroupCntPerThread;
+    cout << "threads: " << threadCnt << "\tshards: " << shardCnt << "\tgroups/s: " << groupCnt / elapsed.count()
+         << "\tevents/s: " << groupCnt * mEventCntPerGroup / elapsed.count()
+         << "\telapsed: " << elapsed.count() * 1000 << " ms" << endl;
+}
+
+void BatcherBenchmark::TestContention() {
+    for (size_t threadCnt : {1, 2, 4, 8}) {
+        Run(threadCnt, 1);
+        Run(threadCnt, threadCnt);
+    }
+}
+
+UNIT_TEST_CASE(BatcherBenchmark, TestContention)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "common/JsonUtil.h"
 #include "pipeline/batch/Batcher.h"
 #include "unittest/Unittest.h"
@@ -34,7 +36,9 @@ public:
     void TestFlushGroupQueue();
     void TestFlushAllWithoutGroupBatch();
     void TestFlushAllWithGroupBatch();
+    void TestShardedAdd();
     void TestMetric();
+    void TestLatencyTimestamps();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
@@ -157,8 +161,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(2U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(2U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -174,8 +178,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer2 = group2.GetSourceBuffer().get();
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -197,8 +201,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer3 = group3.GetSourceBuffer().get();
     RangeCheckpoint* eoo3 = group3.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group3), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -238,8 +242,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(2U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(2U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -255,8 +259,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer2 = group2.GetSourceBuffer().get();
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -278,8 +282,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     RangeCheckpoint* eoo3 = group3.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group3), res);
     APSARA_TEST_EQUAL(0U, res.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
 
     // flush by time to group batch, and then group flush by time
     batch.mGroupFlushStrategy->SetTimeoutSecs(0);
@@ -287,8 +291,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer4 = group4.GetSourceBuffer().get();
     RangeCheckpoint* eoo4 = group4.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group4), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -309,8 +313,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer5 = group5.GetSourceBuffer().get();
     RangeCheckpoint* eoo5 = group5.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group5), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -342,8 +346,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     PipelineEventGroup group7 = CreateEventGroup(2);
     SourceBuffer* buffer7 = group7.GetSourceBuffer().get();
     batch.Add(std::move(group7), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -376,8 +380,8 @@ void BatcherUnittest::TestAddWithOversizedGroup() {
 
     PipelineEventGroup group2 = CreateEventGroup(20);
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0]->mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(3U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -410,7 +414,7 @@ void BatcherUnittest::TestFlushEventQueueWithoutGroupBatch() {
 
     // key existed
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0]->mEventQueueMap.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0].mTags.mInner.size());
@@ -439,7 +443,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), tmp);
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0]->mEventQueueMap.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -459,7 +463,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), tmp);
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0]->mEventQueueMap.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0].mTags.mInner.size());
@@ -533,7 +537,7 @@ void BatcherUnittest::TestFlushAllWithoutGroupBatch() {
 
     vector<BatchedEventsList> res;
     batch.FlushAll(res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0]->mEventQueueMap.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -578,7 +582,7 @@ void BatcherUnittest::TestFlushAllWithGroupBatch() {
     batch.mGroupFlushStrategy->SetMinSizeBytes(10);
     vector<BatchedEventsList> res;
     batch.FlushAll(res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0]->mEventQueueMap.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -598,6 +602,75 @@ void BatcherUnittest::TestFlushAllWithGroupBatch() {
     APSARA_TEST_STREQ("pack_id", res[1][0].mPackIdPrefix.data());
 }
 
+void BatcherUnittest::TestShardedAdd() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 3;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 3;
+
+    INT32_FLAG(batcher_shard_count) = 2;
+    {
+        // no sharding without group batch
+        Batcher<> batch;
+        batch.Init(Json::Value(), sFlusher.get(), strategy);
+        APSARA_TEST_EQUAL(1U, batch.mShards.size());
+    }
+    Batcher<> batch;
+    batch.Init(Json::Value(), sFlusher.get(), strategy, true);
+    INT32_FLAG(batcher_shard_count) = 1;
+    APSARA_TEST_EQUAL(2U, batch.mShards.size());
+
+    // each thread adds to its own shard
+    PipelineEventGroup group1 = CreateEventGroup(2);
+    PipelineEventGroup group2 = CreateEventGroup(2);
+    size_t key = group1.GetTagsHash();
+    vector<BatchedEventsList> tmp1, tmp2;
+    thread([&]() { batch.Add(std::move(group1), tmp1); }).join();
+    thread([&]() { batch.Add(std::move(group2), tmp2); }).join();
+    APSARA_TEST_TRUE(tmp1.empty());
+    APSARA_TEST_TRUE(tmp2.empty());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[1]->mEventQueueMap.size());
+    APSARA_TEST_EQUAL(2U, batch.mEventBatchItemsTotal->GetValue());
+    // each shard has its own timeout record
+    auto& records = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"];
+    APSARA_TEST_EQUAL(2U, records.size());
+    APSARA_TEST_EQUAL(1U, records.count(make_pair(0, key)));
+    size_t otherKey = Batcher<>::GetTimeoutKey(key, 1);
+    APSARA_TEST_NOT_EQUAL(key, otherKey);
+    APSARA_TEST_EQUAL(1U, records.count(make_pair(0, otherKey)));
+
+    APSARA_TEST_EQUAL(key, batch.mShards[0]->mTimeoutKeys[key]);
+    APSARA_TEST_EQUAL(key, batch.mShards[1]->mTimeoutKeys[otherKey]);
+
+    // a queue in another shard whose mixed key collides with the timeout key is not flushed unless registered with it
+    batch.mShards[1]->mEventQueueMap.try_emplace(otherKey);
+    // timeout flush of one shard leaves the other one untouched
+    BatchedEventsList tmp;
+    batch.FlushQueue(key, tmp);
+    APSARA_TEST_TRUE(tmp.empty());
+    APSARA_TEST_TRUE(batch.mShards[0]->mEventQueueMap.empty());
+    APSARA_TEST_TRUE(batch.mShards[0]->mTimeoutKeys.empty());
+    APSARA_TEST_EQUAL(2U, batch.mShards[1]->mEventQueueMap.size());
+    batch.mShards[1]->mEventQueueMap.erase(otherKey);
+    APSARA_TEST_EQUAL(1U, batch.mEventBatchItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(1U, batch.mGroupQueue->GroupSize());
+
+    batch.FlushQueue(otherKey, tmp);
+    APSARA_TEST_TRUE(tmp.empty());
+    APSARA_TEST_TRUE(batch.mShards[1]->mEventQueueMap.empty());
+    APSARA_TEST_TRUE(batch.mShards[1]->mTimeoutKeys.empty());
+    APSARA_TEST_EQUAL(0U, batch.mEventBatchItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(2U, batch.mGroupQueue->GroupSize());
+
+    vector<BatchedEventsList> res;
+    batch.FlushAll(res);
+    APSARA_TEST_EQUAL(1U, res.size());
+    APSARA_TEST_EQUAL(2U, res[0].size());
+    APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
+    APSARA_TEST_EQUAL(2U, res[0][1].mEvents.size());
+}
+
 void BatcherUnittest::TestMetric() {
     {
         DefaultFlushStrategyOptions strategy;
@@ -656,6 +729,42 @@ void BatcherUnittest::TestMetric() {
     }
 }
 
+void BatcherUnittest::TestLatencyTimestamps() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 2;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 3;
+
+    Batcher<> batch;
+    batch.Init(Json::Value(), sFlusher.get(), strategy);
+
+    auto readTime = chrono::time_point_cast<chrono::microseconds>(chrono::system_clock::now() - chrono::seconds(2));
+    auto processTime = chrono::time_point_cast<chrono::microseconds>(chrono::system_clock::now() - chrono::seconds(1));
+    PipelineEventGroup g = CreateEventGroup(3);
+    size_t key = g.GetTagsHash();
+    g.SetMetadataTime(EventGroupMetaKey::READ_TIMESTAMP_MICROSEC, readTime);
+    g.SetMetadataTime(EventGroupMetaKey::PROCESS_TIMESTAMP_MICROSEC, processTime);
+    vector<BatchedEventsList> res;
+    batch.Add(std::move(g), res);
+    APSARA_TEST_EQUAL(1U, res.size());
+    APSARA_TEST_EQUAL(1U, res[0].size());
+    APSARA_TEST_EQUAL(readTime, res[0][0].mReadTime);
+    APSARA_TEST_EQUAL(processTime, res[0][0].mProcessTime);
+
+    uint64_t cnt = 0;
+    for (size_t i = 0; i < Histogram::kBucketCnt; ++i) {
+        cnt += batch.mProcessToFlushLatencyMs->GetBucketCnt(i);
+    }
+    APSARA_TEST_EQUAL(1U, cnt);
+
+    // events left in the batch item keep the timestamps
+    BatchedEventsList list;
+    batch.FlushQueue(key, list);
+    APSARA_TEST_EQUAL(1U, list.size());
+    APSARA_TEST_EQUAL(readTime, list[0].mReadTime);
+    APSARA_TEST_EQUAL(processTime, list[0].mProcessTime);
+}
+
 PipelineEventGroup BatcherUnittest::CreateEventGroup(size_t cnt) {
     PipelineEventGroup group(make_shared<SourceBuffer>());
     group.SetTag(string("key"), string("val"));
@@ -679,7 +788,9 @@ UNIT_TEST_CASE(BatcherUnittest, TestFlushEventQueueWithGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushGroupQueue)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithGroupBatch)
+UNIT_TEST_CASE(BatcherUnittest, TestShardedAdd)
 UNIT_TEST_CASE(BatcherUnittest, TestMetric)
+UNIT_TEST_CASE(BatcherUnittest, TestLatencyTimestamps)
 
 } // namespace logtail
 
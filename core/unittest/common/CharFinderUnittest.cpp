@@ -0,0 +1,100 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/CharFinder.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CharFinderUnittest : public ::testing::Test {
+public:
+    void TestFindFirstChar();
+    void TestFindLastChar();
+    void TestFindAllChars();
+    void TestImplsConsistent();
+};
+
+void CharFinderUnittest::TestFindFirstChar() {
+    string s = "abc\ndef\n";
+    APSARA_TEST_EQUAL(3U, FindFirstChar(s.data(), s.size(), '\n'));
+    APSARA_TEST_EQUAL(3U, FindFirstChar(s.data() + 4, s.size() - 4, '\n'));
+    APSARA_TEST_EQUAL(s.size(), FindFirstChar(s.data(), s.size(), '|'));
+    APSARA_TEST_EQUAL(0U, FindFirstChar(nullptr, 0, '\n'));
+}
+
+void CharFinderUnittest::TestFindLastChar() {
+    string s = "abc\ndef\nghi";
+    APSARA_TEST_EQUAL(7U, FindLastChar(s.data(), s.size(), '\n'));
+    APSARA_TEST_EQUAL(3U, FindLastChar(s.data(), 7, '\n'));
+    APSARA_TEST_EQUAL(3U, FindLastChar(s.data(), 3, '\n'));
+    APSARA_TEST_EQUAL(0U, FindLastChar(s.data(), 0, '\n'));
+    string longLine(100, 'a');
+    longLine[1] = '\n';
+    APSARA_TEST_EQUAL(1U, FindLastChar(longLine.data(), longLine.size(), '\n'));
+}
+
+void CharFinderUnittest::TestFindAllChars() {
+    string s(100, 'a');
+    vector<size_t> expected = {0, 15, 16, 31, 32, 63, 64, 99};
+    for (auto pos : expected) {
+        s[pos] = '|';
+    }
+    vector<size_t> res;
+    FindAllChars(s.data(), s.size(), '|', res);
+    APSARA_TEST_EQUAL(expected, res);
+
+    // positions are appended
+    FindAllChars(s.data(), 1, '|', res);
+    APSARA_TEST_EQUAL(expected.size() + 1, res.size());
+    APSARA_TEST_EQUAL(0U, res.back());
+}
+
+void CharFinderUnittest::TestImplsConsistent() {
+    mt19937 rng(0);
+    for (size_t round = 0; round < 1000; ++round) {
+        string s(rng() % 256, 'a');
+        for (auto& c : s) {
+            if (rng() % 8 == 0) {
+                c = '\n';
+            }
+        }
+        vector<size_t> expectedAll;
+        char_finder::FindAllChars(char_finder::Impl::SCALAR, s.data(), s.size(), '\n', expectedAll);
+        size_t expectedLast = char_finder::FindLastChar(char_finder::Impl::SCALAR, s.data(), s.size(), '\n');
+        for (auto impl : {char_finder::Impl::SSE2, char_finder::Impl::AVX2}) {
+            if (!char_finder::IsImplSupported(impl)) {
+                continue;
+            }
+            vector<size_t> all;
+            char_finder::FindAllChars(impl, s.data(), s.size(), '\n', all);
+            APSARA_TEST_EQUAL_FATAL(expectedAll, all);
+            APSARA_TEST_EQUAL_FATAL(expectedLast, char_finder::FindLastChar(impl, s.data(), s.size(), '\n'));
+        }
+    }
+}
+
+UNIT_TEST_CASE(CharFinderUnittest, TestFindFirstChar)
+UNIT_TEST_CASE(CharFinderUnittest, TestFindLastChar)
+UNIT_TEST_CASE(CharFinderUnittest, TestFindAllChars)
+UNIT_TEST_CASE(CharFinderUnittest, TestImplsConsistent)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,135 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/FileSystemUtil.h"
+#include "common/IoUringReader.h"
+#include "common/LogFileOperator.h"
+#include "common/StringTools.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// many files are appended with small chunks in each round, and new data of all files is read either by one pread per
+// file or by one io_uring batch.
+class IoUringReaderBenchmark : public ::testing::Test {
+public:
+    void TestSmallAppends();
+
+protected:
+    void SetUp() override {
+        mRootDir = GetProcessExecutionDir();
+        if (PATH_SEPARATOR[0] == mRootDir.back())
+            mRootDir.resize(mRootDir.size() - 1);
+        mRootDir += PATH_SEPARATOR + "IoUringReaderBenchmark";
+        bfs::remove_all(mRootDir);
+        bfs::create_directories(mRootDir);
+    }
+
+    void TearDown() override { bfs::remove_all(mRootDir); }
+
+private:
+    void Run(bool useIoUring);
+
+    const size_t mFileCnt = 32;
+    const size_t mRoundCnt = 2000;
+    const size_t mAppendSize = 256;
+    const size_t mReadSize = 64 * 1024;
+    string mRootDir;
+};
+
+void IoUringReaderBenchmark::Run(bool useIoUring) {
+    IoUringReader ioUring;
+    if (useIoUring && !ioUring.Init(mFileCnt, mReadSize)) {
+        cout << "io_uring is not available" << endl;
+        return;
+    }
+
+    vector<unique_ptr<ofstream>> writers;
+    vector<unique_ptr<LogFileOperator>> files;
+    vector<int64_t> offsets(mFileCnt, 0);
+    for (size_t i = 0; i < mFileCnt; ++i) {
+        string path = mRootDir + PATH_SEPARATOR + (useIoUring ? "uring_" : "pread_") + ToString(i) + ".log";
+        writers.emplace_back(make_unique<ofstream>(path.c_str(), fstream::out | fstream::trunc));
+        files.emplace_back(make_unique<LogFileOperator>());
+        files.back()->Open(path.c_str());
+    }
+    string chunk(mAppendSize - 1, 'a');
+    chunk += '\n';
+    unique_ptr<char[]> buf(new char[mReadSize]);
+    vector<IoUringReader::Request> requests(mFileCnt);
+
+    uint64_t readBytes = 0, syscallCnt = 0;
+    chrono::duration<double> elapsed(0);
+    for (size_t round = 0; round < mRoundCnt; ++round) {
+        for (auto& writer : writers) {
+            *writer << chunk;
+            writer->flush();
+        }
+        auto start = chrono::high_resolution_clock::now();
+        if (useIoUring) {
+            for (size_t i = 0; i < mFileCnt; ++i) {
+                requests[i].mFd = files[i]->GetFd();
+                requests[i].mOffset = offsets[i];
+                requests[i].mSize = mReadSize;
+            }
+            uint64_t before = ioUring.GetSyscallCount();
+            if (!ioUring.Read(requests)) {
+                cout << "io_uring read failed" << endl;
+                return;
+            }
+            syscallCnt += ioUring.GetSyscallCount() - before;
+            for (size_t i = 0; i < mFileCnt; ++i) {
+                if (requests[i].mResult > 0) {
+                    offsets[i] += requests[i].mResult;
+                    readBytes += requests[i].mResult;
+                }
+            }
+        } else {
+            for (size_t i = 0; i < mFileCnt; ++i) {
+                int nbytes = files[i]->Pread(buf.get(), 1, mReadSize, offsets[i]);
+                ++syscallCnt;
+                if (nbytes > 0) {
+                    offsets[i] += nbytes;
+                    readBytes += nbytes;
+                }
+            }
+        }
+        elapsed += chrono::high_resolution_clock::now() - start;
+    }
+
+    cout << (useIoUring ? "io_uring" : "pread") << "\tfiles: " << mFileCnt << "\trounds: " << mRoundCnt
+         << "\tsyscalls: " << syscallCnt << "\tsyscalls/s: " << syscallCnt / elapsed.count()
+         << "\tthroughput: " << readBytes / 1024.0 / 1024.0 / elapsed.count() << " MB/s"
+         << "\telapsed: " << elapsed.count() * 1000 << " ms" << endl;
+}
+
+void IoUringReaderBenchmark::TestSmallAppends() {
+    Run(false);
+    Run(true);
+}
+
+UNIT_TEST_CASE(IoUringReaderBenchmark, TestSmallAppends)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,123 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/FileSystemUtil.h"
+#include "common/IoUringReader.h"
+#include "common/LogFileOperator.h"
+#include "common/StringTools.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class IoUringReaderUnittest : public ::testing::Test {
+public:
+    void TestRead();
+    void TestReadBeyondEnd();
+    void TestReadTruncatedToBufferSize();
+
+protected:
+    void SetUp() override {
+        mRootDir = GetProcessExecutionDir();
+        if (PATH_SEPARATOR[0] == mRootDir.back())
+            mRootDir.resize(mRootDir.size() - 1);
+        mRootDir += PATH_SEPARATOR + "IoUringReaderUnittest";
+        bfs::remove_all(mRootDir);
+        bfs::create_directories(mRootDir);
+        for (size_t i = 0; i < 3; ++i) {
+            string path = mRootDir + PATH_SEPARATOR + ToString(i) + ".log";
+            {
+                ofstream writer(path.c_str(), fstream::out | fstream::trunc);
+                writer << "line " << i << " of file\n";
+            }
+            mFiles.emplace_back(make_unique<LogFileOperator>());
+            mFiles.back()->Open(path.c_str());
+        }
+    }
+
+    void TearDown() override {
+        mFiles.clear();
+        bfs::remove_all(mRootDir);
+    }
+
+private:
+    string mRootDir;
+    vector<unique_ptr<LogFileOperator>> mFiles;
+};
+
+void IoUringReaderUnittest::TestRead() {
+    IoUringReader reader;
+    if (!reader.Init(4, 4096)) {
+        // io_uring is not available in this environment
+        return;
+    }
+    vector<IoUringReader::Request> requests(mFiles.size());
+    for (size_t i = 0; i < mFiles.size(); ++i) {
+        requests[i].mFd = mFiles[i]->GetFd();
+        requests[i].mOffset = 5;
+        requests[i].mSize = 1024;
+    }
+    APSARA_TEST_TRUE(reader.Read(requests));
+    for (size_t i = 0; i < mFiles.size(); ++i) {
+        string expected = ToString(i) + " of file\n";
+        APSARA_TEST_EQUAL(static_cast<int32_t>(expected.size()), requests[i].mResult);
+        APSARA_TEST_EQUAL(expected, string(requests[i].mData, requests[i].mResult));
+    }
+    // all reads are submitted and reaped in one syscall
+    APSARA_TEST_EQUAL(1U, reader.GetSyscallCount());
+}
+
+void IoUringReaderUnittest::TestReadBeyondEnd() {
+    IoUringReader reader;
+    if (!reader.Init(4, 4096)) {
+        return;
+    }
+    vector<IoUringReader::Request> requests(2);
+    requests[0].mFd = mFiles[0]->GetFd();
+    requests[0].mOffset = 1024;
+    requests[0].mSize = 1024;
+    requests[1].mFd = -1;
+    requests[1].mOffset = 0;
+    requests[1].mSize = 1024;
+    APSARA_TEST_TRUE(reader.Read(requests));
+    APSARA_TEST_EQUAL(0, requests[0].mResult);
+    APSARA_TEST_TRUE(requests[1].mResult < 0);
+}
+
+void IoUringReaderUnittest::TestReadTruncatedToBufferSize() {
+    IoUringReader reader;
+    if (!reader.Init(4, 4)) {
+        return;
+    }
+    vector<IoUringReader::Request> requests(1);
+    requests[0].mFd = mFiles[1]->GetFd();
+    requests[0].mOffset = 0;
+    requests[0].mSize = 1024;
+    APSARA_TEST_TRUE(reader.Read(requests));
+    APSARA_TEST_EQUAL(4, requests[0].mResult);
+    APSARA_TEST_EQUAL("line", string(requests[0].mData, requests[0].mResult));
+}
+
+UNIT_TEST_CASE(IoUringReaderUnittest, TestRead)
+UNIT_TEST_CASE(IoUringReaderUnittest, TestReadBeyondEnd)
+UNIT_TEST_CASE(IoUringReaderUnittest, TestReadTruncatedToBufferSize)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
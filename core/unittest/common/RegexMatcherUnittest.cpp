@@ -0,0 +1,154 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/RegexMatcher.h"
+#include "common/StringTools.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class RegexMatcherUnittest : public ::testing::Test {
+public:
+    void TestEngine();
+    void TestLiteralPrefix();
+    void TestInvalidPattern();
+    void TestConsistentWithBoost();
+
+private:
+    static const vector<string> sPatterns;
+    static vector<string> GetTexts();
+};
+
+const vector<string> RegexMatcherUnittest::sPatterns = {
+    R"(\[\d+-\d+-\d+ \d+:\d+:\d+\.\d+\]\s\[\w+\]\s.*)",
+    R"(\d+-\d+-\d+ \d+:\d+:\d+,\d+ (INFO|WARN|ERROR) .*)",
+    R"(\s+at\s.*)",
+    R"(\s*Caused by:.*)",
+    R"(\s*\.\.\. \d+ more)",
+    R"(^\[\d{4}-\d{2}-\d{2}.*)",
+    R"(\S+ \S+)",
+    R"([^\s]+)",
+    R"([\s\]x]+y)",
+    R"([[:alpha:]]+\d)",
+    R"(\bword\b.*)",
+    R"((?:ab)+c)",
+    R"(a|b.*)",
+    R"(abc)",
+    R"(a\.b)",
+    R"(ab+c)",
+    R"((a)\1)",
+    R"((?=a)a.*)",
+    R"(\<ab)",
+    R"(^$)",
+    R"(a$)",
+    R"([a-z]*+b)",
+};
+
+vector<string> RegexMatcherUnittest::GetTexts() {
+    vector<string> texts = {"",
+                            "[2024-01-01 12:00:00.123] [INFO] hello",
+                            "2024-01-01 12:00:00,123 ERROR boom",
+                            "java.lang.NullPointerException: null",
+                            "\tat com.example.Book.getTitle(Book.java:16)",
+                            "    at com.example.Author.getBookTitles(Author.java:25)",
+                            "Caused by: java.lang.IllegalStateException: x",
+                            "\t... 5 more",
+                            "\v\v\vy",
+                            "word here",
+                            "wordy",
+                            "ababc",
+                            "abc",
+                            "abcd",
+                            "a.b",
+                            "axb",
+                            "abbbc",
+                            "aa",
+                            "a\nb",
+                            "b\nc",
+                            "foo bar"};
+    mt19937 rng(0);
+    const string alphabet = "ab.\t \n\v[]1:-_xyC";
+    for (size_t i = 0; i < 1000; ++i) {
+        string s(rng() % 10, 'a');
+        for (auto& c : s) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        texts.emplace_back(std::move(s));
+    }
+    return texts;
+}
+
+void RegexMatcherUnittest::TestEngine() {
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::LITERAL, RegexMatcher("abc").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::LITERAL, RegexMatcher(R"(^a\.b)").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::RE2, RegexMatcher(R"(\s+at\s.*)").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::RE2, RegexMatcher(R"(\d{4}-\d{2}(?:ab)+[[:alpha:]])").GetEngine());
+    // backreferences, lookarounds, anchors other than the leading ^, boost specific escapes and possessive quantifiers
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::BOOST, RegexMatcher(R"((a)\1)").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::BOOST, RegexMatcher(R"((?=a)a.*)").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::BOOST, RegexMatcher(R"(a$)").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::BOOST, RegexMatcher(R"(\<ab)").GetEngine());
+    APSARA_TEST_EQUAL(RegexMatcher::Engine::BOOST, RegexMatcher(R"([a-z]*+b)").GetEngine());
+}
+
+void RegexMatcherUnittest::TestLiteralPrefix() {
+    APSARA_TEST_EQUAL("abc", RegexMatcher("abc").mLiteralPrefix);
+    APSARA_TEST_EQUAL("[", RegexMatcher(R"(^\[\d+.*)").mLiteralPrefix);
+    // the last character is not included if followed by a quantifier
+    APSARA_TEST_EQUAL("a", RegexMatcher("ab+c").mLiteralPrefix);
+    APSARA_TEST_EQUAL("", RegexMatcher("a?b").mLiteralPrefix);
+    // no prefix is required with top level alternations
+    APSARA_TEST_EQUAL("", RegexMatcher("ab|cd").mLiteralPrefix);
+    APSARA_TEST_EQUAL("x", RegexMatcher("x(ab|cd)").mLiteralPrefix);
+}
+
+void RegexMatcherUnittest::TestInvalidPattern() {
+    bool thrown = false;
+    try {
+        RegexMatcher matcher("(a");
+    } catch (const boost::regex_error&) {
+        thrown = true;
+    }
+    APSARA_TEST_TRUE(thrown);
+}
+
+void RegexMatcherUnittest::TestConsistentWithBoost() {
+    vector<string> texts = GetTexts();
+    for (const auto& pattern : sPatterns) {
+        RegexMatcher matcher(pattern);
+        boost::regex reg(pattern);
+        for (const auto& text : texts) {
+            string exception;
+            APSARA_TEST_EQUAL_FATAL(BoostRegexSearch(text.data(), text.size(), reg, exception),
+                                    matcher.Search(text, exception));
+            APSARA_TEST_EQUAL_FATAL(BoostRegexMatch(text.data(), text.size(), reg, exception),
+                                    matcher.Match(text, exception));
+        }
+    }
+}
+
+UNIT_TEST_CASE(RegexMatcherUnittest, TestEngine)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestLiteralPrefix)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestInvalidPattern)
+UNIT_TEST_CASE(RegexMatcherUnittest, TestConsistentWithBoost)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
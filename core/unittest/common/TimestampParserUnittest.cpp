@@ -0,0 +1,293 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "common/TimestampParser.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class TimestampParserUnittest : public ::testing::Test {
+public:
+    void TestKind();
+    void TestParseUnixSeconds();
+    void TestParseCompiled();
+    void TestParseNanosecond();
+    void TestConsistentWithStrptime();
+    void TestCache();
+    void TestCacheWithNanosecond();
+    void TestCacheCapacity();
+
+private:
+    static string GenerateTimeString(const string& format, mt19937& rng);
+};
+
+UNIT_TEST_CASE(TimestampParserUnittest, TestKind)
+UNIT_TEST_CASE(TimestampParserUnittest, TestParseUnixSeconds)
+UNIT_TEST_CASE(TimestampParserUnittest, TestParseCompiled)
+UNIT_TEST_CASE(TimestampParserUnittest, TestParseNanosecond)
+UNIT_TEST_CASE(TimestampParserUnittest, TestConsistentWithStrptime)
+UNIT_TEST_CASE(TimestampParserUnittest, TestCache)
+UNIT_TEST_CASE(TimestampParserUnittest, TestCacheWithNanosecond)
+UNIT_TEST_CASE(TimestampParserUnittest, TestCacheCapacity)
+
+void TimestampParserUnittest::TestKind() {
+    APSARA_TEST_TRUE(TimestampParser("%s").GetKind() == TimestampParser::Kind::UNIX_SECONDS);
+    APSARA_TEST_TRUE(TimestampParser("%Y-%m-%d %H:%M:%S").GetKind() == TimestampParser::Kind::COMPILED);
+    APSARA_TEST_TRUE(TimestampParser("%Y-%m-%dT%H:%M:%S.%f").GetKind() == TimestampParser::Kind::COMPILED);
+    APSARA_TEST_TRUE(TimestampParser("[%Y-%m-%d %H:%M:%S.%f").GetKind() == TimestampParser::Kind::COMPILED);
+    APSARA_TEST_TRUE(TimestampParser("%H:%M:%S.%f %Y-%m-%d").GetKind() == TimestampParser::Kind::COMPILED);
+    APSARA_TEST_TRUE(TimestampParser("%F %T").GetKind() == TimestampParser::Kind::COMPILED);
+    // %F and %T after %f reset the nanoseconds in Strptime
+    APSARA_TEST_TRUE(TimestampParser("%f %T").GetKind() == TimestampParser::Kind::STRPTIME);
+    APSARA_TEST_TRUE(TimestampParser("%d %b %y %H:%M").GetKind() == TimestampParser::Kind::STRPTIME);
+    APSARA_TEST_TRUE(TimestampParser("%Y-%m-%d %H:%M:%S %z").GetKind() == TimestampParser::Kind::STRPTIME);
+    // the year is deduced by Strptime if not specified
+    APSARA_TEST_TRUE(TimestampParser("%m-%d %H:%M:%S").GetKind() == TimestampParser::Kind::STRPTIME);
+    APSARA_TEST_TRUE(TimestampParser("%m-%d %H:%M:%S", 2019).GetKind() == TimestampParser::Kind::COMPILED);
+    APSARA_TEST_TRUE(TimestampParser("%Y-%m-%d %").GetKind() == TimestampParser::Kind::STRPTIME);
+}
+
+void TimestampParserUnittest::TestParseUnixSeconds() {
+    TimestampParser parser("%s");
+    struct Case {
+        string input;
+        time_t second;
+        long nanosecond;
+        int nanosecondLength;
+    };
+    vector<Case> cases = {{"1378972170", 1378972170, 0, 0},
+                          {"1378972170425093", 1378972170, 425093000, 6},
+                          {"1378972170123456789", 1378972170, 123456789, 9},
+                          {"1378972170]", 1378972170, 0, 0},
+                          {"17", 17, 0, 0}};
+    for (const auto& c : cases) {
+        LogtailTime ts = {0, 0};
+        int nanosecondLength = -1;
+        const char* end = parser.Parse(c.input.c_str(), ts, nanosecondLength);
+        APSARA_TEST_TRUE_FATAL(end != nullptr);
+        APSARA_TEST_EQUAL(c.second, ts.tv_sec);
+        APSARA_TEST_EQUAL(c.nanosecond, ts.tv_nsec);
+        APSARA_TEST_EQUAL(c.nanosecondLength, nanosecondLength);
+    }
+    LogtailTime ts = {0, 0};
+    int nanosecondLength = -1;
+    APSARA_TEST_TRUE(parser.Parse("abc", ts, nanosecondLength) == nullptr);
+}
+
+void TimestampParserUnittest::TestParseCompiled() {
+    TimestampParser parser("[%Y-%m-%d %H:%M:%S.%f");
+    string input = "[2013-09-12 22:18:28.819129] [INFO]";
+    LogtailTime expected = {0, 0};
+    int expectedNanosecondLength = -1;
+    Strptime("[2013-09-12 22:18:28", "[%Y-%m-%d %H:%M:%S", &expected, expectedNanosecondLength);
+    LogtailTime ts = {0, 0};
+    int nanosecondLength = -1;
+    const char* end = parser.Parse(input.c_str(), ts, nanosecondLength);
+    APSARA_TEST_TRUE_FATAL(end != nullptr);
+    APSARA_TEST_EQUAL("] [INFO]", string(end));
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(819129000L, ts.tv_nsec);
+    APSARA_TEST_EQUAL(6, nanosecondLength);
+
+    APSARA_TEST_TRUE(parser.Parse("2013-09-12 22:18:28.819129", ts, nanosecondLength) == nullptr);
+    APSARA_TEST_TRUE(parser.Parse("[2013-13-12 22:18:28.819129", ts, nanosecondLength) == nullptr);
+    APSARA_TEST_TRUE(parser.Parse("[2013-09-12 22:18:28", ts, nanosecondLength) == nullptr);
+}
+
+void TimestampParserUnittest::TestParseNanosecond() {
+    long nanosecond = -1;
+    int nanosecondLength = -1;
+    string input = "123]";
+    const char* end = TimestampParser::ParseNanosecond(input.c_str(), nanosecond, nanosecondLength);
+    APSARA_TEST_TRUE_FATAL(end != nullptr);
+    APSARA_TEST_EQUAL("]", string(end));
+    APSARA_TEST_EQUAL(123000000L, nanosecond);
+    APSARA_TEST_EQUAL(3, nanosecondLength);
+
+    input = "]";
+    APSARA_TEST_TRUE(TimestampParser::ParseNanosecond(input.c_str(), nanosecond, nanosecondLength) == nullptr);
+    APSARA_TEST_EQUAL(0L, nanosecond);
+}
+
+string TimestampParserUnittest::GenerateTimeString(const string& format, mt19937& rng) {
+    static const string sAlphabet = "0123456789012345678901234567890123456789-: .T%[/";
+    string s;
+    if (rng() % 3 != 0) {
+        // random characters
+        s.resize(rng() % 30);
+        for (auto& c : s) {
+            c = sAlphabet[rng() % sAlphabet.size()];
+        }
+        return s;
+    }
+    time_t t = rng() % 2000000000U;
+    if (format == "%s") {
+        s = to_string(t) + string(rng() % 12, '7');
+    } else {
+        struct tm tm;
+        localtime_r(&t, &tm);
+        char buf[128];
+        strftime(buf, sizeof(buf), format.c_str(), &tm);
+        s = buf;
+        size_t pos = 0;
+        while ((pos = s.find("%f")) != string::npos) {
+            s.replace(pos, 2, to_string(rng() % 1000000));
+        }
+    }
+    // mutate valid time strings
+    if (rng() % 4 == 0 && !s.empty()) {
+        s[rng() % s.size()] = sAlphabet[rng() % sAlphabet.size()];
+    }
+    if (rng() % 4 == 0) {
+        s += sAlphabet[rng() % sAlphabet.size()];
+    }
+    return s;
+}
+
+void TimestampParserUnittest::TestConsistentWithStrptime() {
+    vector<string> formats = {"%Y-%m-%d %H:%M:%S",
+                              "%Y-%m-%d %H:%M:%S.%f",
+                              "%Y-%m-%dT%H:%M:%S",
+                              "%Y-%m-%dT%H:%M:%S.%f",
+                              "[%Y-%m-%d %H:%M:%S.%f",
+                              "%H:%M:%S.%f %Y-%m-%d",
+                              "%F %T",
+                              "%Y/%m/%e%n%H%M%S%f",
+                              "%m-%d %H:%M:%S.%f",
+                              "%Y%%%m",
+                              "%s"};
+    vector<int32_t> years = {-1, 2019};
+    mt19937 rng(0);
+    for (const auto& format : formats) {
+        for (int32_t year : years) {
+            TimestampParser parser(format, year);
+            for (size_t i = 0; i < 20000; ++i) {
+                string s = GenerateTimeString(format, rng);
+                LogtailTime expected = {0, 0};
+                LogtailTime actual = {0, 0};
+                int expectedNanosecondLength = -1;
+                int actualNanosecondLength = -1;
+                const char* expectedEnd
+                    = Strptime(s.c_str(), format.c_str(), &expected, expectedNanosecondLength, year);
+                const char* actualEnd = parser.Parse(s.c_str(), actual, actualNanosecondLength);
+                APSARA_TEST_EQUAL_FATAL(expectedEnd, actualEnd);
+                if (expectedEnd != nullptr) {
+                    APSARA_TEST_EQUAL_FATAL(expected.tv_sec, actual.tv_sec);
+                    APSARA_TEST_EQUAL_FATAL(expected.tv_nsec, actual.tv_nsec);
+                    APSARA_TEST_EQUAL_FATAL(expectedNanosecondLength, actualNanosecondLength);
+                }
+            }
+        }
+    }
+}
+
+void TimestampParserUnittest::TestCache() {
+    TimestampParser parser("%Y-%m-%d %H:%M:%S");
+    TimestampCache cache;
+    LogtailTime ts = {0, 0};
+    LogtailTime expected = {0, 0};
+    int nanosecondLength = -1;
+
+    APSARA_TEST_TRUE(parser.Parse(StringView("2024-01-01 10:00:00"), ts, cache));
+    parser.Parse("2024-01-01 10:00:00", expected, nanosecondLength);
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(1U, cache.Size());
+    // the whole time string is the key if there is no %f
+    APSARA_TEST_TRUE(parser.Parse(StringView("2024-01-01 10:00:00"), ts, cache));
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(1U, cache.Size());
+    APSARA_TEST_TRUE(parser.Parse(StringView("2024-01-01 10:00:001"), ts, cache));
+    parser.Parse("2024-01-01 10:00:001", expected, nanosecondLength);
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(2U, cache.Size());
+
+    APSARA_TEST_FALSE(parser.Parse(StringView("2024-01-01 10:00:"), ts, cache));
+    APSARA_TEST_EQUAL(2U, cache.Size());
+
+    // %s is not cached
+    TimestampParser unixSecondsParser("%s");
+    APSARA_TEST_TRUE(unixSecondsParser.Parse(StringView("1378972170"), ts, cache));
+    APSARA_TEST_EQUAL(1378972170, ts.tv_sec);
+    APSARA_TEST_EQUAL(2U, cache.Size());
+}
+
+void TimestampParserUnittest::TestCacheWithNanosecond() {
+    TimestampParser parser("%Y-%m-%d %H:%M:%S.%f");
+    TimestampCache cache;
+    LogtailTime ts = {0, 0};
+    LogtailTime expected = {0, 0};
+    int nanosecondLength = -1;
+
+    APSARA_TEST_TRUE(parser.Parse(StringView("2024-01-01 10:00:00.123"), ts, cache));
+    parser.Parse("2024-01-01 10:00:00.123", expected, nanosecondLength);
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(123000000L, ts.tv_nsec);
+    APSARA_TEST_EQUAL(1U, cache.Size());
+    APSARA_TEST_TRUE(cache.Find("2024-01-01 10:00:00.") != nullptr);
+
+    APSARA_TEST_TRUE(parser.Parse(StringView("2024-01-01 10:00:00.456789"), ts, cache));
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(456789000L, ts.tv_nsec);
+    APSARA_TEST_EQUAL(1U, cache.Size());
+
+    // nanoseconds are still required on hit
+    APSARA_TEST_FALSE(parser.Parse(StringView("2024-01-01 10:00:00."), ts, cache));
+    APSARA_TEST_FALSE(parser.Parse(StringView("2024-01-01 10:00:00.x"), ts, cache));
+
+    // formats with %f in the middle are not cached
+    TimestampParser nanosecondFirstParser("%H:%M:%S.%f %Y-%m-%d");
+    APSARA_TEST_TRUE(nanosecondFirstParser.Parse(StringView("10:00:00.123 2024-01-01"), ts, cache));
+    APSARA_TEST_TRUE(nanosecondFirstParser.Parse(StringView("10:00:00.123 2024-01-02"), ts, cache));
+    parser.Parse("2024-01-02 10:00:00.123", expected, nanosecondLength);
+    APSARA_TEST_EQUAL(expected.tv_sec, ts.tv_sec);
+    APSARA_TEST_EQUAL(1U, cache.Size());
+}
+
+void TimestampParserUnittest::TestCacheCapacity() {
+    TimestampParser parser("%Y-%m-%d %H:%M:%S.%f");
+    TimestampCache cache;
+    LogtailTime ts = {0, 0};
+    vector<string> timeStrs;
+    for (size_t i = 0; i < TimestampCache::kCapacity + 1; ++i) {
+        timeStrs.emplace_back("2024-01-01 10:00:0" + to_string(i) + ".1");
+    }
+    for (const auto& timeStr : timeStrs) {
+        APSARA_TEST_TRUE(parser.Parse(StringView(timeStr), ts, cache));
+    }
+    APSARA_TEST_EQUAL(TimestampCache::kCapacity, cache.Size());
+    // the oldest one is replaced
+    APSARA_TEST_TRUE(cache.Find(timeStrs[0]) == nullptr);
+    for (size_t i = 1; i < timeStrs.size(); ++i) {
+        const TimestampCache::Entry* entry = cache.Find(timeStrs[i]);
+        APSARA_TEST_TRUE_FATAL(entry != nullptr);
+        APSARA_TEST_EQUAL(timeStrs[i].substr(0, timeStrs[i].size() - 1), entry->key.to_string());
+    }
+
+    // empty keys are ignored
+    cache.Add(StringView(), 0);
+    APSARA_TEST_EQUAL(TimestampCache::kCapacity, cache.Size());
+    APSARA_TEST_TRUE(cache.Find(timeStrs[1]) != nullptr);
+}
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
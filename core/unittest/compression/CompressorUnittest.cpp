@@ -55,6 +55,7 @@ void CompressorUnittest::TestMetric() {
         APSARA_TEST_EQUAL(output.size(), compressor.mOutItemSizeBytes->GetValue());
         APSARA_TEST_EQUAL(0U, compressor.mDiscardedItemsTotal->GetValue());
         APSARA_TEST_EQUAL(0U, compressor.mDiscardedItemSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(static_cast<double>(input.size()) / output.size(), compressor.mCompressionRatio->GetValue());
     }
     {
         CompressorMock compressor(CompressType::MOCK);
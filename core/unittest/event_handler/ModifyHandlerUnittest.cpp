@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 
+#include "checkpoint/CheckPointManager.h"
 #include "common/FileSystemUtil.h"
 #include "common/Flags.h"
 #include "common/JsonUtil.h"
@@ -43,6 +44,7 @@ public:
     void TestHandleContainerStoppedEventWhenNotReadToEnd();
     void TestHandleModifyEventWhenContainerStopped();
     void TestRecoverReaderFromCheckpoint();
+    void TestDumpAndRemoveReaders();
 
 protected:
     static void SetUpTestCase() {
@@ -157,6 +159,7 @@ UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleContainerStoppedEventWhenReadToE
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleContainerStoppedEventWhenNotReadToEnd);
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWhenContainerStopped);
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestRecoverReaderFromCheckpoint);
+UNIT_TEST_CASE(ModifyHandlerUnittest, TestDumpAndRemoveReaders);
 
 void ModifyHandlerUnittest::TestHandleContainerStoppedEventWhenReadToEnd() {
     LOG_INFO(sLogger, ("TestHandleContainerStoppedEventWhenReadToEnd() begin", time(NULL)));
@@ -314,6 +317,64 @@ void ModifyHandlerUnittest::TestRecoverReaderFromCheckpoint() {
     APSARA_TEST_EQUAL_FATAL(handlerPtr->mRotatorReaderMap.size(), 2);
 }
 
+void ModifyHandlerUnittest::TestDumpAndRemoveReaders() {
+    LOG_INFO(sLogger, ("TestDumpAndRemoveReaders() begin", time(NULL)));
+    CheckPointManager::Instance()->RemoveAllCheckPoint();
+    const std::string updatedConfigName = "##1.0##project-0$config-1";
+    PipelineContext updatedCtx;
+    updatedCtx.SetConfigName(updatedConfigName);
+    updatedCtx.SetProcessQueueKey(0);
+
+    CreateHandler createHandler;
+    CreateModifyHandler createModifyHandler(&createHandler);
+    // the untouched config, handlers are released by ~CreateModifyHandler
+    auto* handler = new ModifyHandler(mConfigName, mConfig);
+    handler->mNameReaderMap[gLogName] = LogFileReaderPtrArray{mReaderPtr};
+    mReaderPtr->SetReaderArray(&handler->mNameReaderMap[gLogName]);
+    handler->mDevInodeReaderMap[mReaderPtr->mDevInode] = mReaderPtr;
+    createModifyHandler.mModifyHandlerPtrMap[mConfigName] = handler;
+    // the updated config reading the same file
+    auto updatedReader = std::make_shared<LogFileReader>(gRootDir,
+                                                         gLogName,
+                                                         DevInode(),
+                                                         std::make_pair(&readerOpts, &updatedCtx),
+                                                         std::make_pair(&multilineOpts, &updatedCtx));
+    updatedReader->UpdateReaderManual();
+    APSARA_TEST_TRUE_FATAL(updatedReader->CheckFileSignatureAndOffset(true));
+    auto* updatedHandler = new ModifyHandler(updatedConfigName, mConfig);
+    updatedHandler->mNameReaderMap[gLogName] = LogFileReaderPtrArray{updatedReader};
+    updatedReader->SetReaderArray(&updatedHandler->mNameReaderMap[gLogName]);
+    updatedHandler->mDevInodeReaderMap[updatedReader->mDevInode] = updatedReader;
+    createModifyHandler.mModifyHandlerPtrMap[updatedConfigName] = updatedHandler;
+
+    Event event(gRootDir, gLogName, EVENT_MODIFY, 0, 0, mReaderPtr->mDevInode.dev, mReaderPtr->mDevInode.inode);
+    LogBuffer logbuf;
+    mReaderPtr->ReadLog(logbuf, &event);
+    int64_t lastFilePos = mReaderPtr->mLastFilePos;
+
+    createModifyHandler.DumpAndRemoveReaders({updatedConfigName});
+    // only the updated config is dumped and removed
+    APSARA_TEST_EQUAL_FATAL(1U, createModifyHandler.mModifyHandlerPtrMap.size());
+    APSARA_TEST_EQUAL_FATAL(handler, createModifyHandler.mModifyHandlerPtrMap[mConfigName]);
+    CheckPointPtr checkPoint;
+    APSARA_TEST_TRUE_FATAL(
+        CheckPointManager::Instance()->GetCheckPoint(updatedReader->mDevInode, updatedConfigName, checkPoint));
+    APSARA_TEST_FALSE_FATAL(
+        CheckPointManager::Instance()->GetCheckPoint(mReaderPtr->mDevInode, mConfigName, checkPoint));
+
+    // the untouched reader keeps reading from where it was, without being rebuilt from checkpoint
+    APSARA_TEST_EQUAL_FATAL(mReaderPtr.get(), handler->mDevInodeReaderMap[mReaderPtr->mDevInode].get());
+    APSARA_TEST_TRUE_FATAL(mReaderPtr->mLogFileOp.IsOpen());
+    APSARA_TEST_EQUAL_FATAL(lastFilePos, mReaderPtr->mLastFilePos);
+    std::string newLog = "another sample log\n";
+    writeLog(gRootDir + PATH_SEPARATOR + gLogName, newLog);
+    LogBuffer newLogbuf;
+    mReaderPtr->ReadLog(newLogbuf, &event);
+    APSARA_TEST_EQUAL_FATAL(lastFilePos + static_cast<int64_t>(newLog.size()), mReaderPtr->mLastFilePos);
+
+    CheckPointManager::Instance()->RemoveAllCheckPoint();
+}
+
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
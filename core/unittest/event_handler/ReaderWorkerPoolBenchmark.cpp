@@ -0,0 +1,204 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/FileSystemUtil.h"
+#include "common/JsonUtil.h"
+#include "config/PipelineConfig.h"
+#include "file_server/FileServer.h"
+#include "file_server/event/Event.h"
+#include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/ReaderWorkerPool.h"
+#include "pipeline/Pipeline.h"
+#include "pipeline/queue/ProcessQueueManager.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// tails N synthetic files, each of which lies in its own directory (like container stdout), and reports read
+// throughput for different reader worker counts
+class ReaderWorkerPoolBenchmark : public ::testing::Test {
+public:
+    void TestReadThroughput();
+
+protected:
+    void SetUp() override {
+        mRootDir = GetProcessExecutionDir();
+        if (PATH_SEPARATOR[0] == mRootDir.back())
+            mRootDir.resize(mRootDir.size() - 1);
+        mRootDir += PATH_SEPARATOR + "ReaderWorkerPoolBenchmark";
+        bfs::remove_all(mRootDir);
+
+        string line(mLineSize - 1, 'a');
+        line += '\n';
+        for (size_t i = 0; i < mFileCnt; ++i) {
+            string dir = mRootDir + PATH_SEPARATOR + "pod_" + ToString(i);
+            bfs::create_directories(dir);
+            ofstream writer((dir + PATH_SEPARATOR + "stdout.log").c_str(), fstream::out | fstream::trunc);
+            for (size_t j = 0; j < mFileSize / mLineSize; ++j) {
+                writer << line;
+            }
+        }
+
+        unique_ptr<Json::Value> configJson;
+        string configStr, errorMsg;
+        configStr = R"(
+            {
+                "inputs": [
+                    {
+                        "Type": "input_file",
+                        "FilePaths": [
+                            ")"
+            + mRootDir + R"(/**/stdout.log"
+                        ],
+                        "MaxDirSearchDepth": 1
+                    }
+                ],
+                "flushers": [
+                    {
+                        "Type": "flusher_sls",
+                        "Project": "test_project",
+                        "Logstore": "test_logstore",
+                        "Region": "test_region",
+                        "Endpoint": "test_endpoint"
+                    }
+                ]
+            }
+        )";
+        configJson.reset(new Json::Value());
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, *configJson, errorMsg));
+        Json::Value inputConfigJson = (*configJson)["inputs"][0];
+
+        unique_ptr<PipelineConfig> config(new PipelineConfig(mConfigName, std::move(configJson)));
+        APSARA_TEST_TRUE(config->Parse());
+        mPipeline.reset(new Pipeline());
+        APSARA_TEST_TRUE(mPipeline->Init(std::move(*config)));
+        ctx.SetPipeline(*mPipeline.get());
+        ctx.SetConfigName(mConfigName);
+        ctx.SetProcessQueueKey(0);
+
+        discoveryOpts.Init(inputConfigJson, ctx, "test");
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        FileServer::GetInstance()->AddFileDiscoveryConfig(mConfigName, &discoveryOpts, &ctx);
+        FileServer::GetInstance()->AddFileReaderConfig(mConfigName, &readerOpts, &ctx);
+        FileServer::GetInstance()->AddMultilineConfig(mConfigName, &multilineOpts, &ctx);
+        ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(0, 0, ctx);
+        ProcessQueueManager::GetInstance()->EnablePop(mConfigName);
+    }
+
+    void TearDown() override { bfs::remove_all(mRootDir); }
+
+private:
+    double RunOnce(uint32_t workerCnt);
+
+    const string mConfigName = "##1.0##project-0$config-0";
+    const size_t mFileCnt = 64;
+    const size_t mFileSize = 16 * 1024 * 1024;
+    const size_t mLineSize = 256;
+    string mRootDir;
+    unique_ptr<Pipeline> mPipeline;
+    FileDiscoveryOptions discoveryOpts;
+    FileReaderOptions readerOpts;
+    MultilineOptions multilineOpts;
+    PipelineContext ctx;
+};
+
+double ReaderWorkerPoolBenchmark::RunOnce(uint32_t workerCnt) {
+    auto pool = ReaderWorkerPool::GetInstance();
+    pool->Start(workerCnt);
+
+    FileDiscoveryConfig config = make_pair(&discoveryOpts, &ctx);
+    vector<unique_ptr<ModifyHandler>> handlers;
+    vector<Event> events;
+    for (size_t i = 0; i < mFileCnt; ++i) {
+        string dir = mRootDir + PATH_SEPARATOR + "pod_" + ToString(i);
+        auto devInode = GetFileDevInode(dir + PATH_SEPARATOR + "stdout.log");
+        handlers.emplace_back(make_unique<ModifyHandler>(mConfigName, config));
+        // never break out since there is no LogInput thread in benchmark
+        handlers.back()->mReadFileTimeSlice = UINT64_MAX;
+        Event create(dir, "stdout.log", EVENT_CREATE, -1, 0, devInode.dev, devInode.inode);
+        create.SetConfigName(mConfigName);
+        handlers.back()->Handle(create);
+        events.emplace_back(dir, "stdout.log", EVENT_MODIFY, -1, 0, devInode.dev, devInode.inode);
+        events.back().SetConfigName(mConfigName);
+    }
+
+    atomic_bool stop = false;
+    thread consumer([&]() {
+        unique_ptr<ProcessQueueItem> item;
+        string configName;
+        while (!stop) {
+            if (!ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+                ProcessQueueManager::GetInstance()->Wait(1);
+            }
+        }
+    });
+
+    auto isAllRead = [&]() {
+        for (auto& handler : handlers) {
+            for (auto& item : handler->mDevInodeReaderMap) {
+                if (!item.second->IsReadToEnd()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    auto start = chrono::high_resolution_clock::now();
+    do {
+        // events blocked by full process queue are dispatched again
+        for (size_t i = 0; i < mFileCnt; ++i) {
+            if (workerCnt > 1) {
+                pool->Dispatch(handlers[i].get(), events[i]);
+            } else {
+                handlers[i]->Handle(events[i]);
+            }
+        }
+        while (pool->HasPendingEvents()) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    } while (!isAllRead());
+    auto end = chrono::high_resolution_clock::now();
+
+    stop = true;
+    consumer.join();
+    pool->Stop();
+
+    chrono::duration<double> elapsed = end - start;
+    return mFileCnt * mFileSize / 1024.0 / 1024.0 / elapsed.count();
+}
+
+void ReaderWorkerPoolBenchmark::TestReadThroughput() {
+    for (uint32_t workerCnt : {1U, 2U, 4U, 8U}) {
+        double throughput = RunOnce(workerCnt);
+        cout << "file count: " << mFileCnt << "\tworker count: " << workerCnt << "\tthroughput: " << throughput
+             << " MB/s" << endl;
+    }
+}
+
+UNIT_TEST_CASE(ReaderWorkerPoolBenchmark, TestReadThroughput)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
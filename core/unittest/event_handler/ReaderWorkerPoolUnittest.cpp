@@ -0,0 +1,259 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "common/FileSystemUtil.h"
+#include "common/JsonUtil.h"
+#include "config/PipelineConfig.h"
+#include "file_server/FileServer.h"
+#include "file_server/event/Event.h"
+#include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/LogInput.h"
+#include "file_server/event_handler/ReaderWorkerPool.h"
+#include "pipeline/Pipeline.h"
+#include "pipeline/queue/ProcessQueueManager.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ReaderWorkerPoolUnittest : public ::testing::Test {
+public:
+    void TestDispatchWhenDisabled();
+    void TestDispatchAndHoldOn();
+    void TestReadByWorker();
+    void TestRestart();
+
+protected:
+    static void SetUpTestCase() {
+        gRootDir = GetProcessExecutionDir();
+        if (PATH_SEPARATOR[0] == gRootDir.at(gRootDir.size() - 1))
+            gRootDir.resize(gRootDir.size() - 1);
+        gRootDir += PATH_SEPARATOR + "ReaderWorkerPoolUnittest";
+        bfs::remove_all(gRootDir);
+    }
+
+    void SetUp() override {
+        bfs::create_directories(gRootDir);
+        mLogPath = gRootDir + PATH_SEPARATOR + gLogName;
+        {
+            ofstream writer(mLogPath.c_str(), fstream::out | fstream::trunc);
+            writer << "a sample log\n";
+        }
+
+        unique_ptr<Json::Value> configJson;
+        string configStr, errorMsg;
+        configStr = R"(
+            {
+                "inputs": [
+                    {
+                        "Type": "input_file",
+                        "FilePaths": [
+                            ")"
+            + mLogPath + R"("
+                        ]
+                    }
+                ],
+                "flushers": [
+                    {
+                        "Type": "flusher_sls",
+                        "Project": "test_project",
+                        "Logstore": "test_logstore",
+                        "Region": "test_region",
+                        "Endpoint": "test_endpoint"
+                    }
+                ]
+            }
+        )";
+        configJson.reset(new Json::Value());
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, *configJson, errorMsg));
+        Json::Value inputConfigJson = (*configJson)["inputs"][0];
+
+        unique_ptr<PipelineConfig> config(new PipelineConfig(mConfigName, std::move(configJson)));
+        APSARA_TEST_TRUE(config->Parse());
+        mPipeline.reset(new Pipeline());
+        APSARA_TEST_TRUE(mPipeline->Init(std::move(*config)));
+        ctx.SetPipeline(*mPipeline.get());
+        ctx.SetConfigName(mConfigName);
+        ctx.SetProcessQueueKey(0);
+
+        discoveryOpts = FileDiscoveryOptions();
+        discoveryOpts.Init(inputConfigJson, ctx, "test");
+        mConfig = make_pair(&discoveryOpts, &ctx);
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+
+        FileServer::GetInstance()->AddFileDiscoveryConfig(mConfigName, &discoveryOpts, &ctx);
+        FileServer::GetInstance()->AddFileReaderConfig(mConfigName, &readerOpts, &ctx);
+        FileServer::GetInstance()->AddMultilineConfig(mConfigName, &multilineOpts, &ctx);
+        ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(0, 0, ctx);
+        ProcessQueueManager::GetInstance()->EnablePop(mConfigName);
+    }
+
+    void TearDown() override {
+        ReaderWorkerPool::GetInstance()->Stop();
+        LogInput::GetInstance()->CleanEnviroments();
+        LogInput::GetInstance()->mIdleFlag = false;
+        FileServer::GetInstance()->RemoveFileDiscoveryConfig(mConfigName);
+        FileServer::GetInstance()->RemoveFileReaderConfig(mConfigName);
+        FileServer::GetInstance()->RemoveMultilineConfig(mConfigName);
+        bfs::remove_all(gRootDir);
+    }
+
+private:
+    static string gRootDir;
+    static const string gLogName;
+
+    const string mConfigName = "##1.0##project-0$config-0";
+    string mLogPath;
+    unique_ptr<Pipeline> mPipeline;
+    FileDiscoveryOptions discoveryOpts;
+    FileReaderOptions readerOpts;
+    MultilineOptions multilineOpts;
+    PipelineContext ctx;
+    FileDiscoveryConfig mConfig;
+};
+
+string ReaderWorkerPoolUnittest::gRootDir;
+const string ReaderWorkerPoolUnittest::gLogName = "test.log";
+
+void ReaderWorkerPoolUnittest::TestDispatchWhenDisabled() {
+    auto pool = ReaderWorkerPool::GetInstance();
+    pool->Start(1);
+    APSARA_TEST_FALSE(pool->IsEnabled());
+
+    ModifyHandler handler(mConfigName, mConfig);
+    auto devInode = GetFileDevInode(mLogPath);
+    Event event(gRootDir, gLogName, EVENT_CREATE, -1, 0, devInode.dev, devInode.inode);
+    pool->Dispatch(&handler, event);
+    // handled inline
+    APSARA_TEST_EQUAL(1U, handler.mDevInodeReaderMap.size());
+    APSARA_TEST_FALSE(pool->HasPendingEvents());
+}
+
+void ReaderWorkerPoolUnittest::TestDispatchAndHoldOn() {
+    auto pool = ReaderWorkerPool::GetInstance();
+    // build shards without threads so that dispatched events stay in queue
+    for (size_t i = 0; i < 2; ++i) {
+        pool->mShards.emplace_back(make_unique<ReaderWorkerPool::Shard>());
+    }
+    pool->mEnabled = true;
+
+    ModifyHandler handler1(mConfigName, mConfig);
+    ModifyHandler handler2(mConfigName, mConfig);
+    Event event1(gRootDir, gLogName, EVENT_MODIFY, -1);
+    Event event2(gRootDir, gLogName, EVENT_ISDIR | EVENT_CONTAINER_STOPPED, -1);
+    pool->Dispatch(&handler1, event1);
+    pool->Dispatch(&handler1, event2);
+    pool->Dispatch(&handler1, event2);
+    pool->Dispatch(&handler2, event1);
+    APSARA_TEST_TRUE(pool->HasPendingEvents());
+
+    // events of one handler go to the same shard in order
+    auto& shard1 = *pool->mShards[handler1.GetWorkerIdx() % 2];
+    auto& shard2 = *pool->mShards[handler2.GetWorkerIdx() % 2];
+    APSARA_TEST_NOT_EQUAL(&shard1, &shard2);
+    APSARA_TEST_EQUAL(3U, shard1.mQueue.size());
+    APSARA_TEST_TRUE(shard1.mQueue[0].second->IsModify());
+    APSARA_TEST_TRUE(shard1.mQueue[1].second->IsContainerStopped());
+    APSARA_TEST_TRUE(shard1.mQueue[2].second->IsContainerStopped());
+    APSARA_TEST_EQUAL(1U, shard2.mQueue.size());
+
+    // pending events are returned to LogInput
+    pool->HoldOn();
+    APSARA_TEST_FALSE(pool->HasPendingEvents());
+    APSARA_TEST_TRUE(shard1.mQueue.empty());
+    APSARA_TEST_TRUE(shard2.mQueue.empty());
+    vector<Event*> events;
+    while (Event* ev = LogInput::GetInstance()->PopEventQueue()) {
+        events.push_back(ev);
+    }
+    // duplicated dir events are dropped by the pool and duplicated modify events are merged by LogInput
+    APSARA_TEST_EQUAL(2U, events.size());
+    for (auto ev : events) {
+        // dir events are routed to the original config only
+        APSARA_TEST_EQUAL(mConfigName, ev->GetConfigName());
+        delete ev;
+    }
+    pool->Resume();
+
+    pool->mShards.clear();
+    pool->mEnabled = false;
+}
+
+void ReaderWorkerPoolUnittest::TestReadByWorker() {
+    auto pool = ReaderWorkerPool::GetInstance();
+    pool->Start(2);
+    APSARA_TEST_TRUE_FATAL(pool->IsEnabled());
+    APSARA_TEST_EQUAL(2U, pool->GetThreadCount());
+
+    ModifyHandler handler(mConfigName, mConfig);
+    auto devInode = GetFileDevInode(mLogPath);
+    pool->Dispatch(&handler, Event(gRootDir, gLogName, EVENT_CREATE, -1, 0, devInode.dev, devInode.inode));
+    pool->Dispatch(&handler, Event(gRootDir, gLogName, EVENT_MODIFY, -1, 0, devInode.dev, devInode.inode));
+    for (size_t i = 0; i < 100 && pool->HasPendingEvents(); ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    APSARA_TEST_FALSE_FATAL(pool->HasPendingEvents());
+
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    APSARA_TEST_TRUE_FATAL(ProcessQueueManager::GetInstance()->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL(mConfigName, configName);
+    APSARA_TEST_EQUAL(1U, item->mEventGroup.GetEvents().size());
+}
+
+void ReaderWorkerPoolUnittest::TestRestart() {
+    auto pool = ReaderWorkerPool::GetInstance();
+    pool->Start(2);
+    APSARA_TEST_TRUE_FATAL(pool->IsEnabled());
+    pool->Stop();
+    APSARA_TEST_FALSE(pool->IsEnabled());
+    APSARA_TEST_EQUAL(0U, pool->GetThreadCount());
+    APSARA_TEST_FALSE(pool->HasPendingEvents());
+
+    // shards of the last run are not reused
+    pool->Start(3);
+    APSARA_TEST_TRUE_FATAL(pool->IsEnabled());
+    APSARA_TEST_EQUAL(3U, pool->GetThreadCount());
+
+    ModifyHandler handler(mConfigName, mConfig);
+    auto devInode = GetFileDevInode(mLogPath);
+    pool->Dispatch(&handler, Event(gRootDir, gLogName, EVENT_CREATE, -1, 0, devInode.dev, devInode.inode));
+    pool->Dispatch(&handler, Event(gRootDir, gLogName, EVENT_MODIFY, -1, 0, devInode.dev, devInode.inode));
+    for (size_t i = 0; i < 100 && pool->HasPendingEvents(); ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    APSARA_TEST_FALSE_FATAL(pool->HasPendingEvents());
+
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    APSARA_TEST_TRUE_FATAL(ProcessQueueManager::GetInstance()->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL(1U, item->mEventGroup.GetEvents().size());
+
+    pool->Stop();
+    APSARA_TEST_EQUAL(0U, pool->GetThreadCount());
+}
+
+UNIT_TEST_CASE(ReaderWorkerPoolUnittest, TestDispatchWhenDisabled)
+UNIT_TEST_CASE(ReaderWorkerPoolUnittest, TestDispatchAndHoldOn)
+UNIT_TEST_CASE(ReaderWorkerPoolUnittest, TestReadByWorker)
+UNIT_TEST_CASE(ReaderWorkerPoolUnittest, TestRestart)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
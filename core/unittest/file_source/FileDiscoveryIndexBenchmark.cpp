@@ -0,0 +1,112 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "common/StringTools.h"
+#include "file_server/FileDiscoveryIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "pipeline/PipelineContext.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// mConfigCnt file configs exist on the node, a quarter of which have wildcard base paths. Files under directories of
+// random configs are matched by scanning all configs as ConfigManager::FindBestMatch did on cache miss, and by checking
+// the candidates from the index only.
+class FileDiscoveryIndexBenchmark : public ::testing::Test {
+public:
+    void TestMatch();
+
+private:
+    const size_t mConfigCnt = 800;
+    const size_t mLookupCnt = 20000;
+
+    PipelineContext mCtx;
+};
+
+void FileDiscoveryIndexBenchmark::TestMatch() {
+    vector<unique_ptr<FileDiscoveryOptions>> options;
+    vector<FileDiscoveryConfig> configs;
+    FileDiscoveryIndex index;
+    for (size_t i = 0; i < mConfigCnt; ++i) {
+        Json::Value configJson;
+        string filePath = i % 4 == 0 ? "/var/lib/pods/*/volumes/app_" + ToString(i) + "/**/*.log"
+                                     : "/var/log/app_" + ToString(i) + "/**/*.log";
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = Json::Value(3);
+        configJson["ExcludeFiles"].append(Json::Value("*.gz"));
+        options.emplace_back(new FileDiscoveryOptions());
+        if (!options.back()->Init(configJson, mCtx, "test")) {
+            cout << "init config failed" << endl;
+            return;
+        }
+        configs.emplace_back(options.back().get(), &mCtx);
+        index.Add(ToString(i), configs.back());
+    }
+    vector<string> paths;
+    for (size_t i = 0; i < mLookupCnt; ++i) {
+        size_t idx = (i * 7919) % mConfigCnt;
+        paths.push_back(idx % 4 == 0 ? "/var/lib/pods/" + ToString(i) + "/volumes/app_" + ToString(idx) + "/sub"
+                                     : "/var/log/app_" + ToString(idx) + "/sub");
+    }
+    const string name = "test.log";
+
+    size_t scanMatchCnt = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (const auto& path : paths) {
+        for (const auto& config : configs) {
+            if (config.first->IsMatch(path, name)) {
+                ++scanMatchCnt;
+            }
+        }
+    }
+    chrono::duration<double> scan = chrono::high_resolution_clock::now() - start;
+
+    size_t indexMatchCnt = 0;
+    size_t candidateCnt = 0;
+    vector<FileDiscoveryConfig> candidates;
+    start = chrono::high_resolution_clock::now();
+    for (const auto& path : paths) {
+        candidates.clear();
+        index.FindCandidates(path, candidates);
+        candidateCnt += candidates.size();
+        for (const auto& config : candidates) {
+            if (config.first->IsMatch(path, name)) {
+                ++indexMatchCnt;
+            }
+        }
+    }
+    chrono::duration<double> indexed = chrono::high_resolution_clock::now() - start;
+
+    APSARA_TEST_EQUAL(scanMatchCnt, indexMatchCnt);
+    cout << "configs: " << mConfigCnt << "\tlookups: " << mLookupCnt << "\tmatches: " << indexMatchCnt << endl;
+    cout << "scan:\t" << scan.count() * 1e9 / mLookupCnt << " ns/lookup" << endl;
+    cout << "index:\t" << indexed.count() * 1e9 / mLookupCnt
+         << " ns/lookup\tcandidates/lookup: " << static_cast<double>(candidateCnt) / mLookupCnt << endl;
+}
+
+UNIT_TEST_CASE(FileDiscoveryIndexBenchmark, TestMatch)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,198 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "file_server/FileDiscoveryIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "pipeline/PipelineContext.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FileDiscoveryIndexUnittest : public testing::Test {
+public:
+    void TestFindCandidates();
+    void TestRemove();
+    void TestConsistentWithScan();
+
+protected:
+    void TearDown() override { mOptions.clear(); }
+
+private:
+    FileDiscoveryConfig CreateConfig(const string& filePath, bool enableContainerDiscovery = false) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = Json::Value(3);
+        mOptions.emplace_back(new FileDiscoveryOptions());
+        if (enableContainerDiscovery) {
+            mOptions.back()->SetEnableContainerDiscoveryFlag(true);
+        }
+        APSARA_TEST_TRUE(mOptions.back()->Init(configJson, mCtx, "test"));
+        return make_pair(mOptions.back().get(), &mCtx);
+    }
+
+    set<const FileDiscoveryOptions*> FindCandidates(const FileDiscoveryIndex& index, const string& path) {
+        vector<FileDiscoveryConfig> res;
+        index.FindCandidates(path, res);
+        set<const FileDiscoveryOptions*> candidates;
+        for (const auto& config : res) {
+            candidates.insert(config.first);
+        }
+        APSARA_TEST_EQUAL(res.size(), candidates.size());
+        return candidates;
+    }
+
+    PipelineContext mCtx;
+    vector<unique_ptr<FileDiscoveryOptions>> mOptions;
+};
+
+void FileDiscoveryIndexUnittest::TestFindCandidates() {
+    FileDiscoveryIndex index;
+    auto a = CreateConfig("/var/log/a/*.log");
+    auto b = CreateConfig("/var/log/b/*.log");
+    auto wildcard = CreateConfig("/var/log/*/c/*.log");
+    auto home = CreateConfig("/home/*.log");
+    auto container = CreateConfig("/app/*.log", true);
+    index.Add("a", a);
+    index.Add("b", b);
+    index.Add("wildcard", wildcard);
+    index.Add("home", home);
+    index.Add("container", container);
+    APSARA_TEST_EQUAL(5U, index.Size());
+
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({a.first, container.first}),
+                      FindCandidates(index, "/var/log/a"));
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({a.first, container.first}),
+                      FindCandidates(index, "/var/log/a/sub/sub"));
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({a.first, wildcard.first, container.first}),
+                      FindCandidates(index, "/var/log/a/c"));
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({wildcard.first, container.first}),
+                      FindCandidates(index, "/var/log/d/c/sub"));
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({container.first}), FindCandidates(index, "/var/log/d"));
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({container.first}), FindCandidates(index, "/var/log"));
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({container.first}), FindCandidates(index, "/var/loga"));
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({home.first, container.first}),
+                      FindCandidates(index, "/home"));
+    // path with empty component
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({a.first, b.first, wildcard.first, home.first, container.first}),
+                      FindCandidates(index, "/var//log/a"));
+
+    // base path at root is a candidate of all paths
+    auto root = CreateConfig("/*.log");
+    index.Add("root", root);
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({root.first, container.first}),
+                      FindCandidates(index, "/var/loga"));
+}
+
+void FileDiscoveryIndexUnittest::TestRemove() {
+    FileDiscoveryIndex index;
+    auto a = CreateConfig("/var/log/a/*.log");
+    auto b = CreateConfig("/var/log/b/*.log");
+    auto container = CreateConfig("/app/*.log", true);
+    index.Add("a", a);
+    index.Add("b", b);
+    index.Add("container", container);
+
+    index.Remove("a");
+    APSARA_TEST_EQUAL(2U, index.Size());
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({container.first}), FindCandidates(index, "/var/log/a"));
+    // nodes no longer used are removed
+    APSARA_TEST_EQUAL(1U, index.mRoot.mChildren["var"]->mChildren["log"]->mChildren.size());
+
+    // pattern nodes no longer used are removed
+    auto wildcard = CreateConfig("/var/log/*/c/*.log");
+    index.Add("wildcard", wildcard);
+    APSARA_TEST_EQUAL(1U, index.mRoot.mChildren["var"]->mChildren["log"]->mPatternChildren.size());
+    index.Remove("wildcard");
+    APSARA_TEST_TRUE(index.mRoot.mChildren["var"]->mChildren["log"]->mPatternChildren.empty());
+
+    index.Remove("container");
+    APSARA_TEST_EQUAL(1U, index.Size());
+    APSARA_TEST_TRUE(FindCandidates(index, "/var/log/a").empty());
+
+    // add with an existing name replaces the old one
+    auto c = CreateConfig("/home/c/*.log");
+    index.Add("b", c);
+    APSARA_TEST_EQUAL(1U, index.Size());
+    APSARA_TEST_TRUE(FindCandidates(index, "/var/log/b").empty());
+    APSARA_TEST_EQUAL(set<const FileDiscoveryOptions*>({c.first}), FindCandidates(index, "/home/c"));
+    APSARA_TEST_EQUAL(1U, index.mRoot.mChildren.size());
+
+    index.Remove("b");
+    APSARA_TEST_EQUAL(0U, index.Size());
+    APSARA_TEST_TRUE(index.mRoot.mChildren.empty());
+
+    // remove non-existing config
+    index.Remove("b");
+    APSARA_TEST_EQUAL(0U, index.Size());
+}
+
+void FileDiscoveryIndexUnittest::TestConsistentWithScan() {
+    FileDiscoveryIndex index;
+    vector<FileDiscoveryConfig> configs;
+    for (const auto& filePath : {"/var/log/*.log",
+                                 "/var/log/a/*.log",
+                                 "/var/log/a/b/*.log",
+                                 "/var/log/ab/*.log",
+                                 "/var/log/*/b/*.log",
+                                 "/var/log/a?/*.log",
+                                 "/var/*/a/**/*.log",
+                                 "/home/*.log"}) {
+        configs.push_back(CreateConfig(filePath));
+        index.Add(filePath, configs.back());
+    }
+    for (const auto& path : {"/var",
+                             "/var/log",
+                             "/var/log/a",
+                             "/var/log/a/b",
+                             "/var/log/a/b/c/d",
+                             "/var/log/ab",
+                             "/var/log/ac",
+                             "/var/log/b/b",
+                             "/var/lib/a/b",
+                             "/var/logs/a",
+                             "/home",
+                             "/home/a/b/c/d/e"}) {
+        for (const auto& name : {"", "test.log", "test.txt"}) {
+            set<const FileDiscoveryOptions*> expected, res;
+            for (const auto& config : configs) {
+                if (config.first->IsMatch(path, name)) {
+                    expected.insert(config.first);
+                }
+            }
+            for (const auto& candidate : FindCandidates(index, path)) {
+                if (candidate->IsMatch(path, name)) {
+                    res.insert(candidate);
+                }
+            }
+            APSARA_TEST_EQUAL_FATAL(expected, res);
+        }
+    }
+}
+
+UNIT_TEST_CASE(FileDiscoveryIndexUnittest, TestFindCandidates)
+UNIT_TEST_CASE(FileDiscoveryIndexUnittest, TestRemove)
+UNIT_TEST_CASE(FileDiscoveryIndexUnittest, TestConsistentWithScan)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -32,6 +32,7 @@ public:
     void OnSuccessfulInit() const;
     void OnFailedInit() const;
     void TestFilePaths() const;
+    void TestContainerInfo() const;
 
 private:
     const string pluginType = "test";
@@ -282,9 +283,108 @@ void FileDiscoveryOptionsUnittest::TestFilePaths() const {
     APSARA_TEST_EQUAL("*.log", config->GetFilePattern());
 }
 
+void FileDiscoveryOptionsUnittest::TestContainerInfo() const {
+    FileDiscoveryOptions config;
+    Json::Value configJson, paramsJson;
+    configJson["FilePaths"].append(Json::Value("/home/admin/*.log"));
+    configJson["MaxDirSearchDepth"] = Json::Value(1);
+    APSARA_TEST_TRUE(config.Init(configJson, ctx, pluginType));
+    config.SetEnableContainerDiscoveryFlag(true);
+    config.SetContainerInfo(make_shared<vector<ContainerInfo>>());
+    config.SetDeduceAndSetContainerBaseDirFunc(
+        [](ContainerInfo& containerInfo, const PipelineContext*, const FileDiscoveryOptions* options) {
+            containerInfo.mRealBaseDir = "/logtail_host" + containerInfo.mUpperDir + options->GetBasePath();
+            return true;
+        });
+    auto checkIndex = [&config]() {
+        APSARA_TEST_EQUAL(config.GetContainerInfo()->size(), config.mContainerIDIndex.size());
+        APSARA_TEST_EQUAL(config.GetContainerInfo()->size(), config.mContainerBaseDirIndex.size());
+        for (const auto& info : *config.GetContainerInfo()) {
+            APSARA_TEST_EQUAL(&info, config.GetContainerInfoByID(info.mID));
+            APSARA_TEST_EQUAL(&info, config.GetContainerPathByLogPath(info.mRealBaseDir + "/sub"));
+        }
+    };
+
+    // add
+    for (const auto& id : {"a", "b", "c"}) {
+        paramsJson["ID"] = Json::Value(id);
+        paramsJson["UpperDir"] = Json::Value(string("/") + id);
+        APSARA_TEST_TRUE(config.UpdateContainerInfo(paramsJson, &ctx));
+    }
+    APSARA_TEST_EQUAL(3U, config.GetContainerInfo()->size());
+    checkIndex();
+    APSARA_TEST_TRUE(config.IsMatch("/logtail_host/a/home/admin", "test.log"));
+    APSARA_TEST_TRUE(config.IsMatch("/logtail_host/b/home/admin/sub", "test.log"));
+    APSARA_TEST_FALSE(config.IsMatch("/logtail_host/b/home/admin/sub/sub", "test.log"));
+    APSARA_TEST_FALSE(config.IsMatch("/logtail_host/d/home/admin", "test.log"));
+    APSARA_TEST_FALSE(config.IsMatch("/logtail_host/a/home/admin2", "test.log"));
+    APSARA_TEST_TRUE(config.IsSameContainerInfo(paramsJson, &ctx));
+
+    // update
+    paramsJson["ID"] = Json::Value("b");
+    paramsJson["UpperDir"] = Json::Value("/b/upper");
+    APSARA_TEST_FALSE(config.IsSameContainerInfo(paramsJson, &ctx));
+    APSARA_TEST_TRUE(config.UpdateContainerInfo(paramsJson, &ctx));
+    APSARA_TEST_EQUAL(3U, config.GetContainerInfo()->size());
+    checkIndex();
+    APSARA_TEST_EQUAL("/logtail_host/b/upper/home/admin", config.GetContainerInfoByID("b")->mRealBaseDir);
+    APSARA_TEST_FALSE(config.IsMatch("/logtail_host/b/home/admin", "test.log"));
+    APSARA_TEST_TRUE(config.IsMatch("/logtail_host/b/upper/home/admin", "test.log"));
+
+    // real base dir of a container is inside that of another one, the longest one is found
+    paramsJson["ID"] = Json::Value("nested");
+    paramsJson["UpperDir"] = Json::Value("/a/home/admin/nested");
+    APSARA_TEST_TRUE(config.UpdateContainerInfo(paramsJson, &ctx));
+    checkIndex();
+    APSARA_TEST_EQUAL(config.GetContainerInfoByID("nested"),
+                      config.GetContainerPathByLogPath("/logtail_host/a/home/admin/nested/home/admin"));
+    APSARA_TEST_EQUAL(config.GetContainerInfoByID("a"),
+                      config.GetContainerPathByLogPath("/logtail_host/a/home/admin/nested"));
+    APSARA_TEST_EQUAL(nullptr, config.GetContainerPathByLogPath("/logtail_host/a/home"));
+
+    // delete
+    paramsJson.clear();
+    paramsJson["ID"] = Json::Value("a");
+    APSARA_TEST_TRUE(config.DeleteContainerInfo(paramsJson));
+    APSARA_TEST_EQUAL(3U, config.GetContainerInfo()->size());
+    APSARA_TEST_EQUAL(nullptr, config.GetContainerInfoByID("a"));
+    checkIndex();
+    APSARA_TEST_FALSE(config.IsMatch("/logtail_host/a/home/admin", "test.log"));
+    // delete non-existing container
+    APSARA_TEST_TRUE(config.DeleteContainerInfo(paramsJson));
+    APSARA_TEST_EQUAL(3U, config.GetContainerInfo()->size());
+
+    // update all
+    Json::Value allJson, itemJson;
+    for (const auto& id : {"c", "d"}) {
+        itemJson["ID"] = Json::Value(id);
+        itemJson["UpperDir"] = Json::Value(string("/") + id);
+        allJson["AllCmd"].append(itemJson);
+    }
+    APSARA_TEST_FALSE(config.IsSameContainerInfo(allJson, &ctx));
+    APSARA_TEST_TRUE(config.UpdateContainerInfo(allJson, &ctx));
+    APSARA_TEST_TRUE(config.IsSameContainerInfo(allJson, &ctx));
+    APSARA_TEST_EQUAL(2U, config.GetContainerInfo()->size());
+    checkIndex();
+    APSARA_TEST_EQUAL(nullptr, config.GetContainerInfoByID("b"));
+    APSARA_TEST_EQUAL(nullptr, config.GetContainerInfoByID("nested"));
+    APSARA_TEST_EQUAL("/logtail_host/c/home/admin", config.GetContainerInfoByID("c")->mRealBaseDir);
+    APSARA_TEST_EQUAL("/logtail_host/d/home/admin", config.GetContainerInfoByID("d")->mRealBaseDir);
+
+    // index is rebuilt when container info is restored
+    auto infos = config.GetContainerInfo();
+    FileDiscoveryOptions newConfig;
+    APSARA_TEST_TRUE(newConfig.Init(configJson, ctx, pluginType));
+    newConfig.SetEnableContainerDiscoveryFlag(true);
+    newConfig.SetContainerInfo(infos);
+    APSARA_TEST_EQUAL(&(*infos)[0], newConfig.GetContainerInfoByID((*infos)[0].mID));
+    APSARA_TEST_TRUE(newConfig.IsMatch("/logtail_host/d/home/admin", "test.log"));
+}
+
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, OnSuccessfulInit)
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, OnFailedInit)
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, TestFilePaths)
+UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, TestContainerInfo)
 
 } // namespace logtail
 
@@ -0,0 +1,530 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "app_config/AppConfig.h"
+#include "common/FileEncryption.h"
+#include "common/FileSystemUtil.h"
+#include "pipeline/queue/SLSSenderQueueItem.h"
+#include "plugin/flusher/sls/DiskBufferWriter.h"
+#include "plugin/flusher/sls/FlusherSLS.h"
+#include "plugin/flusher/sls/SLSClientManager.h"
+#include "sdk/Common.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(buffer_file_send_concurrency);
+DECLARE_FLAG_INT32(default_local_file_size);
+DECLARE_FLAG_INT32(default_send_byte_per_sec);
+DECLARE_FLAG_INT32(discard_send_fail_interval);
+DECLARE_FLAG_INT32(send_retry_sleep_interval);
+DECLARE_FLAG_INT32(quota_exceed_wait_interval);
+DECLARE_FLAG_INT32(unauthorized_wait_interval);
+
+using namespace std;
+
+namespace logtail {
+
+// a stub of the SLS server, which replies to the requests only when @mBatchSize of them are pending, so that requests
+// not sent concurrently time out
+class StubSLSServer {
+public:
+    explicit StubSLSServer(size_t batchSize) : mBatchSize(batchSize) {
+        mListenFd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(mListenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(mListenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+        mPort = ntohs(addr.sin_port);
+        listen(mListenFd, 16);
+        mThread = thread([this]() { Run(); });
+    }
+
+    ~StubSLSServer() {
+        mStop = true;
+        shutdown(mListenFd, SHUT_RDWR);
+        close(mListenFd);
+        mThread.join();
+    }
+
+    // requests to @logstore are replied with @statusCode and @errorCode, others with 200
+    void SetResponse(const string& logstore, int statusCode, const string& errorCode) {
+        lock_guard<mutex> lock(mMux);
+        mResponses[logstore] = make_pair(statusCode, errorCode);
+    }
+
+    int32_t GetPort() const { return mPort; }
+    size_t GetRequestCnt() const { return mRequestCnt; }
+
+private:
+    void Run() {
+        vector<pair<int, string>> pending;
+        while (!mStop) {
+            int fd = accept(mListenFd, nullptr, nullptr);
+            if (fd < 0) {
+                continue;
+            }
+            string request;
+            char buf[4096];
+            size_t headerEnd = string::npos;
+            size_t contentLength = 0;
+            while (true) {
+                ssize_t n = recv(fd, buf, sizeof(buf), 0);
+                if (n <= 0) {
+                    break;
+                }
+                request.append(buf, n);
+                if (headerEnd == string::npos && (headerEnd = request.find("\r\n\r\n")) != string::npos) {
+                    auto pos = request.find("Content-Length:");
+                    if (pos != string::npos && pos < headerEnd) {
+                        contentLength = stoul(request.substr(pos + 15, headerEnd - pos - 15));
+                    }
+                }
+                if (headerEnd != string::npos && request.size() >= headerEnd + 4 + contentLength) {
+                    break;
+                }
+            }
+            ++mRequestCnt;
+            // request line: POST /logstores/<logstore>/shards/lb HTTP/1.1
+            string logstore;
+            auto pos = request.find("/logstores/");
+            if (pos != string::npos) {
+                pos += 11;
+                logstore = request.substr(pos, request.find_first_of("/? ", pos) - pos);
+            }
+            pending.emplace_back(fd, logstore);
+            if (pending.size() < mBatchSize) {
+                continue;
+            }
+            for (const auto& item : pending) {
+                Reply(item.first, item.second);
+            }
+            pending.clear();
+        }
+        for (const auto& item : pending) {
+            close(item.first);
+        }
+    }
+
+    void Reply(int fd, const string& logstore) {
+        int statusCode = 200;
+        string body;
+        {
+            lock_guard<mutex> lock(mMux);
+            auto iter = mResponses.find(logstore);
+            if (iter != mResponses.end()) {
+                statusCode = iter->second.first;
+                body = "{\"errorCode\":\"" + iter->second.second + "\",\"errorMessage\":\"stub error\"}";
+            }
+        }
+        string response = "HTTP/1.1 " + to_string(statusCode) + " Stub\r\n" + sdk::X_LOG_REQUEST_ID
+            + ": stub_request_id\r\nContent-Type: application/json\r\nContent-Length: " + to_string(body.size())
+            + "\r\nConnection: close\r\n\r\n" + body;
+        send(fd, response.data(), response.size(), 0);
+        close(fd);
+    }
+
+    size_t mBatchSize;
+    int mListenFd = -1;
+    int32_t mPort = 0;
+    atomic_bool mStop = false;
+    atomic_size_t mRequestCnt = 0;
+    mutex mMux;
+    map<string, pair<int, string>> mResponses;
+    thread mThread;
+};
+
+class DiskBufferWriterUnittest : public ::testing::Test {
+public:
+    void TestWriteBatch();
+    void TestSwitchFile();
+    void TestSendConcurrently();
+    void TestSendRetry();
+    void TestSendDiscard();
+    void TestSendResume();
+    void TestGetSendRetryInterval();
+    void TestSendToServer();
+
+protected:
+    void SetUp() override {
+        mRootDir = GetProcessExecutionDir();
+        if (PATH_SEPARATOR[0] == mRootDir.back())
+            mRootDir.resize(mRootDir.size() - 1);
+        mRootDir += PATH_SEPARATOR + "DiskBufferWriterUnittest";
+        bfs::remove_all(mRootDir);
+        bfs::create_directories(mRootDir);
+        mWriter->SetBufferFilePath(mRootDir);
+        // app config is not loaded in unittest, otherwise each write uses a new file and sending is throttled
+        AppConfig::GetInstance()->mLocalFileSize = INT32_FLAG(default_local_file_size);
+        AppConfig::GetInstance()->mBytePerSec = INT32_FLAG(default_send_byte_per_sec);
+
+        mFlusher.mProject = "test_project";
+        mFlusher.mRegion = "test_region";
+        mFlusher.mAliuid = "123";
+
+        // simulate the result of each record in order, nullopt meaning the record is not sent
+        mWriter->mSendBufferRecordsFunc = [this](CURLM*, const vector<DiskBufferWriter::BufferRecord*>& records) {
+            mSendBatchSizes.push_back(records.size());
+            for (auto record : records) {
+                record->mSent = true;
+                record->mSendResult = SEND_OK;
+                if (!mMockSendResults.empty()) {
+                    record->mSent = mMockSendResults.front().has_value();
+                    record->mSendResult = mMockSendResults.front().value_or(SEND_NETWORK_ERROR);
+                    mMockSendResults.pop_front();
+                }
+            }
+        };
+    }
+
+    void TearDown() override {
+        INT32_FLAG(buffer_file_send_concurrency) = mConcurrency;
+        INT32_FLAG(discard_send_fail_interval) = mDiscardInterval;
+        INT32_FLAG(send_retry_sleep_interval) = mRetryInterval;
+        mWriter->mSendBufferRecordsFunc = mSendFunc;
+        mWriter->mBufferFileResumePos.clear();
+        {
+            lock_guard<mutex> lock(mWriter->mBufferSenderThreadRunningMux);
+            mWriter->mIsSendBufferThreadRunning = true;
+        }
+        mWriter->CloseBufferFile();
+        bfs::remove_all(mRootDir);
+    }
+
+private:
+    vector<SenderQueueItem*> MakeItems(size_t cnt) {
+        vector<SenderQueueItem*> items;
+        for (size_t i = 0; i < cnt; ++i) {
+            items.push_back(new SLSSenderQueueItem(
+                "data_" + to_string(mItemIdx), 100 + mItemIdx, &mFlusher, 0, "logstore_" + to_string(mItemIdx)));
+            ++mItemIdx;
+        }
+        return items;
+    }
+
+    void ReadAll(const string& filename, vector<string>& data, vector<string>& logstores) {
+        FILE* fin = FileReadOnlyOpen(filename.c_str(), "rb");
+        APSARA_TEST_NOT_EQUAL_FATAL(nullptr, fin);
+        int32_t pos = INT32_FLAG(file_encryption_header_length);
+        string encryption;
+        DiskBufferWriter::EncryptionStateMeta meta;
+        bool readResult = false;
+        sls_logs::LogtailBufferMeta bufferMeta;
+        while (mWriter->ReadNextEncryption(pos, fin, filename, encryption, meta, readResult, bufferMeta)) {
+            APSARA_TEST_TRUE(readResult);
+            unique_ptr<char[]> des(new char[meta.mLogDataSize]);
+            APSARA_TEST_TRUE(FileEncryption::GetInstance()->Decrypt(
+                encryption.c_str(),
+                meta.mEncryptionSize,
+                des.get(),
+                meta.mLogDataSize,
+                FileEncryption::GetInstance()->GetDefaultKeyVersion()));
+            data.emplace_back(des.get(), meta.mLogDataSize);
+            logstores.push_back(bufferMeta.logstore());
+            APSARA_TEST_EQUAL("test_project", bufferMeta.project());
+            APSARA_TEST_EQUAL("test_region", bufferMeta.endpoint());
+            APSARA_TEST_EQUAL("123", bufferMeta.aliuid());
+        }
+        fclose(fin);
+    }
+
+    // write @cnt records to a new buffer file and return the positions of them
+    string WriteBufferFile(size_t cnt, vector<int32_t>& positions) {
+        positions.clear();
+        auto items = MakeItems(cnt);
+        APSARA_TEST_TRUE(mWriter->SendToBufferFile(items));
+        DeleteItems(items);
+        string filename = mWriter->GetBufferFileName();
+        mWriter->CloseBufferFile();
+
+        FILE* fin = FileReadOnlyOpen(filename.c_str(), "rb");
+        APSARA_TEST_NOT_EQUAL(nullptr, fin);
+        if (fin == nullptr) {
+            return filename;
+        }
+        int32_t pos = INT32_FLAG(file_encryption_header_length);
+        string encryption;
+        DiskBufferWriter::EncryptionStateMeta meta;
+        bool readResult = false;
+        sls_logs::LogtailBufferMeta bufferMeta;
+        while (true) {
+            int32_t recordPos = pos;
+            if (!mWriter->ReadNextEncryption(pos, fin, filename, encryption, meta, readResult, bufferMeta)) {
+                break;
+            }
+            positions.push_back(recordPos);
+        }
+        fclose(fin);
+        APSARA_TEST_EQUAL(cnt, positions.size());
+        return filename;
+    }
+
+    void SendBufferFile(const string& filename) {
+        mWriter->SendEncryptionBuffer(filename, FileEncryption::GetInstance()->GetDefaultKeyVersion());
+    }
+
+    void DeleteItems(vector<SenderQueueItem*>& items) {
+        for (auto item : items) {
+            delete item;
+        }
+        items.clear();
+    }
+
+    DiskBufferWriter* mWriter = DiskBufferWriter::GetInstance();
+    decltype(mWriter->mSendBufferRecordsFunc) mSendFunc = mWriter->mSendBufferRecordsFunc;
+    // size of each batch sent, and the result of each record in order
+    vector<size_t> mSendBatchSizes;
+    deque<optional<SendResult>> mMockSendResults;
+    FlusherSLS mFlusher;
+    string mRootDir;
+    size_t mItemIdx = 0;
+    int32_t mConcurrency = INT32_FLAG(buffer_file_send_concurrency);
+    int32_t mDiscardInterval = INT32_FLAG(discard_send_fail_interval);
+    int32_t mRetryInterval = INT32_FLAG(send_retry_sleep_interval);
+};
+
+void DiskBufferWriterUnittest::TestWriteBatch() {
+    auto items = MakeItems(3);
+    APSARA_TEST_TRUE(mWriter->SendToBufferFile(items));
+    DeleteItems(items);
+    string filename = mWriter->GetBufferFileName();
+    // the file is kept open for the following batches
+    APSARA_TEST_NOT_EQUAL(nullptr, mWriter->mBufferFile);
+    APSARA_TEST_EQUAL(filename, mWriter->mOpenedBufferFileName);
+
+    items = MakeItems(2);
+    APSARA_TEST_TRUE(mWriter->SendToBufferFile(items));
+    DeleteItems(items);
+    APSARA_TEST_EQUAL(filename, mWriter->GetBufferFileName());
+
+    vector<string> data, logstores;
+    ReadAll(filename, data, logstores);
+    APSARA_TEST_EQUAL(5U, data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        APSARA_TEST_EQUAL("data_" + to_string(i), data[i]);
+        APSARA_TEST_EQUAL("logstore_" + to_string(i), logstores[i]);
+    }
+    APSARA_TEST_EQUAL(mWriter->mBufferFileSize, static_cast<int64_t>(bfs::file_size(filename)));
+}
+
+void DiskBufferWriterUnittest::TestSwitchFile() {
+    auto items = MakeItems(1);
+    APSARA_TEST_TRUE(mWriter->SendToBufferFile(items));
+    DeleteItems(items);
+    string filename = mWriter->GetBufferFileName();
+
+    // the opened file is closed once a new file is to be used
+    mWriter->SetBufferFileName(filename + "_new");
+    items = MakeItems(1);
+    APSARA_TEST_TRUE(mWriter->SendToBufferFile(items));
+    DeleteItems(items);
+    APSARA_TEST_EQUAL(filename + "_new", mWriter->mOpenedBufferFileName);
+
+    vector<string> data, logstores;
+    ReadAll(filename, data, logstores);
+    APSARA_TEST_EQUAL(1U, data.size());
+    data.clear();
+    logstores.clear();
+    ReadAll(filename + "_new", data, logstores);
+    APSARA_TEST_EQUAL(1U, data.size());
+}
+
+void DiskBufferWriterUnittest::TestSendConcurrently() {
+    INT32_FLAG(buffer_file_send_concurrency) = 2;
+    vector<int32_t> positions;
+    string filename = WriteBufferFile(5, positions);
+
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(vector<size_t>({2, 2, 1}), mSendBatchSizes);
+    APSARA_TEST_FALSE(CheckExistance(filename));
+    APSARA_TEST_EQUAL(0U, mWriter->mBufferFileResumePos.size());
+}
+
+void DiskBufferWriterUnittest::TestSendRetry() {
+    INT32_FLAG(buffer_file_send_concurrency) = 2;
+    INT32_FLAG(send_retry_sleep_interval) = 1000;
+    vector<int32_t> positions;
+    string filename = WriteBufferFile(2, positions);
+
+    // only the failed record is sent again
+    mMockSendResults = {SEND_OK, SEND_NETWORK_ERROR, SEND_QUOTA_EXCEED, SEND_OK};
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(vector<size_t>({2, 1, 1}), mSendBatchSizes);
+    APSARA_TEST_FALSE(CheckExistance(filename));
+
+    // retry is interrupted once the sender is stopped, and the failed record is left for the next replay
+    filename = WriteBufferFile(1, positions);
+    mSendBatchSizes.clear();
+    mMockSendResults = {SEND_SERVER_ERROR};
+    {
+        lock_guard<mutex> lock(mWriter->mBufferSenderThreadRunningMux);
+        mWriter->mIsSendBufferThreadRunning = false;
+    }
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(vector<size_t>({1}), mSendBatchSizes);
+    APSARA_TEST_TRUE(CheckExistance(filename));
+    APSARA_TEST_EQUAL(positions.back(), mWriter->mBufferFileResumePos[filename]);
+}
+
+void DiskBufferWriterUnittest::TestSendDiscard() {
+    INT32_FLAG(discard_send_fail_interval) = 0;
+    vector<int32_t> positions;
+    string filename = WriteBufferFile(2, positions);
+
+    // records failed for too long are discarded without retry
+    mMockSendResults = {SEND_SERVER_ERROR, SEND_UNAUTHORIZED};
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(vector<size_t>({2}), mSendBatchSizes);
+    APSARA_TEST_FALSE(CheckExistance(filename));
+
+    // records with non-retryable errors are discarded
+    filename = WriteBufferFile(2, positions);
+    mSendBatchSizes.clear();
+    mMockSendResults = {SEND_DISCARD_ERROR, SEND_PARAMETER_INVALID};
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(vector<size_t>({2}), mSendBatchSizes);
+    APSARA_TEST_FALSE(CheckExistance(filename));
+}
+
+void DiskBufferWriterUnittest::TestSendResume() {
+    INT32_FLAG(buffer_file_send_concurrency) = 2;
+    vector<int32_t> positions;
+    string filename = WriteBufferFile(4, positions);
+
+    // records not sent, e.g. no endpoint is available, are left for the next replay
+    mMockSendResults = {SEND_OK, SEND_OK, nullopt, nullopt};
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(vector<size_t>({2, 2}), mSendBatchSizes);
+    APSARA_TEST_TRUE(CheckExistance(filename));
+    APSARA_TEST_EQUAL(positions[2], mWriter->mBufferFileResumePos[filename]);
+
+    // the next replay starts from the resume position
+    mSendBatchSizes.clear();
+    mMockSendResults = {SEND_OK, nullopt};
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(vector<size_t>({2}), mSendBatchSizes);
+    APSARA_TEST_EQUAL(positions[3], mWriter->mBufferFileResumePos[filename]);
+
+    // the resume position is persisted in the file header and used after restart, so that records before it are not
+    // read again even if they were not marked as handled
+    FILE* fin = FileReadOnlyOpen(filename.c_str(), "rb");
+    APSARA_TEST_NOT_EQUAL_FATAL(nullptr, fin);
+    APSARA_TEST_EQUAL(positions[3], mWriter->ReadResumePos(fin));
+    fclose(fin);
+    int32_t handled = 0;
+    auto handledPos = positions[2] + static_cast<int32_t>(offsetof(DiskBufferWriter::EncryptionStateMeta, mHandled));
+    mWriter->WriteBackMeta(handledPos, &handled, sizeof(handled), filename);
+    mWriter->mBufferFileResumePos.clear();
+    mSendBatchSizes.clear();
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(vector<size_t>({1}), mSendBatchSizes);
+    APSARA_TEST_FALSE(CheckExistance(filename));
+    APSARA_TEST_EQUAL(0U, mWriter->mBufferFileResumePos.size());
+}
+
+void DiskBufferWriterUnittest::TestGetSendRetryInterval() {
+    DiskBufferWriter::BufferRecord networkError, quotaExceed, unauthorized;
+    networkError.mSendResult = SEND_NETWORK_ERROR;
+    quotaExceed.mSendResult = SEND_QUOTA_EXCEED;
+    unauthorized.mSendResult = SEND_UNAUTHORIZED;
+    INT32_FLAG(send_retry_sleep_interval) = 10;
+    int32_t quotaInterval = INT32_FLAG(quota_exceed_wait_interval);
+    int32_t unauthorizedInterval = INT32_FLAG(unauthorized_wait_interval);
+    INT32_FLAG(quota_exceed_wait_interval) = 100;
+    INT32_FLAG(unauthorized_wait_interval) = 50;
+
+    APSARA_TEST_EQUAL(10, DiskBufferWriter::GetSendRetryInterval({&networkError}));
+    APSARA_TEST_EQUAL(50, DiskBufferWriter::GetSendRetryInterval({&networkError, &unauthorized}));
+    APSARA_TEST_EQUAL(100, DiskBufferWriter::GetSendRetryInterval({&unauthorized, &quotaExceed}));
+
+    INT32_FLAG(quota_exceed_wait_interval) = quotaInterval;
+    INT32_FLAG(unauthorized_wait_interval) = unauthorizedInterval;
+}
+
+void DiskBufferWriterUnittest::TestSendToServer() {
+    mWriter->mSendBufferRecordsFunc = mSendFunc;
+    INT32_FLAG(buffer_file_send_concurrency) = 4;
+    StubSLSServer server(4);
+    auto client = SLSClientManager::GetInstance()->GetClient("test_region", "123");
+    client->SetSlsHost("127.0.0.1");
+    client->SetPort(server.GetPort());
+
+    // records of one batch are sent concurrently, and the response of each record is parsed
+    server.SetResponse("server_error", 500, sdk::LOGE_INTERNAL_SERVER_ERROR);
+    server.SetResponse("quota_exceed", 403, sdk::LOGE_WRITE_QUOTA_EXCEED);
+    server.SetResponse("parameter_invalid", 400, sdk::LOGE_PARAMETER_INVALID);
+    vector<string> logstores = {"ok", "server_error", "quota_exceed", "parameter_invalid"};
+    vector<DiskBufferWriter::BufferRecord> records(logstores.size());
+    vector<DiskBufferWriter::BufferRecord*> batch;
+    for (size_t i = 0; i < records.size(); ++i) {
+        auto& bufferMeta = records[i].mBufferMeta;
+        bufferMeta.set_project("test_project");
+        bufferMeta.set_endpoint("test_region");
+        bufferMeta.set_aliuid("123");
+        bufferMeta.set_logstore(logstores[i]);
+        bufferMeta.set_datatype(int(RawDataType::EVENT_GROUP));
+        bufferMeta.set_rawsize(100);
+        bufferMeta.set_compresstype(sls_logs::SLS_CMP_NONE);
+        records[i].mItem = make_unique<SenderQueueItem>("data_" + to_string(i), 100, nullptr, 0);
+        batch.push_back(&records[i]);
+    }
+    CURLM* multi = curl_multi_init();
+    mWriter->SendBufferRecordsOnce(multi, batch);
+    curl_multi_cleanup(multi);
+    APSARA_TEST_EQUAL(4U, server.GetRequestCnt());
+    vector<SendResult> expectedResults = {SEND_OK, SEND_SERVER_ERROR, SEND_QUOTA_EXCEED, SEND_PARAMETER_INVALID};
+    for (size_t i = 0; i < records.size(); ++i) {
+        APSARA_TEST_TRUE(records[i].mSent);
+        APSARA_TEST_EQUAL(expectedResults[i], records[i].mSendResult);
+    }
+    APSARA_TEST_EQUAL(string(sdk::LOGE_INTERNAL_SERVER_ERROR), records[1].mErrorCode);
+
+    // buffer file is removed once all records are sent successfully
+    vector<int32_t> positions;
+    string filename = WriteBufferFile(4, positions);
+    SendBufferFile(filename);
+    APSARA_TEST_EQUAL(8U, server.GetRequestCnt());
+    APSARA_TEST_FALSE(CheckExistance(filename));
+}
+
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestWriteBatch)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestSwitchFile)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestSendConcurrently)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestSendRetry)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestSendDiscard)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestSendResume)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestGetSendRetryInterval)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestSendToServer)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -13,9 +13,17 @@
 // limitations under the License.
 
 #include "unittest/Unittest.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <memory>
+#include <thread>
 #include <vector>
+#include "common/http/AsynCurlRunner.h"
 #include "metadata/LabelingK8sMetadata.h"
 #include "metadata/K8sMetadata.h"
 #include "models/PipelineEventGroup.h"
@@ -23,6 +31,79 @@
 using namespace std;
 
 namespace logtail {
+
+// a stub of the k8s meta service, which replies @mBody to every request after @mDelayMs
+class StubK8sMetaServer {
+public:
+    StubK8sMetaServer(const string& body, int delayMs) : mBody(body), mDelayMs(delayMs) {
+        mListenFd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(mListenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(mListenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+        mPort = ntohs(addr.sin_port);
+        listen(mListenFd, 16);
+        mThread = thread([this]() { Run(); });
+    }
+
+    ~StubK8sMetaServer() {
+        mStop = true;
+        shutdown(mListenFd, SHUT_RDWR);
+        close(mListenFd);
+        mThread.join();
+    }
+
+    int32_t GetPort() const { return mPort; }
+    size_t GetRequestCnt() const { return mRequestCnt; }
+
+private:
+    void Run() {
+        while (!mStop) {
+            int fd = accept(mListenFd, nullptr, nullptr);
+            if (fd < 0) {
+                continue;
+            }
+            string request;
+            char buf[4096];
+            size_t headerEnd = string::npos;
+            size_t contentLength = 0;
+            while (true) {
+                ssize_t n = recv(fd, buf, sizeof(buf), 0);
+                if (n <= 0) {
+                    break;
+                }
+                request.append(buf, n);
+                if (headerEnd == string::npos && (headerEnd = request.find("\r\n\r\n")) != string::npos) {
+                    auto pos = request.find("Content-Length:");
+                    if (pos != string::npos && pos < headerEnd) {
+                        contentLength = stoul(request.substr(pos + 15, headerEnd - pos - 15));
+                    }
+                }
+                if (headerEnd != string::npos && request.size() >= headerEnd + 4 + contentLength) {
+                    break;
+                }
+            }
+            ++mRequestCnt;
+            this_thread::sleep_for(chrono::milliseconds(mDelayMs));
+            string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: "
+                + to_string(mBody.size()) + "\r\nConnection: close\r\n\r\n" + mBody;
+            send(fd, response.data(), response.size(), 0);
+            close(fd);
+        }
+    }
+
+    string mBody;
+    int mDelayMs;
+    int mListenFd = -1;
+    int32_t mPort = 0;
+    atomic_bool mStop = false;
+    atomic_size_t mRequestCnt = 0;
+    thread mThread;
+};
+
 class k8sMetadataUnittest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -50,7 +131,12 @@ public:
         }
         auto& k8sMetadata = K8sMetadata::GetInstance();
         k8sMetadata.SetContainerCache(root);
+        // the request is sent to a local stub rather than a real k8s meta service
+        StubK8sMetaServer server("{}", 0);
+        k8sMetadata.mServiceHost = "127.0.0.1";
+        k8sMetadata.mServicePort = server.GetPort();
         k8sMetadata.GetByLocalHostFromServer();
+        APSARA_TEST_EQUAL(2U, server.GetRequestCnt());
         
         // Assume GetInfoByContainerIdFromCache returns non-null shared_ptr for valid IDs,
         // and check for some expectations.
@@ -259,7 +345,12 @@ public:
 
         auto& k8sMetadata = K8sMetadata::GetInstance();
         k8sMetadata.SetIpCache(root);
+        // the request is sent to a local stub rather than a real k8s meta service
+        StubK8sMetaServer server("{}", 0);
+        k8sMetadata.mServiceHost = "127.0.0.1";
+        k8sMetadata.mServicePort = server.GetPort();
         k8sMetadata.GetByLocalHostFromServer();
+        APSARA_TEST_EQUAL(2U, server.GetRequestCnt());
         unique_ptr<SpanEvent> mSpanEvent;
         auto sourceBuffer = std::make_shared<SourceBuffer>();
         PipelineEventGroup eventGroup(sourceBuffer);
@@ -373,7 +464,12 @@ public:
 
         auto& k8sMetadata = K8sMetadata::GetInstance();
         k8sMetadata.SetIpCache(root);
+        // the request is sent to a local stub rather than a real k8s meta service
+        StubK8sMetaServer server("{}", 0);
+        k8sMetadata.mServiceHost = "127.0.0.1";
+        k8sMetadata.mServicePort = server.GetPort();
         k8sMetadata.GetByLocalHostFromServer();
+        APSARA_TEST_EQUAL(2U, server.GetRequestCnt());
         
         auto sourceBuffer = std::make_shared<SourceBuffer>();
         PipelineEventGroup eventGroup(sourceBuffer);
@@ -415,12 +511,66 @@ public:
         APSARA_TEST_EQUAL("kube-proxy-worker", metricEvent.GetTag("peerWorkloadName").to_string());
         APSARA_TEST_TRUE_FATAL(k8sMetadata.GetInfoByIpFromCache("10.41.0.2") != nullptr);
     }
+
+    void TestAsyncFetchNotBlocking() {
+        LOG_INFO(sLogger, ("TestAsyncFetchNotBlocking() begin", time(NULL)));
+        const string knownId = "containerd://async-known";
+        const string unknownId = "containerd://async-unknown";
+        const string body = R"({"containerd://async-known":{"namespace":"default","workloadName":"async-demo",)"
+                            R"("workloadKind":"deployment","serviceName":"","labels":{},"images":{}}})";
+        StubK8sMetaServer server(body, 1000);
+
+        auto& k8sMetadata = K8sMetadata::GetInstance();
+        k8sMetadata.mServiceHost = "127.0.0.1";
+        k8sMetadata.mServicePort = server.GetPort();
+        k8sMetadata.containerCache.remove(knownId);
+
+        auto createGroup = [&]() {
+            PipelineEventGroup eventGroup(make_shared<SourceBuffer>());
+            for (const auto& id : {knownId, unknownId}) {
+                auto e = eventGroup.AddMetricEvent();
+                e->SetName("test");
+                e->SetTag(containerIdKey, id);
+            }
+            return eventGroup;
+        };
+        LabelingK8sMetadata processor;
+
+        // the processor thread is not blocked by the slow server, and concurrent lookups are coalesced
+        for (size_t i = 0; i < 3; ++i) {
+            auto eventGroup = createGroup();
+            auto start = chrono::steady_clock::now();
+            processor.AddLabelToLogGroup(eventGroup);
+            APSARA_TEST_TRUE(chrono::steady_clock::now() - start < chrono::milliseconds(200));
+            APSARA_TEST_FALSE(eventGroup.GetEvents()[0].Cast<MetricEvent>().HasTag(workloadNameKey));
+        }
+        for (size_t i = 0; i < 50 && k8sMetadata.GetInfoByContainerIdFromCache(knownId) == nullptr; ++i) {
+            this_thread::sleep_for(chrono::milliseconds(100));
+        }
+        this_thread::sleep_for(chrono::milliseconds(100));
+        APSARA_TEST_EQUAL(1U, server.GetRequestCnt());
+
+        // known id is labeled in later batches, and unknown id is not requested again within ttl
+        auto eventGroup = createGroup();
+        processor.AddLabelToLogGroup(eventGroup);
+        APSARA_TEST_EQUAL("async-demo",
+                          eventGroup.GetEvents()[0].Cast<MetricEvent>().GetTag(workloadNameKey).to_string());
+        APSARA_TEST_FALSE(eventGroup.GetEvents()[1].Cast<MetricEvent>().HasTag(workloadNameKey));
+        this_thread::sleep_for(chrono::milliseconds(200));
+        APSARA_TEST_EQUAL(1U, server.GetRequestCnt());
+        APSARA_TEST_TRUE(k8sMetadata.mPendingKeys[0].empty());
+        APSARA_TEST_EQUAL(1U, k8sMetadata.mNegativeCache[0].count(unknownId));
+
+        k8sMetadata.Stop();
+        APSARA_TEST_FALSE(k8sMetadata.mIsCurlRunnerStarted);
+    }
 };
 
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestGetByContainerIds, 0);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestGetByLocalHost, 1);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestAddLabelToMetric, 2);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestAddLabelToSpan, 3);
+APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestAsyncFetchNotBlocking, 4);
 
 
 
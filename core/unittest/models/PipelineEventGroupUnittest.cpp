@@ -34,6 +34,7 @@ public:
     void TestDestructor();
     void TestSetMetadata();
     void TestDelMetadata();
+    void TestMetadataTime();
     void TestFromJsonToJson();
 
 protected:
@@ -253,6 +254,19 @@ void PipelineEventGroupUnittest::TestDelMetadata() {
     APSARA_TEST_FALSE_FATAL(mEventGroup->HasMetadata(EventGroupMetaKey::LOG_FILE_INODE));
 }
 
+void PipelineEventGroupUnittest::TestMetadataTime() {
+    APSARA_TEST_EQUAL(std::chrono::system_clock::time_point(),
+                      mEventGroup->GetMetadataTime(EventGroupMetaKey::READ_TIMESTAMP_MICROSEC));
+    auto now = std::chrono::system_clock::now();
+    mEventGroup->SetMetadataTime(EventGroupMetaKey::READ_TIMESTAMP_MICROSEC, now);
+    APSARA_TEST_EQUAL(std::chrono::time_point_cast<std::chrono::microseconds>(now),
+                      mEventGroup->GetMetadataTime(EventGroupMetaKey::READ_TIMESTAMP_MICROSEC));
+    // invalid value
+    mEventGroup->SetMetadata(EventGroupMetaKey::PROCESS_TIMESTAMP_MICROSEC, std::string("abc"));
+    APSARA_TEST_EQUAL(std::chrono::system_clock::time_point(),
+                      mEventGroup->GetMetadataTime(EventGroupMetaKey::PROCESS_TIMESTAMP_MICROSEC));
+}
+
 void PipelineEventGroupUnittest::TestFromJsonToJson() {
     std::string inJson = R"({
         "events" :
@@ -301,6 +315,7 @@ UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCopy)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDestructor)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSetMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDelMetadata)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestMetadataTime)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestFromJsonToJson)
 
 } // namespace logtail
@@ -39,11 +39,15 @@ public:
     void TestCreateMetricAutoDelete();
     void TestCreateMetricAutoDeleteMultiThread();
     void TestCreateAndDeleteMetric();
+    void TestCounterMultiThread();
+    void TestHistogramBuckets();
 };
 
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDelete, 0);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDeleteMultiThread, 1);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateAndDeleteMetric, 2);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCounterMultiThread, 3);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestHistogramBuckets, 4);
 
 
 void MetricManagerUnittest::TestCreateMetricAutoDelete() {
@@ -320,6 +324,62 @@ void MetricManagerUnittest::TestCreateAndDeleteMetric() {
     delete fileMetric1;
 }
 
+void MetricManagerUnittest::TestCounterMultiThread() {
+    Counter counter("counter", 1);
+    TimeCounter timeCounter("time_counter");
+    // counters only added by one thread are not sharded
+    counter.Add(1);
+    APSARA_TEST_FALSE(counter.IsSharded());
+    APSARA_TEST_EQUAL(2U, counter.GetValue());
+    // more threads than shards, so that some shards are shared
+    const size_t threadCnt = Counter::kShardCnt * 2 + 1;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < 10000; ++j) {
+                counter.Add(1);
+                timeCounter.Add(std::chrono::microseconds(1));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_TRUE(counter.IsSharded());
+    APSARA_TEST_EQUAL(threadCnt * 10000 + 2, counter.GetValue());
+    APSARA_TEST_EQUAL(threadCnt * 10, timeCounter.GetValue());
+
+    std::unique_ptr<Counter> collected(counter.Collect());
+    APSARA_TEST_FALSE(collected->IsSharded());
+    APSARA_TEST_EQUAL(threadCnt * 10000 + 2, collected->GetValue());
+    APSARA_TEST_EQUAL(0U, counter.GetValue());
+    std::unique_ptr<TimeCounter> collectedTime(timeCounter.Collect());
+    APSARA_TEST_EQUAL(threadCnt * 10, collectedTime->GetValue());
+    APSARA_TEST_EQUAL(0U, timeCounter.GetValue());
+}
+
+void MetricManagerUnittest::TestHistogramBuckets() {
+    // buckets are contiguous and each value falls into the bucket containing it
+    APSARA_TEST_EQUAL(0U, Histogram::GetBucketBounds(0).first);
+    for (size_t i = 1; i < Histogram::kBucketCnt; ++i) {
+        APSARA_TEST_EQUAL_FATAL(Histogram::GetBucketBounds(i - 1).second, Histogram::GetBucketBounds(i).first);
+    }
+    for (uint64_t us : {0UL, 1UL, 3UL, 4UL, 7UL, 8UL, 9UL, 1000UL, 123456UL, (1UL << 32) - 1}) {
+        auto bounds = Histogram::GetBucketBounds(Histogram::GetBucketIdx(us));
+        APSARA_TEST_TRUE_FATAL(bounds.first <= us && us < bounds.second);
+    }
+    APSARA_TEST_EQUAL(Histogram::kBucketCnt - 1, Histogram::GetBucketIdx(1UL << 40));
+
+    Histogram histogram("histogram");
+    histogram.Add(std::chrono::microseconds(5));
+    histogram.Add(std::chrono::microseconds(5));
+    histogram.Add(std::chrono::nanoseconds(-1));
+    std::unique_ptr<Histogram> collected(histogram.Collect());
+    APSARA_TEST_EQUAL(2U, collected->GetBucketCnt(Histogram::GetBucketIdx(5)));
+    APSARA_TEST_EQUAL(1U, collected->GetBucketCnt(0));
+    APSARA_TEST_EQUAL(0U, histogram.GetBucketCnt(Histogram::GetBucketIdx(5)));
+}
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
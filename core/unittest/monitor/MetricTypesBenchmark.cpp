@@ -0,0 +1,76 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "monitor/metric_models/MetricTypes.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// all threads add to the same counter, as processor threads do to pipeline and plugin counters. A single atomic
+// updated with seq_cst fetch_add, as Counter did before sharding, is measured as the baseline.
+class MetricTypesBenchmark : public ::testing::Test {
+public:
+    void TestCounterAdd();
+
+private:
+    template <typename F>
+    double Run(size_t threadCnt, F&& add);
+
+    const size_t mAddCntPerThread = 10000000;
+};
+
+template <typename F>
+double MetricTypesBenchmark::Run(size_t threadCnt, F&& add) {
+    vector<thread> threads;
+    auto start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < mAddCntPerThread; ++j) {
+                add();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    return threadCnt * mAddCntPerThread / elapsed.count();
+}
+
+void MetricTypesBenchmark::TestCounterAdd() {
+    for (size_t threadCnt : {1, 2, 4, 8, 16, 32}) {
+        atomic_uint64_t single(0);
+        double singleRate = Run(threadCnt, [&]() { single.fetch_add(1); });
+        Counter counter("counter");
+        double shardedRate = Run(threadCnt, [&]() { counter.Add(1); });
+
+        APSARA_TEST_EQUAL(single.load(), counter.GetValue());
+        cout << "threads: " << threadCnt << "\tsingle atomic adds/s: " << singleRate
+             << "\tcounter adds/s: " << shardedRate << "\tsharded: " << counter.IsSharded() << endl;
+    }
+}
+
+UNIT_TEST_CASE(MetricTypesBenchmark, TestCounterAdd)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -27,6 +27,7 @@ public:
     void TestCreateFromGoMetricMap();
     void TestMerge();
     void TestSendInterval();
+    void TestHistogram();
 
 private:
     std::shared_ptr<SourceBuffer> mSourceBuffer;
@@ -38,6 +39,7 @@ APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestCreateFromMetricEvent,
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestCreateFromGoMetricMap, 1);
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestMerge, 2);
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestSendInterval, 3);
+APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestHistogram, 4);
 
 void SelfMonitorMetricEventUnittest::TestCreateFromMetricEvent() {
     std::vector<std::pair<std::string, std::string>> labels;
@@ -198,6 +200,51 @@ void SelfMonitorMetricEventUnittest::TestSendInterval() {
     APSARA_TEST_TRUE(event.ShouldDelete()); // 第三次调用，间隔计数达到3，应返回true
 }
 
+void SelfMonitorMetricEventUnittest::TestHistogram() {
+    MetricsRecord record(MetricCategory::METRIC_CATEGORY_PIPELINE,
+                         std::make_shared<MetricLabels>(),
+                         std::make_shared<DynamicMetricLabels>());
+    HistogramPtr latency = record.CreateHistogram("latency_ms");
+    // 1ms ~ 50ms
+    for (size_t i = 1; i <= 50; ++i) {
+        latency->Add(std::chrono::milliseconds(i));
+    }
+    std::unique_ptr<MetricsRecord> snapshot1(record.Collect());
+    // 51ms ~ 100ms
+    for (size_t i = 51; i <= 100; ++i) {
+        latency->Add(std::chrono::milliseconds(i));
+    }
+    std::unique_ptr<MetricsRecord> snapshot2(record.Collect());
+
+    SelfMonitorMetricEvent event1(snapshot1.get());
+    SelfMonitorMetricEvent event2(snapshot2.get());
+    APSARA_TEST_EQUAL(1U, event1.mHistograms.size());
+    APSARA_TEST_EQUAL(Histogram::kBucketCnt, event1.mHistograms["latency_ms"].size());
+    event1.Merge(event2);
+
+    mSourceBuffer.reset(new SourceBuffer);
+    mEventGroup.reset(new PipelineEventGroup(mSourceBuffer));
+    mMetricEvent = mEventGroup->CreateMetricEvent();
+    event1.ReadAsMetricEvent(mMetricEvent.get());
+    auto values = mMetricEvent->GetValue<UntypedMultiDoubleValues>();
+    double val = 0;
+    APSARA_TEST_TRUE(values->GetValue("latency_ms_count", val));
+    APSARA_TEST_EQUAL(100, val);
+    // quantiles are accurate to within 25%
+    APSARA_TEST_TRUE(values->GetValue("latency_ms_p50", val));
+    APSARA_TEST_TRUE(val >= 50 * 0.75 && val <= 50 * 1.25);
+    APSARA_TEST_TRUE(values->GetValue("latency_ms_p90", val));
+    APSARA_TEST_TRUE(val >= 90 * 0.75 && val <= 90 * 1.25);
+    APSARA_TEST_TRUE(values->GetValue("latency_ms_p99", val));
+    APSARA_TEST_TRUE(val >= 99 * 0.75 && val <= 99 * 1.25);
+
+    // buckets are cleared after read
+    mMetricEvent = mEventGroup->CreateMetricEvent();
+    event1.ReadAsMetricEvent(mMetricEvent.get());
+    APSARA_TEST_TRUE(mMetricEvent->GetValue<UntypedMultiDoubleValues>()->GetValue("latency_ms_count", val));
+    APSARA_TEST_EQUAL(0, val);
+}
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
@@ -2711,6 +2711,10 @@ void PipelineUnittest::TestProcess() const {
         = pipeline.mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
     pipeline.mProcessorsTotalProcessTimeMs
         = pipeline.mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
+    pipeline.mProcessorsProcessLatencyMs
+        = pipeline.mMetricsRecordRef.CreateHistogram(METRIC_PIPELINE_PROCESSORS_PROCESS_LATENCY_MS);
+    pipeline.mReadToProcessLatencyMs
+        = pipeline.mMetricsRecordRef.CreateHistogram(METRIC_PIPELINE_READ_TO_PROCESS_LATENCY_MS);
 
     vector<PipelineEventGroup> groups;
     groups.emplace_back(make_shared<SourceBuffer>());
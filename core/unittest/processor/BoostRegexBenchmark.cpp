@@ -18,6 +18,9 @@
 #include <iostream>
 #include <sstream>
 
+#include "common/RegexMatcher.h"
+#include "common/StringTools.h"
+#include "file_server/MultilineOptions.h"
 #include "unittest/Unittest.h"
 
 
@@ -94,6 +97,126 @@ static void BM_Regex_Search(int size, int batchSize) {
     }
 }
 
+// log of java applications, where most lines are parts of exception stack traces
+static std::vector<std::string> GenerateJavaLogLines(size_t logCnt) {
+    std::vector<std::string> lines;
+    for (size_t i = 0; i < logCnt; ++i) {
+        if (i % 4 != 0) {
+            lines.emplace_back("2024-04-07 08:02:40.873 INFO  [http-nio-8080-exec-" + std::to_string(i % 16)
+                               + "] com.example.myproject.BookController - GET /api/v1/books?id=" + std::to_string(i));
+            continue;
+        }
+        lines.emplace_back("2024-04-07 08:02:40.873 ERROR [http-nio-8080-exec-" + std::to_string(i % 16)
+                           + "] com.example.myproject.BookController - request failed");
+        lines.emplace_back("java.lang.IllegalStateException: book " + std::to_string(i) + " not found");
+        for (size_t j = 0; j < 20; ++j) {
+            lines.emplace_back("\tat com.example.myproject.layer" + std::to_string(j)
+                               + ".Service.handle(Service.java:" + std::to_string(100 + j) + ")");
+        }
+        lines.emplace_back("Caused by: java.lang.NullPointerException: null");
+        lines.emplace_back("\tat com.example.myproject.Book.getTitle(Book.java:16)");
+        lines.emplace_back("\t... 20 more");
+    }
+    return lines;
+}
+
+// patterns are evaluated in the order they are checked for lines of a partial log, i.e. continue, end and start
+static void BM_Multiline(const std::string& name,
+                         const std::string& startPattern,
+                         const std::string& continuePattern,
+                         const std::string& endPattern,
+                         int batchSize) {
+    Json::Value config;
+    config["Multiline"]["StartPattern"] = startPattern;
+    config["Multiline"]["ContinuePattern"] = continuePattern;
+    config["Multiline"]["EndPattern"] = endPattern;
+    PipelineContext ctx;
+    MultilineOptions multiline;
+    if (!multiline.Init(config, ctx, "benchmark")) {
+        std::cout << "init multiline options failed" << std::endl;
+        return;
+    }
+    std::vector<std::shared_ptr<RegexMatcher>> regs = {
+        multiline.GetContinuePatternReg(), multiline.GetEndPatternReg(), multiline.GetStartPatternReg()};
+
+    std::vector<std::string> lines = GenerateJavaLogLines(1000);
+    size_t totalSize = 0;
+    for (const auto& line : lines) {
+        totalSize += line.size();
+    }
+    std::string exception;
+
+    size_t boostMatched = 0;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < batchSize; ++i) {
+        for (const auto& line : lines) {
+            for (const auto& reg : regs) {
+                if (reg && BoostRegexSearch(line.data(), line.size(), reg->GetBoostRegex(), exception)) {
+                    ++boostMatched;
+                    break;
+                }
+            }
+        }
+    }
+    uint64_t boostDuration = GetCurrentTimeInMicroSeconds() - startTime;
+
+    size_t matcherMatched = 0;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < batchSize; ++i) {
+        for (const auto& line : lines) {
+            for (const auto& reg : regs) {
+                if (reg && reg->Search(line, exception)) {
+                    ++matcherMatched;
+                    break;
+                }
+            }
+        }
+    }
+    uint64_t matcherDuration = GetCurrentTimeInMicroSeconds() - startTime;
+
+    if (boostMatched != matcherMatched) {
+        std::cout << "error: boost matched " << boostMatched << ", matcher matched " << matcherMatched << std::endl;
+    }
+    std::cout << name << "\tboost:\t" << formatSize(totalSize * (uint64_t)batchSize * 1000000 / boostDuration)
+              << "/s\tmatcher:\t" << formatSize(totalSize * (uint64_t)batchSize * 1000000 / matcherDuration) << "/s"
+              << std::endl;
+}
+
+static void BM_Filter(const std::string& name, const std::string& pattern, int batchSize) {
+    RegexMatcher matcher(pattern);
+    std::vector<std::string> lines = GenerateJavaLogLines(1000);
+    size_t totalSize = 0;
+    for (const auto& line : lines) {
+        totalSize += line.size();
+    }
+    std::string exception;
+
+    size_t boostMatched = 0;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < batchSize; ++i) {
+        for (const auto& line : lines) {
+            boostMatched += BoostRegexMatch(line.data(), line.size(), matcher.GetBoostRegex(), exception);
+        }
+    }
+    uint64_t boostDuration = GetCurrentTimeInMicroSeconds() - startTime;
+
+    size_t matcherMatched = 0;
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < batchSize; ++i) {
+        for (const auto& line : lines) {
+            matcherMatched += matcher.Match(line, exception);
+        }
+    }
+    uint64_t matcherDuration = GetCurrentTimeInMicroSeconds() - startTime;
+
+    if (boostMatched != matcherMatched) {
+        std::cout << "error: boost matched " << boostMatched << ", matcher matched " << matcherMatched << std::endl;
+    }
+    std::cout << name << "\tboost:\t" << formatSize(totalSize * (uint64_t)batchSize * 1000000 / boostDuration)
+              << "/s\tmatcher:\t" << formatSize(totalSize * (uint64_t)batchSize * 1000000 / matcherDuration) << "/s"
+              << std::endl;
+}
+
 int main(int argc, char** argv) {
     logtail::Logger::Instance().InitGlobalLoggers();
 #ifdef NDEBUG
@@ -105,5 +228,18 @@ int main(int argc, char** argv) {
     BM_Regex_Match(100, 10000);
     std::cout << "BM_Regex_Search" << std::endl;
     BM_Regex_Search(100, 10000);
+
+    std::cout << "BM_Multiline" << std::endl;
+    BM_Multiline("start", R"(\d+-\d+-\d+ \d+:\d+:\d+\.\d+ .*)", "", "", 100);
+    BM_Multiline("start + continue",
+                 R"(\d+-\d+-\d+ \d+:\d+:\d+\.\d+ .*)",
+                 R"((\s+at\s|\s+\.\.\. \d+ more|Caused by:|[\w.$]+(Exception|Error)).*)",
+                 "",
+                 100);
+    BM_Multiline("continue + end", "", R"(\s+at\s.*|Caused by:.*|[\w.$]+Exception.*)", R"(\s+\.\.\. \d+ more)", 100);
+    BM_Multiline("start + end (backreference)", R"((\d+)-\1.*|\d+-\d+-\d+ .*)", "", R"(\s+\.\.\. \d+ more)", 100);
+    std::cout << "BM_Filter" << std::endl;
+    BM_Filter("level", R"(\d+-\d+-\d+ \d+:\d+:\d+\.\d+ (ERROR|WARN) .*)", 100);
+    BM_Filter("keyword", R"(.*NullPointerException.*)", 100);
     return 0;
 }
\ No newline at end of file
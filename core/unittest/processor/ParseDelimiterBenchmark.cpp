@@ -0,0 +1,175 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "common/CharFinder.h"
+#include "common/TimeUtil.h"
+#include "models/LogEvent.h"
+#include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterTokenizer.h"
+#include "plugin/processor/ProcessorParseDelimiterNative.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+// an access log line with 32 columns, where columns containing separators or quotes are quoted if @quoted
+std::string GenerateAccessLogLine(const std::string& separator, bool quoted) {
+    std::string q = quoted ? "\"" : "";
+    std::string agent = quoted ? R"(Mozilla/5.0 (Macintosh, Intel Mac OS X 10_15_7) ""Chrome"")" : "Mozilla/5.0";
+    std::vector<std::string> columns = {"192.168.1.100",
+                                        "-",
+                                        "admin",
+                                        "2024-04-07T08:02:40.873+08:00",
+                                        "GET",
+                                        q + "/api/v1/books?id=12345&fields=title,author" + q,
+                                        "HTTP/1.1",
+                                        "200",
+                                        "5120",
+                                        "https://example.com/index.html",
+                                        q + agent + q,
+                                        "0.012",
+                                        "0.010",
+                                        "10.0.0.1:8080",
+                                        "4bf92f3577b34da6a3ce929d0e0e4736",
+                                        "00f067aa0ba902b7"};
+    for (size_t i = 0; i < 16; ++i) {
+        columns.emplace_back("value" + std::to_string(i));
+    }
+    std::string line;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (i != 0) {
+            line += separator;
+        }
+        line += columns[i];
+    }
+    return line;
+}
+
+static void BM_ParseDelimiterLine(const std::string& name, const std::string& line, int count) {
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    LogEvent* event = eventGroup.AddLogEvent();
+    std::vector<StringView> columnValues;
+    columnValues.reserve(64);
+
+    DelimiterModeFsmParser fsmParser('"', ',');
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < count; ++i) {
+        columnValues.clear();
+        fsmParser.ParseDelimiterLine(StringView(line), 0, line.size(), columnValues, *event);
+    }
+    uint64_t durationTime = GetCurrentTimeInMicroSeconds() - startTime;
+    std::cout << name << "\tfsm:\t" << formatSize(line.size() * (uint64_t)count * 1000000 / durationTime) << "/s"
+              << std::endl;
+
+    for (auto impl : {char_finder::Impl::SCALAR, char_finder::Impl::SSE2, char_finder::Impl::AVX2}) {
+        if (!char_finder::IsImplSupported(impl)) {
+            continue;
+        }
+        std::vector<size_t> separators, quotes;
+        startTime = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < count; ++i) {
+            separators.clear();
+            quotes.clear();
+            delimiter_tokenizer::FindSeparators(impl, line.data(), line.size(), ',', '"', true, separators, quotes);
+        }
+        durationTime = GetCurrentTimeInMicroSeconds() - startTime;
+        std::cout << name << "\tfind separators " << char_finder::GetImplName(impl) << ":\t"
+                  << formatSize(line.size() * (uint64_t)count * 1000000 / durationTime) << "/s" << std::endl;
+    }
+
+    DelimiterTokenizer tokenizer(',', '"', true);
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < count; ++i) {
+        columnValues.clear();
+        tokenizer.ParseDelimiterLine(StringView(line), 0, line.size(), columnValues, *event);
+    }
+    durationTime = GetCurrentTimeInMicroSeconds() - startTime;
+    std::cout << name << "\ttokenizer:\t" << formatSize(line.size() * (uint64_t)count * 1000000 / durationTime)
+              << "/s" << std::endl;
+}
+
+static void BM_ProcessDelimiter(const std::string& name, const std::string& separator, const std::string& data) {
+    PipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Separator"] = separator;
+    config["Quote"] = "\"";
+    config["Keys"] = Json::arrayValue;
+    for (size_t i = 0; i < 32; ++i) {
+        config["Keys"].append("key" + std::to_string(i));
+    }
+    config["KeepingSourceWhenParseFail"] = true;
+    config["KeepingSourceWhenParseSucceed"] = false;
+    ProcessorParseDelimiterNative processor;
+    processor.SetContext(ctx);
+    processor.SetMetricsRecordRef(ProcessorParseDelimiterNative::sName, "1");
+    if (!processor.Init(config)) {
+        std::cout << "init processor failed" << std::endl;
+        return;
+    }
+
+    const int size = 512;
+    const int batchSize = 100;
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; ++i) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        for (int j = 0; j < size; ++j) {
+            auto logEvent = eventGroup.AddLogEvent();
+            logEvent->SetContent(std::string("content"), data);
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processor.Process(eventGroup);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << name << "\tprocessor:\t"
+              << formatSize(data.size() * (uint64_t)size * (uint64_t)batchSize * 1000000 / durationTime) << "/s"
+              << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    BM_ParseDelimiterLine("unquoted", GenerateAccessLogLine(",", false), 1000000);
+    BM_ParseDelimiterLine("quoted", GenerateAccessLogLine(",", true), 1000000);
+    BM_ProcessDelimiter("unquoted", ",", GenerateAccessLogLine(",", false));
+    BM_ProcessDelimiter("quoted", ",", GenerateAccessLogLine(",", true));
+    BM_ProcessDelimiter("multi-char separator", "||", GenerateAccessLogLine("||", false));
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/ProcessorParseJsonNative.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_json_parse_fast_path);
+
+using namespace logtail;
+
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+static void BM_ParseJson(const std::string& name, const std::string& data, int size, int batchSize) {
+    PipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["KeepingSourceWhenParseFail"] = true;
+    config["KeepingSourceWhenParseSucceed"] = false;
+    ProcessorParseJsonNative processor;
+    processor.SetContext(ctx);
+    processor.SetMetricsRecordRef(ProcessorParseJsonNative::sName, "1");
+    if (!processor.Init(config)) {
+        std::cout << "init processor failed" << std::endl;
+        return;
+    }
+
+    for (bool fastPath : {false, true}) {
+        BOOL_FLAG(enable_json_parse_fast_path) = fastPath;
+        uint64_t durationTime = 0;
+        for (int i = 0; i < batchSize; ++i) {
+            auto sourceBuffer = std::make_shared<SourceBuffer>();
+            PipelineEventGroup eventGroup(sourceBuffer);
+            for (int j = 0; j < size; ++j) {
+                auto logEvent = eventGroup.AddLogEvent();
+                logEvent->SetContent(std::string("content"), data);
+            }
+
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            processor.Process(eventGroup);
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << name << "\t" << (fastPath ? "fast path" : "dom") << ":\t"
+                  << formatSize(data.size() * (uint64_t)size * (uint64_t)batchSize * 1000000 / durationTime) << "/s"
+                  << std::endl;
+    }
+    BOOL_FLAG(enable_json_parse_fast_path) = true;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    BM_ParseJson(
+        "flat",
+        R"({"time":"2024-04-07T08:02:40.873971412Z","level":"INFO","logger":"com.example.myproject.Book","thread":"main","trace_id":"4bf92f3577b34da6a3ce929d0e0e4736","status":200,"latency":1234,"msg":"GET /api/v1/books?id=12345 HTTP/1.1"})",
+        512,
+        100);
+    BM_ParseJson(
+        "escaped",
+        R"({"time":"2024-04-07T08:02:40.873971412Z","level":"ERROR","msg":"Exception in thread \"main\" java.lang.NullPointerException\n\tat com.example.myproject.Book.getTitle(Book.java:16)\n\tat com.example.myproject.Author.getBookTitles(Author.java:25)\n"})",
+        512,
+        100);
+    BM_ParseJson(
+        "nested",
+        R"({"time":"2024-04-07T08:02:40.873971412Z","request":{"method":"GET","uri":"/api/v1/books","headers":{"host":"example.com","user-agent":"curl/7.64.1"}},"response":{"status":200,"size":5120},"tags":["a","b","c"]})",
+        512,
+        100);
+    return 0;
+}
@@ -0,0 +1,156 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "common/TimestampParser.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/ProcessorParseTimestampNative.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+// formats exercised in ProcessorParseTimestampNativeUnittest
+static const std::vector<std::string> kFormats = {"%Y-%m-%d %H:%M:%S",
+                                                  "%Y-%m-%d %H:%M:%S.%f",
+                                                  "%Y-%m-%dT%H:%M:%S",
+                                                  "%Y-%m-%dT%H:%M:%S.%f",
+                                                  "[%Y-%m-%d %H:%M:%S.%f",
+                                                  "%H:%M:%S.%f %Y-%m-%d",
+                                                  "%d %b %y %H:%M",
+                                                  "%s"};
+
+// time strings of @streamCnt streams interleaved, where each stream has 100 lines per second
+std::vector<std::string> GenerateTimeStrings(const std::string& format, size_t streamCnt, size_t count) {
+    std::vector<std::string> timeStrs;
+    timeStrs.reserve(count);
+    time_t base = 1700000000;
+    for (size_t i = 0; i < count; ++i) {
+        size_t line = i / streamCnt;
+        // streams lag behind each other by a few seconds
+        time_t t = base + line / 100 - (i % streamCnt) * 3;
+        std::string nanosecond = std::to_string(100000 + line % 100 * 1000);
+        std::string s;
+        if (format == "%s") {
+            s = std::to_string(t) + nanosecond;
+        } else {
+            struct tm tm;
+            localtime_r(&t, &tm);
+            char buf[128];
+            strftime(buf, sizeof(buf), format.c_str(), &tm);
+            s = buf;
+            size_t pos = s.find("%f");
+            if (pos != std::string::npos) {
+                s.replace(pos, 2, nanosecond);
+            }
+        }
+        timeStrs.emplace_back(s);
+    }
+    return timeStrs;
+}
+
+static void PrintResult(const std::string& format, const std::string& name, uint64_t durationTime, size_t count) {
+    std::cout << format << "\t" << name << ":\t" << durationTime * 1000 / count << " ns/op" << std::endl;
+}
+
+static void BM_ParseTimestamp(const std::string& format, size_t streamCnt, int count) {
+    std::vector<std::string> timeStrs = GenerateTimeStrings(format, streamCnt, count);
+    std::string name = format + " (" + std::to_string(streamCnt) + " streams)";
+    size_t parsedCnt = 0;
+
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (const auto& timeStr : timeStrs) {
+        LogtailTime ts = {0, 0};
+        int nanosecondLength = 0;
+        parsedCnt += Strptime(timeStr.c_str(), format.c_str(), &ts, nanosecondLength) != NULL;
+    }
+    PrintResult(name, "strptime", GetCurrentTimeInMicroSeconds() - startTime, timeStrs.size());
+
+    TimestampParser parser(format);
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (const auto& timeStr : timeStrs) {
+        LogtailTime ts = {0, 0};
+        int nanosecondLength = 0;
+        parsedCnt += parser.Parse(timeStr.c_str(), ts, nanosecondLength) != NULL;
+    }
+    PrintResult(name, "compiled", GetCurrentTimeInMicroSeconds() - startTime, timeStrs.size());
+
+    // the cache lives within an event group, so it is reset every 1024 lines
+    startTime = GetCurrentTimeInMicroSeconds();
+    for (size_t i = 0; i < timeStrs.size(); i += 1024) {
+        TimestampCache cache;
+        for (size_t j = i; j < i + 1024 && j < timeStrs.size(); ++j) {
+            LogtailTime ts = {0, 0};
+            parsedCnt += parser.Parse(StringView(timeStrs[j]), ts, cache);
+        }
+    }
+    PrintResult(name, "compiled with cache", GetCurrentTimeInMicroSeconds() - startTime, timeStrs.size());
+    if (parsedCnt != timeStrs.size() * 3) {
+        std::cout << "parse failed: " << timeStrs.size() * 3 - parsedCnt << std::endl;
+    }
+}
+
+static void BM_ProcessTimestamp(const std::string& format, size_t streamCnt) {
+    PipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    Json::Value config;
+    config["SourceKey"] = "time";
+    config["SourceFormat"] = format;
+    config["SourceTimezone"] = "GMT+00:00";
+    ProcessorParseTimestampNative processor;
+    processor.SetContext(ctx);
+    processor.SetMetricsRecordRef(ProcessorParseTimestampNative::sName, "1");
+    if (!processor.Init(config)) {
+        std::cout << "init processor failed" << std::endl;
+        return;
+    }
+
+    const int size = 1024;
+    const int batchSize = 100;
+    std::vector<std::string> timeStrs = GenerateTimeStrings(format, streamCnt, size * batchSize);
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; ++i) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        for (int j = 0; j < size; ++j) {
+            auto logEvent = eventGroup.AddLogEvent();
+            logEvent->SetContent(std::string("time"), timeStrs[i * size + j]);
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processor.Process(eventGroup);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    PrintResult(format + " (" + std::to_string(streamCnt) + " streams)", "processor", durationTime, size * batchSize);
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    for (const auto& format : kFormats) {
+        for (size_t streamCnt : {1, 4}) {
+            BM_ParseTimestamp(format, streamCnt, 1000000);
+            BM_ProcessTimestamp(format, streamCnt);
+        }
+    }
+    return 0;
+}
@@ -83,68 +83,88 @@ void ProcessorParseApsaraNativeUnittest::TestApsaraEasyReadLogTimeParser() {
     APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
 
     StringView buffer = "[1378972170425093]\tA:B";
-    StringView lastStr;
-    LogtailTime lastTime = {0, 0};
+    TimestampCache timestampCache;
     int64_t microTime = 0;
     uint32_t dateTime = 0;
 
-    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, lastStr, lastTime, microTime);
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
     APSARA_TEST_EQUAL(dateTime, 1378972170);
     APSARA_TEST_EQUAL(microTime, 1378972170425093);
-    APSARA_TEST_EQUAL(lastTime.tv_sec, 0);
+    APSARA_TEST_EQUAL(timestampCache.Size(), 0U);
 
     buffer = "[1378972171093]\tA:B";
     microTime = 0;
     dateTime = 0;
-    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, lastStr, lastTime, microTime);
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
     APSARA_TEST_EQUAL(dateTime, 1378972171);
     APSARA_TEST_EQUAL(microTime, 1378972171093000);
-    APSARA_TEST_EQUAL(lastTime.tv_sec, 0);
+    APSARA_TEST_EQUAL(timestampCache.Size(), 0U);
 
     buffer = "[1378972172]\tA:B";
     microTime = 0;
     dateTime = 0;
-    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, lastStr, lastTime, microTime);
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
     APSARA_TEST_EQUAL(dateTime, 1378972172);
     APSARA_TEST_EQUAL(microTime, 1378972172000000);
-    APSARA_TEST_EQUAL(lastTime.tv_sec, 0);
+    APSARA_TEST_EQUAL(timestampCache.Size(), 0U);
 
     buffer = "[2013-09-12 22:18:28.819129]\tA:B";
     microTime = 0;
     dateTime = 0;
-    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, lastStr, lastTime, microTime);
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
     APSARA_TEST_EQUAL(dateTime, 1378995508);
     APSARA_TEST_EQUAL(microTime, 1378995508819129);
-    APSARA_TEST_EQUAL(dateTime, lastTime.tv_sec);
-    APSARA_TEST_EQUAL(lastStr, "2013-09-12 22:18:28");
+    APSARA_TEST_TRUE_FATAL(timestampCache.Find("2013-09-12 22:18:28") != nullptr);
+    APSARA_TEST_EQUAL(dateTime, timestampCache.Find("2013-09-12 22:18:28")->second);
 
     buffer = "[2013-09-12 22:18:28.819139]\tA:B";
     microTime = 0;
     dateTime = 0;
-    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, lastStr, lastTime, microTime);
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
     APSARA_TEST_EQUAL(dateTime, 1378995508);
     APSARA_TEST_EQUAL(microTime, 1378995508819139);
-    APSARA_TEST_EQUAL(dateTime, lastTime.tv_sec);
-    APSARA_TEST_EQUAL(lastStr, "2013-09-12 22:18:28");
+    APSARA_TEST_TRUE_FATAL(timestampCache.Find("2013-09-12 22:18:28") != nullptr);
+    APSARA_TEST_EQUAL(dateTime, timestampCache.Find("2013-09-12 22:18:28")->second);
 
     buffer = "[2013-09-12 22:18:29.819139]\tA:B";
     microTime = 0;
     dateTime = 0;
-    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, lastStr, lastTime, microTime);
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
     APSARA_TEST_EQUAL(dateTime, 1378995509);
     APSARA_TEST_EQUAL(microTime, 1378995509819139);
-    APSARA_TEST_EQUAL(dateTime, lastTime.tv_sec);
-    APSARA_TEST_EQUAL(lastStr, "2013-09-12 22:18:29");
+    APSARA_TEST_TRUE_FATAL(timestampCache.Find("2013-09-12 22:18:29") != nullptr);
+    APSARA_TEST_EQUAL(dateTime, timestampCache.Find("2013-09-12 22:18:29")->second);
     LOG_INFO(sLogger, ("TestApsaraEasyReadLogTimeParser() end", time(NULL)));
 
     buffer = "[2013-09-12 22:18:29.819]\tA:B";
     microTime = 0;
     dateTime = 0;
-    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, lastStr, lastTime, microTime);
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
     APSARA_TEST_EQUAL(dateTime, 1378995509);
     APSARA_TEST_EQUAL(microTime, 1378995509819000);
-    APSARA_TEST_EQUAL(dateTime, lastTime.tv_sec);
-    APSARA_TEST_EQUAL(lastStr, "2013-09-12 22:18:29");
+    APSARA_TEST_TRUE_FATAL(timestampCache.Find("2013-09-12 22:18:29") != nullptr);
+    APSARA_TEST_EQUAL(dateTime, timestampCache.Find("2013-09-12 22:18:29")->second);
+
+    // seconds of interleaved times are all cached
+    buffer = "[2013-09-12 22:18:28]\tA:B";
+    microTime = 0;
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
+    APSARA_TEST_EQUAL(dateTime, 1378995508);
+    APSARA_TEST_EQUAL(microTime, 1378995508000000);
+    APSARA_TEST_EQUAL(timestampCache.Size(), 2U);
+
+    // a cached second which is a prefix of the time string but not the whole second is not taken
+    buffer = "[2013-09-12 22:18:2]\tA:B";
+    microTime = 0;
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
+    APSARA_TEST_EQUAL(dateTime, 1378995482);
+    APSARA_TEST_EQUAL(microTime, 1378995482000000);
+
+    buffer = "[2013-09-12 22:18:29.1]\tA:B";
+    microTime = 0;
+    dateTime = processor->ApsaraEasyReadLogTimeParser(buffer, timestampCache, microTime);
+    APSARA_TEST_EQUAL(dateTime, 1378995509);
+    APSARA_TEST_EQUAL(microTime, 1378995509100000);
 }
 
 void ProcessorParseApsaraNativeUnittest::TestApsaraLogLineParser() {
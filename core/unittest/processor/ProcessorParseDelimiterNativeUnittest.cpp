@@ -13,10 +13,13 @@
 // limitations under the License.
 
 #include <cstdlib>
+#include <random>
 
 #include "common/JsonUtil.h"
 #include "config/PipelineConfig.h"
 #include "models/LogEvent.h"
+#include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterTokenizer.h"
 #include "pipeline/plugin/instance/ProcessorInstance.h"
 #include "plugin/processor/ProcessorParseDelimiterNative.h"
 #include "plugin/processor/inner/ProcessorMergeMultilineLogNative.h"
@@ -47,6 +50,7 @@ public:
     void TestAllowingShortenedFields();
     void TestExtend();
     void TestEmpty();
+    void TestTokenizerConsistentWithFsm();
     PipelineContext mContext;
 };
 
@@ -64,6 +68,7 @@ UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestProcessEventDiscardUnm
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestAllowingShortenedFields);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestExtend);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestEmpty);
+UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestTokenizerConsistentWithFsm);
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -2587,6 +2592,64 @@ void ProcessorParseDelimiterNativeUnittest::TestEmpty() {
     }
 }
 
+void ProcessorParseDelimiterNativeUnittest::TestTokenizerConsistentWithFsm() {
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    LogEvent* event = eventGroup.AddLogEvent();
+    DelimiterModeFsmParser fsmParser('"', ',');
+    DelimiterTokenizer tokenizer(',', '"', true);
+    std::vector<std::string> lines = {"",
+                                      ",",
+                                      "a,b",
+                                      "\"a,b\",c",
+                                      "\"a\"\"b\",\"\"",
+                                      "\"\"\"\"",
+                                      "\"a\"b,c",
+                                      "a\"b\",c",
+                                      "\"a,b",
+                                      "\"a\"\"\",b"};
+    // quotes spanning several 64 byte blocks
+    lines.push_back("\"" + std::string(100, ',') + "\"," + std::string(100, 'a'));
+    std::mt19937 rng(0);
+    const std::string alphabet = "ab,\"\" ";
+    for (size_t i = 0; i < 10000; ++i) {
+        std::string line(rng() % (i % 10 == 0 ? 300 : 12), 'a');
+        for (auto& c : line) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        lines.emplace_back(std::move(line));
+    }
+    for (const auto& line : lines) {
+        std::vector<StringView> expected, actual;
+        bool expectedRes = fsmParser.ParseDelimiterLine(StringView(line), 0, line.size(), expected, *event);
+        APSARA_TEST_EQUAL_FATAL(expectedRes,
+                                tokenizer.ParseDelimiterLine(StringView(line), 0, line.size(), actual, *event));
+        APSARA_TEST_EQUAL_FATAL(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            APSARA_TEST_EQUAL_FATAL(expected[i], actual[i]);
+        }
+        // all implementations find the same separators and quotes
+        std::vector<size_t> expectedSeparators, expectedQuotes;
+        delimiter_tokenizer::FindSeparators(char_finder::Impl::SCALAR,
+                                            line.data(),
+                                            line.size(),
+                                            ',',
+                                            '"',
+                                            true,
+                                            expectedSeparators,
+                                            expectedQuotes);
+        for (auto impl : {char_finder::Impl::SSE2, char_finder::Impl::AVX2}) {
+            if (!char_finder::IsImplSupported(impl)) {
+                continue;
+            }
+            std::vector<size_t> separators, quotes;
+            delimiter_tokenizer::FindSeparators(impl, line.data(), line.size(), ',', '"', true, separators, quotes);
+            APSARA_TEST_EQUAL_FATAL(expectedSeparators, separators);
+            APSARA_TEST_EQUAL_FATAL(expectedQuotes, quotes);
+        }
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
\ No newline at end of file
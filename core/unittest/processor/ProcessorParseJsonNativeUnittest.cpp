@@ -13,6 +13,7 @@
 // limitations under the License.
 #include <cstdlib>
 
+#include "common/Flags.h"
 #include "common/JsonUtil.h"
 #include "config/PipelineConfig.h"
 #include "models/LogEvent.h"
@@ -21,6 +22,8 @@
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_BOOL(enable_json_parse_fast_path);
+
 namespace logtail {
 
 class ProcessorParseJsonNativeUnittest : public ::testing::Test {
@@ -36,6 +39,7 @@ public:
     void TestProcessJsonContent();
     void TestProcessJsonRaw();
     void TestMultipleLines();
+    void TestFastPath();
 
     PipelineContext mContext;
 };
@@ -58,6 +62,8 @@ UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestProcessJsonRaw);
 
 UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestMultipleLines);
 
+UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestFastPath);
+
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
     return pluginMeta;
@@ -693,6 +699,61 @@ void ProcessorParseJsonNativeUnittest::TestProcessEventDiscardUnmatch() {
     APSARA_TEST_GE_FATAL(processorInstance.mTotalProcessTimeMs->GetValue(), uint64_t(0));
 }
 
+void ProcessorParseJsonNativeUnittest::TestFastPath() {
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["KeepingSourceWhenParseFail"] = true;
+    config["KeepingSourceWhenParseSucceed"] = false;
+    config["CopingRawLog"] = false;
+    config["RenamedSourceKey"] = "rawLog";
+    // logs handled by the fast path, by rapidjson for some values, and by the dom path
+    const std::vector<std::string> logs = {
+        R"({"url": "POST /PutData?Category=YunOsAccountOpLog HTTP/1.1", "status": 200, "ok": true, "err": null})",
+        R"({"msg":"line1\nline2 \"quoted\" \/ \u4e2d\u6587 \ud83d\ude00","escaped\tkey":"v"})",
+        R"({"obj":{"a":[1,"b",false,null],"c":{}},"arr":[],"spaced":{ "a" : [ 1, 2 ] },"unicode":["\u0041"]})",
+        R"({"int":-12,"zero":0,"negative_zero":-0,"double":1.50,"exp":1e3,"big":123456789012345678901234567890})",
+        R"({"content":"overwritten","content":"twice"})",
+        R"(  {"a":"b"}  )",
+        R"({"a":"\udc00"})",
+        R"({"a":1,})",
+        R"(["a","b"])",
+        R"({"a":"b"}x)",
+        R"({"a":1e400})",
+    };
+    std::string results[2];
+    for (bool fastPath : {false, true}) {
+        BOOL_FLAG(enable_json_parse_fast_path) = fastPath;
+        PipelineEventGroup eventGroup(std::make_shared<SourceBuffer>());
+        for (const auto& log : logs) {
+            auto logEvent = eventGroup.AddLogEvent();
+            logEvent->SetContent(std::string("content"), log);
+            logEvent->SetTimestamp(12345678901);
+        }
+        ProcessorParseJsonNative processor;
+        processor.SetContext(mContext);
+        processor.SetMetricsRecordRef(ProcessorParseJsonNative::sName, "1");
+        APSARA_TEST_TRUE_FATAL(processor.Init(config));
+        processor.Process(eventGroup);
+        results[fastPath] = eventGroup.ToJsonString();
+    }
+    BOOL_FLAG(enable_json_parse_fast_path) = true;
+    APSARA_TEST_EQUAL_FATAL(results[false], results[true]);
+
+    // unescaped strings and compact nested values are referenced in place
+    PipelineEventGroup eventGroup(std::make_shared<SourceBuffer>());
+    auto logEvent = eventGroup.AddLogEvent();
+    logEvent->SetContent(std::string("content"), std::string(R"({"key":"value","obj":{"a":1}})"));
+    StringView content = logEvent->GetContent("content");
+    ProcessorParseJsonNative processor;
+    processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorParseJsonNative::sName, "1");
+    APSARA_TEST_TRUE_FATAL(processor.Init(config));
+    processor.Process(eventGroup);
+    auto& event = eventGroup.GetEvents()[0].Cast<LogEvent>();
+    APSARA_TEST_EQUAL_FATAL(content.data() + 8, event.GetContent("key").data());
+    APSARA_TEST_EQUAL_FATAL(content.data() + 21, event.GetContent("obj").data());
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -633,9 +633,9 @@ void ProcessorParseTimestampNativeUnittest::TestProcessEventPreciseTimestampLega
     ProcessorParseTimestampNative& processor = *(new ProcessorParseTimestampNative);
     ProcessorInstance processorInstance(&processor, getPluginMeta());
     APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
-    logtail::StringView timeStrCache;
+    TimestampCache timestampCache;
     LogtailTime logTime = {0, 0};
-    APSARA_TEST_TRUE_FATAL(processor.ProcessEvent("/var/log/message", logEvent, logTime, timeStrCache));
+    APSARA_TEST_TRUE_FATAL(processor.ProcessEvent("/var/log/message", logEvent, logTime, timestampCache));
     // judge result
     std::string outJson = logEvent->ToJsonString();
     std::stringstream expectJsonSs;
@@ -658,6 +658,7 @@ public:
 
     void TestParseLogTime();
     void TestParseLogTimeSecondCache();
+    void TestParseLogTimeInterleavedCache();
     void TestAdjustTimeZone();
 
     PipelineContext mContext;
@@ -665,6 +666,7 @@ public:
 
 UNIT_TEST_CASE(ProcessorParseLogTimeUnittest, TestParseLogTime);
 UNIT_TEST_CASE(ProcessorParseLogTimeUnittest, TestParseLogTimeSecondCache);
+UNIT_TEST_CASE(ProcessorParseLogTimeUnittest, TestParseLogTimeInterleavedCache);
 // UNIT_TEST_CASE(ProcessorParseLogTimeUnittest, TestAdjustTimeZone);
 
 void ProcessorParseLogTimeUnittest::TestParseLogTime() {
@@ -706,8 +708,9 @@ void ProcessorParseLogTimeUnittest::TestParseLogTime() {
         APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
         LogtailTime outTime = {0, 0};
         uint64_t preciseTimestamp = 0;
-        StringView timeStrCache;
-        bool ret = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timeStrCache);
+        TimestampCache timestampCache;
+        bool ret
+            = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timestampCache);
         EXPECT_EQ(ret, true) << "failed: " + c.inputTimeStr;
         EXPECT_EQ(outTime.tv_sec, c.exceptedLogTime) << "failed: " + c.inputTimeStr;
         EXPECT_EQ(outTime.tv_nsec, c.exceptedLogTimeNanosecond) << "failed: " + c.inputTimeStr;
@@ -752,11 +755,12 @@ void ProcessorParseLogTimeUnittest::TestParseLogTimeSecondCache() {
             }
         }
 
-        StringView timeStrCache = "2012-01-01 15:04:59";
+        TimestampCache timestampCache;
+        timestampCache.Add("2012-01-01 15:04:59", 0);
         for (size_t i = 0; i < inputTimes.size(); ++i) {
             auto c = inputTimes[i];
             bool ret
-                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timeStrCache);
+                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timestampCache);
             APSARA_TEST_EQUAL(ret, true);
             APSARA_TEST_EQUAL(outTime.tv_sec, c.exceptedLogTime);
             APSARA_TEST_EQUAL(outTime.tv_nsec, c.exceptedLogTimeNanosecond);
@@ -783,11 +787,12 @@ void ProcessorParseLogTimeUnittest::TestParseLogTimeSecondCache() {
                                         expectLogTimeNanosecondBase + i * 1000000 + j * 100000);
             }
         }
-        StringView timeStrCache = "2012-01-01 15:04:59";
+        TimestampCache timestampCache;
+        timestampCache.Add("2012-01-01 15:04:59", 0);
         for (size_t i = 0; i < inputTimes.size(); ++i) {
             auto c = inputTimes[i];
             bool ret
-                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timeStrCache);
+                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timestampCache);
             APSARA_TEST_EQUAL(ret, true);
             APSARA_TEST_EQUAL(outTime.tv_sec, c.exceptedLogTime);
             APSARA_TEST_EQUAL(outTime.tv_nsec, c.exceptedLogTimeNanosecond);
@@ -812,11 +817,12 @@ void ProcessorParseLogTimeUnittest::TestParseLogTimeSecondCache() {
                     std::string(second.data()), expectLogTimeBase + i, 0, expectLogTimeNanosecondBase + i * 1000000);
             }
         }
-        StringView timeStrCache = "1484147106";
+        TimestampCache timestampCache;
+        timestampCache.Add("1484147106", 0);
         for (size_t i = 0; i < inputTimes.size(); ++i) {
             auto c = inputTimes[i];
             bool ret
-                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timeStrCache);
+                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timestampCache);
             APSARA_TEST_EQUAL(ret, true);
             APSARA_TEST_EQUAL(outTime.tv_sec, c.exceptedLogTime);
             APSARA_TEST_EQUAL(outTime.tv_nsec, c.exceptedLogTimeNanosecond);
@@ -843,11 +849,12 @@ void ProcessorParseLogTimeUnittest::TestParseLogTimeSecondCache() {
                                         expectLogTimeNanosecondBase + i * 1000000 + j * 100000);
             }
         }
-        StringView timeStrCache = "1484147106";
+        TimestampCache timestampCache;
+        timestampCache.Add("1484147106", 0);
         for (size_t i = 0; i < inputTimes.size(); ++i) {
             auto c = inputTimes[i];
             bool ret
-                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timeStrCache);
+                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timestampCache);
             APSARA_TEST_EQUAL(ret, true);
             APSARA_TEST_EQUAL(outTime.tv_sec, c.exceptedLogTime);
             APSARA_TEST_EQUAL(outTime.tv_nsec, c.exceptedLogTimeNanosecond);
@@ -874,11 +881,12 @@ void ProcessorParseLogTimeUnittest::TestParseLogTimeSecondCache() {
                                         expectLogTimeNanosecondBase + i * 1000000 + j * 100000);
             }
         }
-        StringView timeStrCache = "15:04:59.0 2012-01-01";
+        TimestampCache timestampCache;
+        timestampCache.Add("15:04:59.0 2012-01-01", 0);
         for (size_t i = 0; i < inputTimes.size(); ++i) {
             auto c = inputTimes[i];
             bool ret
-                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timeStrCache);
+                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timestampCache);
             APSARA_TEST_EQUAL(ret, true);
             APSARA_TEST_EQUAL(outTime.tv_sec, c.exceptedLogTime);
             APSARA_TEST_EQUAL(outTime.tv_nsec, c.exceptedLogTimeNanosecond);
@@ -886,6 +894,43 @@ void ProcessorParseLogTimeUnittest::TestParseLogTimeSecondCache() {
     }
 }
 
+void ProcessorParseLogTimeUnittest::TestParseLogTimeInterleavedCache() {
+    Json::Value config;
+    config["SourceKey"] = "time";
+    config["SourceTimezone"] = "GMT+00:00";
+    config["SourceFormat"] = "%Y-%m-%d %H:%M:%S.%f";
+    ProcessorParseTimestampNative& processor = *(new ProcessorParseTimestampNative);
+    ProcessorInstance processorInstance(&processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+
+    // time strings of two streams are interleaved
+    std::vector<std::string> inputTimes;
+    for (size_t i = 0; i < 4; ++i) {
+        inputTimes.emplace_back("2012-01-01 15:05:0" + std::to_string(i) + ".1");
+        inputTimes.emplace_back("2012-01-01 15:04:0" + std::to_string(i) + ".2");
+    }
+    inputTimes.insert(inputTimes.end(), inputTimes.begin(), inputTimes.end());
+    TimestampCache timestampCache;
+    for (size_t i = 0; i < inputTimes.size(); ++i) {
+        LogtailTime outTime = {0, 0};
+        uint64_t preciseTimestamp = 0;
+        APSARA_TEST_TRUE(
+            processor.ParseLogTime(inputTimes[i], "/var/log/message", outTime, preciseTimestamp, timestampCache));
+        if (i % 2 == 0) {
+            APSARA_TEST_EQUAL(1325430300 + (i % 8) / 2, outTime.tv_sec);
+            APSARA_TEST_EQUAL(100000000, outTime.tv_nsec);
+        } else {
+            APSARA_TEST_EQUAL(1325430240 + (i % 8) / 2, outTime.tv_sec);
+            APSARA_TEST_EQUAL(200000000, outTime.tv_nsec);
+        }
+    }
+    // seconds of both streams are kept in the cache
+    APSARA_TEST_EQUAL(TimestampCache::kCapacity, timestampCache.Size());
+    APSARA_TEST_TRUE(timestampCache.Find("2012-01-01 15:05:00.9") != nullptr);
+    APSARA_TEST_TRUE(timestampCache.Find("2012-01-01 15:04:03.9") != nullptr);
+    APSARA_TEST_TRUE(timestampCache.Find("2012-01-01 15:04:04.9") == nullptr);
+}
+
 void ProcessorParseLogTimeUnittest::TestAdjustTimeZone() {
     struct Case {
         std::string inputTimeStr;
@@ -925,11 +970,12 @@ void ProcessorParseLogTimeUnittest::TestAdjustTimeZone() {
                                         expectLogTimeNanosecondBase + i * 1000000 + j * 100000);
             }
         }
-        StringView timeStrCache = "2012-01-01 15:04:59";
+        TimestampCache timestampCache;
+        timestampCache.Add("2012-01-01 15:04:59", 0);
         for (size_t i = 0; i < inputTimes.size(); ++i) {
             auto c = inputTimes[i];
             bool ret
-                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timeStrCache);
+                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timestampCache);
             APSARA_TEST_EQUAL(ret, true);
             APSARA_TEST_EQUAL(outTime.tv_sec, c.exceptedLogTime);
             APSARA_TEST_EQUAL(outTime.tv_nsec, c.exceptedLogTimeNanosecond);
@@ -957,11 +1003,12 @@ void ProcessorParseLogTimeUnittest::TestAdjustTimeZone() {
                                         expectLogTimeNanosecondBase + i * 1000000 + j * 100000);
             }
         }
-        StringView timeStrCache = "2012-01-01 15:04:59";
+        TimestampCache timestampCache;
+        timestampCache.Add("2012-01-01 15:04:59", 0);
         for (size_t i = 0; i < inputTimes.size(); ++i) {
             auto c = inputTimes[i];
             bool ret
-                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timeStrCache);
+                = processor.ParseLogTime(c.inputTimeStr, "/var/log/message", outTime, preciseTimestamp, timestampCache);
             APSARA_TEST_EQUAL(ret, true);
             APSARA_TEST_EQUAL(outTime.tv_sec, c.exceptedLogTime);
             APSARA_TEST_EQUAL(outTime.tv_nsec, c.exceptedLogTimeNanosecond);
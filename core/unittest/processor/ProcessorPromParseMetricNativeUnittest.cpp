@@ -127,6 +127,12 @@ void ProcessorParsePrometheusMetricUnittest::TestProcess() {
     // judge timestamp
     APSARA_TEST_EQUAL(time_t(timestampMilliSec / 1000),
                       eventGroup.GetEvents().at(0).Cast<MetricEvent>().GetTimestamp());
+
+    // events already parsed are kept
+    processor.Process(eventGroup);
+    APSARA_TEST_EQUAL((size_t)8, eventGroup.GetEvents().size());
+    APSARA_TEST_EQUAL("test_metric1", eventGroup.GetEvents().at(0).Cast<MetricEvent>().GetName());
+    APSARA_TEST_EQUAL("8", eventGroup.GetMetadata(EventGroupMetaKey::PROMETHEUS_SAMPLES_SCRAPED));
 }
 
 UNIT_TEST_CASE(ProcessorParsePrometheusMetricUnittest, TestInit)
@@ -33,6 +33,7 @@ public:
     void TestProcess();
     void TestAddAutoMetrics();
     void TestHonorLabels();
+    void TestRelabelCache();
 
     PipelineContext mContext;
 };
@@ -41,6 +42,7 @@ void ProcessorPromRelabelMetricNativeUnittest::TestInit() {
     Json::Value config;
     ProcessorPromRelabelMetricNative processor;
     processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
 
     // success config
     string configStr;
@@ -82,6 +84,7 @@ void ProcessorPromRelabelMetricNativeUnittest::TestProcess() {
 
     ProcessorPromRelabelMetricNative processor;
     processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
 
     string configStr;
     string errorMsg;
@@ -159,6 +162,7 @@ void ProcessorPromRelabelMetricNativeUnittest::TestAddAutoMetrics() {
 
     ProcessorPromRelabelMetricNative processor;
     processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
 
     string configStr;
     string errorMsg;
@@ -231,6 +235,7 @@ void ProcessorPromRelabelMetricNativeUnittest::TestHonorLabels() {
 
     ProcessorPromRelabelMetricNative processor;
     processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
 
     string configStr;
     string errorMsg;
@@ -280,10 +285,130 @@ test_metric8{k1="v1", k3="v2", } 9.9410452992e+10 1715829785083
     APSARA_TEST_EQUAL("v2", eventGroup.GetEvents().at(7).Cast<MetricEvent>().GetTag(string("exported_k3")).to_string());
 }
 
+void ProcessorPromRelabelMetricNativeUnittest::TestRelabelCache() {
+    Json::Value config;
+    ProcessorPromRelabelMetricNative processor;
+    processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
+
+    string configStr;
+    string errorMsg;
+    configStr = R"JSON(
+        {
+            "job_name": "test_job",
+            "metric_relabel_configs": [
+                {
+                    "action": "drop",
+                    "regex": "v.*",
+                    "source_labels": [
+                        "k3"
+                    ]
+                },
+                {
+                    "action": "replace",
+                    "regex": "(.*)",
+                    "replacement": "${1}_new",
+                    "source_labels": [
+                        "k1"
+                    ],
+                    "target_label": "k1"
+                },
+                {
+                    "action": "replace",
+                    "regex": "(.*)",
+                    "replacement": "${1}",
+                    "source_labels": [
+                        "k2"
+                    ],
+                    "target_label": "__tmp"
+                },
+                {
+                    "action": "labeldrop",
+                    "regex": "k2"
+                }
+            ]
+        }
+    )JSON";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, config, errorMsg));
+    APSARA_TEST_TRUE(processor.Init(config));
+
+    string rawData = R"""(
+test_metric1{k1="v1", k2="v2"} 1.0
+test_metric2{k1="v1", k3="2"} 2.0
+test_metric3{k1="v1", k3="v3"} 3.0
+)""";
+    auto check = [&](PipelineEventGroup& eventGroup) {
+        APSARA_TEST_EQUAL(2U, eventGroup.GetEvents().size());
+        const auto& e1 = eventGroup.GetEvents().at(0).Cast<MetricEvent>();
+        APSARA_TEST_EQUAL("test_metric1", e1.GetName());
+        APSARA_TEST_EQUAL("v1_new", e1.GetTag(string("k1")).to_string());
+        APSARA_TEST_FALSE(e1.HasTag(string("k2")));
+        APSARA_TEST_FALSE(e1.HasTag(string("__tmp")));
+        APSARA_TEST_EQUAL("instance_1", e1.GetTag(string("instance")).to_string());
+        APSARA_TEST_EQUAL("test_metric1", e1.GetTag(prometheus::NAME).to_string());
+        const auto& e2 = eventGroup.GetEvents().at(1).Cast<MetricEvent>();
+        APSARA_TEST_EQUAL("test_metric2", e2.GetName());
+        APSARA_TEST_EQUAL("v1_new", e2.GetTag(string("k1")).to_string());
+        APSARA_TEST_EQUAL("2", e2.GetTag(string("k3")).to_string());
+        APSARA_TEST_FALSE(e2.HasTag(string("__tmp")));
+    };
+    auto parse = [&](uint64_t scrapeTimestamp, const string& instance) {
+        auto eventGroup = TextParser().Parse(rawData, 0, 0);
+        eventGroup.SetMetadata(EventGroupMetaKey::PROMETHEUS_SCRAPE_TIMESTAMP_MILLISEC, ToString(scrapeTimestamp));
+        eventGroup.SetTag(string("instance"), instance);
+        return eventGroup;
+    };
+
+    // first scrape, all missed
+    auto eventGroup = parse(1000, "instance_1");
+    processor.Process(eventGroup);
+    check(eventGroup);
+    APSARA_TEST_EQUAL(0U, processor.mRelabelCacheHitTotal->GetValue());
+    APSARA_TEST_EQUAL(3U, processor.mRelabelCacheMissTotal->GetValue());
+    APSARA_TEST_EQUAL(1U, processor.mRelabelCaches.size());
+    auto& cache = processor.mRelabelCaches.begin()->second->mCache;
+    APSARA_TEST_EQUAL(3U, cache.Size());
+
+    // second scrape, all hit and the result is the same
+    eventGroup = parse(2000, "instance_1");
+    processor.Process(eventGroup);
+    check(eventGroup);
+    APSARA_TEST_EQUAL(3U, processor.mRelabelCacheHitTotal->GetValue());
+    APSARA_TEST_EQUAL(3U, processor.mRelabelCacheMissTotal->GetValue());
+
+    // another target has its own cache
+    eventGroup = parse(2000, "instance_2");
+    processor.Process(eventGroup);
+    APSARA_TEST_EQUAL(2U, processor.mRelabelCaches.size());
+    APSARA_TEST_EQUAL(3U, processor.mRelabelCacheHitTotal->GetValue());
+    APSARA_TEST_EQUAL(6U, processor.mRelabelCacheMissTotal->GetValue());
+
+    // series disappeared are evicted in the next scrape
+    rawData = R"""(
+test_metric1{k1="v1", k2="v2"} 1.0
+)""";
+    eventGroup = parse(3000, "instance_1");
+    processor.Process(eventGroup);
+    APSARA_TEST_EQUAL(3U, cache.Size());
+    eventGroup = parse(4000, "instance_1");
+    processor.Process(eventGroup);
+    APSARA_TEST_EQUAL(1U, cache.Size());
+    APSARA_TEST_EQUAL(5U, processor.mRelabelCacheHitTotal->GetValue());
+
+    // size is bounded
+    RelabelResultCache boundedCache(1);
+    boundedCache.Add(1, RelabelResult());
+    boundedCache.Add(2, RelabelResult());
+    APSARA_TEST_EQUAL(1U, boundedCache.Size());
+    APSARA_TEST_NOT_EQUAL(nullptr, boundedCache.Get(1));
+    APSARA_TEST_EQUAL(nullptr, boundedCache.Get(2));
+}
+
 UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestProcess)
 UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestAddAutoMetrics)
 UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestHonorLabels)
+UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestRelabelCache)
 
 
 } // namespace logtail
@@ -0,0 +1,168 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "common/CharFinder.h"
+#include "common/TimeUtil.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
+#include "unittest/Unittest.h"
+
+
+using namespace logtail;
+
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+static std::string MakeLines(size_t lineSize, size_t totalSize) {
+    std::string line(lineSize - 1, 'a');
+    line += '\n';
+    std::string buffer;
+    buffer.reserve(totalSize + lineSize);
+    while (buffer.size() < totalSize) {
+        buffer += line;
+    }
+    return buffer;
+}
+
+// the original byte-by-byte loop, kept as the baseline
+static void FindAllCharsByteByByte(const char* data, size_t size, char ch, std::vector<size_t>& positions) {
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] == ch) {
+            positions.push_back(i);
+        }
+    }
+}
+
+static void BM_FindAllChars(size_t lineSize, int batchSize) {
+    std::string buffer = MakeLines(lineSize, 4 * 1024 * 1024);
+    std::vector<size_t> positions;
+    positions.reserve(buffer.size() / lineSize + 1);
+
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; ++i) {
+        positions.clear();
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        FindAllCharsByteByByte(buffer.data(), buffer.size(), '\n', positions);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << "line size: " << lineSize << "\tbyte by byte:\t"
+              << formatSize(buffer.size() * (uint64_t)batchSize * 1000000 / durationTime) << "/s" << std::endl;
+
+    for (auto impl : {char_finder::Impl::SCALAR, char_finder::Impl::SSE2, char_finder::Impl::AVX2}) {
+        if (!char_finder::IsImplSupported(impl)) {
+            continue;
+        }
+        durationTime = 0;
+        for (int i = 0; i < batchSize; ++i) {
+            positions.clear();
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            char_finder::FindAllChars(impl, buffer.data(), buffer.size(), '\n', positions);
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << "line size: " << lineSize << "\t" << char_finder::GetImplName(impl) << ":\t\t"
+                  << formatSize(buffer.size() * (uint64_t)batchSize * 1000000 / durationTime) << "/s" << std::endl;
+    }
+}
+
+static void BM_FindLastChar(size_t lineSize, int batchSize) {
+    std::string buffer = MakeLines(lineSize, 4 * 1024 * 1024);
+    for (auto impl : {char_finder::Impl::SCALAR, char_finder::Impl::SSE2, char_finder::Impl::AVX2}) {
+        if (!char_finder::IsImplSupported(impl)) {
+            continue;
+        }
+        uint64_t durationTime = 0;
+        size_t scanned = 0;
+        for (int i = 0; i < batchSize; ++i) {
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            // walk all lines backward like the reader rollback does
+            size_t end = buffer.size() - 1;
+            while (end > 0) {
+                size_t pos = char_finder::FindLastChar(impl, buffer.data(), end, '\n');
+                end = pos == end ? 0 : pos;
+            }
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+            scanned += buffer.size();
+        }
+        std::cout << "line size: " << lineSize << "\t" << char_finder::GetImplName(impl) << ":\t\t"
+                  << formatSize(scanned * 1000000 / durationTime) << "/s" << std::endl;
+    }
+}
+
+static void BM_SplitLogString(size_t lineSize, int batchSize) {
+    PipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    Json::Value config;
+    config["SourceKey"] = "content";
+    ProcessorSplitLogStringNative processor;
+    processor.SetContext(ctx);
+    processor.SetMetricsRecordRef(ProcessorSplitLogStringNative::sName, "1");
+    if (!processor.Init(config)) {
+        std::cout << "init processor failed" << std::endl;
+        return;
+    }
+
+    std::string buffer = MakeLines(lineSize, 512 * 1024);
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; ++i) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        auto logEvent = eventGroup.AddLogEvent();
+        logEvent->SetContent(std::string("content"), buffer);
+        logEvent->SetPosition(0, buffer.size());
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processor.Process(eventGroup);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << "line size: " << lineSize << "\tsplit log string:\t"
+              << formatSize(buffer.size() * (uint64_t)batchSize * 1000000 / durationTime) << "/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    std::cout << "BM_FindAllChars" << std::endl;
+    for (size_t lineSize : {32, 128, 512, 4096}) {
+        BM_FindAllChars(lineSize, 100);
+    }
+    std::cout << "BM_FindLastChar" << std::endl;
+    for (size_t lineSize : {32, 128, 512, 4096}) {
+        BM_FindLastChar(lineSize, 100);
+    }
+    std::cout << "BM_SplitLogString" << std::endl;
+    for (size_t lineSize : {32, 128, 512, 4096}) {
+        BM_SplitLogString(lineSize, 100);
+    }
+    return 0;
+}
@@ -21,6 +21,7 @@
 #include "common/StringTools.h"
 #include "common/http/HttpResponse.h"
 #include "common/timer/Timer.h"
+#include "models/MetricEvent.h"
 #include "models/RawEvent.h"
 #include "prometheus/Constants.h"
 #include "prometheus/async/PromFuture.h"
@@ -37,6 +38,7 @@ public:
     void TestInitscrapeScheduler();
     void TestProcess();
     void TestStreamMetricWriteCallback();
+    void TestStreamParseMetricWriteCallback();
     void TestReceiveMessage();
 
     void TestScheduler();
@@ -188,6 +190,48 @@ void ScrapeSchedulerUnittest::TestStreamMetricWriteCallback() {
     APSARA_TEST_EQUAL("go_memstats_alloc_bytes_total 1.5159292e+08", res.GetEvents()[10].Cast<RawEvent>().GetContent());
 }
 
+void ScrapeSchedulerUnittest::TestStreamParseMetricWriteCallback() {
+    EventPool eventPool{true};
+    auto* body = new PromMetricResponseBody(&eventPool);
+    body->mParser = make_unique<TextParser>(true);
+    body->mParser->SetDefaultTimestamp(1715829785, 83000000);
+    HttpResponse httpResponse = HttpResponse(
+        body, [](void* ptr) { delete static_cast<PromMetricResponseBody*>(ptr); }, PromMetricWriteCallback);
+
+    // lines are split across chunks, and invalid lines are dropped
+    vector<string> chunks = {"# HELP go_gc_duration_seconds A summary of the pause duration.\n# TYPE go_gc_dur",
+                             "ation_seconds summary\ngo_gc_duration_seconds{quantile=\"0\"} 1.5531e-05\ngo_gc_",
+                             "duration_seconds{quanti",
+                             "le=\"0.25\"} 3.9357e-05 1715829785001\n",
+                             "invalid{ 1\n  go_goroutines 7\n",
+                             "go_info{version=\"go1.22.3\"} 1"};
+    for (auto& chunk : chunks) {
+        PromMetricWriteCallback(chunk.data(), (size_t)1, chunk.size(), (void*)body);
+    }
+    auto& res = body->mEventGroup;
+    APSARA_TEST_EQUAL(3UL, res.GetEvents().size());
+    body->FlushCache();
+    APSARA_TEST_EQUAL(4UL, res.GetEvents().size());
+    size_t rawSize = 0;
+    for (const auto& chunk : chunks) {
+        rawSize += chunk.size();
+    }
+    APSARA_TEST_EQUAL(rawSize, body->mRawSize);
+
+    const auto& e0 = res.GetEvents()[0].Cast<MetricEvent>();
+    APSARA_TEST_EQUAL("go_gc_duration_seconds", e0.GetName());
+    APSARA_TEST_EQUAL("go_gc_duration_seconds", e0.GetTag(prometheus::NAME));
+    APSARA_TEST_EQUAL("0", e0.GetTag("quantile"));
+    APSARA_TEST_EQUAL(1.5531e-05, e0.GetValue<UntypedSingleValue>()->mValue);
+    APSARA_TEST_EQUAL(1715829785, e0.GetTimestamp());
+    APSARA_TEST_EQUAL(83000000U, e0.GetTimestampNanosecond().value());
+    const auto& e1 = res.GetEvents()[1].Cast<MetricEvent>();
+    APSARA_TEST_EQUAL("0.25", e1.GetTag("quantile"));
+    APSARA_TEST_EQUAL(1000000U, e1.GetTimestampNanosecond().value());
+    APSARA_TEST_EQUAL("go_goroutines", res.GetEvents()[2].Cast<MetricEvent>().GetName());
+    APSARA_TEST_EQUAL("go1.22.3", res.GetEvents()[3].Cast<MetricEvent>().GetTag("version"));
+}
+
 void ScrapeSchedulerUnittest::TestReceiveMessage() {
     Labels labels;
     labels.Set(prometheus::ADDRESS_LABEL_NAME, "localhost:8080");
@@ -278,6 +322,7 @@ void ScrapeSchedulerUnittest::TestExactlyScrape() {
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestInitscrapeScheduler)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestProcess)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestStreamMetricWriteCallback)
+UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestStreamParseMetricWriteCallback)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestScheduler)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestQueueIsFull)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestExactlyScrape)
@@ -14,9 +14,16 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "models/RawEvent.h"
 #include "prometheus/labels/TextParser.h"
+#include "prometheus/schedulers/ScrapeScheduler.h"
 #include "unittest/Unittest.h"
 
 using namespace std;
@@ -27,6 +34,8 @@ class TextParserBenchmark : public testing::Test {
 public:
     void TestParse100M() const;
     void TestParse1000M() const;
+    void TestStreamParse100M() const;
+    void TestParseHistogram() const;
 
 protected:
     void SetUp() override {
@@ -47,6 +56,9 @@ protected:
     }
 
 private:
+    void ReceiveByChunk(const std::string& data, PromMetricResponseBody& body) const;
+
+    const size_t mChunkSize = 16 * 1024;
     std::string mRawData = R"""(
 test_metric1{k1="v1", k2="v2"} 2.0 1234567890
 test_metric2{k1="v1",k2="v2"} 9.9410452992e+10
@@ -87,8 +99,89 @@ void TextParserBenchmark::TestParse1000M() const {
     // elapsed: 4960MB in release mode
 }
 
+void TextParserBenchmark::ReceiveByChunk(const std::string& data, PromMetricResponseBody& body) const {
+    // curl delivers the response body in chunks, which split lines randomly
+    std::string chunk;
+    for (size_t pos = 0; pos < data.size(); pos += mChunkSize) {
+        chunk.assign(data, pos, std::min(mChunkSize, data.size() - pos));
+        PromMetricWriteCallback(chunk.data(), 1, chunk.size(), &body);
+    }
+    body.FlushCache();
+}
+
+// raw events are created in the http callback and parsed by processor, compared with parsing in the http callback
+void TextParserBenchmark::TestStreamParse100M() const {
+    size_t rawCnt = 0;
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        PromMetricResponseBody body(nullptr);
+        ReceiveByChunk(m100MData, body);
+        auto received = std::chrono::high_resolution_clock::now();
+
+        TextParser parser;
+        EventsContainer newEvents;
+        newEvents.reserve(body.mEventGroup.GetEvents().size());
+        for (auto& e : body.mEventGroup.MutableEvents()) {
+            auto metricEvent = body.mEventGroup.CreateMetricEvent();
+            if (parser.ParseLine(e.Cast<RawEvent>().GetContent(), *metricEvent)) {
+                newEvents.emplace_back(std::move(metricEvent), false, nullptr);
+            }
+        }
+        body.mEventGroup.MutableEvents().swap(newEvents);
+        rawCnt = body.mEventGroup.GetEvents().size();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> receiveElapsed = received - start;
+        std::chrono::duration<double> parseElapsed = end - received;
+        cout << "raw event then parse, receive: " << receiveElapsed.count()
+             << " seconds, parse: " << parseElapsed.count() << " seconds" << endl;
+    }
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        PromMetricResponseBody body(nullptr);
+        body.mParser = std::make_unique<TextParser>();
+        ReceiveByChunk(m100MData, body);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> elapsed = end - start;
+        cout << "stream parse, receive: " << elapsed.count() << " seconds" << endl;
+        APSARA_TEST_EQUAL(rawCnt, body.mEventGroup.GetEvents().size());
+    }
+}
+
+// a scrape of 10000 histogram series with 12 buckets each, as exposed by a typical http server, parsed with and
+// without merging the samples of one series into one event
+void TextParserBenchmark::TestParseHistogram() const {
+    const std::vector<std::string> bounds
+        = {"0.005", "0.01", "0.025", "0.05", "0.1", "0.25", "0.5", "1", "2.5", "5", "10", "+Inf"};
+    std::string data;
+    for (size_t i = 0; i < 10000; ++i) {
+        std::string labels = "method=\"GET\",path=\"/api/v1/item_" + std::to_string(i) + "\",code=\"200\"";
+        for (size_t j = 0; j < bounds.size(); ++j) {
+            data += "http_request_duration_seconds_bucket{" + labels + ",le=\"" + bounds[j] + "\"} "
+                + std::to_string(j * 10) + "\n";
+        }
+        data += "http_request_duration_seconds_sum{" + labels + "} 123.4\n";
+        data += "http_request_duration_seconds_count{" + labels + "} 110\n";
+    }
+
+    for (bool convert : {false, true}) {
+        auto start = std::chrono::high_resolution_clock::now();
+        TextParser parser;
+        parser.SetConvertClassicHistograms(convert);
+        auto res = parser.Parse(data, 0, 0);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> elapsed = end - start;
+        cout << (convert ? "merged" : "classic") << "\tevents: " << res.GetEvents().size()
+             << "\tdata size: " << res.DataSize() << "\telapsed: " << elapsed.count() << " seconds" << endl;
+        APSARA_TEST_EQUAL(convert ? 10000U : 140000U, res.GetEvents().size());
+    }
+}
+
 UNIT_TEST_CASE(TextParserBenchmark, TestParse100M)
 UNIT_TEST_CASE(TextParserBenchmark, TestParse1000M)
+UNIT_TEST_CASE(TextParserBenchmark, TestStreamParse100M)
+UNIT_TEST_CASE(TextParserBenchmark, TestParseHistogram)
 
 } // namespace logtail
 
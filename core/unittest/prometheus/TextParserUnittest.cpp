@@ -40,6 +40,8 @@ public:
     void TestParseSuccess();
 
     void TestHonorTimestamps();
+
+    void TestMergeHistogramsAndSummaries();
 };
 
 void TextParserUnittest::TestParseMultipleLines() const {
@@ -388,6 +390,88 @@ void TextParserUnittest::TestParseUnicodeLabelValue() {
 
 UNIT_TEST_CASE(TextParserUnittest, TestParseUnicodeLabelValue)
 
+void TextParserUnittest::TestMergeHistogramsAndSummaries() {
+    auto parser = TextParser();
+    parser.SetConvertClassicHistograms(true);
+    string rawData = R"""(
+# TYPE http_request_duration_seconds histogram
+http_request_duration_seconds_bucket{code="200",le="0.5"} 10
+http_request_duration_seconds_bucket{code="200",le="0.1"} 5
+http_request_duration_seconds_bucket{code="200",le="+Inf"} 12
+http_request_duration_seconds_sum{code="200"} 3.5
+http_request_duration_seconds_count{code="200"} 12
+http_request_duration_seconds_bucket{code="500",le="0.1"} 1
+http_request_duration_seconds_bucket{code="500",le="+Inf"} 2
+http_request_duration_seconds_sum{code="500"} 0.3
+http_request_duration_seconds_count{code="500"} 2
+# TYPE rpc_duration_seconds summary
+rpc_duration_seconds{quantile="0.5"} 0.01
+rpc_duration_seconds{quantile="0.99"} 0.2
+rpc_duration_seconds_sum 17.5
+rpc_duration_seconds_count 1000
+# incomplete histogram without _count is left as is
+incomplete_bucket{le="1"} 1
+incomplete_bucket{le="+Inf"} 1
+incomplete_sum 0.5
+plain_metric{le="1"} 1
+)""";
+    auto eGroup = parser.Parse(rawData, 0, 0);
+    const auto& events = eGroup.GetEvents();
+    APSARA_TEST_EQUAL_FATAL(7UL, events.size());
+
+    const auto& h1 = events[0].Cast<MetricEvent>();
+    APSARA_TEST_EQUAL("http_request_duration_seconds", h1.GetName().to_string());
+    APSARA_TEST_EQUAL("200", h1.GetTag("code").to_string());
+    APSARA_TEST_FALSE(h1.HasTag("le"));
+    APSARA_TEST_TRUE_FATAL(h1.Is<HistogramValue>());
+    const auto* hv1 = h1.GetValue<HistogramValue>();
+    APSARA_TEST_EQUAL(3UL, hv1->mBuckets.size());
+    // buckets are sorted by upper bound
+    APSARA_TEST_TRUE(IsDoubleEqual(0.1, hv1->mBuckets[0].first));
+    APSARA_TEST_TRUE(IsDoubleEqual(5, hv1->mBuckets[0].second));
+    APSARA_TEST_TRUE(IsDoubleEqual(0.5, hv1->mBuckets[1].first));
+    APSARA_TEST_TRUE(isinf(hv1->mBuckets[2].first));
+    APSARA_TEST_TRUE(IsDoubleEqual(3.5, hv1->mSum));
+    APSARA_TEST_TRUE(IsDoubleEqual(12, hv1->mCount));
+    APSARA_TEST_EQUAL(5UL, hv1->SampleCnt());
+
+    const auto& h2 = events[1].Cast<MetricEvent>();
+    APSARA_TEST_EQUAL("500", h2.GetTag("code").to_string());
+    APSARA_TEST_TRUE_FATAL(h2.Is<HistogramValue>());
+    APSARA_TEST_EQUAL(2UL, h2.GetValue<HistogramValue>()->mBuckets.size());
+
+    const auto& s = events[2].Cast<MetricEvent>();
+    APSARA_TEST_EQUAL("rpc_duration_seconds", s.GetName().to_string());
+    APSARA_TEST_FALSE(s.HasTag("quantile"));
+    APSARA_TEST_TRUE_FATAL(s.Is<SummaryValue>());
+    const auto* sv = s.GetValue<SummaryValue>();
+    APSARA_TEST_EQUAL(2UL, sv->mQuantiles.size());
+    APSARA_TEST_TRUE(IsDoubleEqual(0.99, sv->mQuantiles[1].first));
+    APSARA_TEST_TRUE(IsDoubleEqual(0.2, sv->mQuantiles[1].second));
+    APSARA_TEST_TRUE(IsDoubleEqual(17.5, sv->mSum));
+    APSARA_TEST_TRUE(IsDoubleEqual(1000, sv->mCount));
+
+    for (size_t i = 3; i < events.size(); ++i) {
+        APSARA_TEST_TRUE(events[i].Cast<MetricEvent>().Is<UntypedSingleValue>());
+    }
+    APSARA_TEST_EQUAL("incomplete_bucket", events[3].Cast<MetricEvent>().GetName().to_string());
+    APSARA_TEST_EQUAL("plain_metric", events[6].Cast<MetricEvent>().GetName().to_string());
+
+    // __name__ tag set by the processor follows the merged name
+    parser.SetConvertClassicHistograms(false);
+    eGroup = parser.Parse(rawData, 0, 0);
+    APSARA_TEST_EQUAL(17UL, eGroup.GetEvents().size());
+    for (auto& e : eGroup.MutableEvents()) {
+        e.Cast<MetricEvent>().SetTagNoCopy(StringView("__name__"), e.Cast<MetricEvent>().GetName());
+    }
+    TextParser::MergeHistogramsAndSummaries(eGroup.MutableEvents());
+    APSARA_TEST_EQUAL(7UL, eGroup.GetEvents().size());
+    APSARA_TEST_EQUAL("http_request_duration_seconds",
+                      eGroup.GetEvents()[0].Cast<MetricEvent>().GetTag("__name__").to_string());
+}
+
+UNIT_TEST_CASE(TextParserUnittest, TestMergeHistogramsAndSummaries)
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
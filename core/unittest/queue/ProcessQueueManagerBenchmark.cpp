@@ -0,0 +1,163 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/StringTools.h"
+#include "models/PipelineEventGroup.h"
+#include "pipeline/queue/ExactlyOnceQueueManager.h"
+#include "pipeline/queue/ProcessQueueManager.h"
+#include "pipeline/queue/QueueKeyManager.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// mQueueCnt pipelines exist and only some of them have data, which is the common case. Each processor thread pops an
+// item and pushes it back to the same queue, so the number of non-empty queues stays the same during the test. The
+// linear scan over all queues, as done before the ready set is introduced, is measured as the baseline.
+class ProcessQueueManagerBenchmark : public ::testing::Test {
+public:
+    void TestPopItem();
+
+protected:
+    static void SetUpTestCase() { sManager = ProcessQueueManager::GetInstance(); }
+
+    void TearDown() override {
+        QueueKeyManager::GetInstance()->Clear();
+        sManager->Clear();
+        ExactlyOnceQueueManager::GetInstance()->Clear();
+    }
+
+private:
+    void Run(size_t threadCnt, size_t activeQueueCnt, bool linearScan);
+    bool PopByLinearScan(unique_ptr<ProcessQueueItem>& item, string& configName);
+
+    static ProcessQueueManager* sManager;
+    static pair<size_t, ProcessQueueManager::ProcessQueueIterator> sCurrentQueueIndex;
+
+    const size_t mQueueCnt = 1000;
+    const size_t mPopCntPerThread = 200000;
+};
+
+ProcessQueueManager* ProcessQueueManagerBenchmark::sManager;
+pair<size_t, ProcessQueueManager::ProcessQueueIterator> ProcessQueueManagerBenchmark::sCurrentQueueIndex;
+
+// the scan starts from the queue next to the one popped last time, as PopItem did before the ready set is introduced
+bool ProcessQueueManagerBenchmark::PopByLinearScan(unique_ptr<ProcessQueueItem>& item, string& configName) {
+    lock_guard<mutex> lock(sManager->mQueueMux);
+    for (size_t i = 0; i <= ProcessQueueManager::sMaxPriority; ++i) {
+        auto& queues = sManager->mPriorityQueue[i];
+        if (queues.empty()) {
+            continue;
+        }
+        auto start = sCurrentQueueIndex.first == i ? sCurrentQueueIndex.second : queues.begin();
+        auto iter = start;
+        do {
+            auto& que = *iter;
+            if (++iter == queues.end()) {
+                iter = queues.begin();
+            }
+            if (que->Pop(item)) {
+                configName = que->GetConfigName();
+                if (que->Empty()) {
+                    sManager->RemoveReadyQueue(que->GetKey());
+                }
+                sCurrentQueueIndex = make_pair(i, iter);
+                return true;
+            }
+        } while (iter != start);
+    }
+    return false;
+}
+
+void ProcessQueueManagerBenchmark::Run(size_t threadCnt, size_t activeQueueCnt, bool linearScan) {
+    PipelineContext ctx;
+    vector<QueueKey> keys;
+    for (size_t i = 0; i < mQueueCnt; ++i) {
+        string configName = "test_config_" + ToString(i);
+        ctx.SetConfigName(configName);
+        QueueKey key = QueueKeyManager::GetInstance()->GetKey(configName);
+        sManager->CreateOrUpdateBoundedQueue(key, 0, ctx);
+        sManager->EnablePop(configName);
+        keys.push_back(key);
+    }
+    sCurrentQueueIndex = make_pair(ProcessQueueManager::sMaxPriority + 1, sManager->mPriorityQueue[0].end());
+    // active queues are spread among all queues, and are kept below high watermark so that pushing back never fails
+    size_t itemCntPerQueue = min(threadCnt, sManager->mBoundedQueueParam.GetHighWatermark() - 1);
+    for (size_t i = 0; i < activeQueueCnt; ++i) {
+        QueueKey key = keys[i * mQueueCnt / activeQueueCnt];
+        for (size_t j = 0; j < itemCntPerQueue; ++j) {
+            // the queue key is kept in the item so that it can be pushed back
+            PipelineEventGroup g(make_shared<SourceBuffer>());
+            sManager->PushQueue(key, make_unique<ProcessQueueItem>(std::move(g), key));
+        }
+    }
+
+    atomic_size_t missCnt(0);
+    vector<thread> threads;
+    auto start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back([&, i]() {
+            unique_ptr<ProcessQueueItem> item;
+            string configName;
+            for (size_t j = 0; j < mPopCntPerThread;) {
+                bool res = linearScan ? PopByLinearScan(item, configName) : sManager->PopItem(i, item, configName);
+                if (!res) {
+                    ++missCnt;
+                    continue;
+                }
+                ++j;
+                QueueKey key = item->mInputIndex;
+                sManager->PushQueue(key, std::move(item));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+
+    size_t popCnt = threadCnt * mPopCntPerThread;
+    cout << (linearScan ? "linear scan" : "ready set") << "\tthreads: " << threadCnt
+         << "\tactive queues: " << activeQueueCnt << "/" << mQueueCnt << "\tpops/s: " << popCnt / elapsed.count()
+         << "\tns/pop: " << elapsed.count() * 1e9 / popCnt << "\tmisses: " << missCnt << endl;
+
+    TearDown();
+}
+
+void ProcessQueueManagerBenchmark::TestPopItem() {
+    for (size_t threadCnt : {1, 8}) {
+        for (size_t activeQueueCnt : {1, 10, 100, 1000}) {
+            Run(threadCnt, activeQueueCnt, true);
+            Run(threadCnt, activeQueueCnt, false);
+        }
+    }
+}
+
+UNIT_TEST_CASE(ProcessQueueManagerBenchmark, TestPopItem)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -61,7 +61,6 @@ PipelineContext ProcessQueueManagerUnittest::sCtx;
 
 void ProcessQueueManagerUnittest::TestUpdateSameTypeQueue() {
     // create queue
-    //   and current index is invalid before creation
     QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_config_1");
     PipelineContext ctx;
     ctx.SetConfigName("test_config_1");
@@ -71,153 +70,108 @@ void ProcessQueueManagerUnittest::TestUpdateSameTypeQueue() {
     APSARA_TEST_EQUAL(1U, sProcessQueueManager->mPriorityQueue[0].size());
     auto iter = sProcessQueueManager->mQueues[key].first;
     APSARA_TEST_TRUE(iter == prev(sProcessQueueManager->mPriorityQueue[0].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == iter);
     APSARA_TEST_EQUAL(sProcessQueueManager->mBoundedQueueParam.GetCapacity(), (*iter)->mCapacity);
     APSARA_TEST_EQUAL(sProcessQueueManager->mBoundedQueueParam.GetLowWatermark(),
                       static_cast<BoundedProcessQueue*>(iter->get())->mLowWatermark);
     APSARA_TEST_EQUAL(sProcessQueueManager->mBoundedQueueParam.GetHighWatermark(),
                       static_cast<BoundedProcessQueue*>(iter->get())->mHighWatermark);
     APSARA_TEST_EQUAL("test_config_1", (*iter)->GetConfigName());
-
-    // create queue
-    //   and current index is valid before creation
-    APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(1, 0, sCtx));
-    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mQueues.size());
-    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mQueues[1].first == prev(sProcessQueueManager->mPriorityQueue[0].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[0].first);
+    // empty queue is not ready
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[0].empty());
 
     // add more queue
+    APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(1, 0, sCtx));
     APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(2, 0, sCtx));
-    APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(3, 0, sCtx));
-    sProcessQueueManager->mCurrentQueueIndex.second = sProcessQueueManager->mQueues[2].first;
+    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mQueues.size());
+    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mPriorityQueue[0].size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mQueues[2].first == prev(sProcessQueueManager->mPriorityQueue[0].end()));
+    sProcessQueueManager->PushQueue(1, GenerateItem());
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mReadyQueues[0].size());
 
     // update queue with same priority
     APSARA_TEST_FALSE(sProcessQueueManager->CreateOrUpdateBoundedQueue(0, 0, sCtx));
 
     // update queue with different priority
-    //   and current index not equal to the updated queue
+    //   and the updated queue is not ready
     APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(0, 1, sCtx));
-    APSARA_TEST_EQUAL(4U, sProcessQueueManager->mQueues.size());
-    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mPriorityQueue[0].size());
+    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mQueues.size());
+    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[0].size());
     APSARA_TEST_EQUAL(1U, sProcessQueueManager->mPriorityQueue[1].size());
     APSARA_TEST_TRUE(sProcessQueueManager->mQueues[0].first == prev(sProcessQueueManager->mPriorityQueue[1].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[2].first);
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mReadyQueues[0].size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[1].empty());
 
     // update queue with different priority
-    //   and current index equals to the updated queue
-    //     and the updated queue is not the last in the list
-    APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(2, 1, sCtx));
-    APSARA_TEST_EQUAL(4U, sProcessQueueManager->mQueues.size());
-    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[1].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mQueues[2].first == prev(sProcessQueueManager->mPriorityQueue[1].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[3].first);
-
-    // update queue with different priority
-    //   and current index equals to the updated queue
-    //     and the updated queue is the last in the list
-    //       and more queues exist
-    APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(3, 1, sCtx));
-    APSARA_TEST_EQUAL(4U, sProcessQueueManager->mQueues.size());
-    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mPriorityQueue[1].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mQueues[3].first == prev(sProcessQueueManager->mPriorityQueue[1].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[1].first);
-
-    // update queue with different priority
-    //   and current index equals to the updated queue
-    //     and the updated queue is the last in the list
-    //       and no more queue exists
+    //   and the updated queue is ready
     APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(1, 1, sCtx));
-    APSARA_TEST_EQUAL(4U, sProcessQueueManager->mQueues.size());
-    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_EQUAL(4U, sProcessQueueManager->mPriorityQueue[1].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mQueues[1].first == prev(sProcessQueueManager->mPriorityQueue[1].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mPriorityQueue[0].end());
-
-    // update queue with different priority
-    //   and current index is invalid before update
-    APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(0, 0, sCtx));
-    APSARA_TEST_EQUAL(4U, sProcessQueueManager->mQueues.size());
+    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mQueues.size());
     APSARA_TEST_EQUAL(1U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mPriorityQueue[1].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mQueues[0].first == prev(sProcessQueueManager->mPriorityQueue[0].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[0].first);
+    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[1].size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mQueues[1].first == prev(sProcessQueueManager->mPriorityQueue[1].end()));
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[0].empty());
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mReadyQueues[1].size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[1].front() == sProcessQueueManager->mQueues[1].first);
 }
 
 void ProcessQueueManagerUnittest::TestUpdateDifferentTypeQueue() {
     sProcessQueueManager->CreateOrUpdateBoundedQueue(0, 0, sCtx);
     sProcessQueueManager->CreateOrUpdateBoundedQueue(1, 0, sCtx);
+    sProcessQueueManager->PushQueue(0, GenerateItem());
+    sProcessQueueManager->PushQueue(1, GenerateItem());
 
-    // current index not equal to the updated queue
     APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateCircularQueue(1, 0, 100, sCtx));
     APSARA_TEST_EQUAL(2U, sProcessQueueManager->mQueues.size());
     APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[0].size());
     APSARA_TEST_TRUE(sProcessQueueManager->mQueues[1].first == prev(sProcessQueueManager->mPriorityQueue[0].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[0].first);
+    // the old queue is discarded, so it is no longer ready
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mReadyQueues[0].size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[0].front() == sProcessQueueManager->mQueues[0].first);
 
-    // current index equals to the updated queue
-    //   and the updated queue is not the last in the list
     APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateCircularQueue(0, 0, 100, sCtx));
     APSARA_TEST_EQUAL(2U, sProcessQueueManager->mQueues.size());
     APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[0].size());
     APSARA_TEST_TRUE(sProcessQueueManager->mQueues[0].first == prev(sProcessQueueManager->mPriorityQueue[0].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[1].first);
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[0].empty());
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueueIndex.empty());
 
-    // current index equals to the update queue
-    //   and the updated queue is the last in the list
-    sProcessQueueManager->mCurrentQueueIndex.second = prev(sProcessQueueManager->mPriorityQueue[0].end());
     APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(0, 0, sCtx));
     APSARA_TEST_EQUAL(2U, sProcessQueueManager->mQueues.size());
     APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[0].size());
     APSARA_TEST_TRUE(sProcessQueueManager->mQueues[0].first == prev(sProcessQueueManager->mPriorityQueue[0].end()));
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[1].first);
 }
 
 void ProcessQueueManagerUnittest::TestDeleteQueue() {
     QueueKey key1 = QueueKeyManager::GetInstance()->GetKey("test_config_1");
     QueueKey key2 = QueueKeyManager::GetInstance()->GetKey("test_config_2");
     QueueKey key3 = QueueKeyManager::GetInstance()->GetKey("test_config_3");
-    QueueKey key4 = QueueKeyManager::GetInstance()->GetKey("test_config_4");
     sProcessQueueManager->CreateOrUpdateBoundedQueue(key1, 0, sCtx);
     sProcessQueueManager->CreateOrUpdateBoundedQueue(key2, 0, sCtx);
     sProcessQueueManager->CreateOrUpdateBoundedQueue(key3, 0, sCtx);
-    sProcessQueueManager->CreateOrUpdateBoundedQueue(key4, 0, sCtx);
-    sProcessQueueManager->mCurrentQueueIndex.second = sProcessQueueManager->mQueues[key3].first;
+    sProcessQueueManager->PushQueue(key2, GenerateItem());
+    sProcessQueueManager->PushQueue(key3, GenerateItem());
 
-    // current index not equal to the deleted queue
+    // the deleted queue is not ready
     APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(key1));
-    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mQueues.size());
-    APSARA_TEST_EQUAL(3U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key3].first);
-    APSARA_TEST_EQUAL("", QueueKeyManager::GetInstance()->GetName(key1));
-
-    // current index equals to the deleted queue
-    //   and the deleted queue is not the last in the list
-    APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(key3));
     APSARA_TEST_EQUAL(2U, sProcessQueueManager->mQueues.size());
     APSARA_TEST_EQUAL(2U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key4].first);
-    APSARA_TEST_EQUAL("", QueueKeyManager::GetInstance()->GetName(key3));
+    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mReadyQueues[0].size());
+    APSARA_TEST_EQUAL("", QueueKeyManager::GetInstance()->GetName(key1));
 
-    // current index equals to the deleted queue
-    //   and the deleted queue is the last in the list
-    //     and more queues exist
-    APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(key4));
+    // the deleted queue is ready
+    APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(key2));
     APSARA_TEST_EQUAL(1U, sProcessQueueManager->mQueues.size());
     APSARA_TEST_EQUAL(1U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key2].first);
-    APSARA_TEST_EQUAL("", QueueKeyManager::GetInstance()->GetName(key4));
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mReadyQueues[0].size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[0].front() == sProcessQueueManager->mQueues[key3].first);
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mReadyQueueIndex.count(key3));
+    APSARA_TEST_EQUAL("", QueueKeyManager::GetInstance()->GetName(key2));
 
-    // current index equals to the deleted queue
-    //   and the deleted queue is the last in the list
-    //     and no more queue exists
-    APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(key2));
+    APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(key3));
     APSARA_TEST_EQUAL(0U, sProcessQueueManager->mQueues.size());
     APSARA_TEST_EQUAL(0U, sProcessQueueManager->mPriorityQueue[0].size());
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mPriorityQueue[0].end());
-    APSARA_TEST_EQUAL("", QueueKeyManager::GetInstance()->GetName(key2));
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[0].empty());
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueueIndex.empty());
+    APSARA_TEST_EQUAL("", QueueKeyManager::GetInstance()->GetName(key3));
 
     // queue not exist
     APSARA_TEST_FALSE(sProcessQueueManager->DeleteQueue(key1));
@@ -285,42 +239,50 @@ void ProcessQueueManagerUnittest::TestPopItem() {
     ExactlyOnceQueueManager::GetInstance()->CreateOrUpdateQueue(5, 0, ctx, vector<RangeCheckpointPtr>(5));
     ExactlyOnceQueueManager::GetInstance()->EnablePopProcessQueue("test_config_5");
 
+    sProcessQueueManager->PushQueue(key3, GenerateItem());
+    sProcessQueueManager->PushQueue(key2, GenerateItem());
     sProcessQueueManager->PushQueue(key2, GenerateItem());
     sProcessQueueManager->PushQueue(key3, GenerateItem());
-    sProcessQueueManager->mCurrentQueueIndex = {1, prev(prev(sProcessQueueManager->mPriorityQueue[1].end()))};
+    APSARA_TEST_EQUAL(2U, sProcessQueueManager->mReadyQueues[1].size());
 
-    // the item comes from the queue between current index and queue list end
+    // queues are visited in the order they become non-empty
     APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
     APSARA_TEST_EQUAL("test_config_3", configName);
-    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mCurrentQueueIndex.first);
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key4].first);
+    // the popped queue is moved to the end
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[1].back() == sProcessQueueManager->mQueues[key3].first);
 
-    // the item comes from the queue between queue list and current index
     APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
     APSARA_TEST_EQUAL("test_config_2", configName);
-    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mCurrentQueueIndex.first);
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key3].first);
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[1].back() == sProcessQueueManager->mQueues[key2].first);
 
     sProcessQueueManager->PushQueue(key1, GenerateItem());
-    // the item comes from queue list other than the one pointed by current index
+    // the item comes from queues with higher priority first
     APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
     APSARA_TEST_EQUAL("test_config_1", configName);
-    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mCurrentQueueIndex.first);
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key1].first);
+    // the queue becomes empty and is no longer ready
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[0].empty());
+    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mReadyQueueIndex.count(key1));
+
+    // queue not valid to pop is skipped
+    sProcessQueueManager->DisablePop("test_config_3", true);
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL("test_config_2", configName);
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mReadyQueues[1].size());
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[1].front() == sProcessQueueManager->mQueues[key3].first);
 
-    sProcessQueueManager->mCurrentQueueIndex = {1, prev(sProcessQueueManager->mPriorityQueue[1].end())};
     sProcessQueueManager->PushQueue(5, GenerateItem());
     // the item comes from exactly once queue
     APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
     APSARA_TEST_EQUAL("test_config_5", configName);
-    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mCurrentQueueIndex.first);
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key1].first);
 
-    sProcessQueueManager->mCurrentQueueIndex = {1, prev(sProcessQueueManager->mPriorityQueue[1].end())};
     // no item
     APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName));
-    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mCurrentQueueIndex.first);
-    APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key1].first);
+
+    sProcessQueueManager->EnablePop("test_config_3");
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL("test_config_3", configName);
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueues[1].empty());
+    APSARA_TEST_TRUE(sProcessQueueManager->mReadyQueueIndex.empty());
 }
 
 void ProcessQueueManagerUnittest::TestIsAllQueueEmpty() {
@@ -70,6 +70,7 @@ public:
     }
     void TestReadGBK();
     void TestReadUTF8();
+    void TestReadWithPrefetchedData();
 
     std::unique_ptr<char[]> expectedContent;
     static std::string logPathDir;
@@ -82,6 +83,7 @@ public:
 
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadGBK);
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestReadWithPrefetchedData);
 
 std::string LogFileReaderUnittest::logPathDir;
 std::string LogFileReaderUnittest::gbkFile;
@@ -506,6 +508,48 @@ void LogFileReaderUnittest::TestReadUTF8() {
     }
 }
 
+void LogFileReaderUnittest::TestReadWithPrefetchedData() {
+    std::string content;
+    {
+        std::ifstream fin(logPathDir + PATH_SEPARATOR + utf8File, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+    }
+    { // prefetched data is used and the rest is read by pread
+        MultilineOptions multilineOpts;
+        LogFileReader reader(
+            logPathDir, utf8File, DevInode(), std::make_pair(&readerOpts, &ctx), std::make_pair(&multilineOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        reader.CheckFileSignatureAndOffset(true);
+        int fd = -1;
+        int64_t offset = -1;
+        size_t size = 0;
+        APSARA_TEST_TRUE_FATAL(reader.GetNextReadRange(fd, offset, size));
+        APSARA_TEST_EQUAL_FATAL(0, offset);
+        reader.SetPrefetchedData(0, content.data(), content.size() / 2, false);
+        LogBuffer logBuffer;
+        bool moreData = false;
+        reader.ReadUTF8(logBuffer, reader.mLogFileOp.GetFileSize(), moreData);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        APSARA_TEST_STREQ_FATAL(expectedContent.get(), logBuffer.rawBuffer.data());
+        APSARA_TEST_EQUAL_FATAL(nullptr, reader.mPrefetchedData);
+    }
+    { // prefetched data with mismatched offset is ignored
+        MultilineOptions multilineOpts;
+        LogFileReader reader(
+            logPathDir, utf8File, DevInode(), std::make_pair(&readerOpts, &ctx), std::make_pair(&multilineOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        reader.CheckFileSignatureAndOffset(true);
+        std::string fake(content.size(), 'x');
+        reader.SetPrefetchedData(1, fake.data(), fake.size(), true);
+        LogBuffer logBuffer;
+        bool moreData = false;
+        reader.ReadUTF8(logBuffer, reader.mLogFileOp.GetFileSize(), moreData);
+        APSARA_TEST_STREQ_FATAL(expectedContent.get(), logBuffer.rawBuffer.data());
+    }
+}
+
 class LogMultiBytesUnittest : public ::testing::Test {
 public:
     static void SetUpTestCase() {
@@ -0,0 +1,104 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "sdk/Common.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// the same body is sent mTryCnt times, as happens when the backend is throttling. Previously the body was hashed with
+// DoMd5 twice on each try (for Content-MD5 and for the signature), now it is hashed once per item.
+class SDKMd5Benchmark : public ::testing::Test {
+public:
+    void TestRetry();
+
+private:
+    const size_t mBodySize = 1024 * 1024;
+    const size_t mItemCnt = 20;
+    const size_t mTryCnt = 10;
+};
+
+static string DoMd5ToString(const string& body) {
+    uint8_t md5[sdk::MD5_BYTES];
+    sdk::DoMd5(reinterpret_cast<const uint8_t*>(body.data()), body.size(), md5);
+    static const char* table = "0123456789ABCDEF";
+    string res(32, 'a');
+    for (int i = 0; i < 16; ++i) {
+        res[i * 2] = table[md5[i] >> 4];
+        res[i * 2 + 1] = table[md5[i] & 0x0F];
+    }
+    return res;
+}
+
+void SDKMd5Benchmark::TestRetry() {
+    mt19937 rng(0);
+    string body(mBodySize, '\0');
+    for (auto& c : body) {
+        c = static_cast<char>(rng());
+    }
+    APSARA_TEST_EQUAL(DoMd5ToString(body), sdk::CalcMD5(body));
+
+    string digest;
+    auto start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < mItemCnt; ++i) {
+        for (size_t j = 0; j < mTryCnt; ++j) {
+            digest = DoMd5ToString(body);
+            digest = DoMd5ToString(body);
+        }
+    }
+    chrono::duration<double> before = chrono::high_resolution_clock::now() - start;
+
+    start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < mItemCnt; ++i) {
+        string cached;
+        for (size_t j = 0; j < mTryCnt; ++j) {
+            if (cached.empty()) {
+                cached = sdk::CalcMD5(body);
+            }
+            digest = cached;
+        }
+    }
+    chrono::duration<double> after = chrono::high_resolution_clock::now() - start;
+
+    start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < mItemCnt; ++i) {
+        digest = DoMd5ToString(body);
+    }
+    chrono::duration<double> doMd5 = chrono::high_resolution_clock::now() - start;
+    start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < mItemCnt; ++i) {
+        digest = sdk::CalcMD5(body);
+    }
+    chrono::duration<double> calcMd5 = chrono::high_resolution_clock::now() - start;
+
+    double totalMB = mBodySize * mItemCnt / 1024.0 / 1024.0;
+    cout << "DoMd5 throughput: " << totalMB / doMd5.count() << " MB/s" << endl;
+    cout << "CalcMD5 throughput: " << totalMB / calcMd5.count() << " MB/s" << endl;
+    cout << "items: " << mItemCnt << "\ttries: " << mTryCnt << "\tbody size: " << mBodySize << endl;
+    cout << "hashing time before: " << before.count() * 1000 << " ms\tafter: " << after.count() * 1000 << " ms"
+         << endl;
+}
+
+UNIT_TEST_CASE(SDKMd5Benchmark, TestRetry)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
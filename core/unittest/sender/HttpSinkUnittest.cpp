@@ -0,0 +1,95 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runner/sink/http/HttpSink.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(http_sink_max_idle_handlers_per_host);
+
+using namespace std;
+
+namespace logtail {
+
+class HttpSinkUnittest : public ::testing::Test {
+public:
+    void TestHandlerPool();
+    void TestBorrowedBody();
+
+protected:
+    static void SetUpTestCase() { HttpSink::GetInstance()->Init(); }
+
+    static void TearDownTestCase() { HttpSink::GetInstance()->Stop(); }
+
+    void TearDown() override {
+        HttpSink::GetInstance()->ClearHandlerPool();
+        HttpSink::GetInstance()->mHandlerPoolHitCnt = 0;
+        HttpSink::GetInstance()->mHandlerPoolMissCnt = 0;
+    }
+};
+
+void HttpSinkUnittest::TestHandlerPool() {
+    HttpSink* sink = HttpSink::GetInstance();
+    APSARA_TEST_NOT_EQUAL(nullptr, sink->mShare);
+
+    // empty pool
+    APSARA_TEST_EQUAL(nullptr, sink->AcquireHandler("host1"));
+    APSARA_TEST_EQUAL(0.0, sink->mHandlerPoolHitRate->GetValue());
+
+    CURL* handler1 = curl_easy_init();
+    CURL* handler2 = curl_easy_init();
+    sink->ReleaseHandler("host1", handler1);
+    sink->ReleaseHandler("host2", handler2);
+    APSARA_TEST_EQUAL(2U, sink->mPooledHandlersTotal->GetValue());
+
+    // handlers are pooled by host
+    APSARA_TEST_EQUAL(handler1, sink->AcquireHandler("host1"));
+    APSARA_TEST_EQUAL(nullptr, sink->AcquireHandler("host1"));
+    APSARA_TEST_EQUAL(handler2, sink->AcquireHandler("host2"));
+    APSARA_TEST_EQUAL(0U, sink->mPooledHandlersTotal->GetValue());
+    APSARA_TEST_EQUAL(0.5, sink->mHandlerPoolHitRate->GetValue());
+
+    // idle handlers exceeding the limit are cleaned up
+    INT32_FLAG(http_sink_max_idle_handlers_per_host) = 1;
+    sink->ReleaseHandler("host1", handler1);
+    sink->ReleaseHandler("host1", handler2);
+    APSARA_TEST_EQUAL(1U, sink->mHandlerPool["host1"].size());
+    APSARA_TEST_EQUAL(1U, sink->mPooledHandlersTotal->GetValue());
+    INT32_FLAG(http_sink_max_idle_handlers_per_host) = 64;
+}
+
+void HttpSinkUnittest::TestBorrowedBody() {
+    SenderQueueItem item(string(1024 * 1024, 'a'), 1024 * 1024, nullptr, 0);
+    {
+        // the data of the item is referenced by the request
+        HttpSinkRequest request("POST", false, "host", 80, "/", "", {}, item.mData, &item);
+        APSARA_TEST_EQUAL(&item.mData, &request.GetBody());
+        APSARA_TEST_TRUE(request.mBody.empty());
+    }
+    {
+        // other body is copied
+        string body = "body";
+        HttpSinkRequest request("POST", false, "host", 80, "/", "", {}, body, &item);
+        APSARA_TEST_EQUAL(body, request.GetBody());
+        APSARA_TEST_NOT_EQUAL(&body, &request.GetBody());
+        HttpSinkRequest requestWithoutItem("POST", false, "host", 80, "/", "", {}, body, nullptr);
+        APSARA_TEST_EQUAL(body, requestWithoutItem.GetBody());
+    }
+}
+
+UNIT_TEST_CASE(HttpSinkUnittest, TestHandlerPool)
+UNIT_TEST_CASE(HttpSinkUnittest, TestBorrowedBody)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,155 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <json/json.h>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "common/TimeUtil.h"
+#include "pipeline/serializer/JsonSerializer.h"
+#include "protobuf/sls/LogGroupSerializer.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+using namespace logtail;
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+// the original Json::Value based implementation, kept as the baseline
+static void SerializeByJsonValue(const BatchedEvents& group, std::string& res) {
+    Json::Value groupTags;
+    for (const auto& tag : group.mTags.mInner) {
+        groupTags[tag.first.to_string()] = tag.second.to_string();
+    }
+    std::ostringstream oss;
+    for (size_t i = 0; i < group.mEvents.size(); ++i) {
+        if (group.mEvents[i]->GetType() == PipelineEvent::Type::LOG) {
+            const auto& e = group.mEvents[i].Cast<LogEvent>();
+            Json::Value eventJson;
+            eventJson.copy(groupTags);
+            eventJson["__time__"] = e.GetTimestamp();
+            for (const auto& kv : e) {
+                eventJson[kv.first.to_string()] = kv.second.to_string();
+            }
+            Json::StreamWriterBuilder writer;
+            writer["indentation"] = "";
+            oss << Json::writeString(writer, eventJson);
+        } else {
+            const auto& e = group.mEvents[i].Cast<MetricEvent>();
+            Json::Value eventJson;
+            eventJson.copy(groupTags);
+            eventJson["__time__"] = e.GetTimestamp();
+            eventJson[METRIC_RESERVED_KEY_LABELS] = Json::Value();
+            for (auto tag = e.TagsBegin(); tag != e.TagsEnd(); tag++) {
+                eventJson[METRIC_RESERVED_KEY_LABELS][tag->first.to_string()] = tag->second.to_string();
+            }
+            eventJson[METRIC_RESERVED_KEY_NAME] = e.GetName().to_string();
+            eventJson[METRIC_RESERVED_KEY_VALUE] = e.GetValue<UntypedSingleValue>()->mValue;
+            Json::StreamWriterBuilder writer;
+            writer["indentation"] = "";
+            oss << Json::writeString(writer, eventJson);
+        }
+    }
+    res = oss.str();
+}
+
+static PipelineEventGroup CreateEventGroup(bool isMetric, size_t eventCnt, size_t contentCnt) {
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    group.SetTag(std::string("__path__"), std::string("/var/log/test.log"));
+    group.SetTag(std::string("__hostname__"), std::string("test-host"));
+    for (size_t i = 0; i < eventCnt; ++i) {
+        if (isMetric) {
+            auto e = group.AddMetricEvent();
+            e->SetName("test_metric");
+            for (size_t j = 0; j < contentCnt; ++j) {
+                e->SetTag("label_" + std::to_string(j), "value_" + std::to_string(j));
+            }
+            e->SetTimestamp(1234567890);
+            e->SetValue<UntypedSingleValue>(i * 0.5);
+        } else {
+            auto e = group.AddLogEvent();
+            for (size_t j = 0; j < contentCnt; ++j) {
+                e->SetContent("key_" + std::to_string(j), "value \"" + std::to_string(j) + "\" " + std::string(50, 'a'));
+            }
+            e->SetTimestamp(1234567890);
+        }
+    }
+    return group;
+}
+
+static BatchedEvents ToBatch(PipelineEventGroup&& group) {
+    return BatchedEvents(std::move(group.MutableEvents()),
+                         std::move(group.GetSizedTags()),
+                         std::move(group.GetSourceBuffer()),
+                         group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                         std::move(group.GetExactlyOnceCheckpoint()));
+}
+
+static void BM_Serialize(bool isMetric, size_t contentCnt, int batchSize) {
+    PipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    FlusherMock flusher;
+    flusher.SetContext(ctx);
+    flusher.SetMetricsRecordRef(FlusherMock::sName, "1");
+    JsonEventGroupSerializer serializer(&flusher);
+
+    const size_t eventCnt = 1000;
+    std::string res, errorMsg;
+    uint64_t jsonValueTime = 0, streamingTime = 0, outputSize = 0;
+    for (int i = 0; i < batchSize; ++i) {
+        BatchedEvents batch = ToBatch(CreateEventGroup(isMetric, eventCnt, contentCnt));
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        SerializeByJsonValue(batch, res);
+        jsonValueTime += GetCurrentTimeInMicroSeconds() - startTime;
+
+        startTime = GetCurrentTimeInMicroSeconds();
+        serializer.DoSerialize(std::move(batch), res, errorMsg);
+        streamingTime += GetCurrentTimeInMicroSeconds() - startTime;
+        outputSize += res.size();
+    }
+    std::cout << (isMetric ? "metric" : "log") << "\tcontents: " << contentCnt << "\tjson value:\t"
+              << formatSize(outputSize * 1000000 / jsonValueTime) << "/s"
+              << "\tstreaming:\t" << formatSize(outputSize * 1000000 / streamingTime) << "/s"
+              << "\tspeedup: " << std::fixed << std::setprecision(1) << double(jsonValueTime) / streamingTime
+              << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    for (size_t contentCnt : {1, 5, 20}) {
+        BM_Serialize(false, contentCnt, 100);
+    }
+    for (size_t contentCnt : {1, 5, 20}) {
+        BM_Serialize(true, contentCnt, 100);
+    }
+    return 0;
+}
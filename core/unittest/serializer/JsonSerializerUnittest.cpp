@@ -0,0 +1,335 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <json/json.h>
+
+#include <limits>
+
+#include "pipeline/serializer/JsonSerializer.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+using namespace std;
+
+namespace logtail {
+
+class JsonSerializerUnittest : public ::testing::Test {
+public:
+    void TestSerializeLogEvents();
+    void TestSerializeLogEventsWithDuplicatedKeys();
+    void TestSerializeLogEventsAsJsoncpp();
+    void TestSerializeMetricEvents();
+    void TestSerializeMetricEventsAsJsoncpp();
+    void TestSerializeSpanEvents();
+    void TestSerializeEmptyGroup();
+
+protected:
+    static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
+
+    void SetUp() override {
+        mCtx.SetConfigName("test_config");
+        sFlusher->SetContext(mCtx);
+        sFlusher->SetMetricsRecordRef(FlusherMock::sName, "1");
+    }
+
+private:
+    BatchedEvents CreateBatch(PipelineEventGroup& group);
+    // the output of the serializer based on Json::Value, which is to be kept
+    string SerializeByJsoncpp(const PipelineEventGroup& group);
+
+    static unique_ptr<FlusherMock> sFlusher;
+
+    PipelineContext mCtx;
+};
+
+unique_ptr<FlusherMock> JsonSerializerUnittest::sFlusher;
+
+void JsonSerializerUnittest::TestSerializeLogEvents() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("tag_key"), string("tag_value"));
+    LogEvent* e = group.AddLogEvent();
+    e->SetContent(string("key"), string("value\n\"quoted\"\\\t\x01"));
+    e->SetTimestamp(1234567890);
+    e = group.AddLogEvent();
+    e->SetContent(string("key1"), string("value1"));
+    e->SetContent(string("key2"), string("\xe4\xb8\xad"));
+    e->SetTimestamp(1234567891);
+
+    string res("reused buffer"), errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(CreateBatch(group), res, errorMsg));
+    // keys are sorted and non-ascii characters are escaped, as jsoncpp does
+    APSARA_TEST_EQUAL("{\"__time__\":1234567890,\"key\":\"value\\n\\\"quoted\\\"\\\\\\t\\u0001\","
+                      "\"tag_key\":\"tag_value\"}"
+                      "{\"__time__\":1234567891,\"key1\":\"value1\",\"key2\":\"\\u4e2d\",\"tag_key\":\"tag_value\"}",
+                      res);
+}
+
+void JsonSerializerUnittest::TestSerializeLogEventsWithDuplicatedKeys() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("tag1"), string("tag_value1"));
+    group.SetTag(string("tag2"), string("tag_value2"));
+    // content overrides group tag
+    LogEvent* e = group.AddLogEvent();
+    e->SetContent(string("tag1"), string("value"));
+    e->SetTimestamp(1234567890);
+    // content overrides time
+    e = group.AddLogEvent();
+    e->SetContent(string("__time__"), string("value"));
+    e->SetContent(string("key"), string("value"));
+    e->SetTimestamp(1234567891);
+    // no duplicated key
+    e = group.AddLogEvent();
+    e->SetContent(string("key"), string("value"));
+    e->SetTimestamp(1234567892);
+
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(CreateBatch(group), res, errorMsg));
+    APSARA_TEST_EQUAL("{\"__time__\":1234567890,\"tag1\":\"value\",\"tag2\":\"tag_value2\"}"
+                      "{\"__time__\":\"value\",\"key\":\"value\",\"tag1\":\"tag_value1\",\"tag2\":\"tag_value2\"}"
+                      "{\"__time__\":1234567892,\"key\":\"value\",\"tag1\":\"tag_value1\",\"tag2\":\"tag_value2\"}",
+                      res);
+}
+
+void JsonSerializerUnittest::TestSerializeLogEventsAsJsoncpp() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("tag"), string("tag\x1fvalue"));
+    group.SetTag(string("__time__"), string("tag_time"));
+    group.SetTag(string("dup"), string("tag_dup"));
+    group.SetTag(string("\xe4\xb8\xad"), string("\xe6\x96\x87"));
+    // control characters
+    LogEvent* e = group.AddLogEvent();
+    string controls;
+    for (int c = 0; c < 0x20; ++c) {
+        controls.push_back(static_cast<char>(c));
+    }
+    controls += "\x7f\"\\/";
+    e->SetContent(string("controls"), controls);
+    e->SetContent(string("key\n\t"), string("value"));
+    e->SetTimestamp(1234567890);
+    // non-ascii characters, including 4-byte and invalid utf-8 sequences
+    e = group.AddLogEvent();
+    e->SetContent(string("\xe4\xb8\xad\xe6\x96\x87"), string("\xe4\xb8\xad\xe6\x96\x87 caf\xc3\xa9"));
+    e->SetContent(string("emoji"), string("\xf0\x9f\x98\x80"));
+    e->SetContent(string("invalid"), string("\xff\xc3(\xed\xa0\x80\xe4\xb8"));
+    e->SetTimestamp(1234567891);
+    // duplicated keys
+    e = group.AddLogEvent();
+    e->SetContent(string("dup"), string("content_dup"));
+    e->SetContent(string("__time__"), string("content_time"));
+    e->SetTimestamp(1234567892);
+    // key order
+    e = group.AddLogEvent();
+    for (const auto& key : {"b", "B", "a", "A1", "_", "\x7f", "\xc3\xa9", "ab", "a\x01"}) {
+        e->SetContent(string(key), string("value"));
+    }
+    e->SetTimestamp(1234567893);
+
+    string expected = SerializeByJsoncpp(group);
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(CreateBatch(group), res, errorMsg));
+    APSARA_TEST_EQUAL(expected, res);
+}
+
+void JsonSerializerUnittest::TestSerializeMetricEvents() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("tag_key"), string("tag_value"));
+    // single value
+    MetricEvent* e = group.AddMetricEvent();
+    e->SetName("single");
+    e->SetTag(string("label1"), string("value1"));
+    e->SetTag(string("label2"), string("value2"));
+    e->SetTimestamp(1234567890);
+    e->SetValue<UntypedSingleValue>(0.1);
+    // integral value without label
+    e = group.AddMetricEvent();
+    e->SetName("integral");
+    e->SetTimestamp(1234567890);
+    e->SetValue<UntypedSingleValue>(2.0);
+    // multi values
+    e = group.AddMetricEvent();
+    e->SetName("multi");
+    e->SetTimestamp(1234567890);
+    e->SetValue(map<StringView, double>{{"v1", 1.5}, {"v2", 3.0}});
+    // histogram
+    e = group.AddMetricEvent();
+    e->SetName("histogram");
+    e->SetTimestamp(1234567890);
+    e->SetValue(HistogramValue{{{0.5, 1.0}, {numeric_limits<double>::infinity(), 2.0}}, 1.5, 2.0});
+    // summary
+    e = group.AddMetricEvent();
+    e->SetName("summary");
+    e->SetTimestamp(1234567890);
+    e->SetValue(SummaryValue{{{0.5, 0.25}, {0.99, 1.0}}, 1.5, 3.0});
+    // no value, ignored
+    e = group.AddMetricEvent();
+    e->SetName("empty");
+
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(CreateBatch(group), res, errorMsg));
+    APSARA_TEST_EQUAL("{\"__labels__\":{\"label1\":\"value1\",\"label2\":\"value2\"},"
+                      "\"__name__\":\"single\",\"__time__\":1234567890,\"__value__\":0.10000000000000001,"
+                      "\"tag_key\":\"tag_value\"}"
+                      "{\"__labels__\":null,\"__name__\":\"integral\",\"__time__\":1234567890,\"__value__\":2.0,"
+                      "\"tag_key\":\"tag_value\"}"
+                      "{\"__labels__\":null,\"__name__\":\"multi\",\"__time__\":1234567890,"
+                      "\"__value__\":{\"v1\":1.5,\"v2\":3.0},\"tag_key\":\"tag_value\"}"
+                      "{\"__labels__\":null,\"__name__\":\"histogram\",\"__time__\":1234567890,"
+                      "\"__value__\":{\"sum\":1.5,\"count\":2.0,\"buckets\":{\"0.5\":1.0,\"+Inf\":2.0}},"
+                      "\"tag_key\":\"tag_value\"}"
+                      "{\"__labels__\":null,\"__name__\":\"summary\",\"__time__\":1234567890,"
+                      "\"__value__\":{\"sum\":1.5,\"count\":3.0,\"quantiles\":{\"0.5\":0.25,\"0.99\":1.0}},"
+                      "\"tag_key\":\"tag_value\"}",
+                      res);
+}
+
+void JsonSerializerUnittest::TestSerializeMetricEventsAsJsoncpp() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("__name__"), string("tag_name"));
+    group.SetTag(string("_tag"), string("\xe4\xb8\xad\n"));
+    group.SetTag(string("tag"), string("value"));
+    MetricEvent* e = group.AddMetricEvent();
+    e->SetName("single\t\xe6\x96\x87");
+    e->SetTag(string("b"), string("\x01"));
+    e->SetTag(string("a"), string("\xf0\x9f\x98\x80"));
+    e->SetTimestamp(1234567890);
+    e->SetValue<UntypedSingleValue>(1e-7);
+    e = group.AddMetricEvent();
+    e->SetName("multi");
+    e->SetTimestamp(1234567891);
+    e->SetValue(map<StringView, double>{{"v2", -3.0}, {"v1", 12345678901234.5}});
+    e = group.AddMetricEvent();
+    e->SetName("integral");
+    e->SetTimestamp(1234567892);
+    e->SetValue<UntypedSingleValue>(100.0);
+
+    string expected = SerializeByJsoncpp(group);
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(CreateBatch(group), res, errorMsg));
+    APSARA_TEST_EQUAL(expected, res);
+}
+
+void JsonSerializerUnittest::TestSerializeSpanEvents() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("tag_key"), string("tag_value"));
+    SpanEvent* e = group.AddSpanEvent();
+    e->SetTraceId("trace");
+    e->SetSpanId("span");
+    e->SetParentSpanId("parent");
+    e->SetName("name");
+    e->SetKind(SpanEvent::Kind::Client);
+    e->SetStatus(SpanEvent::StatusCode::Ok);
+    e->SetTraceState("state");
+    e->SetTag(string("key"), string("value"));
+    e->SetScopeTag(string("scope_key"), string("scope_value"));
+    auto link = e->AddLink();
+    link->SetTraceId("link_trace");
+    link->SetSpanId("link_span");
+    link->SetTag(string("link_key"), string("link_value"));
+    auto inner = e->AddEvent();
+    inner->SetName("inner");
+    inner->SetTimestampNs(1500);
+    e->SetStartTimeNs(1000);
+    e->SetEndTimeNs(2000);
+    e->SetTimestamp(1234567890);
+
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(CreateBatch(group), res, errorMsg));
+    APSARA_TEST_EQUAL(
+        "{\"tag_key\":\"tag_value\",\"__time__\":1234567890,\"traceId\":\"trace\",\"spanId\":\"span\","
+        "\"parentSpanId\":\"parent\",\"spanName\":\"name\",\"kind\":\""
+            + GetKindString(SpanEvent::Kind::Client) + "\",\"statusCode\":\""
+            + GetStatusString(SpanEvent::StatusCode::Ok)
+            + "\",\"traceState\":\"state\",\"attributes\":{\"key\":\"value\",\"scope_key\":\"scope_value\"},"
+              "\"links\":[{\"traceId\":\"link_trace\",\"spanId\":\"link_span\",\"traceState\":\"\","
+              "\"attributes\":{\"link_key\":\"link_value\"}}],"
+              "\"events\":[{\"name\":\"inner\",\"timestamp\":1500,\"attributes\":{}}],"
+              "\"startTime\":1000,\"endTime\":2000,\"duration\":1000}",
+        res);
+}
+
+void JsonSerializerUnittest::TestSerializeEmptyGroup() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    string res, errorMsg;
+    APSARA_TEST_FALSE(serializer.DoSerialize(CreateBatch(group), res, errorMsg));
+    APSARA_TEST_EQUAL("empty event group", errorMsg);
+}
+
+BatchedEvents JsonSerializerUnittest::CreateBatch(PipelineEventGroup& group) {
+    BatchedEvents batch(std::move(group.MutableEvents()),
+                        std::move(group.GetSizedTags()),
+                        std::move(group.GetSourceBuffer()),
+                        group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                        std::move(group.GetExactlyOnceCheckpoint()));
+    return batch;
+}
+
+string JsonSerializerUnittest::SerializeByJsoncpp(const PipelineEventGroup& group) {
+    Json::Value groupTags;
+    for (const auto& tag : group.GetTags()) {
+        groupTags[tag.first.to_string()] = tag.second.to_string();
+    }
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    string res;
+    for (const auto& event : group.GetEvents()) {
+        Json::Value eventJson;
+        eventJson.copy(groupTags);
+        if (event->GetType() == PipelineEvent::Type::LOG) {
+            const auto& e = event.Cast<LogEvent>();
+            eventJson["__time__"] = e.GetTimestamp();
+            for (const auto& kv : e) {
+                eventJson[kv.first.to_string()] = kv.second.to_string();
+            }
+        } else {
+            const auto& e = event.Cast<MetricEvent>();
+            eventJson["__time__"] = e.GetTimestamp();
+            eventJson["__labels__"] = Json::Value();
+            for (auto tag = e.TagsBegin(); tag != e.TagsEnd(); tag++) {
+                eventJson["__labels__"][tag->first.to_string()] = tag->second.to_string();
+            }
+            eventJson["__name__"] = e.GetName().to_string();
+            if (e.Is<UntypedSingleValue>()) {
+                eventJson["__value__"] = e.GetValue<UntypedSingleValue>()->mValue;
+            } else {
+                eventJson["__value__"] = Json::Value();
+                for (auto value = e.GetValue<UntypedMultiDoubleValues>()->ValusBegin();
+                     value != e.GetValue<UntypedMultiDoubleValues>()->ValusEnd();
+                     value++) {
+                    eventJson["__value__"][value->first.to_string()] = value->second;
+                }
+            }
+        }
+        res += Json::writeString(writer, eventJson);
+    }
+    return res;
+}
+
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeLogEvents)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeLogEventsWithDuplicatedKeys)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeLogEventsAsJsoncpp)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeMetricEvents)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeMetricEventsAsJsoncpp)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeSpanEvents)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeEmptyGroup)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <limits>
+#include <vector>
+
 #include "pipeline/serializer/SLSSerializer.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "unittest/Unittest.h"
@@ -26,6 +30,7 @@ class SLSSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
     void TestSerializeEventGroupList();
+    void TestSerializeDistributionMetricEvents();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherSLS>(); }
@@ -409,6 +414,57 @@ BatchedEvents SLSSerializerUnittest::CreateBatchedLogEvents(bool enableNanosecon
 }
 
 
+void SLSSerializerUnittest::TestSerializeDistributionMetricEvents() {
+    SLSEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    MetricEvent* e = group.AddMetricEvent();
+    e->SetName("test_histogram");
+    // prometheus events carry the metric name in __name__, which is overridden for each log
+    e->SetTag(string("__name__"), string("test_histogram"));
+    e->SetTag(string("a"), string("x"));
+    e->SetTag(string("z"), string("y"));
+    e->SetTimestamp(1234567890);
+    e->SetValue(HistogramValue{{{0.5, 1.0}, {numeric_limits<double>::infinity(), 3.0}}, 2.5, 3.0});
+    e = group.AddMetricEvent();
+    e->SetName("test_summary");
+    e->SetTag(string("__name__"), string("test_summary"));
+    e->SetTimestamp(1234567890);
+    e->SetValue(SummaryValue{{{0.99, 0.2}}, 17.5, 10.0});
+    BatchedEvents batch(std::move(group.MutableEvents()),
+                        std::move(group.GetSizedTags()),
+                        std::move(group.GetSourceBuffer()),
+                        group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                        std::move(group.GetExactlyOnceCheckpoint()));
+
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+    sls_logs::LogGroup logGroup;
+    APSARA_TEST_TRUE(logGroup.ParseFromString(res));
+
+    // one log per bucket and quantile, plus _sum and _count
+    APSARA_TEST_EQUAL_FATAL(7, logGroup.logs_size());
+    const vector<array<string, 3>> expected = {
+        {"__name__#$#test_histogram_bucket|a#$#x|le#$#0.5|z#$#y", "1.000000", "test_histogram_bucket"},
+        {"__name__#$#test_histogram_bucket|a#$#x|le#$#+Inf|z#$#y", "3.000000", "test_histogram_bucket"},
+        {"__name__#$#test_histogram_sum|a#$#x|z#$#y", "2.500000", "test_histogram_sum"},
+        {"__name__#$#test_histogram_count|a#$#x|z#$#y", "3.000000", "test_histogram_count"},
+        {"__name__#$#test_summary|quantile#$#0.99", "0.200000", "test_summary"},
+        {"__name__#$#test_summary_sum", "17.500000", "test_summary_sum"},
+        {"__name__#$#test_summary_count", "10.000000", "test_summary_count"},
+    };
+    for (int i = 0; i < logGroup.logs_size(); ++i) {
+        const auto& log = logGroup.logs(i);
+        APSARA_TEST_EQUAL(1234567890U, log.time());
+        APSARA_TEST_EQUAL(4, log.contents_size());
+        APSARA_TEST_EQUAL("__labels__", log.contents(0).key());
+        APSARA_TEST_EQUAL(expected[i][0], log.contents(0).value());
+        APSARA_TEST_EQUAL("__value__", log.contents(2).key());
+        APSARA_TEST_EQUAL(expected[i][1], log.contents(2).value());
+        APSARA_TEST_EQUAL("__name__", log.contents(3).key());
+        APSARA_TEST_EQUAL(expected[i][2], log.contents(3).value());
+    }
+}
+
 BatchedEvents SLSSerializerUnittest::CreateBatchedMetricEvents(bool enableNanosecond,
                                                                uint32_t nanoTimestamp,
                                                                bool emptyValue,
@@ -527,6 +583,7 @@ BatchedEvents SLSSerializerUnittest::CreateBatchedSpanEvents() {
 
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroup)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroupList)
+UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeDistributionMetricEvents)
 
 } // namespace logtail
 